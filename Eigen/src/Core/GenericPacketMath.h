@@ -465,6 +465,17 @@ pmadd(const Packet&  a,
          const Packet&  c)
 { return padd(pmul(a, b),c); }
 
+/** \internal \returns c plus, for each 32-bit integer lane, the sum of the products of the two pairs
+  * of 16-bit signed integers packed in the corresponding lanes of a and b (as the x86 pmaddwd instruction).
+  * The sums wrap around on overflow, which only happens when all four integers are -32768. */
+template<typename Packet> EIGEN_DEVICE_FUNC inline Packet
+pmaddpairs(const Packet& a, const Packet& b, const Packet& c)
+{
+  const int lo = int(short(a & 0xffff)) * int(short(b & 0xffff));
+  const int hi = int(short(a >> 16)) * int(short(b >> 16));
+  return static_cast<Packet>(static_cast<unsigned int>(lo) + static_cast<unsigned int>(hi) + static_cast<unsigned int>(c));
+}
+
 /** \internal \returns a packet version of \a *from.
   * The pointer \a from must be aligned on a \a Alignment bytes boundary. */
 template<typename Packet, int Alignment>
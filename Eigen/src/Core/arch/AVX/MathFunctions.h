@@ -431,6 +431,21 @@ Packet4d prsqrt<Packet4d>(const Packet4d& x) {
   return _mm256_div_pd(p4d_one, _mm256_sqrt_pd(x));
 }
 
+template <> EIGEN_DEFINE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS EIGEN_UNUSED
+Packet8bf psqrt<Packet8bf>(const Packet8bf& x) {
+  return float_to_bf16(psqrt<Packet8f>(bf16_to_float(x)));
+}
+
+template <> EIGEN_DEFINE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS EIGEN_UNUSED
+Packet8bf pexp<Packet8bf>(const Packet8bf& x) {
+  return float_to_bf16(pexp<Packet8f>(bf16_to_float(x)));
+}
+
+template <> EIGEN_DEFINE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS EIGEN_UNUSED
+Packet8bf plog<Packet8bf>(const Packet8bf& x) {
+  return float_to_bf16(plog<Packet8f>(bf16_to_float(x)));
+}
+
 
 }  // end namespace internal
 
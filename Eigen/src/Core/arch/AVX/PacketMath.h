@@ -146,6 +146,10 @@ template<> EIGEN_STRONG_INLINE Packet8f pconj(const Packet8f& a) { return a; }
 template<> EIGEN_STRONG_INLINE Packet4d pconj(const Packet4d& a) { return a; }
 template<> EIGEN_STRONG_INLINE Packet8i pconj(const Packet8i& a) { return a; }
 
+#ifdef EIGEN_VECTORIZE_AVX2
+template<> EIGEN_STRONG_INLINE Packet8i pmaddpairs(const Packet8i& a, const Packet8i& b, const Packet8i& c) { return _mm256_add_epi32(_mm256_madd_epi16(a,b), c); }
+#endif
+
 template<> EIGEN_STRONG_INLINE Packet8f pmul<Packet8f>(const Packet8f& a, const Packet8f& b) { return _mm256_mul_ps(a,b); }
 template<> EIGEN_STRONG_INLINE Packet4d pmul<Packet4d>(const Packet4d& a, const Packet4d& b) { return _mm256_mul_pd(a,b); }
 
@@ -639,6 +643,256 @@ template<> EIGEN_STRONG_INLINE Packet4d pinsertlast(const Packet4d& a, double b)
   return _mm256_blend_pd(a,pset1<Packet4d>(b),(1<<3));
 }
 
+// bfloat16 packets: 8 bfloat16 fit in a SSE register and convert to a Packet8f,
+// in which the arithmetic operations are performed.
+typedef struct {
+  __m128i x;
+} Packet8bf;
+
+template<> struct is_arithmetic<Packet8bf> { enum { value = true }; };
+
+#ifndef EIGEN_VECTORIZE_AVX512
+template<> struct packet_traits<bfloat16> : default_packet_traits
+{
+  typedef Packet8bf type;
+  // There is no half-size packet for Packet8bf.
+  typedef Packet8bf half;
+  enum {
+    Vectorizable = 1,
+    AlignedOnScalar = 1,
+    size = 8,
+    HasHalfPacket = 0,
+    HasAdd    = 1,
+    HasSub    = 1,
+    HasMul    = 1,
+    HasNegate = 1,
+    HasAbs    = 1,
+    HasAbs2   = 0,
+    HasMin    = 1,
+    HasMax    = 1,
+    HasConj   = 1,
+    HasSetLinear = 1,
+    HasDiv    = 1,
+    HasSqrt   = 1,
+    HasRsqrt  = 0,
+    HasExp    = 1,
+    HasLog    = 1,
+    HasBlend  = 0
+  };
+};
+#endif
+
+template<> struct unpacket_traits<Packet8bf> { typedef bfloat16 type; enum {size=8, alignment=Aligned16}; typedef Packet8bf half; };
+
+EIGEN_STRONG_INLINE Packet8f bf16_to_float(const Packet8bf& a) {
+#ifdef EIGEN_VECTORIZE_AVX2
+  return _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_cvtepu16_epi32(a.x), 16));
+#else
+  const __m128i zero = _mm_setzero_si128();
+  return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_castsi128_ps(_mm_unpacklo_epi16(zero, a.x))),
+                              _mm_castsi128_ps(_mm_unpackhi_epi16(zero, a.x)), 1);
+#endif
+}
+
+EIGEN_STRONG_INLINE Packet8bf float_to_bf16(const Packet8f& a) {
+  Packet8bf result;
+  result.x = _mm_packs_epi32(float_to_bf16_epi32(_mm256_castps256_ps128(a)),
+                             float_to_bf16_epi32(_mm256_extractf128_ps(a, 1)));
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf pset1<Packet8bf>(const bfloat16& from) {
+  Packet8bf result;
+  result.x = _mm_set1_epi16(from.value);
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE bfloat16 pfirst<Packet8bf>(const Packet8bf& from) {
+  return bfloat16_impl::raw_uint16_to_bfloat16(static_cast<unsigned short>(_mm_extract_epi16(from.x, 0)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf pload<Packet8bf>(const bfloat16* from) {
+  Packet8bf result;
+  result.x = _mm_load_si128(reinterpret_cast<const __m128i*>(from));
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf ploadu<Packet8bf>(const bfloat16* from) {
+  Packet8bf result;
+  result.x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(from));
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE void pstore<bfloat16>(bfloat16* to, const Packet8bf& from) {
+  _mm_store_si128(reinterpret_cast<__m128i*>(to), from.x);
+}
+
+template<> EIGEN_STRONG_INLINE void pstoreu<bfloat16>(bfloat16* to, const Packet8bf& from) {
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(to), from.x);
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf ploaddup<Packet8bf>(const bfloat16* from) {
+  Packet8bf result;
+  // duplicate the 16-bit words of the lower half
+  result.x = _mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(from)),
+                                _mm_loadl_epi64(reinterpret_cast<const __m128i*>(from)));
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf ploadquad<Packet8bf>(const bfloat16* from) {
+  Packet8bf result;
+  const short a = static_cast<short>(from[0].value);
+  const short b = static_cast<short>(from[1].value);
+  result.x = _mm_set_epi16(b, b, b, b, a, a, a, a);
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf pgather<bfloat16, Packet8bf>(const bfloat16* from, Index stride) {
+  Packet8bf result;
+  result.x = _mm_set_epi16(from[7*stride].value, from[6*stride].value, from[5*stride].value, from[4*stride].value,
+                           from[3*stride].value, from[2*stride].value, from[1*stride].value, from[0*stride].value);
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE void pscatter<bfloat16, Packet8bf>(bfloat16* to, const Packet8bf& from, Index stride) {
+  EIGEN_ALIGN16 bfloat16 aux[8];
+  pstore(aux, from);
+  for(int i=0; i<8; ++i)
+    to[stride*i] = aux[i];
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf pconj(const Packet8bf& a) { return a; }
+
+template<> EIGEN_STRONG_INLINE Packet8bf pnegate(const Packet8bf& a) {
+  Packet8bf result;
+  result.x = _mm_xor_si128(a.x, _mm_set1_epi16(static_cast<short>(0x8000)));
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf pabs(const Packet8bf& a) {
+  Packet8bf result;
+  result.x = _mm_and_si128(a.x, _mm_set1_epi16(0x7fff));
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf padd<Packet8bf>(const Packet8bf& a, const Packet8bf& b) {
+  return float_to_bf16(padd<Packet8f>(bf16_to_float(a), bf16_to_float(b)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf psub<Packet8bf>(const Packet8bf& a, const Packet8bf& b) {
+  return float_to_bf16(psub<Packet8f>(bf16_to_float(a), bf16_to_float(b)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf pmul<Packet8bf>(const Packet8bf& a, const Packet8bf& b) {
+  return float_to_bf16(pmul<Packet8f>(bf16_to_float(a), bf16_to_float(b)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf pmadd<Packet8bf>(const Packet8bf& a, const Packet8bf& b, const Packet8bf& c) {
+  return float_to_bf16(pmadd<Packet8f>(bf16_to_float(a), bf16_to_float(b), bf16_to_float(c)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf pdiv<Packet8bf>(const Packet8bf& a, const Packet8bf& b) {
+  return float_to_bf16(pdiv<Packet8f>(bf16_to_float(a), bf16_to_float(b)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf pmin<Packet8bf>(const Packet8bf& a, const Packet8bf& b) {
+  return float_to_bf16(pmin<Packet8f>(bf16_to_float(a), bf16_to_float(b)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf pmax<Packet8bf>(const Packet8bf& a, const Packet8bf& b) {
+  return float_to_bf16(pmax<Packet8f>(bf16_to_float(a), bf16_to_float(b)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf plset<Packet8bf>(const bfloat16& a) {
+  return float_to_bf16(plset<Packet8f>(static_cast<float>(a)));
+}
+
+template<> EIGEN_STRONG_INLINE bfloat16 predux<Packet8bf>(const Packet8bf& a) {
+  return bfloat16(predux<Packet8f>(bf16_to_float(a)));
+}
+
+template<> EIGEN_STRONG_INLINE bfloat16 predux_mul<Packet8bf>(const Packet8bf& a) {
+  return bfloat16(predux_mul<Packet8f>(bf16_to_float(a)));
+}
+
+template<> EIGEN_STRONG_INLINE bfloat16 predux_min<Packet8bf>(const Packet8bf& a) {
+  return bfloat16(predux_min<Packet8f>(bf16_to_float(a)));
+}
+
+template<> EIGEN_STRONG_INLINE bfloat16 predux_max<Packet8bf>(const Packet8bf& a) {
+  return bfloat16(predux_max<Packet8f>(bf16_to_float(a)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf preduxp<Packet8bf>(const Packet8bf* vecs) {
+  Packet8f pf[8];
+  for(int i=0; i<8; ++i)
+    pf[i] = bf16_to_float(vecs[i]);
+  return float_to_bf16(preduxp<Packet8f>(pf));
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf pinsertfirst(const Packet8bf& a, bfloat16 b) {
+  Packet8bf result;
+  result.x = _mm_insert_epi16(a.x, int(b.value), 0);
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf pinsertlast(const Packet8bf& a, bfloat16 b) {
+  Packet8bf result;
+  result.x = _mm_insert_epi16(a.x, int(b.value), 7);
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet8bf preverse(const Packet8bf& a) {
+  Packet8bf result;
+  result.x = _mm_shuffle_epi8(a.x, _mm_setr_epi8(14,15,12,13,10,11,8,9,6,7,4,5,2,3,0,1));
+  return result;
+}
+
+EIGEN_DEVICE_FUNC inline void
+ptranspose(PacketBlock<Packet8bf,8>& kernel) {
+  __m128i a = _mm_unpacklo_epi16(kernel.packet[0].x, kernel.packet[1].x);
+  __m128i b = _mm_unpacklo_epi16(kernel.packet[2].x, kernel.packet[3].x);
+  __m128i c = _mm_unpacklo_epi16(kernel.packet[4].x, kernel.packet[5].x);
+  __m128i d = _mm_unpacklo_epi16(kernel.packet[6].x, kernel.packet[7].x);
+  __m128i e = _mm_unpackhi_epi16(kernel.packet[0].x, kernel.packet[1].x);
+  __m128i f = _mm_unpackhi_epi16(kernel.packet[2].x, kernel.packet[3].x);
+  __m128i g = _mm_unpackhi_epi16(kernel.packet[4].x, kernel.packet[5].x);
+  __m128i h = _mm_unpackhi_epi16(kernel.packet[6].x, kernel.packet[7].x);
+
+  __m128i ab_lo = _mm_unpacklo_epi32(a, b);
+  __m128i ab_hi = _mm_unpackhi_epi32(a, b);
+  __m128i cd_lo = _mm_unpacklo_epi32(c, d);
+  __m128i cd_hi = _mm_unpackhi_epi32(c, d);
+  __m128i ef_lo = _mm_unpacklo_epi32(e, f);
+  __m128i ef_hi = _mm_unpackhi_epi32(e, f);
+  __m128i gh_lo = _mm_unpacklo_epi32(g, h);
+  __m128i gh_hi = _mm_unpackhi_epi32(g, h);
+
+  kernel.packet[0].x = _mm_unpacklo_epi64(ab_lo, cd_lo);
+  kernel.packet[1].x = _mm_unpackhi_epi64(ab_lo, cd_lo);
+  kernel.packet[2].x = _mm_unpacklo_epi64(ab_hi, cd_hi);
+  kernel.packet[3].x = _mm_unpackhi_epi64(ab_hi, cd_hi);
+  kernel.packet[4].x = _mm_unpacklo_epi64(ef_lo, gh_lo);
+  kernel.packet[5].x = _mm_unpackhi_epi64(ef_lo, gh_lo);
+  kernel.packet[6].x = _mm_unpacklo_epi64(ef_hi, gh_hi);
+  kernel.packet[7].x = _mm_unpackhi_epi64(ef_hi, gh_hi);
+}
+
+// Interleaves the coefficients of 4 packets as the packing of the rhs of products expects it: the first
+// result holds the first two coefficients of each packet, the second one the next two, and so on.
+EIGEN_DEVICE_FUNC inline void
+ptranspose(PacketBlock<Packet8bf,4>& kernel) {
+  __m128i a = _mm_unpacklo_epi16(kernel.packet[0].x, kernel.packet[1].x);
+  __m128i b = _mm_unpacklo_epi16(kernel.packet[2].x, kernel.packet[3].x);
+  __m128i c = _mm_unpackhi_epi16(kernel.packet[0].x, kernel.packet[1].x);
+  __m128i d = _mm_unpackhi_epi16(kernel.packet[2].x, kernel.packet[3].x);
+
+  kernel.packet[0].x = _mm_unpacklo_epi32(a, b);
+  kernel.packet[1].x = _mm_unpackhi_epi32(a, b);
+  kernel.packet[2].x = _mm_unpacklo_epi32(c, d);
+  kernel.packet[3].x = _mm_unpackhi_epi32(c, d);
+}
+
 } // end namespace internal
 
 } // end namespace Eigen
@@ -373,6 +373,26 @@ EIGEN_STRONG_INLINE Packet16f prsqrt<Packet16f>(const Packet16f& x) {
   return _mm512_rsqrt28_ps(x);
 }
 #endif
+
+template <>
+EIGEN_DEFINE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS EIGEN_UNUSED Packet16bf
+psqrt<Packet16bf>(const Packet16bf& x) {
+  return float_to_bf16(psqrt<Packet16f>(bf16_to_float(x)));
+}
+
+template <>
+EIGEN_DEFINE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS EIGEN_UNUSED Packet16bf
+pexp<Packet16bf>(const Packet16bf& x) {
+  return float_to_bf16(pexp<Packet16f>(bf16_to_float(x)));
+}
+
+#if defined(EIGEN_VECTORIZE_AVX512DQ)
+template <>
+EIGEN_DEFINE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS EIGEN_UNUSED Packet16bf
+plog<Packet16bf>(const Packet16bf& x) {
+  return float_to_bf16(plog<Packet16f>(bf16_to_float(x)));
+}
+#endif
 #endif
 
 }  // end namespace internal
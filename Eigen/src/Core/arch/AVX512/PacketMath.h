@@ -193,6 +193,13 @@ EIGEN_STRONG_INLINE Packet16i pconj(const Packet16i& a) {
   return a;
 }
 
+#ifdef EIGEN_VECTORIZE_AVX512BW
+template <>
+EIGEN_STRONG_INLINE Packet16i pmaddpairs(const Packet16i& a, const Packet16i& b, const Packet16i& c) {
+  return _mm512_add_epi32(_mm512_madd_epi16(a, b), c);
+}
+#endif
+
 template <>
 EIGEN_STRONG_INLINE Packet16f pmul<Packet16f>(const Packet16f& a,
                                               const Packet16f& b) {
@@ -1320,6 +1327,244 @@ template<> EIGEN_STRONG_INLINE Packet8d pinsertlast(const Packet8d& a, double b)
   return _mm512_mask_broadcastsd_pd(a, (1<<7), _mm_load_sd(&b));
 }
 
+// bfloat16 packets: 16 bfloat16 fit in an AVX register and convert to a Packet16f,
+// in which the arithmetic operations are performed.
+typedef struct {
+  __m256i x;
+} Packet16bf;
+
+template<> struct is_arithmetic<Packet16bf> { enum { value = true }; };
+
+template<> struct packet_traits<bfloat16> : default_packet_traits
+{
+  typedef Packet16bf type;
+  // There is no half-size packet for Packet16bf.
+  typedef Packet16bf half;
+  enum {
+    Vectorizable = 1,
+    AlignedOnScalar = 1,
+    size = 16,
+    HasHalfPacket = 0,
+    HasAdd    = 1,
+    HasSub    = 1,
+    HasMul    = 1,
+    HasNegate = 1,
+    HasAbs    = 1,
+    HasAbs2   = 0,
+    HasMin    = 1,
+    HasMax    = 1,
+    HasConj   = 1,
+    HasSetLinear = 1,
+    HasDiv    = 1,
+    HasSqrt   = packet_traits<float>::HasSqrt,
+    HasRsqrt  = 0,
+    HasExp    = packet_traits<float>::HasExp,
+    HasLog    = packet_traits<float>::HasLog,
+    HasBlend  = 0
+  };
+};
+
+template<> struct unpacket_traits<Packet16bf> { typedef bfloat16 type; enum {size=16, alignment=Aligned32}; typedef Packet16bf half; };
+
+EIGEN_STRONG_INLINE Packet16f bf16_to_float(const Packet16bf& a) {
+  return _mm512_castsi512_ps(_mm512_slli_epi32(_mm512_cvtepu16_epi32(a.x), 16));
+}
+
+EIGEN_STRONG_INLINE Packet16bf float_to_bf16(const Packet16f& a) {
+  const __m512i u = _mm512_castps_si512(a);
+  const __m512i lsb = _mm512_and_si512(_mm512_srli_epi32(u, 16), _mm512_set1_epi32(1));
+  const __m512i rounded = _mm512_add_epi32(u, _mm512_add_epi32(_mm512_set1_epi32(0x7fff), lsb));
+  // NaNs are not rounded, which could turn them into infinities, but made quiet
+  const __mmask16 nan = _mm512_cmpgt_epi32_mask(_mm512_and_si512(u, _mm512_set1_epi32(0x7fffffff)), _mm512_set1_epi32(0x7f800000));
+  const __m512i t = _mm512_mask_blend_epi32(nan, rounded, _mm512_or_si512(u, _mm512_set1_epi32(0x00400000)));
+  Packet16bf result;
+  result.x = _mm512_cvtepi32_epi16(_mm512_srli_epi32(t, 16));
+  return result;
+}
+
+// Splits a Packet16bf into its two Packet8bf halves, and conversely.
+EIGEN_STRONG_INLINE Packet8bf bf16_lower_half(const Packet16bf& a) {
+  Packet8bf result;
+  result.x = _mm256_castsi256_si128(a.x);
+  return result;
+}
+
+EIGEN_STRONG_INLINE Packet8bf bf16_upper_half(const Packet16bf& a) {
+  Packet8bf result;
+  result.x = _mm256_extractf128_si256(a.x, 1);
+  return result;
+}
+
+EIGEN_STRONG_INLINE Packet16bf bf16_concat(const Packet8bf& lo, const Packet8bf& hi) {
+  Packet16bf result;
+  result.x = _mm256_insertf128_si256(_mm256_castsi128_si256(lo.x), hi.x, 1);
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet16bf pset1<Packet16bf>(const bfloat16& from) {
+  Packet16bf result;
+  result.x = _mm256_set1_epi16(from.value);
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE bfloat16 pfirst<Packet16bf>(const Packet16bf& from) {
+  return bfloat16_impl::raw_uint16_to_bfloat16(static_cast<unsigned short>(_mm_extract_epi16(_mm256_castsi256_si128(from.x), 0)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet16bf pload<Packet16bf>(const bfloat16* from) {
+  Packet16bf result;
+  result.x = _mm256_load_si256(reinterpret_cast<const __m256i*>(from));
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet16bf ploadu<Packet16bf>(const bfloat16* from) {
+  Packet16bf result;
+  result.x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(from));
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE void pstore<bfloat16>(bfloat16* to, const Packet16bf& from) {
+  _mm256_store_si256(reinterpret_cast<__m256i*>(to), from.x);
+}
+
+template<> EIGEN_STRONG_INLINE void pstoreu<bfloat16>(bfloat16* to, const Packet16bf& from) {
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(to), from.x);
+}
+
+template<> EIGEN_STRONG_INLINE Packet16bf ploaddup<Packet16bf>(const bfloat16* from) {
+  return bf16_concat(ploaddup<Packet8bf>(from), ploaddup<Packet8bf>(from + 4));
+}
+
+template<> EIGEN_STRONG_INLINE Packet16bf ploadquad<Packet16bf>(const bfloat16* from) {
+  return bf16_concat(ploadquad<Packet8bf>(from), ploadquad<Packet8bf>(from + 2));
+}
+
+template<> EIGEN_STRONG_INLINE Packet16bf pgather<bfloat16, Packet16bf>(const bfloat16* from, Index stride) {
+  return bf16_concat(pgather<bfloat16, Packet8bf>(from, stride), pgather<bfloat16, Packet8bf>(from + 8*stride, stride));
+}
+
+template<> EIGEN_STRONG_INLINE void pscatter<bfloat16, Packet16bf>(bfloat16* to, const Packet16bf& from, Index stride) {
+  pscatter<bfloat16, Packet8bf>(to, bf16_lower_half(from), stride);
+  pscatter<bfloat16, Packet8bf>(to + 8*stride, bf16_upper_half(from), stride);
+}
+
+template<> EIGEN_STRONG_INLINE Packet16bf pconj(const Packet16bf& a) { return a; }
+
+template<> EIGEN_STRONG_INLINE Packet16bf pnegate(const Packet16bf& a) {
+  Packet16bf result;
+  result.x = _mm256_xor_si256(a.x, _mm256_set1_epi16(static_cast<short>(0x8000)));
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet16bf pabs(const Packet16bf& a) {
+  Packet16bf result;
+  result.x = _mm256_and_si256(a.x, _mm256_set1_epi16(0x7fff));
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet16bf padd<Packet16bf>(const Packet16bf& a, const Packet16bf& b) {
+  return float_to_bf16(padd<Packet16f>(bf16_to_float(a), bf16_to_float(b)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet16bf psub<Packet16bf>(const Packet16bf& a, const Packet16bf& b) {
+  return float_to_bf16(psub<Packet16f>(bf16_to_float(a), bf16_to_float(b)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet16bf pmul<Packet16bf>(const Packet16bf& a, const Packet16bf& b) {
+  return float_to_bf16(pmul<Packet16f>(bf16_to_float(a), bf16_to_float(b)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet16bf pmadd<Packet16bf>(const Packet16bf& a, const Packet16bf& b, const Packet16bf& c) {
+  return float_to_bf16(pmadd<Packet16f>(bf16_to_float(a), bf16_to_float(b), bf16_to_float(c)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet16bf pdiv<Packet16bf>(const Packet16bf& a, const Packet16bf& b) {
+  return float_to_bf16(pdiv<Packet16f>(bf16_to_float(a), bf16_to_float(b)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet16bf pmin<Packet16bf>(const Packet16bf& a, const Packet16bf& b) {
+  return float_to_bf16(pmin<Packet16f>(bf16_to_float(a), bf16_to_float(b)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet16bf pmax<Packet16bf>(const Packet16bf& a, const Packet16bf& b) {
+  return float_to_bf16(pmax<Packet16f>(bf16_to_float(a), bf16_to_float(b)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet16bf plset<Packet16bf>(const bfloat16& a) {
+  return float_to_bf16(plset<Packet16f>(static_cast<float>(a)));
+}
+
+template<> EIGEN_STRONG_INLINE bfloat16 predux<Packet16bf>(const Packet16bf& a) {
+  return bfloat16(predux<Packet16f>(bf16_to_float(a)));
+}
+
+template<> EIGEN_STRONG_INLINE bfloat16 predux_mul<Packet16bf>(const Packet16bf& a) {
+  return bfloat16(predux_mul<Packet16f>(bf16_to_float(a)));
+}
+
+template<> EIGEN_STRONG_INLINE bfloat16 predux_min<Packet16bf>(const Packet16bf& a) {
+  return bfloat16(predux_min<Packet16f>(bf16_to_float(a)));
+}
+
+template<> EIGEN_STRONG_INLINE bfloat16 predux_max<Packet16bf>(const Packet16bf& a) {
+  return bfloat16(predux_max<Packet16f>(bf16_to_float(a)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet16bf preduxp<Packet16bf>(const Packet16bf* vecs) {
+  Packet16f pf[16];
+  for(int i=0; i<16; ++i)
+    pf[i] = bf16_to_float(vecs[i]);
+  return float_to_bf16(preduxp<Packet16f>(pf));
+}
+
+template<> EIGEN_STRONG_INLINE Packet16bf pinsertfirst(const Packet16bf& a, bfloat16 b) {
+  return bf16_concat(pinsertfirst(bf16_lower_half(a), b), bf16_upper_half(a));
+}
+
+template<> EIGEN_STRONG_INLINE Packet16bf pinsertlast(const Packet16bf& a, bfloat16 b) {
+  return bf16_concat(bf16_lower_half(a), pinsertlast(bf16_upper_half(a), b));
+}
+
+template<> EIGEN_STRONG_INLINE Packet16bf preverse(const Packet16bf& a) {
+  return bf16_concat(preverse(bf16_upper_half(a)), preverse(bf16_lower_half(a)));
+}
+
+// The transpositions work on the Packet8bf halves: the 16x16 block is made of four 8x8 blocks.
+EIGEN_DEVICE_FUNC inline void
+ptranspose(PacketBlock<Packet16bf,16>& kernel) {
+  PacketBlock<Packet8bf,8> q[4];
+  for(int i=0; i<8; ++i)
+  {
+    q[0].packet[i] = bf16_lower_half(kernel.packet[i]);
+    q[1].packet[i] = bf16_upper_half(kernel.packet[i]);
+    q[2].packet[i] = bf16_lower_half(kernel.packet[i+8]);
+    q[3].packet[i] = bf16_upper_half(kernel.packet[i+8]);
+  }
+  for(int j=0; j<4; ++j)
+    ptranspose(q[j]);
+  for(int i=0; i<8; ++i)
+  {
+    kernel.packet[i]   = bf16_concat(q[0].packet[i], q[2].packet[i]);
+    kernel.packet[i+8] = bf16_concat(q[1].packet[i], q[3].packet[i]);
+  }
+}
+
+EIGEN_DEVICE_FUNC inline void
+ptranspose(PacketBlock<Packet16bf,4>& kernel) {
+  PacketBlock<Packet8bf,4> lo, hi;
+  for(int i=0; i<4; ++i)
+  {
+    lo.packet[i] = bf16_lower_half(kernel.packet[i]);
+    hi.packet[i] = bf16_upper_half(kernel.packet[i]);
+  }
+  ptranspose(lo);
+  ptranspose(hi);
+  kernel.packet[0] = bf16_concat(lo.packet[0], lo.packet[1]);
+  kernel.packet[1] = bf16_concat(lo.packet[2], lo.packet[3]);
+  kernel.packet[2] = bf16_concat(hi.packet[0], hi.packet[1]);
+  kernel.packet[3] = bf16_concat(hi.packet[2], hi.packet[3]);
+}
+
 } // end namespace internal
 
 } // end namespace Eigen
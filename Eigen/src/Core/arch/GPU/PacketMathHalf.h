@@ -501,17 +501,17 @@ struct packet_traits<half> : default_packet_traits {
     HasSub    = 1,
     HasMul    = 1,
     HasNegate = 1,
-    HasAbs    = 0,
+    HasAbs    = 1,
     HasAbs2   = 0,
-    HasMin    = 0,
-    HasMax    = 0,
+    HasMin    = 1,
+    HasMax    = 1,
     HasConj   = 0,
-    HasSetLinear = 0,
-    HasDiv = 0,
-    HasSqrt = 0,
+    HasSetLinear = 1,
+    HasDiv = 1,
+    HasSqrt = 1,
     HasRsqrt = 0,
-    HasExp = 0,
-    HasLog = 0,
+    HasExp = packet_traits<float>::HasExp,
+    HasLog = packet_traits<float>::HasLog,
     HasBlend = 0
   };
 };
@@ -637,10 +637,15 @@ EIGEN_STRONG_INLINE Packet16h float2half(const Packet16f& a) {
 }
 
 template<> EIGEN_STRONG_INLINE Packet16h pnegate(const Packet16h& a) {
-  // FIXME we could do that with bit manipulation
-  Packet16f af = half2float(a);
-  Packet16f rf = pnegate(af);
-  return float2half(rf);
+  Packet16h result;
+  result.x = _mm256_xor_si256(a.x, _mm256_set1_epi16(short(0x8000)));
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet16h pabs(const Packet16h& a) {
+  Packet16h result;
+  result.x = _mm256_and_si256(a.x, _mm256_set1_epi16(0x7fff));
+  return result;
 }
 
 template<> EIGEN_STRONG_INLINE Packet16h padd<Packet16h>(const Packet16h& a, const Packet16h& b) {
@@ -664,6 +669,63 @@ template<> EIGEN_STRONG_INLINE Packet16h pmul<Packet16h>(const Packet16h& a, con
   return float2half(rf);
 }
 
+// The product and the sum are computed in float and rounded only once
+template<> EIGEN_STRONG_INLINE Packet16h pmadd<Packet16h>(const Packet16h& a, const Packet16h& b, const Packet16h& c) {
+  Packet16f af = half2float(a);
+  Packet16f bf = half2float(b);
+  Packet16f cf = half2float(c);
+  Packet16f rf = pmadd(af, bf, cf);
+  return float2half(rf);
+}
+
+template<> EIGEN_STRONG_INLINE Packet16h pdiv<Packet16h>(const Packet16h& a, const Packet16h& b) {
+  Packet16f af = half2float(a);
+  Packet16f bf = half2float(b);
+  Packet16f rf = pdiv(af, bf);
+  return float2half(rf);
+}
+
+template<> EIGEN_STRONG_INLINE Packet16h pmin<Packet16h>(const Packet16h& a, const Packet16h& b) {
+  Packet16f af = half2float(a);
+  Packet16f bf = half2float(b);
+  Packet16f rf = pmin(af, bf);
+  return float2half(rf);
+}
+
+template<> EIGEN_STRONG_INLINE Packet16h pmax<Packet16h>(const Packet16h& a, const Packet16h& b) {
+  Packet16f af = half2float(a);
+  Packet16f bf = half2float(b);
+  Packet16f rf = pmax(af, bf);
+  return float2half(rf);
+}
+
+template<> EIGEN_STRONG_INLINE Packet16h plset<Packet16h>(const Eigen::half& a) {
+  return float2half(plset<Packet16f>(static_cast<float>(a)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet16h psqrt<Packet16h>(const Packet16h& a) {
+  Packet16f af = half2float(a);
+  Packet16f rf = psqrt(af);
+  return float2half(rf);
+}
+
+#if EIGEN_GNUC_AT_LEAST(5, 3)
+template<> EIGEN_STRONG_INLINE Packet16h pexp<Packet16h>(const Packet16h& a) {
+  Packet16f af = half2float(a);
+  Packet16f rf = pexp(af);
+  return float2half(rf);
+}
+#ifdef EIGEN_VECTORIZE_AVX512DQ
+template<> EIGEN_STRONG_INLINE Packet16h plog<Packet16h>(const Packet16h& a) {
+  Packet16f af = half2float(a);
+  Packet16f rf = plog(af);
+  return float2half(rf);
+}
+#endif
+#endif
+
+template<> EIGEN_STRONG_INLINE Packet16h pconj(const Packet16h& a) { return a; }
+
 template<> EIGEN_STRONG_INLINE half predux<Packet16h>(const Packet16h& from) {
   Packet16f from_float = half2float(from);
   return half(predux(from_float));
@@ -674,6 +736,16 @@ template<> EIGEN_STRONG_INLINE half predux_mul<Packet16h>(const Packet16h& from)
   return half(predux_mul(from_float));
 }
 
+template<> EIGEN_STRONG_INLINE half predux_min<Packet16h>(const Packet16h& from) {
+  Packet16f from_float = half2float(from);
+  return half(predux_min(from_float));
+}
+
+template<> EIGEN_STRONG_INLINE half predux_max<Packet16h>(const Packet16h& from) {
+  Packet16f from_float = half2float(from);
+  return half(predux_max(from_float));
+}
+
 template<> EIGEN_STRONG_INLINE Packet16h preduxp<Packet16h>(const Packet16h* p) {
   Packet16f pf[16];
   pf[0] = half2float(p[0]);
@@ -949,17 +1021,17 @@ struct packet_traits<Eigen::half> : default_packet_traits {
     HasSub    = 1,
     HasMul    = 1,
     HasNegate = 1,
-    HasAbs    = 0,
+    HasAbs    = 1,
     HasAbs2   = 0,
-    HasMin    = 0,
-    HasMax    = 0,
+    HasMin    = 1,
+    HasMax    = 1,
     HasConj   = 0,
-    HasSetLinear = 0,
-    HasDiv = 0,
-    HasSqrt = 0,
+    HasSetLinear = 1,
+    HasDiv = 1,
+    HasSqrt = 1,
     HasRsqrt = 0,
-    HasExp = 0,
-    HasLog = 0,
+    HasExp = 1,
+    HasLog = 1,
     HasBlend = 0
   };
 };
@@ -1062,10 +1134,15 @@ EIGEN_STRONG_INLINE Packet8h float2half(const Packet8f& a) {
 template<> EIGEN_STRONG_INLINE Packet8h pconj(const Packet8h& a) { return a; }
 
 template<> EIGEN_STRONG_INLINE Packet8h pnegate(const Packet8h& a) {
-  // FIXME we could do that with bit manipulation
-  Packet8f af = half2float(a);
-  Packet8f rf = pnegate(af);
-  return float2half(rf);
+  Packet8h result;
+  result.x = _mm_xor_si128(a.x, _mm_set1_epi16(short(0x8000)));
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet8h pabs(const Packet8h& a) {
+  Packet8h result;
+  result.x = _mm_and_si128(a.x, _mm_set1_epi16(0x7fff));
+  return result;
 }
 
 template<> EIGEN_STRONG_INLINE Packet8h padd<Packet8h>(const Packet8h& a, const Packet8h& b) {
@@ -1089,6 +1166,58 @@ template<> EIGEN_STRONG_INLINE Packet8h pmul<Packet8h>(const Packet8h& a, const
   return float2half(rf);
 }
 
+// The product and the sum are computed in float and rounded only once
+template<> EIGEN_STRONG_INLINE Packet8h pmadd<Packet8h>(const Packet8h& a, const Packet8h& b, const Packet8h& c) {
+  Packet8f af = half2float(a);
+  Packet8f bf = half2float(b);
+  Packet8f cf = half2float(c);
+  Packet8f rf = pmadd(af, bf, cf);
+  return float2half(rf);
+}
+
+template<> EIGEN_STRONG_INLINE Packet8h pdiv<Packet8h>(const Packet8h& a, const Packet8h& b) {
+  Packet8f af = half2float(a);
+  Packet8f bf = half2float(b);
+  Packet8f rf = pdiv(af, bf);
+  return float2half(rf);
+}
+
+template<> EIGEN_STRONG_INLINE Packet8h pmin<Packet8h>(const Packet8h& a, const Packet8h& b) {
+  Packet8f af = half2float(a);
+  Packet8f bf = half2float(b);
+  Packet8f rf = pmin(af, bf);
+  return float2half(rf);
+}
+
+template<> EIGEN_STRONG_INLINE Packet8h pmax<Packet8h>(const Packet8h& a, const Packet8h& b) {
+  Packet8f af = half2float(a);
+  Packet8f bf = half2float(b);
+  Packet8f rf = pmax(af, bf);
+  return float2half(rf);
+}
+
+template<> EIGEN_STRONG_INLINE Packet8h plset<Packet8h>(const Eigen::half& a) {
+  return float2half(plset<Packet8f>(static_cast<float>(a)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet8h psqrt<Packet8h>(const Packet8h& a) {
+  Packet8f af = half2float(a);
+  Packet8f rf = psqrt(af);
+  return float2half(rf);
+}
+
+template<> EIGEN_STRONG_INLINE Packet8h pexp<Packet8h>(const Packet8h& a) {
+  Packet8f af = half2float(a);
+  Packet8f rf = pexp(af);
+  return float2half(rf);
+}
+
+template<> EIGEN_STRONG_INLINE Packet8h plog<Packet8h>(const Packet8h& a) {
+  Packet8f af = half2float(a);
+  Packet8f rf = plog(af);
+  return float2half(rf);
+}
+
 template<> EIGEN_STRONG_INLINE Packet8h pgather<Eigen::half, Packet8h>(const Eigen::half* from, Index stride)
 {
   Packet8h result;
@@ -531,6 +531,21 @@ ptanh<Packet4f>(const Packet4f& x) {
   return internal::generic_fast_tanh_float(x);
 }
 
+template<> EIGEN_DEFINE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS EIGEN_UNUSED
+Packet4bf psqrt<Packet4bf>(const Packet4bf& x) {
+  return float_to_bf16(psqrt<Packet4f>(bf16_to_float(x)));
+}
+
+template<> EIGEN_DEFINE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS EIGEN_UNUSED
+Packet4bf pexp<Packet4bf>(const Packet4bf& x) {
+  return float_to_bf16(pexp<Packet4f>(bf16_to_float(x)));
+}
+
+template<> EIGEN_DEFINE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS EIGEN_UNUSED
+Packet4bf plog<Packet4bf>(const Packet4bf& x) {
+  return float_to_bf16(plog<Packet4f>(bf16_to_float(x)));
+}
+
 } // end namespace internal
 
 namespace numext {
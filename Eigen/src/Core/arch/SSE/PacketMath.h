@@ -245,6 +245,7 @@ template<> EIGEN_STRONG_INLINE Packet2d pdiv<Packet2d>(const Packet2d& a, const
 
 // for some weird raisons, it has to be overloaded for packet of integers
 template<> EIGEN_STRONG_INLINE Packet4i pmadd(const Packet4i& a, const Packet4i& b, const Packet4i& c) { return padd(pmul(a,b), c); }
+template<> EIGEN_STRONG_INLINE Packet4i pmaddpairs(const Packet4i& a, const Packet4i& b, const Packet4i& c) { return _mm_add_epi32(_mm_madd_epi16(a,b), c); }
 #ifdef __FMA__
 template<> EIGEN_STRONG_INLINE Packet4f pmadd(const Packet4f& a, const Packet4f& b, const Packet4f& c) { return _mm_fmadd_ps(a,b,c); }
 template<> EIGEN_STRONG_INLINE Packet2d pmadd(const Packet2d& a, const Packet2d& b, const Packet2d& c) { return _mm_fmadd_pd(a,b,c); }
@@ -920,6 +921,224 @@ template<> EIGEN_STRONG_INLINE Packet2d pinsertlast(const Packet2d& a, double b)
 #endif
 }
 
+// bfloat16 packets: 4 bfloat16 are stored in the lower half of a register so that they convert to
+// a Packet4f, and the arithmetic operations are performed in float.
+typedef struct {
+  __m128i x;
+} Packet4bf;
+
+template<> struct is_arithmetic<Packet4bf> { enum { value = true }; };
+
+#ifndef EIGEN_VECTORIZE_AVX
+template<> struct packet_traits<bfloat16> : default_packet_traits
+{
+  typedef Packet4bf type;
+  typedef Packet4bf half;
+  enum {
+    Vectorizable = 1,
+    AlignedOnScalar = 1,
+    size = 4,
+    HasHalfPacket = 0,
+    HasAdd    = 1,
+    HasSub    = 1,
+    HasMul    = 1,
+    HasNegate = 1,
+    HasAbs    = 1,
+    HasAbs2   = 0,
+    HasMin    = 1,
+    HasMax    = 1,
+    HasConj   = 1,
+    HasSetLinear = 1,
+    HasDiv    = 1,
+    HasSqrt   = 1,
+    HasRsqrt  = 0,
+    HasExp    = 1,
+    HasLog    = 1,
+    HasBlend  = 0
+  };
+};
+#endif
+
+template<> struct unpacket_traits<Packet4bf> { typedef bfloat16 type; enum {size=4, alignment=Aligned16}; typedef Packet4bf half; };
+
+EIGEN_STRONG_INLINE Packet4f bf16_to_float(const Packet4bf& a) {
+  return _mm_castsi128_ps(_mm_unpacklo_epi16(_mm_setzero_si128(), a.x));
+}
+
+// Rounds the floats of a to the nearest bfloat16, ties to even, and returns them sign extended to 32 bits.
+EIGEN_STRONG_INLINE __m128i float_to_bf16_epi32(const Packet4f& a) {
+  const __m128i u = _mm_castps_si128(a);
+  const __m128i lsb = _mm_and_si128(_mm_srli_epi32(u, 16), _mm_set1_epi32(1));
+  const __m128i rounded = _mm_add_epi32(u, _mm_add_epi32(_mm_set1_epi32(0x7fff), lsb));
+  // NaNs are not rounded, which could turn them into infinities, but made quiet
+  const __m128i nan = _mm_cmpgt_epi32(_mm_and_si128(u, _mm_set1_epi32(0x7fffffff)), _mm_set1_epi32(0x7f800000));
+  const __m128i quiet = _mm_or_si128(u, _mm_set1_epi32(0x00400000));
+  return _mm_srai_epi32(_mm_or_si128(_mm_and_si128(nan, quiet), _mm_andnot_si128(nan, rounded)), 16);
+}
+
+EIGEN_STRONG_INLINE Packet4bf float_to_bf16(const Packet4f& a) {
+  Packet4bf result;
+  const __m128i t = float_to_bf16_epi32(a);
+  result.x = _mm_packs_epi32(t, t);
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf pset1<Packet4bf>(const bfloat16& from) {
+  Packet4bf result;
+  result.x = _mm_set1_epi16(from.value);
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE bfloat16 pfirst<Packet4bf>(const Packet4bf& from) {
+  return bfloat16_impl::raw_uint16_to_bfloat16(static_cast<unsigned short>(_mm_extract_epi16(from.x, 0)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf pload<Packet4bf>(const bfloat16* from) {
+  Packet4bf result;
+  result.x = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(from));
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf ploadu<Packet4bf>(const bfloat16* from) {
+  Packet4bf result;
+  result.x = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(from));
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE void pstore<bfloat16>(bfloat16* to, const Packet4bf& from) {
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(to), from.x);
+}
+
+template<> EIGEN_STRONG_INLINE void pstoreu<bfloat16>(bfloat16* to, const Packet4bf& from) {
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(to), from.x);
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf ploaddup<Packet4bf>(const bfloat16* from) {
+  Packet4bf result;
+  const short a = static_cast<short>(from[0].value);
+  const short b = static_cast<short>(from[1].value);
+  result.x = _mm_set_epi16(b, b, b, b, b, b, a, a);
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf ploadquad<Packet4bf>(const bfloat16* from) {
+  return pset1<Packet4bf>(from[0]);
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf pgather<bfloat16, Packet4bf>(const bfloat16* from, Index stride) {
+  Packet4bf result;
+  result.x = _mm_set_epi16(0, 0, 0, 0, from[3*stride].value, from[2*stride].value, from[1*stride].value, from[0*stride].value);
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE void pscatter<bfloat16, Packet4bf>(bfloat16* to, const Packet4bf& from, Index stride) {
+  EIGEN_ALIGN16 bfloat16 aux[8];
+  _mm_store_si128(reinterpret_cast<__m128i*>(aux), from.x);
+  to[stride*0] = aux[0];
+  to[stride*1] = aux[1];
+  to[stride*2] = aux[2];
+  to[stride*3] = aux[3];
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf pconj(const Packet4bf& a) { return a; }
+
+template<> EIGEN_STRONG_INLINE Packet4bf pnegate(const Packet4bf& a) {
+  Packet4bf result;
+  result.x = _mm_xor_si128(a.x, _mm_set1_epi16(static_cast<short>(0x8000)));
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf pabs(const Packet4bf& a) {
+  Packet4bf result;
+  result.x = _mm_and_si128(a.x, _mm_set1_epi16(0x7fff));
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf padd<Packet4bf>(const Packet4bf& a, const Packet4bf& b) {
+  return float_to_bf16(padd<Packet4f>(bf16_to_float(a), bf16_to_float(b)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf psub<Packet4bf>(const Packet4bf& a, const Packet4bf& b) {
+  return float_to_bf16(psub<Packet4f>(bf16_to_float(a), bf16_to_float(b)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf pmul<Packet4bf>(const Packet4bf& a, const Packet4bf& b) {
+  return float_to_bf16(pmul<Packet4f>(bf16_to_float(a), bf16_to_float(b)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf pmadd<Packet4bf>(const Packet4bf& a, const Packet4bf& b, const Packet4bf& c) {
+  return float_to_bf16(pmadd<Packet4f>(bf16_to_float(a), bf16_to_float(b), bf16_to_float(c)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf pdiv<Packet4bf>(const Packet4bf& a, const Packet4bf& b) {
+  return float_to_bf16(pdiv<Packet4f>(bf16_to_float(a), bf16_to_float(b)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf pmin<Packet4bf>(const Packet4bf& a, const Packet4bf& b) {
+  return float_to_bf16(pmin<Packet4f>(bf16_to_float(a), bf16_to_float(b)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf pmax<Packet4bf>(const Packet4bf& a, const Packet4bf& b) {
+  return float_to_bf16(pmax<Packet4f>(bf16_to_float(a), bf16_to_float(b)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf plset<Packet4bf>(const bfloat16& a) {
+  return float_to_bf16(plset<Packet4f>(static_cast<float>(a)));
+}
+
+template<> EIGEN_STRONG_INLINE bfloat16 predux<Packet4bf>(const Packet4bf& a) {
+  return bfloat16(predux<Packet4f>(bf16_to_float(a)));
+}
+
+template<> EIGEN_STRONG_INLINE bfloat16 predux_mul<Packet4bf>(const Packet4bf& a) {
+  return bfloat16(predux_mul<Packet4f>(bf16_to_float(a)));
+}
+
+template<> EIGEN_STRONG_INLINE bfloat16 predux_min<Packet4bf>(const Packet4bf& a) {
+  return bfloat16(predux_min<Packet4f>(bf16_to_float(a)));
+}
+
+template<> EIGEN_STRONG_INLINE bfloat16 predux_max<Packet4bf>(const Packet4bf& a) {
+  return bfloat16(predux_max<Packet4f>(bf16_to_float(a)));
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf preduxp<Packet4bf>(const Packet4bf* vecs) {
+  Packet4f pf[4];
+  for(int i=0; i<4; ++i)
+    pf[i] = bf16_to_float(vecs[i]);
+  return float_to_bf16(preduxp<Packet4f>(pf));
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf pinsertfirst(const Packet4bf& a, bfloat16 b) {
+  Packet4bf result;
+  result.x = _mm_insert_epi16(a.x, int(b.value), 0);
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf pinsertlast(const Packet4bf& a, bfloat16 b) {
+  Packet4bf result;
+  result.x = _mm_insert_epi16(a.x, int(b.value), 3);
+  return result;
+}
+
+template<> EIGEN_STRONG_INLINE Packet4bf preverse(const Packet4bf& a) {
+  Packet4bf result;
+  result.x = _mm_shufflelo_epi16(a.x, _MM_SHUFFLE(0,1,2,3));
+  return result;
+}
+
+EIGEN_DEVICE_FUNC inline void
+ptranspose(PacketBlock<Packet4bf,4>& kernel) {
+  __m128i t0 = _mm_unpacklo_epi16(kernel.packet[0].x, kernel.packet[1].x);
+  __m128i t1 = _mm_unpacklo_epi16(kernel.packet[2].x, kernel.packet[3].x);
+  __m128i r01 = _mm_unpacklo_epi32(t0, t1);
+  __m128i r23 = _mm_unpackhi_epi32(t0, t1);
+  kernel.packet[0].x = r01;
+  kernel.packet[1].x = _mm_unpackhi_epi64(r01, r01);
+  kernel.packet[2].x = r23;
+  kernel.packet[3].x = _mm_unpackhi_epi64(r23, r23);
+}
+
 // Scalar path for pmadd with FMA to ensure consistency with vectorized path.
 #ifdef __FMA__
 template<> EIGEN_STRONG_INLINE float pmadd(const float& a, const float& b, const float& c) {
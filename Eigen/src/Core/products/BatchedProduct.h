@@ -0,0 +1,210 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_BATCHED_PRODUCT_H
+#define EIGEN_BATCHED_PRODUCT_H
+
+namespace Eigen {
+
+namespace internal {
+
+/* Computes count independent products dst[b] = lhs[b] * rhs[b] of small fixed-size matrices,
+ * the b-th operands starting b*stride scalars after the first ones.
+ *
+ * Instead of vectorizing each product on its own, PacketSize products are processed together:
+ * their coefficients are interleaved (SoA) by transposing PacketSize x PacketSize blocks such that the
+ * lanes of a packet hold the same coefficient of PacketSize different products. The products are then
+ * evaluated by a register blocked triple loop of packet multiply-adds, and the result de-interleaved.
+ * The remaining count % PacketSize products are evaluated by lazyProduct.
+ *
+ * Interleaving costs a few transpositions per coefficient, so it only pays off when the lazy product of a
+ * single pair cannot be evaluated with full packets (e.g., 3x3 or 7x7 matrices). Otherwise all the products
+ * are evaluated by lazyProduct.
+ */
+template<typename DstType, typename LhsType, typename RhsType>
+struct batched_product_impl
+{
+  typedef typename DstType::Scalar Scalar;
+  typedef typename packet_traits<Scalar>::type Packet;
+  enum {
+    PacketSize = unpacket_traits<Packet>::size,
+    Rows  = LhsType::RowsAtCompileTime,
+    Depth = LhsType::ColsAtCompileTime,
+    Cols  = RhsType::ColsAtCompileTime,
+    Vectorize = packet_traits<Scalar>::Vectorizable && PacketSize>1 && !NumTraits<Scalar>::IsInteger
+  };
+  typedef copy_using_evaluator_traits<evaluator<DstType>, evaluator<Product<LhsType,RhsType,LazyProduct> >,
+                                      assign_op<Scalar,Scalar> > LazyProductTraits;
+  enum {
+    Interleave = Vectorize && int(LazyProductTraits::Traversal)!=int(InnerVectorizedTraversal)
+  };
+
+  // storage index of the coefficient (i,j)
+  template<typename MatrixType>
+  static Index index(Index i, Index j)
+  {
+    return MatrixType::IsRowMajor ? i*MatrixType::ColsAtCompileTime + j : i + j*MatrixType::RowsAtCompileTime;
+  }
+
+  // Interleaves the coefficients of PacketSize matrices of Size coefficients starting stride scalars apart.
+  // When Size is not a multiple of PacketSize, the last block overlaps the previous one.
+  template<int Size>
+  static EIGEN_STRONG_INLINE void pack(Scalar* packed, const Scalar* src, Index stride)
+  {
+    for(Index c=0; c<Size; c+=PacketSize)
+    {
+      if(Size<PacketSize)
+      {
+        for(Index p=0; p<Size; ++p)
+          pstore(packed + p*PacketSize, pgather<Scalar,Packet>(src + p, stride));
+        return;
+      }
+      Index c0 = (std::min)(c, Index(Size-PacketSize));
+      PacketBlock<Packet,PacketSize> block;
+      for(Index p=0; p<PacketSize; ++p)
+        block.packet[p] = ploadu<Packet>(src + p*stride + c0);
+      ptranspose(block);
+      for(Index p=0; p<PacketSize; ++p)
+        pstore(packed + (c0+p)*PacketSize, block.packet[p]);
+    }
+  }
+
+  template<int Size>
+  static EIGEN_STRONG_INLINE void unpack(Scalar* dst, Index stride, const Scalar* packed)
+  {
+    for(Index c=0; c<Size; c+=PacketSize)
+    {
+      if(Size<PacketSize)
+      {
+        for(Index p=0; p<Size; ++p)
+          pscatter<Scalar,Packet>(dst + p, pload<Packet>(packed + p*PacketSize), stride);
+        return;
+      }
+      Index c0 = (std::min)(c, Index(Size-PacketSize));
+      PacketBlock<Packet,PacketSize> block;
+      for(Index p=0; p<PacketSize; ++p)
+        block.packet[p] = pload<Packet>(packed + (c0+p)*PacketSize);
+      ptranspose(block);
+      for(Index p=0; p<PacketSize; ++p)
+        pstoreu(dst + p*stride + c0, block.packet[p]);
+    }
+  }
+
+  // computes the MR x NR block of the interleaved destination starting at (i,j)
+  template<int MR, int NR>
+  static EIGEN_STRONG_INLINE void micro_kernel(Scalar* dst, const Scalar* lhs, const Scalar* rhs, Index i, Index j)
+  {
+    Packet acc[MR][NR];
+    for(int q=0; q<MR; ++q)
+      for(int c=0; c<NR; ++c)
+        acc[q][c] = pset1<Packet>(Scalar(0));
+    for(Index k=0; k<Depth; ++k)
+    {
+      Packet a[MR];
+      for(int q=0; q<MR; ++q)
+        a[q] = pload<Packet>(lhs + index<LhsType>(i+q,k)*PacketSize);
+      for(int c=0; c<NR; ++c)
+      {
+        Packet b = pload<Packet>(rhs + index<RhsType>(k,j+c)*PacketSize);
+        for(int q=0; q<MR; ++q)
+          acc[q][c] = pmadd(a[q], b, acc[q][c]);
+      }
+    }
+    for(int q=0; q<MR; ++q)
+      for(int c=0; c<NR; ++c)
+        pstore(dst + index<DstType>(i+q,j+c)*PacketSize, acc[q][c]);
+  }
+
+  template<int NR>
+  static EIGEN_STRONG_INLINE void micro_panel(Scalar* dst, const Scalar* lhs, const Scalar* rhs, Index j)
+  {
+    const Index peeledRows = (Rows/4)*4;
+    for(Index i=0; i<peeledRows; i+=4)
+      micro_kernel<4,NR>(dst, lhs, rhs, i, j);
+    // process the remaining rows at once to keep several independent accumulators
+    if(Rows%4)
+      micro_kernel<(Rows%4 ? Rows%4 : 1),NR>(dst, lhs, rhs, peeledRows, j);
+  }
+
+  static void run(Scalar* dst, Index dstStride, const Scalar* lhs, Index lhsStride,
+                  const Scalar* rhs, Index rhsStride, Index count)
+  {
+    EIGEN_STATIC_ASSERT(DstType::SizeAtCompileTime!=Dynamic && LhsType::SizeAtCompileTime!=Dynamic && RhsType::SizeAtCompileTime!=Dynamic,
+                        THIS_METHOD_IS_ONLY_FOR_MATRICES_OF_A_SPECIFIC_SIZE)
+    EIGEN_STATIC_ASSERT(int(RhsType::RowsAtCompileTime)==int(Depth) && int(DstType::RowsAtCompileTime)==int(Rows) && int(DstType::ColsAtCompileTime)==int(Cols),
+                        INVALID_MATRIX_PRODUCT)
+    EIGEN_STATIC_ASSERT((internal::is_same<Scalar,typename LhsType::Scalar>::value && internal::is_same<Scalar,typename RhsType::Scalar>::value),
+                        YOU_MIXED_DIFFERENT_NUMERIC_TYPES__YOU_NEED_TO_USE_THE_CAST_METHOD_OF_MATRIXBASE_TO_CAST_NUMERIC_TYPES_EXPLICITLY)
+
+    Index b = 0;
+    if(Interleave)
+    {
+      ei_declare_aligned_stack_constructed_variable(Scalar, packedLhs, Rows*Depth*PacketSize, 0);
+      ei_declare_aligned_stack_constructed_variable(Scalar, packedRhs, Depth*Cols*PacketSize, 0);
+      ei_declare_aligned_stack_constructed_variable(Scalar, packedDst, Rows*Cols*PacketSize, 0);
+      Index peeled = (count/PacketSize)*PacketSize;
+      for(; b<peeled; b+=PacketSize)
+      {
+        pack<Rows*Depth>(packedLhs, lhs + b*lhsStride, lhsStride);
+        pack<Depth*Cols>(packedRhs, rhs + b*rhsStride, rhsStride);
+        Index j = 0;
+        for(; j+2<=Cols; j+=2)
+          micro_panel<2>(packedDst, packedLhs, packedRhs, j);
+        if(j<Cols)
+          micro_panel<1>(packedDst, packedLhs, packedRhs, j);
+        unpack<Rows*Cols>(dst + b*dstStride, dstStride, packedDst);
+      }
+    }
+
+    for(; b<count; ++b)
+      Map<DstType>(dst + b*dstStride).noalias() = Map<const LhsType>(lhs + b*lhsStride).lazyProduct(Map<const RhsType>(rhs + b*rhsStride));
+  }
+};
+
+} // end namespace internal
+
+/** \ingroup Core_Module
+  *
+  * Computes the \a count independent matrix products \c dst[b] \c = \c lhs[b] \c * \c rhs[b] of small fixed-size matrices.
+  *
+  * When the product of a single pair cannot be fully vectorized, e.g., for 3x3, 6x6 or 7x7 matrices of floats, the products
+  * are evaluated several at a time such that the SIMD lanes span the batch rather than the coefficients of a single product.
+  * Otherwise, this is equivalent to calling lazyProduct() for each pair.
+  *
+  * \param dst, lhs, rhs arrays of \a count fixed-size matrices, e.g., the data of a \c std::vector<Matrix4f,aligned_allocator<Matrix4f> >
+  *
+  * The destination must not alias the operands.
+  *
+  * \sa batchedProduct(const Map<DstType>&, Index, const Map<const LhsType>&, Index, const Map<const RhsType>&, Index, Index)
+  */
+template<typename DstType, typename LhsType, typename RhsType>
+void batchedProduct(DstType* dst, const LhsType* lhs, const RhsType* rhs, Index count)
+{
+  typedef typename DstType::Scalar Scalar;
+  internal::batched_product_impl<DstType,LhsType,RhsType>::run(
+      dst->data(), Index(sizeof(DstType)/sizeof(Scalar)),
+      lhs->data(), Index(sizeof(LhsType)/sizeof(Scalar)),
+      rhs->data(), Index(sizeof(RhsType)/sizeof(Scalar)), count);
+}
+
+/** \ingroup Core_Module
+  *
+  * Overload of batchedProduct() for operands stored in user buffers: \a dst, \a lhs and \a rhs map the first matrix of each
+  * array, and the following ones start \a dstStride, \a lhsStride, and \a rhsStride scalars further respectively.
+  * For instance, a 3D tensor of shape 4x4xN can be seen as an array of Matrix4f with a stride of 16.
+  */
+template<typename DstType, typename LhsType, typename RhsType>
+void batchedProduct(const Map<DstType>& dst, Index dstStride, const Map<const LhsType>& lhs, Index lhsStride,
+                    const Map<const RhsType>& rhs, Index rhsStride, Index count)
+{
+  internal::batched_product_impl<DstType,LhsType,RhsType>::run(
+      const_cast<typename DstType::Scalar*>(dst.data()), dstStride, lhs.data(), lhsStride, rhs.data(), rhsStride, count);
+}
+
+} // end namespace Eigen
+
+#endif // EIGEN_BATCHED_PRODUCT_H
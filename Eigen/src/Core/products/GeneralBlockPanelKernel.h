@@ -277,6 +277,126 @@ inline bool useSpecificBlockingSizes(Index& k, Index& m, Index& n)
   return false;
 }
 
+/** \internal Blocking sizes selected for a class of products, see setProductBlockingSizes() */
+struct TunedBlockingSizes
+{
+  int lhs;
+  int rhs;
+  int shape;
+  std::ptrdiff_t kc, mc, nc;
+};
+
+/** \internal Identifies the scalar type T in the table of tuned blocking sizes by its size and kind */
+template<typename T> struct blocking_scalar_code
+{
+  enum { value = int(sizeof(T))*8 + (NumTraits<T>::IsComplex ? 2 : 0) + (NumTraits<T>::IsInteger ? 1 : 0) };
+};
+
+// the 16-bit floating point types have the same size and traits
+template<> struct blocking_scalar_code<half>     { enum { value = 2*8 + 4 }; };
+template<> struct blocking_scalar_code<bfloat16> { enum { value = 2*8 + 5 }; };
+
+/** \internal \returns the class of the k x m x n products, which packs the binary logarithm of each dimension on 4 bits */
+inline int blocking_shape_class(std::ptrdiff_t k, std::ptrdiff_t m, std::ptrdiff_t n)
+{
+  const std::ptrdiff_t dims[3] = { k, m, n };
+  int shape = 0;
+  for(int d=0; d<3; ++d)
+  {
+    int l = 0;
+    while(l<15 && (dims[d]>>(l+1))>0)
+      ++l;
+    shape = (shape<<4) | l;
+  }
+  return shape;
+}
+
+/** \internal Table of the blocking sizes set by setProductBlockingSizes() */
+struct TunedBlockingSizesTable
+{
+  enum { Capacity = 256 };
+
+  TunedBlockingSizesTable() : m_size(0) {}
+
+  int size() const { return m_size; }
+  const TunedBlockingSizes& operator[](int i) const { return m_entries[i]; }
+  void clear() { m_size = 0; }
+
+  const TunedBlockingSizes* find(int lhs, int rhs, int shape) const
+  {
+    for(int i=0; i<m_size; ++i)
+      if(m_entries[i].shape==shape && m_entries[i].lhs==lhs && m_entries[i].rhs==rhs)
+        return &m_entries[i];
+    return 0;
+  }
+
+  bool insert(const TunedBlockingSizes& entry)
+  {
+    for(int i=0; i<m_size; ++i)
+    {
+      if(m_entries[i].shape==entry.shape && m_entries[i].lhs==entry.lhs && m_entries[i].rhs==entry.rhs)
+      {
+        m_entries[i] = entry;
+        return true;
+      }
+    }
+    if(m_size==Capacity)
+      return false;
+    m_entries[m_size++] = entry;
+    return true;
+  }
+
+  void erase(int lhs, int rhs, int shape)
+  {
+    for(int i=0; i<m_size; ++i)
+    {
+      if(m_entries[i].shape==shape && m_entries[i].lhs==lhs && m_entries[i].rhs==rhs)
+      {
+        m_entries[i] = m_entries[--m_size];
+        return;
+      }
+    }
+  }
+
+protected:
+  int m_size;
+  TunedBlockingSizes m_entries[Capacity];
+};
+
+/** \internal */
+inline TunedBlockingSizesTable& tuned_blocking_sizes()
+{
+  static TunedBlockingSizesTable table;
+  return table;
+}
+
+/** \internal \returns the blocking size \a block of a dimension of size \a size, rounded down to a multiple of \a step if possible */
+template<typename Index>
+inline Index round_blocking_size(Index size, Index block, Index step)
+{
+  if(block>=size)
+    return size;
+  return block>step ? block - block%step : block;
+}
+
+template<typename LhsScalar, typename RhsScalar, typename Index>
+inline bool useTunedBlockingSizes(Index& k, Index& m, Index& n)
+{
+  const TunedBlockingSizesTable& table = tuned_blocking_sizes();
+  if(table.size()==0)
+    return false;
+  const TunedBlockingSizes* entry = table.find(blocking_scalar_code<LhsScalar>::value, blocking_scalar_code<RhsScalar>::value,
+                                               blocking_shape_class(k, m, n));
+  if(entry==0)
+    return false;
+  // like the heuristic, the blocks smaller than the product are multiples of the peeling and register blocking sizes of gebp
+  typedef gebp_traits<LhsScalar,RhsScalar> Traits;
+  k = round_blocking_size<Index>(k, entry->kc, 8);
+  m = round_blocking_size<Index>(m, entry->mc, Traits::mr);
+  n = round_blocking_size<Index>(n, entry->nc, Traits::nr);
+  return true;
+}
+
 /** \brief Computes the blocking parameters for a m x k times k x n matrix product
   *
   * \param[in,out] k Input: the third dimension of the product. Output: the blocking size along the same dimension.
@@ -289,14 +409,18 @@ inline bool useSpecificBlockingSizes(Index& k, Index& m, Index& n)
   *
   * The blocking size parameters may be evaluated:
   *   - either by a heuristic based on cache sizes;
+  *   - or using the values set for this class of sequential products by setProductBlockingSizes();
   *   - or using fixed prescribed values (for testing purposes).
   *
-  * \sa setCpuCacheSizes */
+  * \sa setCpuCacheSizes, setProductBlockingSizes */
 
 template<typename LhsScalar, typename RhsScalar, int KcFactor, typename Index>
 void computeProductBlockingSizes(Index& k, Index& m, Index& n, Index num_threads = 1)
 {
-  if (!useSpecificBlockingSizes(k, m, n)) {
+  if (useSpecificBlockingSizes(k, m, n))
+    return;
+  // the tuned sizes are measured on plain products, i.e., without the larger kc of the triangular kernels
+  if (!(KcFactor==1 && num_threads==1 && useTunedBlockingSizes<LhsScalar, RhsScalar>(k, m, n))) {
     evaluateProductBlockingSizesHeuristic<LhsScalar, RhsScalar, KcFactor, Index>(k, m, n, num_threads);
   }
 }
@@ -2144,6 +2268,32 @@ inline void setCpuCacheSizes(std::ptrdiff_t l1, std::ptrdiff_t l2, std::ptrdiff_
   internal::manage_caching_sizes(SetAction, &l1, &l2, &l3);
 }
 
+/** Sets the blocking sizes \a kc, \a mc and \a nc used by the sequential matrix products of scalar types \a LhsScalar
+  * and \a RhsScalar whose dimensions have the same binary logarithms (rounded down) as \a k, \a m and \a n.
+  * These values override the cache size based heuristic for this class of products, and are typically measured
+  * on the host by autotuneProductBlockingSizes() of the unsupported ProductBlockingTuner module.
+  *
+  * This function is not thread safe: it must not be called while matrix products are running.
+  *
+  * \returns false if the table of blocking sizes is full
+  *
+  * \sa clearProductBlockingSizes(), computeProductBlockingSizes */
+template<typename LhsScalar, typename RhsScalar>
+inline bool setProductBlockingSizes(Index k, Index m, Index n, Index kc, Index mc, Index nc)
+{
+  eigen_assert(kc>0 && mc>0 && nc>0);
+  internal::TunedBlockingSizes entry = { internal::blocking_scalar_code<LhsScalar>::value, internal::blocking_scalar_code<RhsScalar>::value,
+                                         internal::blocking_shape_class(k, m, n), kc, mc, nc };
+  return internal::tuned_blocking_sizes().insert(entry);
+}
+
+/** Restores the default blocking sizes of all matrix products.
+  * \sa setProductBlockingSizes() */
+inline void clearProductBlockingSizes()
+{
+  internal::tuned_blocking_sizes().clear();
+}
+
 } // end namespace Eigen
 
 #endif // EIGEN_GENERAL_BLOCK_PANEL_H
@@ -64,6 +64,12 @@ static void run(Index rows, Index cols, Index depth,
   level3_blocking<LhsScalar,RhsScalar>& blocking,
   GemmParallelInfo<Index>* info = 0)
 {
+#ifdef EIGEN_USE_RUNTIME_DISPATCH
+  // the threads of a parallel product share packed blocks, so only sequential products can be dispatched
+  if(info==0 && dispatch_gemm<Index,LhsScalar,LhsStorageOrder,ConjugateLhs,RhsScalar,RhsStorageOrder,ConjugateRhs>
+                  ::run(rows, cols, depth, _lhs, lhsStride, _rhs, rhsStride, _res, resStride, alpha, blocking))
+    return;
+#endif
   typedef const_blas_data_mapper<LhsScalar, Index, LhsStorageOrder> LhsMapper;
   typedef const_blas_data_mapper<RhsScalar, Index, RhsStorageOrder> RhsMapper;
   typedef blas_data_mapper<typename Traits::ResScalar, Index, ColMajor> ResMapper;
@@ -79,12 +85,13 @@ static void run(Index rows, Index cols, Index depth,
   gemm_pack_rhs<RhsScalar, Index, RhsMapper, Traits::nr, RhsStorageOrder> pack_rhs;
   gebp_kernel<LhsScalar, RhsScalar, Index, ResMapper, Traits::mr, Traits::nr, ConjugateLhs, ConjugateRhs> gebp;
 
-#ifdef EIGEN_HAS_OPENMP
+#if defined(EIGEN_HAS_OPENMP) || defined(EIGEN_HAS_PARALLEL_EXECUTOR)
   if(info)
   {
     // this is the parallel version!
-    int tid = omp_get_thread_num();
-    int threads = omp_get_num_threads();
+    int tid = int(info->logical_thread_id);
+    int threads = int(info->num_threads);
+    GemmParallelTaskInfo<Index>* task_info = info->task_info;
 
     LhsScalar* blockA = blocking.blockA();
     eigen_internal_assert(blockA!=0);
@@ -105,15 +112,15 @@ static void run(Index rows, Index cols, Index depth,
       // each thread packs the sub block A_k,i to A'_i where i is the thread id.
 
       // However, before copying to A'_i, we have to make sure that no other thread is still using it,
-      // i.e., we test that info[tid].users equals 0.
-      // Then, we set info[tid].users to the number of threads to mark that all other threads are going to use it.
-      while(info[tid].users!=0) {}
-      info[tid].users = threads;
+      // i.e., we test that task_info[tid].users equals 0.
+      // Then, we set task_info[tid].users to the number of threads to mark that all other threads are going to use it.
+      while(task_info[tid].users!=0) {}
+      task_info[tid].users = threads;
 
-      pack_lhs(blockA+info[tid].lhs_start*actual_kc, lhs.getSubMapper(info[tid].lhs_start,k), actual_kc, info[tid].lhs_length);
+      pack_lhs(blockA+task_info[tid].lhs_start*actual_kc, lhs.getSubMapper(task_info[tid].lhs_start,k), actual_kc, task_info[tid].lhs_length);
 
       // Notify the other threads that the part A'_i is ready to go.
-      info[tid].sync = k;
+      task_info[tid].sync = k;
 
       // Computes C_i += A' * B' per A'_i
       for(int shift=0; shift<threads; ++shift)
@@ -124,11 +131,11 @@ static void run(Index rows, Index cols, Index depth,
         // we use testAndSetOrdered to mimic a volatile access.
         // However, no need to wait for the B' part which has been updated by the current thread!
         if (shift>0) {
-          while(info[i].sync!=k) {
+          while(task_info[i].sync!=k) {
           }
         }
 
-        gebp(res.getSubMapper(info[i].lhs_start, 0), blockA+info[i].lhs_start*actual_kc, blockB, info[i].lhs_length, actual_kc, nc, alpha);
+        gebp(res.getSubMapper(task_info[i].lhs_start, 0), blockA+task_info[i].lhs_start*actual_kc, blockB, task_info[i].lhs_length, actual_kc, nc, alpha);
       }
 
       // Then keep going as usual with the remaining B'
@@ -149,11 +156,11 @@ static void run(Index rows, Index cols, Index depth,
 #if !EIGEN_HAS_CXX11_ATOMIC
         #pragma omp atomic
 #endif
-        info[i].users -= 1;
+        task_info[i].users -= 1;
     }
   }
   else
-#endif // EIGEN_HAS_OPENMP
+#endif // EIGEN_HAS_OPENMP || EIGEN_HAS_PARALLEL_EXECUTOR
   {
     EIGEN_UNUSED_VARIABLE(info);
 
@@ -0,0 +1,227 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_GENERAL_MATRIX_MATRIX_BFLOAT16_H
+#define EIGEN_GENERAL_MATRIX_MATRIX_BFLOAT16_H
+
+// The bfloat16 packets have as many coefficients as the float ones on x86, and neither type is vectorized
+// without SIMD support: in both cases, the packed blocks of bfloat16 and float operands have the same layout.
+#if defined(EIGEN_VECTORIZE_SSE) || !defined(EIGEN_VECTORIZE)
+#define EIGEN_BFLOAT16_PACKS_AS_FLOAT
+#endif
+
+namespace Eigen {
+
+namespace internal {
+
+template<bool Vectorized = packet_traits<bfloat16>::Vectorizable>
+struct bfloat16_block_to_float
+{
+  template<typename Index>
+  static void run(float* dst, const bfloat16* src, Index size)
+  {
+    for(Index i=0; i<size; ++i)
+      dst[i] = static_cast<float>(src[i]);
+  }
+};
+
+template<>
+struct bfloat16_block_to_float<true>
+{
+  template<typename Index>
+  static void run(float* dst, const bfloat16* src, Index size)
+  {
+    typedef packet_traits<bfloat16>::type Packet;
+    typedef packet_traits<float>::type FloatPacket;
+    enum { PacketSize = unpacket_traits<Packet>::size };
+    EIGEN_STATIC_ASSERT(int(PacketSize)==int(unpacket_traits<FloatPacket>::size), YOU_MADE_A_PROGRAMMING_MISTAKE)
+    Index i = 0;
+    for(; i+PacketSize<=size; i+=PacketSize)
+      pstoreu(dst+i, pcast<Packet,FloatPacket>(ploadu<Packet>(src+i)));
+    for(; i<size; ++i)
+      dst[i] = static_cast<float>(src[i]);
+  }
+};
+
+#ifdef EIGEN_BFLOAT16_PACKS_AS_FLOAT
+
+template<typename Index>
+struct bfloat16_packs_as_float
+{
+  typedef gebp_traits<bfloat16,bfloat16> Traits;
+  typedef gebp_traits<float,float> FloatTraits;
+  enum {
+    value = int(Traits::mr)==int(FloatTraits::mr) && int(Traits::nr)==int(FloatTraits::nr)
+         && int(Traits::LhsProgress)==int(FloatTraits::LhsProgress)
+  };
+};
+
+/* Specialization of the gebp kernel for bfloat16 operands, as used by the Tensor contractions
+ *    => the packed blocks are converted to float and multiplied by the float kernel, and the products are
+ *       accumulated in float and rounded into the bfloat16 result once per call, that is once per block of the depth.
+ *
+ * The block is processed per panels of at most panel_rows rows and nr columns, which are packed contiguously by
+ * gemm_pack_lhs and gemm_pack_rhs: the float copies of the panels and their accumulators thus remain small enough to
+ * live on the stack, and each lhs panel is converted once per call.
+ *
+ * In contrast, Tensor<half> contractions run the generic gebp kernel on half packets, rounding each multiply-add to half.
+ */
+template<typename Index, typename DataMapper, int mr, int nr, bool ConjugateLhs, bool ConjugateRhs>
+struct gebp_kernel<bfloat16,bfloat16,Index,DataMapper,mr,nr,ConjugateLhs,ConjugateRhs>
+{
+  typedef bfloat16 ResScalar;
+
+  EIGEN_DONT_INLINE
+  void operator()(const DataMapper& res, const bfloat16* blockA, const bfloat16* blockB,
+                  Index rows, Index depth, Index cols, bfloat16 alpha,
+                  Index strideA=-1, Index strideB=-1, Index offsetA=0, Index offsetB=0)
+  {
+    EIGEN_STATIC_ASSERT(bfloat16_packs_as_float<Index>::value, YOU_MADE_A_PROGRAMMING_MISTAKE)
+    typedef blas_data_mapper<float,Index,ColMajor> FloatMapper;
+
+    if(strideA==-1) strideA = depth;
+    if(strideB==-1) strideB = depth;
+
+    // the lhs panels are split at multiples of mr, which preserves the layout of the packed rows
+    const Index panel_rows = numext::mini(rows, numext::maxi(Index(1), Index(EIGEN_STACK_ALLOCATION_LIMIT/4) / (Index(sizeof(float)*mr)*strideA))*mr);
+    ei_declare_aligned_stack_constructed_variable(float, floatA, panel_rows*strideA, 0);
+    ei_declare_aligned_stack_constructed_variable(float, floatB, nr*strideB, 0);
+    ei_declare_aligned_stack_constructed_variable(float, acc, panel_rows*nr, 0);
+
+    gebp_kernel<float,float,Index,FloatMapper,mr,nr,false,false> gebp;
+    const float falpha = static_cast<float>(alpha);
+
+    for(Index i=0; i<rows; i+=panel_rows)
+    {
+      const Index actual_rows = numext::mini(i+panel_rows, rows)-i;
+      bfloat16_block_to_float<>::run(floatA, blockA+i*strideA, actual_rows*strideA);
+
+      for(Index j=0; j<cols; j+=nr)
+      {
+        const Index actual_cols = numext::mini(j+Index(nr), cols)-j;
+        bfloat16_block_to_float<>::run(floatB, blockB+j*strideB, actual_cols*strideB);
+
+        std::fill(acc, acc+actual_rows*actual_cols, 0.f);
+        gebp(FloatMapper(acc, actual_rows), floatA, floatB, actual_rows, depth, actual_cols, falpha,
+             strideA, strideB, offsetA, offsetB);
+
+        for(Index c=0; c<actual_cols; ++c)
+          for(Index r=0; r<actual_rows; ++r)
+            res(i+r,j+c) = bfloat16(static_cast<float>(res(i+r,j+c)) + acc[r+c*actual_rows]);
+      }
+    }
+  }
+};
+
+#endif // EIGEN_BFLOAT16_PACKS_AS_FLOAT
+
+/* Specialization for bfloat16 operands and a col-major destination matrix
+ *    => the operands are packed as bfloat16, thus reading half the memory of float operands, and the packed
+ *       blocks are converted to float and multiplied by the float kernel. The products are accumulated in float
+ *       and the result is rounded once.
+ *
+ * Where the packed layouts of the two types differ, the operands are converted to float beforehand as for half.
+ */
+template<
+  typename Index,
+  int LhsStorageOrder, bool ConjugateLhs,
+  int RhsStorageOrder, bool ConjugateRhs>
+struct general_matrix_matrix_product<Index,bfloat16,LhsStorageOrder,ConjugateLhs,bfloat16,RhsStorageOrder,ConjugateRhs,ColMajor>
+{
+  typedef gebp_traits<bfloat16,bfloat16> Traits;
+  typedef bfloat16 ResScalar;
+  static void run(Index rows, Index cols, Index depth,
+    const bfloat16* _lhs, Index lhsStride,
+    const bfloat16* _rhs, Index rhsStride,
+    bfloat16* _res, Index resStride,
+    bfloat16 alpha,
+    level3_blocking<bfloat16,bfloat16>& /*blocking*/,
+    GemmParallelInfo<Index>* /*info*/ = 0)
+  {
+    // in a parallel product, each thread computes a vertical panel of the result, i.e., a range of columns, on its own
+#ifdef EIGEN_BFLOAT16_PACKS_AS_FLOAT
+    typedef const_blas_data_mapper<bfloat16, Index, LhsStorageOrder> LhsMapper;
+    typedef const_blas_data_mapper<bfloat16, Index, RhsStorageOrder> RhsMapper;
+    typedef blas_data_mapper<float, Index, ColMajor> AccMapper;
+    EIGEN_STATIC_ASSERT(bfloat16_packs_as_float<Index>::value, YOU_MADE_A_PROGRAMMING_MISTAKE)
+
+    LhsMapper lhs(_lhs,lhsStride);
+    RhsMapper rhs(_rhs,rhsStride);
+
+    // the kernel works on float blocks, which must fit in the caches
+    Index kc = depth, mc = rows, nc = cols;
+    computeProductBlockingSizes<float,float>(kc, mc, nc);
+
+    gemm_pack_lhs<bfloat16, Index, LhsMapper, Traits::mr, Traits::LhsProgress, LhsStorageOrder> pack_lhs;
+    gemm_pack_rhs<bfloat16, Index, RhsMapper, Traits::nr, RhsStorageOrder> pack_rhs;
+    gebp_kernel<float, float, Index, AccMapper, Traits::mr, Traits::nr, false, false> gebp;
+
+    ei_declare_aligned_stack_constructed_variable(bfloat16, blockA, kc*mc, 0);
+    ei_declare_aligned_stack_constructed_variable(bfloat16, blockB, kc*nc, 0);
+    ei_declare_aligned_stack_constructed_variable(float, floatA, kc*mc, 0);
+    ei_declare_aligned_stack_constructed_variable(float, floatB, kc*nc, 0);
+    ei_declare_aligned_stack_constructed_variable(float, acc, mc*nc, 0);
+
+    const bool pack_rhs_once = mc!=rows && kc==depth && nc==cols;
+    const float falpha = static_cast<float>(alpha);
+    Map<Matrix<bfloat16,Dynamic,Dynamic>,0,OuterStride<> > dst(_res, rows, cols, OuterStride<>(resStride));
+
+    // For each mc x nc block of the result, accumulated in float...
+    for(Index i2=0; i2<rows; i2+=mc)
+    {
+      const Index actual_mc = (std::min)(i2+mc,rows)-i2;
+
+      for(Index j2=0; j2<cols; j2+=nc)
+      {
+        const Index actual_nc = (std::min)(j2+nc,cols)-j2;
+        Map<Matrix<float,Dynamic,Dynamic> > accBlock(acc, actual_mc, actual_nc);
+        accBlock.setZero();
+
+        for(Index k2=0; k2<depth; k2+=kc)
+        {
+          const Index actual_kc = (std::min)(k2+kc,depth)-k2;
+
+          pack_lhs(blockA, lhs.getSubMapper(i2,k2), actual_kc, actual_mc);
+          bfloat16_block_to_float<>::run(floatA, blockA, actual_kc*actual_mc);
+
+          if((!pack_rhs_once) || i2==0)
+          {
+            pack_rhs(blockB, rhs.getSubMapper(k2,j2), actual_kc, actual_nc);
+            bfloat16_block_to_float<>::run(floatB, blockB, actual_kc*actual_nc);
+          }
+
+          gebp(AccMapper(acc, actual_mc), floatA, floatB, actual_mc, actual_kc, actual_nc, falpha);
+        }
+
+        dst.block(i2, j2, actual_mc, actual_nc) = (dst.block(i2, j2, actual_mc, actual_nc).template cast<float>() + accBlock).template cast<bfloat16>();
+      }
+    }
+#else
+    typedef Matrix<float,Dynamic,Dynamic,LhsStorageOrder> LhsFloat;
+    typedef Matrix<float,Dynamic,Dynamic,RhsStorageOrder> RhsFloat;
+    typedef Matrix<float,Dynamic,Dynamic,ColMajor> ResFloat;
+
+    LhsFloat lhs = Map<const Matrix<bfloat16,Dynamic,Dynamic,LhsStorageOrder>,0,OuterStride<> >(_lhs, rows, depth, OuterStride<>(lhsStride)).template cast<float>();
+    RhsFloat rhs = Map<const Matrix<bfloat16,Dynamic,Dynamic,RhsStorageOrder>,0,OuterStride<> >(_rhs, depth, cols, OuterStride<>(rhsStride)).template cast<float>();
+    ResFloat res = ResFloat::Zero(rows, cols);
+
+    gemm_blocking_space<ColMajor,float,float,Dynamic,Dynamic,Dynamic> blocking(rows, cols, depth, 1, true);
+    general_matrix_matrix_product<Index,float,LhsStorageOrder,false,float,RhsStorageOrder,false,ColMajor>
+      ::run(rows, cols, depth, lhs.data(), lhs.outerStride(), rhs.data(), rhs.outerStride(),
+            res.data(), res.outerStride(), static_cast<float>(alpha), blocking);
+
+    Map<Matrix<bfloat16,Dynamic,Dynamic>,0,OuterStride<> > dst(_res, rows, cols, OuterStride<>(resStride));
+    dst = (dst.template cast<float>() + res).template cast<bfloat16>();
+#endif
+  }
+};
+
+} // end namespace internal
+
+} // end namespace Eigen
+
+#endif // EIGEN_GENERAL_MATRIX_MATRIX_BFLOAT16_H
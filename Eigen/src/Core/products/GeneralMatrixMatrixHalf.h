@@ -0,0 +1,60 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_GENERAL_MATRIX_MATRIX_HALF_H
+#define EIGEN_GENERAL_MATRIX_MATRIX_HALF_H
+
+namespace Eigen {
+
+namespace internal {
+
+/* Specialization for half precision operands and a col-major destination matrix
+ *    => the operands are converted to float, multiplied by the float kernel, and the result is rounded once.
+ *
+ * Besides the accuracy of the float accumulation, this avoids converting the operands of every multiply-add
+ * of the gebp kernel. The conversions cost O(rows*depth + depth*cols + rows*cols) operations only.
+ */
+template<
+  typename Index,
+  int LhsStorageOrder, bool ConjugateLhs,
+  int RhsStorageOrder, bool ConjugateRhs>
+struct general_matrix_matrix_product<Index,half,LhsStorageOrder,ConjugateLhs,half,RhsStorageOrder,ConjugateRhs,ColMajor>
+{
+  typedef gebp_traits<half,half> Traits;
+  typedef half ResScalar;
+  static void run(Index rows, Index cols, Index depth,
+    const half* _lhs, Index lhsStride,
+    const half* _rhs, Index rhsStride,
+    half* _res, Index resStride,
+    half alpha,
+    level3_blocking<half,half>& /*blocking*/,
+    GemmParallelInfo<Index>* /*info*/ = 0)
+  {
+    typedef Matrix<float,Dynamic,Dynamic,LhsStorageOrder> LhsFloat;
+    typedef Matrix<float,Dynamic,Dynamic,RhsStorageOrder> RhsFloat;
+    typedef Matrix<float,Dynamic,Dynamic,ColMajor> ResFloat;
+
+    // in a parallel product, each thread computes a vertical panel of the result, i.e., a range of columns, on its own
+    LhsFloat lhs = Map<const Matrix<half,Dynamic,Dynamic,LhsStorageOrder>,0,OuterStride<> >(_lhs, rows, depth, OuterStride<>(lhsStride)).template cast<float>();
+    RhsFloat rhs = Map<const Matrix<half,Dynamic,Dynamic,RhsStorageOrder>,0,OuterStride<> >(_rhs, depth, cols, OuterStride<>(rhsStride)).template cast<float>();
+    ResFloat res = ResFloat::Zero(rows, cols);
+
+    gemm_blocking_space<ColMajor,float,float,Dynamic,Dynamic,Dynamic> blocking(rows, cols, depth, 1, true);
+    general_matrix_matrix_product<Index,float,LhsStorageOrder,false,float,RhsStorageOrder,false,ColMajor>
+      ::run(rows, cols, depth, lhs.data(), lhs.outerStride(), rhs.data(), rhs.outerStride(),
+            res.data(), res.outerStride(), static_cast<float>(alpha), blocking);
+
+    Map<Matrix<half,Dynamic,Dynamic>,0,OuterStride<> > dst(_res, rows, cols, OuterStride<>(resStride));
+    dst = (dst.template cast<float>() + res).template cast<half>();
+  }
+};
+
+} // end namespace internal
+
+} // end namespace Eigen
+
+#endif // EIGEN_GENERAL_MATRIX_MATRIX_HALF_H
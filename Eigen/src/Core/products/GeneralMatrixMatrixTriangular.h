@@ -10,6 +10,10 @@
 #ifndef EIGEN_GENERAL_MATRIX_MATRIX_TRIANGULAR_H
 #define EIGEN_GENERAL_MATRIX_MATRIX_TRIANGULAR_H
 
+#if (defined(EIGEN_HAS_OPENMP) || defined(EIGEN_HAS_PARALLEL_EXECUTOR)) && !defined(EIGEN_USE_BLAS)
+#define EIGEN_HAS_PARALLEL_SYRK
+#endif
+
 namespace Eigen { 
 
 template<typename Scalar, typename Index, int StorageOrder, int UpLo, bool ConjLhs, bool ConjRhs>
@@ -124,6 +128,143 @@ struct general_matrix_matrix_triangular_product<Index,LhsScalar,LhsStorageOrder,
   }
 };
 
+/* Multi-threaded version of general_matrix_matrix_triangular_product:
+ * the columns of the (column major) destination are split into slices having the same number of
+ * coefficients in the triangular part. Each slice is made of a triangular diagonal block, processed by
+ * general_matrix_matrix_triangular_product, and of a rectangular block (below the diagonal block for a
+ * lower triangular destination, above it otherwise) processed by general_matrix_matrix_product.
+ * Each thread packs its own operands.
+ */
+template <typename Index,
+          typename LhsScalar, int LhsStorageOrder, bool ConjugateLhs,
+          typename RhsScalar, int RhsStorageOrder, bool ConjugateRhs,
+                              int ResStorageOrder, int  UpLo>
+struct parallel_general_matrix_matrix_triangular_product
+{
+  typedef typename ScalarBinaryOpTraits<LhsScalar, RhsScalar>::ReturnType ResScalar;
+
+  template<typename BlockingType>
+  static void run(Index size, Index depth, const LhsScalar* lhs, Index lhsStride,
+                  const RhsScalar* rhs, Index rhsStride, ResScalar* res, Index resStride,
+                  const ResScalar& alpha, BlockingType& blocking)
+  {
+    general_matrix_matrix_triangular_product<Index,LhsScalar,LhsStorageOrder,ConjugateLhs,RhsScalar,RhsStorageOrder,ConjugateRhs,ResStorageOrder,UpLo>
+      ::run(size, depth, lhs, lhsStride, rhs, rhsStride, res, resStride, alpha, blocking);
+  }
+};
+
+#ifdef EIGEN_HAS_PARALLEL_SYRK
+// as usual if the result is row major => we transpose the product
+template <typename Index, typename LhsScalar, int LhsStorageOrder, bool ConjugateLhs,
+                          typename RhsScalar, int RhsStorageOrder, bool ConjugateRhs, int  UpLo>
+struct parallel_general_matrix_matrix_triangular_product<Index,LhsScalar,LhsStorageOrder,ConjugateLhs,RhsScalar,RhsStorageOrder,ConjugateRhs,RowMajor,UpLo>
+{
+  typedef typename ScalarBinaryOpTraits<LhsScalar, RhsScalar>::ReturnType ResScalar;
+
+  template<typename BlockingType>
+  static void run(Index size, Index depth, const LhsScalar* lhs, Index lhsStride,
+                  const RhsScalar* rhs, Index rhsStride, ResScalar* res, Index resStride,
+                  const ResScalar& alpha, BlockingType& blocking)
+  {
+    parallel_general_matrix_matrix_triangular_product<Index,
+        RhsScalar, RhsStorageOrder==RowMajor ? ColMajor : RowMajor, ConjugateRhs,
+        LhsScalar, LhsStorageOrder==RowMajor ? ColMajor : RowMajor, ConjugateLhs,
+        ColMajor, UpLo==Lower?Upper:Lower>
+      ::run(size, depth, rhs, rhsStride, lhs, lhsStride, res, resStride, alpha, blocking);
+  }
+};
+
+template <typename Index, typename LhsScalar, int LhsStorageOrder, bool ConjugateLhs,
+                          typename RhsScalar, int RhsStorageOrder, bool ConjugateRhs, int  UpLo>
+struct parallel_general_matrix_matrix_triangular_product<Index,LhsScalar,LhsStorageOrder,ConjugateLhs,RhsScalar,RhsStorageOrder,ConjugateRhs,ColMajor,UpLo>
+{
+  typedef typename ScalarBinaryOpTraits<LhsScalar, RhsScalar>::ReturnType ResScalar;
+  typedef gebp_traits<LhsScalar,RhsScalar> Traits;
+  typedef gemm_blocking_space<ColMajor,LhsScalar,RhsScalar,Dynamic,Dynamic,Dynamic> BlockingType;
+  typedef general_matrix_matrix_triangular_product<Index,LhsScalar,LhsStorageOrder,ConjugateLhs,RhsScalar,RhsStorageOrder,ConjugateRhs,ColMajor,UpLo> Syrk;
+  typedef general_matrix_matrix_product<Index,LhsScalar,LhsStorageOrder,ConjugateLhs,RhsScalar,RhsStorageOrder,ConjugateRhs,ColMajor> Gemm;
+
+  // number of coefficients of the columns [0,j) of the triangular part
+  static double cols_work(Index j, Index size)
+  {
+    double dj = double(j);
+    return UpLo==Lower ? dj*double(size) - dj*(dj-1.)/2. : dj*(dj+1.)/2.;
+  }
+
+  // first column of the k-th out of n slices having the same amount of work
+  static Index slice_start(Index k, Index n, Index size)
+  {
+    if(k==n)
+      return size;
+    double work = cols_work(size, size) * double(k) / double(n);
+    Index lo = 0, hi = size;
+    while(lo<hi)
+    {
+      Index mid = lo + (hi-lo)/2;
+      if(cols_work(mid, size)<work) lo = mid+1;
+      else                          hi = mid;
+    }
+    return (lo/Traits::nr)*Traits::nr;
+  }
+
+  struct session
+  {
+    session(Index size, Index depth, const LhsScalar* lhs, Index lhsStride,
+            const RhsScalar* rhs, Index rhsStride, ResScalar* res, Index resStride, const ResScalar& alpha)
+      : m_size(size), m_depth(depth), m_lhs(lhs), m_lhsStride(lhsStride),
+        m_rhs(rhs), m_rhsStride(rhsStride), m_res(res), m_resStride(resStride), m_alpha(alpha)
+    {}
+
+    const LhsScalar* lhs(Index i) const { return LhsStorageOrder==ColMajor ? m_lhs + i : m_lhs + i*m_lhsStride; }
+    const RhsScalar* rhs(Index j) const { return RhsStorageOrder==ColMajor ? m_rhs + j*m_rhsStride : m_rhs + j; }
+    ResScalar* res(Index i, Index j) const { return m_res + i + j*m_resStride; }
+
+    void operator()(Index t, Index threads) const
+    {
+      Index j0 = slice_start(t,   threads, m_size);
+      Index j1 = slice_start(t+1, threads, m_size);
+      if(j1<=j0)
+        return;
+      Index width = j1-j0;
+
+      BlockingType syrkBlocking(width, width, m_depth, 1, false);
+      Syrk::run(width, m_depth, lhs(j0), m_lhsStride, rhs(j0), m_rhsStride, res(j0,j0), m_resStride, m_alpha, syrkBlocking);
+
+      Index i0 = UpLo==Lower ? j1 : 0;
+      Index rows = UpLo==Lower ? m_size-j1 : j0;
+      if(rows>0)
+      {
+        BlockingType gemmBlocking(rows, width, m_depth, 1, false);
+        Gemm::run(rows, width, m_depth, lhs(i0), m_lhsStride, rhs(j0), m_rhsStride,
+                  res(i0,j0), m_resStride, m_alpha, gemmBlocking);
+      }
+    }
+
+    Index m_size, m_depth;
+    const LhsScalar* m_lhs;
+    Index m_lhsStride;
+    const RhsScalar* m_rhs;
+    Index m_rhsStride;
+    ResScalar* m_res;
+    Index m_resStride;
+    ResScalar m_alpha;
+  };
+
+  template<typename ActualBlockingType>
+  static void run(Index size, Index depth, const LhsScalar* lhs, Index lhsStride,
+                  const RhsScalar* rhs, Index rhsStride, ResScalar* res, Index resStride,
+                  const ResScalar& alpha, ActualBlockingType& blocking)
+  {
+    // see parallelize_gemm
+    double work = static_cast<double>(size) * static_cast<double>(size) * static_cast<double>(depth) / 2.;
+    Index threads = (std::min)(parallel_threads_for_work(work, gemm_min_task_size), size/Traits::nr);
+    if(threads>1)
+      return run_parallel_session(session(size, depth, lhs, lhsStride, rhs, rhsStride, res, resStride, alpha), threads);
+    Syrk::run(size, depth, lhs, lhsStride, rhs, rhsStride, res, resStride, alpha, blocking);
+  }
+};
+#endif // EIGEN_HAS_PARALLEL_SYRK
+
 // Optimized packed Block * packed Block product kernel evaluating only one given triangular part
 // This kernel is built on top of the gebp kernel:
 // - the current destination block is processed per panel of actual_mc x BlockSize
@@ -283,7 +424,7 @@ struct general_product_to_triangular_selector<MatrixType,ProductType,UpLo,false>
 
     BlockingType blocking(size, size, depth, 1, false);
 
-    internal::general_matrix_matrix_triangular_product<Index,
+    internal::parallel_general_matrix_matrix_triangular_product<Index,
       typename Lhs::Scalar, LhsIsRowMajor ? RowMajor : ColMajor, LhsBlasTraits::NeedToConjugate,
       typename Rhs::Scalar, RhsIsRowMajor ? RowMajor : ColMajor, RhsBlasTraits::NeedToConjugate,
       IsRowMajor ? RowMajor : ColMajor, UpLo&(Lower|Upper)>
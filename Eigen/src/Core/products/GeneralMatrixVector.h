@@ -10,6 +10,10 @@
 #ifndef EIGEN_GENERAL_MATRIX_VECTOR_H
 #define EIGEN_GENERAL_MATRIX_VECTOR_H
 
+#if defined(EIGEN_PARALLELIZE_GEMV) && (defined(EIGEN_HAS_OPENMP) || defined(EIGEN_HAS_PARALLEL_EXECUTOR)) && !defined(EIGEN_USE_BLAS)
+#define EIGEN_HAS_PARALLEL_GEMV
+#endif
+
 namespace Eigen {
 
 namespace internal {
@@ -64,6 +68,10 @@ EIGEN_DEVICE_FUNC EIGEN_DONT_INLINE void general_matrix_vector_product<Index,Lhs
         ResScalar* res, Index resIncr,
   RhsScalar alpha)
 {
+#ifdef EIGEN_USE_RUNTIME_DISPATCH
+  if(dispatch_gemv<Index,LhsScalar,LhsMapper,ColMajor,ConjugateLhs,RhsScalar,RhsMapper,ConjugateRhs>::run(rows, cols, alhs, rhs, res, resIncr, alpha))
+    return;
+#endif
   EIGEN_UNUSED_VARIABLE(resIncr);
   eigen_internal_assert(resIncr==1);
 
@@ -247,6 +255,10 @@ EIGEN_DEVICE_FUNC EIGEN_DONT_INLINE void general_matrix_vector_product<Index,Lhs
   ResScalar* res, Index resIncr,
   ResScalar alpha)
 {
+#ifdef EIGEN_USE_RUNTIME_DISPATCH
+  if(dispatch_gemv<Index,LhsScalar,LhsMapper,RowMajor,ConjugateLhs,RhsScalar,RhsMapper,ConjugateRhs>::run(rows, cols, alhs, rhs, res, resIncr, alpha))
+    return;
+#endif
   // The following copy tells the compiler that lhs's attributes are not modified outside this function
   // This helps GCC to generate propoer code.
   LhsMapper lhs(alhs);
@@ -398,6 +410,106 @@ EIGEN_DEVICE_FUNC EIGEN_DONT_INLINE void general_matrix_vector_product<Index,Lhs
   }
 }
 
+/* Multi-threaded matrix * vector product:
+ * Large products are split across threads when EIGEN_PARALLELIZE_GEMV is defined,
+ * otherwise this simply forwards to general_matrix_vector_product.
+ *  - if there are enough rows, each thread computes a horizontal slice of the result,
+ *  - otherwise (short and wide matrices), each thread accumulates the product of a vertical panel
+ *    of the lhs into its own temporary, and these partial results are eventually summed up into res.
+ * Since matrix * vector products are memory bound, the number of threads is chosen such that each
+ * thread reads a large enough chunk of the lhs.
+ */
+template<typename Index, typename LhsScalar, typename LhsMapper, int LhsStorageOrder, bool ConjugateLhs, typename RhsScalar, typename RhsMapper, bool ConjugateRhs>
+struct parallel_general_matrix_vector_product
+{
+  typedef general_matrix_vector_product<Index,LhsScalar,LhsMapper,LhsStorageOrder,ConjugateLhs,RhsScalar,RhsMapper,ConjugateRhs> Gemv;
+  typedef typename Gemv::ResScalar ResScalar;
+
+#ifdef EIGEN_HAS_PARALLEL_GEMV
+  enum { MinBlockSize = 16 };
+
+  // each thread computes res.segment(r0,r1-r0) += alpha * lhs.middleRows(r0,r1-r0) * rhs
+  template<typename AlphaScalar>
+  struct row_session
+  {
+    row_session(Index rows, Index cols, const LhsMapper& lhs, const RhsMapper& rhs, ResScalar* res, Index resIncr, AlphaScalar alpha)
+      : m_rows(rows), m_cols(cols), m_lhs(lhs), m_rhs(rhs), m_res(res), m_resIncr(resIncr), m_alpha(alpha)
+    {}
+
+    void operator()(Index i, Index threads) const
+    {
+      Index blockRows = (m_rows / threads) & ~Index(MinBlockSize-1);
+      Index r0 = i*blockRows;
+      Index actualBlockRows = (i+1==threads) ? m_rows-r0 : blockRows;
+      Gemv::run(actualBlockRows, m_cols, m_lhs.getSubMapper(r0,0), m_rhs, m_res+r0*m_resIncr, m_resIncr, m_alpha);
+    }
+
+    Index m_rows, m_cols;
+    const LhsMapper& m_lhs;
+    const RhsMapper& m_rhs;
+    ResScalar* m_res;
+    Index m_resIncr;
+    AlphaScalar m_alpha;
+  };
+
+  // each thread accumulates alpha * lhs.middleCols(c0,c1-c0) * rhs.segment(c0,c1-c0) into its own buffer,
+  // the first thread directly accumulates into res
+  template<typename AlphaScalar>
+  struct col_session
+  {
+    col_session(Index rows, Index cols, const LhsMapper& lhs, const RhsMapper& rhs, ResScalar* res, Index resIncr, AlphaScalar alpha, ResScalar* buffers)
+      : m_rows(rows), m_cols(cols), m_lhs(lhs), m_rhs(rhs), m_res(res), m_resIncr(resIncr), m_alpha(alpha), m_buffers(buffers)
+    {}
+
+    void operator()(Index i, Index threads) const
+    {
+      Index blockCols = (m_cols / threads) & ~Index(MinBlockSize-1);
+      Index c0 = i*blockCols;
+      Index actualBlockCols = (i+1==threads) ? m_cols-c0 : blockCols;
+      if(i==0)
+        Gemv::run(m_rows, actualBlockCols, m_lhs, m_rhs, m_res, m_resIncr, m_alpha);
+      else
+        Gemv::run(m_rows, actualBlockCols, m_lhs.getSubMapper(0,c0), m_rhs.getSubMapper(c0,0), m_buffers+(i-1)*m_rows, 1, m_alpha);
+    }
+
+    Index m_rows, m_cols;
+    const LhsMapper& m_lhs;
+    const RhsMapper& m_rhs;
+    ResScalar* m_res;
+    Index m_resIncr;
+    AlphaScalar m_alpha;
+    ResScalar* m_buffers;
+  };
+#endif
+
+  template<typename AlphaScalar>
+  static void run(Index rows, Index cols, const LhsMapper& lhs, const RhsMapper& rhs, ResScalar* res, Index resIncr, AlphaScalar alpha)
+  {
+#ifdef EIGEN_HAS_PARALLEL_GEMV
+    Index threads = parallel_threads_for_work(double(rows)*double(cols), gemv_min_task_size);
+    if(rows>=threads*MinBlockSize)
+    {
+      if(threads>1)
+        return run_parallel_session(row_session<AlphaScalar>(rows, cols, lhs, rhs, res, resIncr, alpha), threads);
+    }
+    else
+    {
+      threads = (std::min)(threads, cols/MinBlockSize);
+      if(threads>1)
+      {
+        ei_declare_aligned_stack_constructed_variable(ResScalar, buffers, (threads-1)*rows, 0);
+        Map<Matrix<ResScalar,Dynamic,Dynamic> > partials(buffers, rows, threads-1);
+        partials.setZero();
+        run_parallel_session(col_session<AlphaScalar>(rows, cols, lhs, rhs, res, resIncr, alpha, buffers), threads);
+        Map<Matrix<ResScalar,Dynamic,1>, 0, InnerStride<> >(res, rows, InnerStride<>(resIncr)) += partials.rowwise().sum();
+        return;
+      }
+    }
+#endif
+    Gemv::run(rows, cols, lhs, rhs, res, resIncr, alpha);
+  }
+};
+
 } // end namespace internal
 
 } // end namespace Eigen
@@ -18,6 +18,80 @@ namespace Eigen {
 
 namespace internal {
 
+/** \internal
+  * Type-erased unit of work run by a ParallelExecutor: operator()(i) is called once for each logical thread i. */
+struct parallel_task
+{
+  virtual ~parallel_task() {}
+  virtual void operator()(Index i) const = 0;
+};
+
+}
+
+/** \class ParallelExecutor
+  * \ingroup Core_Module
+  *
+  * \brief Abstract interface to run Eigen's multi-threaded kernels on user-supplied threads
+  *
+  * By default, the multi-threaded code paths of Eigen (e.g., large matrix products) rely on OpenMP.
+  * When \c EIGEN_USE_PARALLEL_EXECUTOR is defined before including Eigen, these code paths can instead
+  * be dispatched onto an existing set of worker threads by implementing this interface and registering
+  * it with setParallelExecutor(). An implementation wrapping a ThreadPoolInterface is provided by
+  * the \c unsupported/Eigen/CXX11/ThreadPool module (see ThreadPoolExecutor).
+  *
+  * \sa setParallelExecutor(), parallelExecutor()
+  */
+class ParallelExecutor
+{
+  public:
+    virtual ~ParallelExecutor() {}
+
+    /** \returns the maximal number of logical threads that can run concurrently through run(). */
+    virtual int numThreads() const = 0;
+
+    /** \returns true if the calling thread is one of the worker threads of this executor, or is currently
+      * running a task of a session started by run(). Eigen does not start nested parallel sessions from such a thread. */
+    virtual bool inWorkerThread() const = 0;
+
+    /** Calls \a task(i) for each i in [0,n) and returns when all of them have completed.
+      * The \a n calls must be able to make progress concurrently since they might synchronize with each other,
+      * even when run() is called by several threads at once: an implementation must either admit a session only
+      * once \a n threads are available for it, or serialize the sessions. One of the calls may be made by the
+      * calling thread. \a n is never larger than numThreads(). */
+    virtual void run(Index n, const internal::parallel_task& task) = 0;
+};
+
+namespace internal {
+
+/** \internal */
+inline void manage_parallel_executor(Action action, ParallelExecutor** e)
+{
+  static ParallelExecutor* m_executor = 0;
+  eigen_internal_assert(e!=0);
+  if(action==SetAction)
+    m_executor = *e;
+  else if(action==GetAction)
+    *e = m_executor;
+  else
+    eigen_internal_assert(false);
+}
+
+/** \internal \returns the number of threads to use when setNbThreads() has not been called */
+inline int default_num_threads()
+{
+  #ifdef EIGEN_HAS_PARALLEL_EXECUTOR
+  ParallelExecutor* executor;
+  manage_parallel_executor(GetAction, &executor);
+  if(executor)
+    return executor->numThreads();
+  #endif
+  #ifdef EIGEN_HAS_OPENMP
+  return omp_get_max_threads();
+  #else
+  return 1;
+  #endif
+}
+
 /** \internal */
 inline void manage_multi_threading(Action action, int* v)
 {
@@ -31,11 +105,11 @@ inline void manage_multi_threading(Action action, int* v)
   else if(action==GetAction)
   {
     eigen_internal_assert(v!=0);
-    #ifdef EIGEN_HAS_OPENMP
+    #if defined(EIGEN_HAS_OPENMP) || defined(EIGEN_HAS_PARALLEL_EXECUTOR)
     if(m_maxThreads>0)
       *v = m_maxThreads;
     else
-      *v = omp_get_max_threads();
+      *v = default_num_threads();
     #else
     *v = 1;
     #endif
@@ -73,11 +147,33 @@ inline void setNbThreads(int v)
   internal::manage_multi_threading(SetAction, &v);
 }
 
+/** Registers \a executor to run the multi-threaded code paths of Eigen, or restores the default
+  * OpenMP based behavior if \a executor is null.
+  *
+  * This has an effect only if \c EIGEN_USE_PARALLEL_EXECUTOR is defined. The executor must outlive
+  * all the Eigen calls made while it is registered. Unless setNbThreads() is called, the number of
+  * threads used by Eigen is then given by ParallelExecutor::numThreads().
+  *
+  * \sa parallelExecutor(), ParallelExecutor, setNbThreads() */
+inline void setParallelExecutor(ParallelExecutor* executor)
+{
+  internal::manage_parallel_executor(SetAction, &executor);
+}
+
+/** \returns the executor registered by setParallelExecutor(), or null if none
+  * \sa setParallelExecutor() */
+inline ParallelExecutor* parallelExecutor()
+{
+  ParallelExecutor* executor;
+  internal::manage_parallel_executor(GetAction, &executor);
+  return executor;
+}
+
 namespace internal {
 
-template<typename Index> struct GemmParallelInfo
+template<typename Index> struct GemmParallelTaskInfo
 {
-  GemmParallelInfo() : sync(-1), users(0), lhs_start(0), lhs_length(0) {}
+  GemmParallelTaskInfo() : sync(-1), users(0), lhs_start(0), lhs_length(0) {}
 
   // volatile is not enough on all architectures (see bug 1572)
   // to guarantee that when thread A says to thread B that it is
@@ -95,6 +191,129 @@ template<typename Index> struct GemmParallelInfo
   Index lhs_length;
 };
 
+/** \internal
+  * Per-thread view of a parallel GEMM session: the logical id of the calling thread,
+  * the actual number of threads, and the shared synchronization slots (one per thread). */
+template<typename Index> struct GemmParallelInfo
+{
+  GemmParallelInfo(Index _logical_thread_id, Index _num_threads, GemmParallelTaskInfo<Index>* _task_info)
+    : logical_thread_id(_logical_thread_id), num_threads(_num_threads), task_info(_task_info)
+  {}
+
+  Index logical_thread_id;
+  Index num_threads;
+  GemmParallelTaskInfo<Index>* task_info;
+};
+
+#if defined(EIGEN_HAS_OPENMP) || defined(EIGEN_HAS_PARALLEL_EXECUTOR)
+
+/** \internal \returns true if the calling thread is already part of a parallel session */
+inline bool in_parallel_session()
+{
+  #ifdef EIGEN_HAS_PARALLEL_EXECUTOR
+  ParallelExecutor* executor = parallelExecutor();
+  if(executor)
+    return executor->inWorkerThread();
+  #endif
+  #ifdef EIGEN_HAS_OPENMP
+  // FIXME omp_get_num_threads()>1 only works for openmp, what if the user does not use openmp?
+  return omp_get_num_threads()>1;
+  #else
+  return false;
+  #endif
+}
+
+/** \internal
+  * Minimal number of elementary operations that is worth a thread, for each kind of kernel.
+  * Level 3 kernels (GEMM and the kernels built on gebp) pay for packing blocks in each thread,
+  * level 2 kernels (GEMV, TRMV) read their lhs only once and merely need to amortize the parallel session,
+  * and sparse kernels perform an indirect access per operation. */
+const double gemm_min_task_size = 50000;
+const double gemv_min_task_size = 32768;
+const double sparse_min_task_size = 20000;
+
+/** \internal \returns the number of threads to use for a kernel performing \a work elementary operations,
+  * such that each thread performs at least \a minTaskSize of them. Returns 1 if we already are in a parallel session. */
+inline Index parallel_threads_for_work(double work, double minTaskSize)
+{
+  Index threads = nbThreads();
+  if(threads<=1 || in_parallel_session())
+    return 1;
+  return (std::max<Index>)(1, (std::min<Index>)(threads, static_cast<Index>(work / minTaskSize)));
+}
+
+#ifdef EIGEN_HAS_PARALLEL_EXECUTOR
+template<typename Functor>
+struct parallel_task_adaptor : parallel_task
+{
+  parallel_task_adaptor(const Functor& func, Index threads) : m_func(func), m_threads(threads) {}
+  virtual void operator()(Index i) const { m_func(i, m_threads); }
+  const Functor& m_func;
+  Index m_threads;
+};
+#endif
+
+/** \internal
+  * Runs \a func(i,actual_threads) on up to \a threads concurrent threads, through the registered
+  * ParallelExecutor if any, and through OpenMP otherwise. Note that with OpenMP the actual number
+  * of threads might be lower than the requested one. All the calls can synchronize with each other. */
+template<typename Functor>
+void run_parallel_session(const Functor& func, Index threads)
+{
+  #ifdef EIGEN_HAS_PARALLEL_EXECUTOR
+  ParallelExecutor* executor = parallelExecutor();
+  if(executor)
+  {
+    threads = (std::min<Index>)(threads, executor->numThreads());
+    executor->run(threads, parallel_task_adaptor<Functor>(func, threads));
+    return;
+  }
+  #endif
+  #ifdef EIGEN_HAS_OPENMP
+  #pragma omp parallel num_threads(threads)
+  {
+    func(omp_get_thread_num(), omp_get_num_threads());
+  }
+  #else
+  func(0, 1);
+  #endif
+}
+
+template<typename Functor, typename Index>
+struct gemm_parallel_session
+{
+  gemm_parallel_session(const Functor& func, Index rows, Index cols, bool transpose, GemmParallelTaskInfo<Index>* task_info)
+    : m_func(func), m_rows(rows), m_cols(cols), m_transpose(transpose), m_task_info(task_info)
+  {}
+
+  void operator()(Index i, Index actual_threads) const
+  {
+    Index blockCols = (m_cols / actual_threads) & ~Index(0x3);
+    Index blockRows = (m_rows / actual_threads);
+    blockRows = (blockRows/Functor::Traits::mr)*Functor::Traits::mr;
+
+    Index r0 = i*blockRows;
+    Index actualBlockRows = (i+1==actual_threads) ? m_rows-r0 : blockRows;
+
+    Index c0 = i*blockCols;
+    Index actualBlockCols = (i+1==actual_threads) ? m_cols-c0 : blockCols;
+
+    m_task_info[i].lhs_start = r0;
+    m_task_info[i].lhs_length = actualBlockRows;
+
+    GemmParallelInfo<Index> info(i, actual_threads, m_task_info);
+    if(m_transpose) m_func(c0, actualBlockCols, 0, m_rows, &info);
+    else            m_func(0, m_rows, c0, actualBlockCols, &info);
+  }
+
+  const Functor& m_func;
+  Index m_rows, m_cols;
+  bool m_transpose;
+  GemmParallelTaskInfo<Index>* m_task_info;
+};
+
+#endif
+
 template<bool Condition, typename Functor, typename Index>
 void parallelize_gemm(const Functor& func, Index rows, Index cols, Index depth, bool transpose)
 {
@@ -103,7 +322,7 @@ void parallelize_gemm(const Functor& func, Index rows, Index cols, Index depth,
   // Without C++11, we have to disable GEMM's parallelization on
   // non x86 architectures because there volatile is not enough for our purpose.
   // See bug 1572.
-#if (! defined(EIGEN_HAS_OPENMP)) || defined(EIGEN_USE_BLAS) || ((!EIGEN_HAS_CXX11_ATOMIC) && !(EIGEN_ARCH_i386_OR_x86_64))
+#if (! (defined(EIGEN_HAS_OPENMP) || defined(EIGEN_HAS_PARALLEL_EXECUTOR))) || defined(EIGEN_USE_BLAS) || ((!EIGEN_HAS_CXX11_ATOMIC) && !(EIGEN_ARCH_i386_OR_x86_64))
   // FIXME the transpose variable is only needed to properly split
   // the matrix product when multithreading is enabled. This is a temporary
   // fix to support row-major destination matrices. This whole
@@ -113,7 +332,7 @@ void parallelize_gemm(const Functor& func, Index rows, Index cols, Index depth,
   func(0,rows, 0,cols);
 #else
 
-  // Dynamically check whether we should enable or disable OpenMP.
+  // Dynamically check whether we should enable or disable multi-threading.
   // The conditions are:
   // - the max number of threads we can create is greater than 1
   // - we are not already in a parallel code
@@ -127,16 +346,14 @@ void parallelize_gemm(const Functor& func, Index rows, Index cols, Index depth,
   // compute the maximal number of threads from the total amount of work:
   double work = static_cast<double>(rows) * static_cast<double>(cols) *
       static_cast<double>(depth);
-  double kMinTaskSize = 50000;  // FIXME improve this heuristic.
-  pb_max_threads = std::max<Index>(1, std::min<Index>(pb_max_threads, work / kMinTaskSize));
+  pb_max_threads = std::max<Index>(1, std::min<Index>(pb_max_threads, work / gemm_min_task_size));
 
   // compute the number of threads we are going to use
   Index threads = std::min<Index>(nbThreads(), pb_max_threads);
 
   // if multi-threading is explicitly disabled, not useful, or if we already are in a parallel session,
   // then abort multi-threading
-  // FIXME omp_get_num_threads()>1 only works for openmp, what if the user does not use openmp?
-  if((!Condition) || (threads==1) || (omp_get_num_threads()>1))
+  if((!Condition) || (threads==1) || in_parallel_session())
     return func(0,rows, 0,cols);
 
   Eigen::initParallel();
@@ -145,30 +362,9 @@ void parallelize_gemm(const Functor& func, Index rows, Index cols, Index depth,
   if(transpose)
     std::swap(rows,cols);
 
-  ei_declare_aligned_stack_constructed_variable(GemmParallelInfo<Index>,info,threads,0);
-
-  #pragma omp parallel num_threads(threads)
-  {
-    Index i = omp_get_thread_num();
-    // Note that the actual number of threads might be lower than the number of request ones.
-    Index actual_threads = omp_get_num_threads();
-
-    Index blockCols = (cols / actual_threads) & ~Index(0x3);
-    Index blockRows = (rows / actual_threads);
-    blockRows = (blockRows/Functor::Traits::mr)*Functor::Traits::mr;
-
-    Index r0 = i*blockRows;
-    Index actualBlockRows = (i+1==actual_threads) ? rows-r0 : blockRows;
-
-    Index c0 = i*blockCols;
-    Index actualBlockCols = (i+1==actual_threads) ? cols-c0 : blockCols;
+  ei_declare_aligned_stack_constructed_variable(GemmParallelTaskInfo<Index>,task_info,threads,0);
 
-    info[i].lhs_start = r0;
-    info[i].lhs_length = actualBlockRows;
-
-    if(transpose) func(c0, actualBlockCols, 0, rows, info);
-    else          func(0, rows, c0, actualBlockCols, info);
-  }
+  run_parallel_session(gemm_parallel_session<Functor,Index>(func, rows, cols, transpose, task_info), threads);
 #endif
 }
 
@@ -0,0 +1,350 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_PREPACKED_PRODUCT_H
+#define EIGEN_PREPACKED_PRODUCT_H
+
+namespace Eigen {
+
+template<typename MatrixType> class PrepackedLhs;
+template<typename MatrixType, typename Rhs> class PrepackedProduct;
+
+namespace internal {
+
+/* Layout of a left hand side packed once for all:
+ * the rows are split into blocks of mc rows, and the depth into blocks of kc columns. The mc x kc blocks are
+ * packed by gemm_pack_lhs exactly as in general_matrix_matrix_product, and stored one after the other,
+ * row block by row block. Each block starts on an aligned address since gebp_kernel loads them with pload.
+ */
+template<typename Scalar>
+struct prepacked_lhs_layout
+{
+  enum { Align = EIGEN_MAX_ALIGN_BYTES>int(sizeof(Scalar)) ? EIGEN_MAX_ALIGN_BYTES/int(sizeof(Scalar)) : 1 };
+
+  prepacked_lhs_layout() : rows(0), depth(0), kc(0), mc(0), rowBlockSize(0) {}
+
+  prepacked_lhs_layout(Index _rows, Index _depth, Index _kc, Index _mc)
+    : rows(_rows), depth(_depth), kc(_kc), mc(_mc), rowBlockSize(0)
+  {
+    for(Index k2=0; k2<depth; k2+=kc)
+      rowBlockSize += padded(mc*((std::min)(k2+kc,depth)-k2));
+  }
+
+  static Index padded(Index size) { return ((size+Align-1)/Align)*Align; }
+
+  // offset of the block starting at row i2 and column k2
+  Index offset(Index i2, Index k2) const
+  {
+    const Index actual_mc = (std::min)(i2+mc,rows)-i2;
+    return (i2/mc)*rowBlockSize + (k2/kc)*padded(actual_mc*kc);
+  }
+
+  Index size() const { return rows==0 ? 0 : ((rows-1)/mc+1)*rowBlockSize; }
+
+  Index rows, depth, kc, mc;
+  Index rowBlockSize;
+};
+
+/* Computes res += alpha * lhs * rhs where lhs has been packed according to layout.
+ * Since the lhs is already packed, the rhs blocks are packed once and the loops are reordered accordingly. */
+template<typename Index, typename LhsScalar, bool ConjugateLhs, typename RhsScalar, int RhsStorageOrder, bool ConjugateRhs>
+struct general_matrix_matrix_product_prepacked
+{
+  typedef gebp_traits<LhsScalar,RhsScalar> Traits;
+  typedef typename ScalarBinaryOpTraits<LhsScalar, RhsScalar>::ReturnType ResScalar;
+
+  static void run(Index cols, const LhsScalar* packedLhs, const prepacked_lhs_layout<LhsScalar>& layout,
+                  const RhsScalar* _rhs, Index rhsStride, ResScalar* _res, Index resStride, ResScalar alpha)
+  {
+    typedef const_blas_data_mapper<RhsScalar, Index, RhsStorageOrder> RhsMapper;
+    typedef blas_data_mapper<typename Traits::ResScalar, Index, ColMajor> ResMapper;
+    RhsMapper rhs(_rhs,rhsStride);
+    ResMapper res(_res, resStride);
+
+    const Index rows = layout.rows, depth = layout.depth;
+    const Index kc = layout.kc, mc = layout.mc;
+    Index k = depth, m = rows, nc = cols;
+    computeProductBlockingSizes<LhsScalar,RhsScalar>(k, m, nc);
+    nc = (std::max)(nc, Index(1));
+
+    gemm_pack_rhs<RhsScalar, Index, RhsMapper, Traits::nr, RhsStorageOrder> pack_rhs;
+    gebp_kernel<LhsScalar, RhsScalar, Index, ResMapper, Traits::mr, Traits::nr, ConjugateLhs, ConjugateRhs> gebp;
+
+    std::size_t sizeB = kc*nc;
+    ei_declare_aligned_stack_constructed_variable(RhsScalar, blockB, sizeB, 0);
+
+    for(Index k2=0; k2<depth; k2+=kc)
+    {
+      const Index actual_kc = (std::min)(k2+kc,depth)-k2;
+      for(Index j2=0; j2<cols; j2+=nc)
+      {
+        const Index actual_nc = (std::min)(j2+nc,cols)-j2;
+        pack_rhs(blockB, rhs.getSubMapper(k2,j2), actual_kc, actual_nc);
+        for(Index i2=0; i2<rows; i2+=mc)
+        {
+          const Index actual_mc = (std::min)(i2+mc,rows)-i2;
+          gebp(res.getSubMapper(i2, j2), packedLhs + layout.offset(i2,k2), blockB, actual_mc, actual_kc, actual_nc, alpha);
+        }
+      }
+    }
+  }
+
+#if defined(EIGEN_HAS_OPENMP) || defined(EIGEN_HAS_PARALLEL_EXECUTOR)
+  // each thread processes a slice of the columns of the rhs, in multiples of nr
+  struct session
+  {
+    session(Index cols, const LhsScalar* packedLhs, const prepacked_lhs_layout<LhsScalar>& layout,
+            const RhsScalar* rhs, Index rhsStride, ResScalar* res, Index resStride, ResScalar alpha)
+      : m_cols(cols), m_packedLhs(packedLhs), m_layout(layout), m_rhs(rhs), m_rhsStride(rhsStride),
+        m_res(res), m_resStride(resStride), m_alpha(alpha)
+    {}
+
+    void operator()(Index i, Index threads) const
+    {
+      Index blockCols = (m_cols / threads / Traits::nr) * Traits::nr;
+      Index c0 = i*blockCols;
+      Index actualBlockCols = (i+1==threads) ? m_cols-c0 : blockCols;
+      run(actualBlockCols, m_packedLhs, m_layout,
+          m_rhs + (RhsStorageOrder==RowMajor ? c0 : c0*m_rhsStride), m_rhsStride, m_res + c0*m_resStride, m_resStride, m_alpha);
+    }
+
+    Index m_cols;
+    const LhsScalar* m_packedLhs;
+    const prepacked_lhs_layout<LhsScalar>& m_layout;
+    const RhsScalar* m_rhs;
+    Index m_rhsStride;
+    ResScalar* m_res;
+    Index m_resStride;
+    ResScalar m_alpha;
+  };
+#endif
+
+  static void run_parallel(Index cols, const LhsScalar* packedLhs, const prepacked_lhs_layout<LhsScalar>& layout,
+                           const RhsScalar* rhs, Index rhsStride, ResScalar* res, Index resStride, ResScalar alpha)
+  {
+#if defined(EIGEN_HAS_OPENMP) || defined(EIGEN_HAS_PARALLEL_EXECUTOR)
+    // same heuristic as the parallel triangular solver
+    double work = static_cast<double>(layout.rows) * static_cast<double>(layout.depth) * static_cast<double>(cols);
+    Index threads = (std::min)(parallel_threads_for_work(work, gemm_min_task_size), cols/Traits::nr);
+    if(threads>1)
+      return run_parallel_session(session(cols, packedLhs, layout, rhs, rhsStride, res, resStride, alpha), threads);
+#endif
+    run(cols, packedLhs, layout, rhs, rhsStride, res, resStride, alpha);
+  }
+};
+
+/** \internal \returns a pointer past the last coefficient of the directly accessible expression \a m */
+template<typename Derived>
+const typename Derived::Scalar* direct_access_end(const Derived& m)
+{
+  if(m.size()==0)
+    return m.data();
+  return m.data() + (m.outerSize()-1)*m.outerStride() + (m.innerSize()-1)*m.innerStride() + 1;
+}
+
+/** \internal \returns whether the product by \a rhs must be evaluated into a temporary before being
+  * assigned to \a dst: the destination is cleared before the rhs is read. */
+template<typename Rhs, bool HasUsableDirectAccess = blas_traits<Rhs>::HasUsableDirectAccess>
+struct prepacked_product_may_alias
+{
+  // the rhs is evaluated after dst is cleared
+  template<typename Dest>
+  static bool run(const Rhs&, const Dest&) { return true; }
+};
+
+template<typename Rhs>
+struct prepacked_product_may_alias<Rhs,true>
+{
+  template<typename Dest>
+  static bool run(const Rhs& a_rhs, const Dest& dst)
+  {
+    typename blas_traits<Rhs>::ExtractType rhs = blas_traits<Rhs>::extract(a_rhs);
+    return rhs.data() < direct_access_end(dst) && dst.data() < direct_access_end(rhs);
+  }
+};
+
+template<typename MatrixType, typename Rhs>
+struct traits<PrepackedProduct<MatrixType,Rhs> >
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef Matrix<Scalar, MatrixType::RowsAtCompileTime, Rhs::ColsAtCompileTime, ColMajor,
+                 MatrixType::MaxRowsAtCompileTime, Rhs::MaxColsAtCompileTime> ReturnType;
+};
+
+} // end namespace internal
+
+/** \class PrepackedLhs
+  * \ingroup Core_Module
+  *
+  * \brief A matrix stored in the packed format of the left hand side of the matrix products
+  *
+  * \tparam _MatrixType the type of the matrix, e.g., MatrixXf
+  *
+  * A general matrix product first copies blocks of its operands into a layout suited to its kernel, and for
+  * medium sized products this packing step takes a significant part of the time. When the same matrix is
+  * multiplied by many right hand sides, e.g., the weights of a layer of a neural network, this class permits
+  * to pack it once for all:
+  * \code
+  * PrepackedLhs<MatrixXf> packedW(W);
+  * for(...)
+  *   Y = packedW * X;   // same as Y = W * X
+  * \endcode
+  *
+  * The packed format depends on the blocking sizes (see computeProductBlockingSizes) selected at construction time,
+  * and on the instruction set the code is compiled for: a PrepackedLhs object must not be shared between translation
+  * units compiled with different SIMD options.
+  *
+  * \sa scaleAndAddTo()
+  */
+template<typename _MatrixType>
+class PrepackedLhs
+{
+  public:
+    typedef _MatrixType MatrixType;
+    typedef typename MatrixType::Scalar Scalar;
+    typedef typename NumTraits<Scalar>::Real RealScalar;
+    typedef Matrix<Scalar,Dynamic,1> PackedStorage;
+
+    /** Default constructor, call compute() to pack a matrix */
+    PrepackedLhs() {}
+
+    /** Packs \a matrix, with blocking sizes suited to products with \a cols columns (by default, as many as \a matrix has rows). */
+    template<typename InputType>
+    explicit PrepackedLhs(const EigenBase<InputType>& matrix, Index cols = -1)
+    {
+      compute(matrix, cols);
+    }
+
+    /** Packs \a matrix, with blocking sizes suited to products with \a cols columns (by default, as many as \a matrix has rows). */
+    template<typename InputType>
+    PrepackedLhs& compute(const EigenBase<InputType>& matrix, Index cols = -1)
+    {
+      typedef internal::gebp_traits<Scalar,Scalar> Traits;
+      enum { LhsStorageOrder = MatrixType::IsRowMajor ? RowMajor : ColMajor };
+      typedef Ref<const Matrix<Scalar,Dynamic,Dynamic,LhsStorageOrder>, 0, OuterStride<> > LhsRef;
+      typedef internal::const_blas_data_mapper<Scalar, Index, LhsStorageOrder> LhsMapper;
+
+      LhsRef lhsRef(matrix.derived());
+      const Index rows = lhsRef.rows(), depth = lhsRef.cols();
+      Index kc = depth, mc = rows, nc = cols<0 ? rows : cols;
+      internal::computeProductBlockingSizes<Scalar,Scalar>(kc, mc, nc);
+      kc = (std::max)(kc, Index(1));
+      mc = (std::max)(mc, Index(1));
+      m_layout = internal::prepacked_lhs_layout<Scalar>(rows, depth, kc, mc);
+      m_packed.resize(m_layout.size());
+
+      LhsMapper lhs(lhsRef.data(), lhsRef.outerStride());
+      internal::gemm_pack_lhs<Scalar, Index, LhsMapper, Traits::mr, Traits::LhsProgress, LhsStorageOrder> pack_lhs;
+      for(Index i2=0; i2<rows; i2+=mc)
+      {
+        const Index actual_mc = (std::min)(i2+mc,rows)-i2;
+        for(Index k2=0; k2<depth; k2+=kc)
+        {
+          const Index actual_kc = (std::min)(k2+kc,depth)-k2;
+          pack_lhs(m_packed.data() + m_layout.offset(i2,k2), lhs.getSubMapper(i2,k2), actual_kc, actual_mc);
+        }
+      }
+      return *this;
+    }
+
+    /** \returns the number of rows of the packed matrix */
+    Index rows() const { return m_layout.rows; }
+    /** \returns the number of columns of the packed matrix */
+    Index cols() const { return m_layout.depth; }
+
+    /** \returns an expression of the product of the packed matrix by \a rhs, to be assigned to a matrix */
+    template<typename Rhs>
+    const PrepackedProduct<MatrixType,Rhs> operator*(const MatrixBase<Rhs>& rhs) const
+    {
+      return PrepackedProduct<MatrixType,Rhs>(*this, rhs.derived());
+    }
+
+    /** Performs \a dst += \a alpha * \c M * \a rhs where \c M is the packed matrix.
+      * The destination must not alias \a rhs. */
+    template<typename Dest, typename Rhs>
+    void scaleAndAddTo(Dest& dst, const MatrixBase<Rhs>& a_rhs, const Scalar& alpha) const
+    {
+      typedef internal::blas_traits<Rhs> RhsBlasTraits;
+      typedef typename RhsBlasTraits::DirectLinearAccessType ActualRhsType;
+      typedef typename internal::remove_all<ActualRhsType>::type ActualRhsTypeCleaned;
+
+      eigen_assert(dst.rows()==rows() && dst.cols()==a_rhs.cols() && a_rhs.rows()==cols());
+      if(rows()==0 || cols()==0 || a_rhs.cols()==0)
+        return;
+
+      typename internal::add_const_on_value_type<ActualRhsType>::type rhs = RhsBlasTraits::extract(a_rhs.derived());
+      Scalar actualAlpha = alpha * RhsBlasTraits::extractScalarFactor(a_rhs.derived());
+
+      typedef internal::general_matrix_matrix_product_prepacked<Index, Scalar, false,
+        Scalar, (ActualRhsTypeCleaned::Flags&RowMajorBit) ? RowMajor : ColMajor, bool(RhsBlasTraits::NeedToConjugate)> Gemm;
+
+      if((Dest::Flags&RowMajorBit) || dst.innerStride()!=1)
+      {
+        // the kernel writes a column major result with unit inner stride
+        Matrix<Scalar,Dynamic,Dynamic> res = Matrix<Scalar,Dynamic,Dynamic>::Zero(dst.rows(), dst.cols());
+        Gemm::run_parallel(res.cols(), m_packed.data(), m_layout, &rhs.coeffRef(0,0), rhs.outerStride(),
+                           res.data(), res.outerStride(), actualAlpha);
+        dst += res;
+      }
+      else
+      {
+        Gemm::run_parallel(dst.cols(), m_packed.data(), m_layout, &rhs.coeffRef(0,0), rhs.outerStride(),
+                           &dst.coeffRef(0,0), dst.outerStride(), actualAlpha);
+      }
+    }
+
+  protected:
+    internal::prepacked_lhs_layout<Scalar> m_layout;
+    PackedStorage m_packed;
+};
+
+/** \class PrepackedProduct
+  * \ingroup Core_Module
+  *
+  * \brief Expression of the product of a PrepackedLhs by a matrix
+  *
+  * This class is the return type of PrepackedLhs::operator*(), and most of the time this is the only way it is used.
+  * Like a regular product, it is evaluated into a temporary when the destination might alias the right hand side.
+  */
+template<typename MatrixType, typename Rhs>
+class PrepackedProduct : public ReturnByValue<PrepackedProduct<MatrixType,Rhs> >
+{
+  public:
+    typedef typename MatrixType::Scalar Scalar;
+
+    PrepackedProduct(const PrepackedLhs<MatrixType>& lhs, const Rhs& rhs) : m_lhs(lhs), m_rhs(rhs)
+    {
+      eigen_assert(lhs.cols()==rhs.rows());
+    }
+
+    Index rows() const { return m_lhs.rows(); }
+    Index cols() const { return m_rhs.cols(); }
+
+    template<typename Dest>
+    void evalTo(Dest& dst) const
+    {
+      if(internal::prepacked_product_may_alias<Rhs>::run(m_rhs, dst))
+      {
+        typename internal::traits<PrepackedProduct>::ReturnType tmp(rows(), cols());
+        tmp.setZero();
+        m_lhs.scaleAndAddTo(tmp, m_rhs, Scalar(1));
+        dst = tmp;
+        return;
+      }
+      dst.resize(rows(), cols());
+      dst.setZero();
+      m_lhs.scaleAndAddTo(dst, m_rhs, Scalar(1));
+    }
+
+  protected:
+    const PrepackedLhs<MatrixType>& m_lhs;
+    typename Rhs::Nested m_rhs;
+};
+
+} // end namespace Eigen
+
+#endif // EIGEN_PREPACKED_PRODUCT_H
@@ -159,6 +159,122 @@ EIGEN_DONT_INLINE void triangular_matrix_vector_product<Index,Mode,LhsScalar,Con
     }
   }
 
+/* Multi-threaded triangular matrix * vector product:
+ * When EIGEN_PARALLELIZE_GEMV is defined, large products are split into horizontal slices
+ * having the same number of non-zeros of the triangular matrix, otherwise this simply forwards
+ * to triangular_matrix_vector_product. For a lower triangular matrix, each slice is made of a
+ * dense rectangular part (handled by a gemv) followed by a triangular (or trapezoidal) block,
+ * whereas for an upper triangular matrix each slice is a trapezoidal block.
+ */
+template<typename Index, int Mode, typename LhsScalar, bool ConjLhs, typename RhsScalar, bool ConjRhs, int StorageOrder>
+struct parallel_triangular_matrix_vector_product
+{
+  typedef triangular_matrix_vector_product<Index,Mode,LhsScalar,ConjLhs,RhsScalar,ConjRhs,StorageOrder> Trmv;
+  typedef typename Trmv::ResScalar ResScalar;
+
+#ifdef EIGEN_HAS_PARALLEL_GEMV
+  enum {
+    IsLower = ((Mode&Lower)==Lower),
+    MinBlockSize = 16
+  };
+  typedef const_blas_data_mapper<LhsScalar,Index,StorageOrder> LhsMapper;
+  typedef const_blas_data_mapper<RhsScalar,Index,RowMajor> RhsMapper;
+  typedef general_matrix_vector_product<Index,LhsScalar,LhsMapper,StorageOrder,ConjLhs,RhsScalar,RhsMapper,ConjRhs> Gemv;
+
+  // number of coefficients of the rows [0,r) of the triangular part of a rows x cols matrix
+  static double rows_work(Index r, Index rows, Index cols)
+  {
+    double size = double((std::min)(rows,cols));
+    double dr = double(r);
+    if(!IsLower)
+      return dr*double(cols) - dr*(dr-1.)/2.;
+    else if(dr<=size)
+      return dr*(dr+1.)/2.;
+    else
+      return size*(size+1.)/2. + (dr-size)*size;
+  }
+
+  // first row of the k-th out of n slices having the same amount of work
+  static Index slice_start(Index k, Index n, Index rows, Index cols)
+  {
+    Index actualRows = IsLower ? rows : (std::min)(rows,cols);
+    if(k==n)
+      return actualRows;
+    double work = rows_work(actualRows, rows, cols) * double(k) / double(n);
+    Index lo = 0, hi = actualRows;
+    while(lo<hi)
+    {
+      Index mid = lo + (hi-lo)/2;
+      if(rows_work(mid, rows, cols)<work) lo = mid+1;
+      else                                hi = mid;
+    }
+    return (lo/MinBlockSize)*MinBlockSize;
+  }
+
+  template<typename AlphaScalar>
+  struct session
+  {
+    session(Index rows, Index cols, const LhsScalar* lhs, Index lhsStride,
+            const RhsScalar* rhs, Index rhsIncr, ResScalar* res, Index resIncr, const AlphaScalar& alpha)
+      : m_rows(rows), m_cols(cols), m_lhs(lhs), m_lhsStride(lhsStride),
+        m_rhs(rhs), m_rhsIncr(rhsIncr), m_res(res), m_resIncr(resIncr), m_alpha(alpha)
+    {}
+
+    const LhsScalar* lhs(Index i, Index j) const
+    {
+      return StorageOrder==ColMajor ? m_lhs + i + j*m_lhsStride : m_lhs + i*m_lhsStride + j;
+    }
+
+    void operator()(Index i, Index threads) const
+    {
+      Index r0 = slice_start(i,   threads, m_rows, m_cols);
+      Index r1 = slice_start(i+1, threads, m_rows, m_cols);
+      if(r1<=r0)
+        return;
+      if(IsLower)
+      {
+        Index size = (std::min)(m_rows,m_cols);
+        Index denseCols = (std::min)(r0,size);
+        if(denseCols>0)
+          Gemv::run(r1-r0, denseCols, LhsMapper(lhs(r0,0), m_lhsStride), RhsMapper(m_rhs, m_rhsIncr),
+                    m_res+r0*m_resIncr, m_resIncr, m_alpha);
+        if(r0<size)
+          Trmv::run(r1-r0, (std::min)(r1,size)-r0, lhs(r0,r0), m_lhsStride,
+                    m_rhs+r0*m_rhsIncr, m_rhsIncr, m_res+r0*m_resIncr, m_resIncr, m_alpha);
+      }
+      else
+      {
+        Trmv::run(r1-r0, m_cols-r0, lhs(r0,r0), m_lhsStride,
+                  m_rhs+r0*m_rhsIncr, m_rhsIncr, m_res+r0*m_resIncr, m_resIncr, m_alpha);
+      }
+    }
+
+    Index m_rows, m_cols;
+    const LhsScalar* m_lhs;
+    Index m_lhsStride;
+    const RhsScalar* m_rhs;
+    Index m_rhsIncr;
+    ResScalar* m_res;
+    Index m_resIncr;
+    AlphaScalar m_alpha;
+  };
+#endif
+
+  template<typename AlphaScalar>
+  static void run(Index rows, Index cols, const LhsScalar* lhs, Index lhsStride,
+                  const RhsScalar* rhs, Index rhsIncr, ResScalar* res, Index resIncr, const AlphaScalar& alpha)
+  {
+#ifdef EIGEN_HAS_PARALLEL_GEMV
+    Index actualRows = IsLower ? rows : (std::min)(rows,cols);
+    Index threads = parallel_threads_for_work(rows_work(actualRows, rows, cols), gemv_min_task_size);
+    threads = (std::min)(threads, actualRows/MinBlockSize);
+    if(threads>1)
+      return run_parallel_session(session<AlphaScalar>(rows, cols, lhs, lhsStride, rhs, rhsIncr, res, resIncr, alpha), threads);
+#endif
+    Trmv::run(rows, cols, lhs, lhsStride, rhs, rhsIncr, res, resIncr, alpha);
+  }
+};
+
 /***************************************************************************
 * Wrapper to product_triangular_vector
 ***************************************************************************/
@@ -258,7 +374,7 @@ template<int Mode> struct trmv_selector<Mode,ColMajor>
         MappedDest(actualDestPtr, dest.size()) = dest;
     }
 
-    internal::triangular_matrix_vector_product
+    internal::parallel_triangular_matrix_vector_product
       <Index,Mode,
        LhsScalar, LhsBlasTraits::NeedToConjugate,
        RhsScalar, RhsBlasTraits::NeedToConjugate,
@@ -324,7 +440,7 @@ template<int Mode> struct trmv_selector<Mode,RowMajor>
       Map<typename ActualRhsTypeCleaned::PlainObject>(actualRhsPtr, actualRhs.size()) = actualRhs;
     }
 
-    internal::triangular_matrix_vector_product
+    internal::parallel_triangular_matrix_vector_product
       <Index,Mode,
        LhsScalar, LhsBlasTraits::NeedToConjugate,
        RhsScalar, RhsBlasTraits::NeedToConjugate,
@@ -10,6 +10,10 @@
 #ifndef EIGEN_TRIANGULAR_SOLVER_MATRIX_H
 #define EIGEN_TRIANGULAR_SOLVER_MATRIX_H
 
+#if (defined(EIGEN_HAS_OPENMP) || defined(EIGEN_HAS_PARALLEL_EXECUTOR)) && !defined(EIGEN_USE_BLAS)
+#define EIGEN_HAS_PARALLEL_TRSM
+#endif
+
 namespace Eigen { 
 
 namespace internal {
@@ -328,6 +332,65 @@ EIGEN_DONT_INLINE void triangular_solve_matrix<Scalar,Index,OnTheRight,Mode,Conj
     }
   }
 
+/* Multi-threaded triangular solver with multiple right hand sides:
+ * the columns (resp. rows) of the right hand sides are independent when the triangular matrix
+ * is on the left (resp. on the right). They are thus split into slices which are solved
+ * concurrently by triangular_solve_matrix, each thread using its own packing buffers.
+ */
+template <typename Scalar, typename Index, int Side, int Mode, bool Conjugate, int TriStorageOrder, int OtherStorageOrder>
+struct parallel_triangular_solve_matrix
+{
+  typedef triangular_solve_matrix<Scalar,Index,Side,Mode,Conjugate,TriStorageOrder,OtherStorageOrder> Trsm;
+
+#ifdef EIGEN_HAS_PARALLEL_TRSM
+  typedef gebp_traits<Scalar,Scalar> Traits;
+  enum {
+    // true if the independent right hand sides are stored contiguously
+    OtherIsContiguous = (Side==OnTheLeft) == (OtherStorageOrder==ColMajor)
+  };
+
+  template<typename BlockingType>
+  struct session
+  {
+    session(Index size, Index otherSize, const Scalar* tri, Index triStride, Scalar* other, Index otherStride)
+      : m_size(size), m_otherSize(otherSize), m_tri(tri), m_triStride(triStride), m_other(other), m_otherStride(otherStride)
+    {}
+
+    void operator()(Index i, Index threads) const
+    {
+      Index blockSize = (m_otherSize / threads / Traits::nr) * Traits::nr;
+      Index start = i*blockSize;
+      Index actualBlockSize = (i+1==threads) ? m_otherSize-start : blockSize;
+      Index rows = Side==OnTheLeft ? m_size : actualBlockSize;
+      Index cols = Side==OnTheLeft ? actualBlockSize : m_size;
+      BlockingType blocking(rows, cols, m_size, 1, false);
+      Trsm::run(m_size, actualBlockSize, m_tri, m_triStride,
+                m_other + (OtherIsContiguous ? start*m_otherStride : start), m_otherStride, blocking);
+    }
+
+    Index m_size, m_otherSize;
+    const Scalar* m_tri;
+    Index m_triStride;
+    Scalar* m_other;
+    Index m_otherStride;
+  };
+#endif
+
+  template<typename BlockingType>
+  static void run(Index size, Index otherSize, const Scalar* tri, Index triStride,
+                  Scalar* other, Index otherStride, BlockingType& blocking)
+  {
+#ifdef EIGEN_HAS_PARALLEL_TRSM
+    // Same heuristic as parallelize_gemm: each thread processes at least nr right hand sides.
+    double work = static_cast<double>(size) * static_cast<double>(size) * static_cast<double>(otherSize);
+    Index threads = (std::min)(parallel_threads_for_work(work, gemm_min_task_size), otherSize/Traits::nr);
+    if(threads>1)
+      return run_parallel_session(session<BlockingType>(size, otherSize, tri, triStride, other, otherStride), threads);
+#endif
+    Trsm::run(size, otherSize, tri, triStride, other, otherStride, blocking);
+  }
+};
+
 } // end namespace internal
 
 } // end namespace Eigen
@@ -0,0 +1,264 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_WIDENED_PRODUCT_H
+#define EIGEN_WIDENED_PRODUCT_H
+
+namespace Eigen {
+
+template<typename AccScalar, typename Lhs, typename Rhs> class WidenedProduct;
+
+namespace internal {
+
+// true for the integer types whose values are exactly representable by a 16-bit signed integer
+template<typename T> struct fits_in_int16 { enum { value = 0 }; };
+template<> struct fits_in_int16<signed char>   { enum { value = 1 }; };
+template<> struct fits_in_int16<unsigned char> { enum { value = 1 }; };
+template<> struct fits_in_int16<short>         { enum { value = 1 }; };
+
+#if defined(EIGEN_VECTORIZE_AVX512BW)
+typedef Packet16i widened_gemm_packet;
+#elif defined(EIGEN_VECTORIZE_AVX2)
+typedef Packet8i widened_gemm_packet;
+#elif defined(EIGEN_VECTORIZE_SSE2)
+typedef Packet4i widened_gemm_packet;
+#else
+typedef int widened_gemm_packet;
+#endif
+
+/* Computes res += lhs * rhs for 8 or 16-bit integer operands and a column major 32-bit integer result.
+ *
+ * The operands are widened to 16 bits while being packed, and two consecutive coefficients along the depth
+ * are stored in each 32-bit word. The micro kernel is then a sequence of pmaddpairs (pmaddwd on x86), which
+ * multiplies the pairs of 16-bit integers and sums each pair of products into 32-bit accumulators without
+ * any intermediate rounding or saturation. Note that pmaddubsw, which directly multiplies 8-bit integers,
+ * is not used since it requires an unsigned operand and saturates its 16-bit results.
+ *
+ * The lhs is packed per panels of MR rows, such that a packet holds a pair of coefficients of PacketSize rows,
+ * and the rhs is packed per column, each pair of coefficients being broadcast to the whole packet.
+ */
+template<typename LhsScalar, typename RhsScalar>
+struct widened_gemm
+{
+  typedef widened_gemm_packet Packet;
+  enum {
+    PacketSize = unpacket_traits<Packet>::size,
+    MR = 2*PacketSize,
+    NR = 4,
+    KcPairs = 256
+  };
+
+  static EIGEN_STRONG_INLINE int pair(int lo, int hi)
+  {
+    return int(static_cast<unsigned int>(static_cast<unsigned short>(lo)) | (static_cast<unsigned int>(static_cast<unsigned short>(hi)) << 16));
+  }
+
+  template<int N>
+  static EIGEN_STRONG_INLINE void micro_kernel(const int* blockA, const int* blockB, Index kcp, Index actual_mr,
+                                               int* res, Index resStride)
+  {
+    Packet acc0[N], acc1[N];
+    for(int c=0; c<N; ++c)
+    {
+      acc0[c] = pset1<Packet>(0);
+      acc1[c] = pset1<Packet>(0);
+    }
+    for(Index p=0; p<kcp; ++p)
+    {
+      Packet a0 = pload<Packet>(blockA + p*MR);
+      Packet a1 = pload<Packet>(blockA + p*MR + PacketSize);
+      for(int c=0; c<N; ++c)
+      {
+        Packet b = pset1<Packet>(blockB[c*kcp + p]);
+        acc0[c] = pmaddpairs(a0, b, acc0[c]);
+        acc1[c] = pmaddpairs(a1, b, acc1[c]);
+      }
+    }
+    EIGEN_ALIGN_MAX int tmp[MR];
+    for(int c=0; c<N; ++c)
+    {
+      pstore(tmp, acc0[c]);
+      pstore(tmp + PacketSize, acc1[c]);
+      for(Index r=0; r<actual_mr; ++r)
+        res[r + c*resStride] += tmp[r];
+    }
+  }
+
+  template<typename LhsMapper, typename RhsMapper>
+  static void run(Index rows, Index cols, Index depth, const LhsMapper& lhs, const RhsMapper& rhs, int* res, Index resStride)
+  {
+    const Index pairs = (depth+1)/2;
+    const Index kcp = (std::min)(pairs, Index(KcPairs));
+    ei_declare_aligned_stack_constructed_variable(int, blockA, MR*kcp, 0);
+    ei_declare_aligned_stack_constructed_variable(int, blockB, kcp*cols, 0);
+
+    for(Index p2=0; p2<pairs; p2+=kcp)
+    {
+      const Index actual_kcp = (std::min)(p2+kcp,pairs)-p2;
+      const Index k2 = 2*p2;
+      const bool odd = 2*(p2+actual_kcp) > depth;
+      const Index full_kcp = odd ? actual_kcp-1 : actual_kcp;
+
+      // pack the rhs pairs column by column, the last missing coefficient of an odd depth being zero
+      for(Index j=0; j<cols; ++j)
+      {
+        int* b = blockB + j*actual_kcp;
+        for(Index p=0; p<full_kcp; ++p)
+          b[p] = pair(rhs(k2+2*p,j), rhs(k2+2*p+1,j));
+        if(odd)
+          b[full_kcp] = pair(rhs(depth-1,j), 0);
+      }
+
+      for(Index i=0; i<rows; i+=MR)
+      {
+        const Index actual_mr = (std::min)(i+Index(MR),rows)-i;
+        for(Index p=0; p<actual_kcp; ++p)
+        {
+          int* a = blockA + p*MR;
+          const Index k = k2+2*p;
+          const bool has_hi = k+1<depth;
+          Index r = 0;
+          for(; r<actual_mr; ++r)
+            a[r] = pair(lhs(i+r,k), has_hi ? int(lhs(i+r,k+1)) : 0);
+          for(; r<MR; ++r)
+            a[r] = 0;
+        }
+
+        Index j = 0;
+        for(; j+NR<=cols; j+=NR)
+          micro_kernel<NR>(blockA, blockB + j*actual_kcp, actual_kcp, actual_mr, res + i + j*resStride, resStride);
+        for(; j<cols; ++j)
+          micro_kernel<1>(blockA, blockB + j*actual_kcp, actual_kcp, actual_mr, res + i + j*resStride, resStride);
+      }
+    }
+  }
+};
+
+template<typename AccScalar, typename Lhs, typename Rhs,
+         bool UseKernel = is_same<AccScalar,int>::value && fits_in_int16<typename Lhs::Scalar>::value
+                                                        && fits_in_int16<typename Rhs::Scalar>::value>
+struct widened_product_impl
+{
+  template<typename Dest>
+  static void addTo(Dest& dst, const Lhs& lhs, const Rhs& rhs)
+  {
+    dst.noalias() += lhs.template cast<AccScalar>() * rhs.template cast<AccScalar>();
+  }
+};
+
+template<typename AccScalar, typename Lhs, typename Rhs>
+struct widened_product_impl<AccScalar,Lhs,Rhs,true>
+{
+  typedef typename Lhs::Scalar LhsScalar;
+  typedef typename Rhs::Scalar RhsScalar;
+  enum {
+    LhsStorageOrder = Lhs::IsRowMajor ? RowMajor : ColMajor,
+    RhsStorageOrder = Rhs::IsRowMajor ? RowMajor : ColMajor
+  };
+
+  template<typename Dest>
+  static void addTo(Dest& dst, const Lhs& a_lhs, const Rhs& a_rhs)
+  {
+    typedef Ref<const Matrix<LhsScalar,Dynamic,Dynamic,LhsStorageOrder>, 0, OuterStride<> > LhsRef;
+    typedef Ref<const Matrix<RhsScalar,Dynamic,Dynamic,RhsStorageOrder>, 0, OuterStride<> > RhsRef;
+    typedef const_blas_data_mapper<LhsScalar, Index, LhsStorageOrder> LhsMapper;
+    typedef const_blas_data_mapper<RhsScalar, Index, RhsStorageOrder> RhsMapper;
+
+    LhsRef lhs(a_lhs);
+    RhsRef rhs(a_rhs);
+    // the kernel writes a column major result with unit inner stride
+    if(Dest::IsRowMajor ? dst.rows()>1 : dst.innerStride()!=1)
+    {
+      Matrix<int,Dynamic,Dynamic> res = Matrix<int,Dynamic,Dynamic>::Zero(dst.rows(), dst.cols());
+      widened_gemm<LhsScalar,RhsScalar>::run(lhs.rows(), rhs.cols(), lhs.cols(), LhsMapper(lhs.data(), lhs.outerStride()),
+                                             RhsMapper(rhs.data(), rhs.outerStride()), res.data(), res.outerStride());
+      dst += res;
+    }
+    else
+    {
+      widened_gemm<LhsScalar,RhsScalar>::run(lhs.rows(), rhs.cols(), lhs.cols(), LhsMapper(lhs.data(), lhs.outerStride()),
+                                             RhsMapper(rhs.data(), rhs.outerStride()), &dst.coeffRef(0,0),
+                                             Dest::IsRowMajor ? dst.innerStride() : dst.outerStride());
+    }
+  }
+};
+
+template<typename AccScalar, typename Lhs, typename Rhs>
+struct traits<WidenedProduct<AccScalar,Lhs,Rhs> >
+{
+  typedef Matrix<AccScalar, Lhs::RowsAtCompileTime, Rhs::ColsAtCompileTime,
+                 (Lhs::RowsAtCompileTime==1 && Rhs::ColsAtCompileTime!=1) ? RowMajor : ColMajor,
+                 Lhs::MaxRowsAtCompileTime, Rhs::MaxColsAtCompileTime> ReturnType;
+};
+
+} // end namespace internal
+
+/** \class WidenedProduct
+  * \ingroup Core_Module
+  *
+  * \brief Expression of a matrix product accumulated in a wider scalar type
+  *
+  * This class is the return type of widenedProduct(), and most of the time this is the only way it is used.
+  */
+template<typename AccScalar, typename Lhs, typename Rhs>
+class WidenedProduct : public ReturnByValue<WidenedProduct<AccScalar,Lhs,Rhs> >
+{
+  public:
+    WidenedProduct(const Lhs& lhs, const Rhs& rhs) : m_lhs(lhs), m_rhs(rhs)
+    {
+      eigen_assert(lhs.cols()==rhs.rows());
+    }
+
+    Index rows() const { return m_lhs.rows(); }
+    Index cols() const { return m_rhs.cols(); }
+
+    template<typename Dest>
+    void evalTo(Dest& dst) const
+    {
+      dst.resize(rows(), cols());
+      dst.setZero();
+      internal::widened_product_impl<AccScalar,Lhs,Rhs>::addTo(dst, m_lhs, m_rhs);
+    }
+
+    /** Performs \a dst += \c lhs * \c rhs, \a dst being of scalar type \a AccScalar */
+    template<typename Dest>
+    void addTo(Dest& dst) const
+    {
+      eigen_assert(dst.rows()==rows() && dst.cols()==cols());
+      internal::widened_product_impl<AccScalar,Lhs,Rhs>::addTo(dst, m_lhs, m_rhs);
+    }
+
+  protected:
+    typename Lhs::Nested m_lhs;
+    typename Rhs::Nested m_rhs;
+};
+
+/** \ingroup Core_Module
+  *
+  * \returns an expression of the matrix product \a lhs * \a rhs in which the products and their sums are
+  * computed with the scalar type \a AccScalar, e.g.:
+  * \code
+  * Matrix<int8_t,Dynamic,Dynamic> A, B;
+  * Matrix<int32_t,Dynamic,Dynamic> C = widenedProduct<int32_t>(A, B);
+  * \endcode
+  * In contrast, \c A*B would be computed and accumulated with 8-bit integers.
+  *
+  * When \a AccScalar is a 32-bit integer and the operands are 8 or 16-bit integers (signed or unsigned for 8 bits),
+  * a dedicated kernel multiplies pairs of 16-bit integers into 32-bit accumulators (pmaddwd on x86 with SSE2,
+  * AVX2 or AVX512BW). Otherwise, the product is evaluated as <tt>lhs.cast<AccScalar>() * rhs.cast<AccScalar>()</tt>.
+  *
+  * As for any 32-bit integer arithmetic, the sums must not overflow.
+  */
+template<typename AccScalar, typename Lhs, typename Rhs>
+const WidenedProduct<AccScalar,Lhs,Rhs> widenedProduct(const MatrixBase<Lhs>& lhs, const MatrixBase<Rhs>& rhs)
+{
+  return WidenedProduct<AccScalar,Lhs,Rhs>(lhs.derived(), rhs.derived());
+}
+
+} // end namespace Eigen
+
+#endif // EIGEN_WIDENED_PRODUCT_H
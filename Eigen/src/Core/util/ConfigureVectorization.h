@@ -264,6 +264,9 @@
       #ifdef __AVX512DQ__
         #define EIGEN_VECTORIZE_AVX512DQ
       #endif
+      #ifdef __AVX512BW__
+        #define EIGEN_VECTORIZE_AVX512BW
+      #endif
       #ifdef __AVX512ER__
         #define EIGEN_VECTORIZE_AVX512ER
       #endif
@@ -357,7 +360,7 @@
   #endif
 #endif
 
-#if defined(__F16C__) && !defined(EIGEN_COMP_CLANG)
+#if defined(__F16C__) && defined(EIGEN_VECTORIZE_AVX) && (!EIGEN_COMP_CLANG || EIGEN_COMP_CLANG>=380)
   // We can use the optimized fp16 to float and float to fp16 conversion routines
   #define EIGEN_HAS_FP16_C
 #endif
@@ -0,0 +1,145 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_RUNTIME_DISPATCH_H
+#define EIGEN_RUNTIME_DISPATCH_H
+
+#include "RuntimeDispatchRegistry.h"
+
+#if !defined(EIGEN_NO_CPUID) && EIGEN_ARCH_i386_OR_x86_64
+#  if EIGEN_COMP_GNUC
+     // xgetbv, emitted as raw bytes for old assemblers
+#    define EIGEN_XGETBV(xcr0) \
+       { unsigned int eax_, edx_; __asm__ __volatile__ (".byte 0x0f, 0x01, 0xd0" : "=a" (eax_), "=d" (edx_) : "c" (0)); xcr0 = eax_; }
+#  elif EIGEN_COMP_MSVC && (EIGEN_COMP_MSVC >= 1600)
+#    define EIGEN_XGETBV(xcr0) xcr0 = (unsigned int)_xgetbv(0);
+#  endif
+#endif
+
+namespace Eigen {
+
+namespace internal {
+
+/** \internal
+  * \returns the most advanced instruction set among EIGEN_DISPATCH_ISA_* supported by both the CPU and the OS */
+inline int queryDispatchInstructionSet()
+{
+#if defined(EIGEN_CPUID) && defined(EIGEN_XGETBV)
+  int abcd[4];
+  EIGEN_CPUID(abcd,0x0,0);
+  int max_std_funcs = abcd[0];
+  if(max_std_funcs<1)
+    return 0;
+
+  EIGEN_CPUID(abcd,0x1,0);
+  const bool sse2    = (abcd[3] & (1<<26)) != 0;
+  const bool sse4_2  = (abcd[2] & (1<<20)) != 0;
+  const bool fma     = (abcd[2] & (1<<12)) != 0;
+  const bool osxsave = (abcd[2] & (1<<27)) != 0;
+  const bool avx     = (abcd[2] & (1<<28)) != 0;
+  bool avx2 = false, avx512 = false;
+  if(max_std_funcs>=7)
+  {
+    EIGEN_CPUID(abcd,0x7,0);
+    avx2   = (abcd[1] & (1<<5)) != 0;
+    avx512 = (abcd[1] & (1<<16)) != 0 && (abcd[1] & (1<<17)) != 0; // AVX512F and AVX512DQ
+  }
+
+  // the OS must save the YMM (and ZMM) registers on context switches
+  unsigned int xcr0 = 0;
+  if(osxsave)
+    EIGEN_XGETBV(xcr0)
+  const bool ymm = (xcr0 & 0x06) == 0x06;
+  const bool zmm = (xcr0 & 0xe6) == 0xe6;
+
+  if(avx512 && avx2 && fma && zmm)  return EIGEN_DISPATCH_ISA_AVX512;
+  if(avx2 && fma && avx && ymm)     return EIGEN_DISPATCH_ISA_AVX2_FMA;
+  if(avx && ymm)                    return EIGEN_DISPATCH_ISA_AVX;
+  if(sse4_2)                        return EIGEN_DISPATCH_ISA_SSE4_2;
+  if(sse2)                          return EIGEN_DISPATCH_ISA_SSE2;
+#endif
+  return 0;
+}
+
+/** \internal
+  * \returns the kernels compiled for the most advanced instruction set supported by the CPU,
+  * or a null pointer if none is more advanced than the one of the current translation unit.
+  * Only the instruction set of the CPU is cached, so that the kernels registered by static
+  * initializers are found even by products running before them. */
+inline const eigen_dispatch_kernels* dispatchKernels()
+{
+  static const int cpu_isa = queryDispatchInstructionSet();
+  for(int isa = cpu_isa; isa>EIGEN_DISPATCH_COMPILED_ISA; --isa)
+    if(eigen_dispatch_slot(isa))
+      return eigen_dispatch_slot(isa);
+  return 0;
+}
+
+/* Entry points called by the matrix-matrix and matrix-vector product kernels:
+ * they forward the product to the selected kernels and return true if possible,
+ * and return false to fall back to the kernels of the current translation unit otherwise.
+ */
+template<typename Index, typename LhsScalar, int LhsStorageOrder, bool ConjugateLhs, typename RhsScalar, int RhsStorageOrder, bool ConjugateRhs>
+struct dispatch_gemm
+{
+  template<typename ResScalar, typename BlockingType>
+  static bool run(Index, Index, Index, const LhsScalar*, Index, const RhsScalar*, Index, ResScalar*, Index, ResScalar, const BlockingType&)
+  { return false; }
+};
+
+template<typename Index, typename LhsScalar, typename LhsMapper, int LhsStorageOrder, bool ConjugateLhs, typename RhsScalar, typename RhsMapper, bool ConjugateRhs>
+struct dispatch_gemv
+{
+  template<typename ResScalar, typename AlphaScalar>
+  static bool run(Index, Index, const LhsMapper&, const RhsMapper&, ResScalar*, Index, AlphaScalar)
+  { return false; }
+};
+
+#define EIGEN_DISPATCH_PRODUCT_SPECIALIZATION(SCALAR, PREFIX) \
+template<typename Index, int LhsStorageOrder, int RhsStorageOrder> \
+struct dispatch_gemm<Index,SCALAR,LhsStorageOrder,false,SCALAR,RhsStorageOrder,false> \
+{ \
+  template<typename BlockingType> \
+  static bool run(Index rows, Index cols, Index depth, const SCALAR* lhs, Index lhsStride, const SCALAR* rhs, Index rhsStride, \
+                  SCALAR* res, Index resStride, SCALAR alpha, const BlockingType& blocking) \
+  { \
+    const eigen_dispatch_kernels* kernels = dispatchKernels(); \
+    if(kernels==0 || kernels->PREFIX##gemm==0) \
+      return false; \
+    kernels->PREFIX##gemm(LhsStorageOrder==RowMajor, RhsStorageOrder==RowMajor, rows, cols, depth, \
+                          lhs, lhsStride, rhs, rhsStride, res, resStride, alpha, \
+                          blocking.kc(), blocking.mc(), blocking.nc()); \
+    return true; \
+  } \
+}; \
+\
+template<typename Index, int LhsStorageOrder, int RhsStorageOrder> \
+struct dispatch_gemv<Index,SCALAR,const_blas_data_mapper<SCALAR,Index,LhsStorageOrder>,LhsStorageOrder,false, \
+                     SCALAR,const_blas_data_mapper<SCALAR,Index,RhsStorageOrder>,false> \
+{ \
+  static bool run(Index rows, Index cols, const const_blas_data_mapper<SCALAR,Index,LhsStorageOrder>& lhs, \
+                  const const_blas_data_mapper<SCALAR,Index,RhsStorageOrder>& rhs, SCALAR* res, Index resIncr, SCALAR alpha) \
+  { \
+    const eigen_dispatch_kernels* kernels = dispatchKernels(); \
+    if(kernels==0 || kernels->PREFIX##gemv==0) \
+      return false; \
+    kernels->PREFIX##gemv(LhsStorageOrder==RowMajor, rows, cols, lhs.data(), lhs.stride(), \
+                          rhs.data(), RhsStorageOrder==RowMajor ? rhs.stride() : 1, res, resIncr, alpha); \
+    return true; \
+  } \
+};
+
+EIGEN_DISPATCH_PRODUCT_SPECIALIZATION(float,  s)
+EIGEN_DISPATCH_PRODUCT_SPECIALIZATION(double, d)
+
+#undef EIGEN_DISPATCH_PRODUCT_SPECIALIZATION
+
+} // end namespace internal
+
+} // end namespace Eigen
+
+#endif // EIGEN_RUNTIME_DISPATCH_H
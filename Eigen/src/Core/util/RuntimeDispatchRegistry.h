@@ -0,0 +1,69 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_RUNTIME_DISPATCH_REGISTRY_H
+#define EIGEN_RUNTIME_DISPATCH_REGISTRY_H
+
+// This file is shared by the regular translation units and by the ones including Eigen/RuntimeDispatch,
+// in which the name of the library namespace is redefined. Therefore it must not make use of that name,
+// and it only relies on plain types.
+
+#include <cstddef>
+
+#define EIGEN_DISPATCH_ISA_SSE2     1
+#define EIGEN_DISPATCH_ISA_SSE4_2   2
+#define EIGEN_DISPATCH_ISA_AVX      3
+#define EIGEN_DISPATCH_ISA_AVX2_FMA 4
+#define EIGEN_DISPATCH_ISA_AVX512   5
+#define EIGEN_DISPATCH_ISA_COUNT    6
+
+// instruction set the current translation unit is compiled for
+#if defined(EIGEN_VECTORIZE_AVX512)
+  #define EIGEN_DISPATCH_COMPILED_ISA EIGEN_DISPATCH_ISA_AVX512
+#elif defined(EIGEN_VECTORIZE_AVX2) && defined(EIGEN_VECTORIZE_FMA)
+  #define EIGEN_DISPATCH_COMPILED_ISA EIGEN_DISPATCH_ISA_AVX2_FMA
+#elif defined(EIGEN_VECTORIZE_AVX)
+  #define EIGEN_DISPATCH_COMPILED_ISA EIGEN_DISPATCH_ISA_AVX
+#elif defined(EIGEN_VECTORIZE_SSE4_2)
+  #define EIGEN_DISPATCH_COMPILED_ISA EIGEN_DISPATCH_ISA_SSE4_2
+#elif defined(EIGEN_VECTORIZE_SSE2)
+  #define EIGEN_DISPATCH_COMPILED_ISA EIGEN_DISPATCH_ISA_SSE2
+#else
+  #define EIGEN_DISPATCH_COMPILED_ISA 0
+#endif
+
+// Kernels compiled for a given instruction set. Storage orders are passed as booleans (true for row major),
+// and the destination of the matrix products is always column major. The matrix products use the blocking
+// sizes kc, mc, nc of the caller, rounded to the register blocking sizes of their own instruction set.
+struct eigen_dispatch_kernels
+{
+  int isa;
+  void (*sgemm)(bool lhsRowMajor, bool rhsRowMajor, std::ptrdiff_t rows, std::ptrdiff_t cols, std::ptrdiff_t depth,
+                const float* lhs, std::ptrdiff_t lhsStride, const float* rhs, std::ptrdiff_t rhsStride,
+                float* res, std::ptrdiff_t resStride, float alpha, std::ptrdiff_t kc, std::ptrdiff_t mc, std::ptrdiff_t nc);
+  void (*dgemm)(bool lhsRowMajor, bool rhsRowMajor, std::ptrdiff_t rows, std::ptrdiff_t cols, std::ptrdiff_t depth,
+                const double* lhs, std::ptrdiff_t lhsStride, const double* rhs, std::ptrdiff_t rhsStride,
+                double* res, std::ptrdiff_t resStride, double alpha, std::ptrdiff_t kc, std::ptrdiff_t mc, std::ptrdiff_t nc);
+  void (*sgemv)(bool lhsRowMajor, std::ptrdiff_t rows, std::ptrdiff_t cols, const float* lhs, std::ptrdiff_t lhsStride,
+                const float* rhs, std::ptrdiff_t rhsIncr, float* res, std::ptrdiff_t resIncr, float alpha);
+  void (*dgemv)(bool lhsRowMajor, std::ptrdiff_t rows, std::ptrdiff_t cols, const double* lhs, std::ptrdiff_t lhsStride,
+                const double* rhs, std::ptrdiff_t rhsIncr, double* res, std::ptrdiff_t resIncr, double alpha);
+};
+
+// \internal \returns the registered kernels for the instruction set isa, or a null pointer.
+inline const eigen_dispatch_kernels*& eigen_dispatch_slot(int isa)
+{
+  static const eigen_dispatch_kernels* slots[EIGEN_DISPATCH_ISA_COUNT] = { 0 };
+  return slots[isa];
+}
+
+inline void eigen_register_dispatch_kernels(const eigen_dispatch_kernels* kernels)
+{
+  eigen_dispatch_slot(kernels->isa) = kernels;
+}
+
+#endif // EIGEN_RUNTIME_DISPATCH_REGISTRY_H
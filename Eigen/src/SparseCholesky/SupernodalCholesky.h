@@ -0,0 +1,687 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_SUPERNODAL_CHOLESKY_H
+#define EIGEN_SUPERNODAL_CHOLESKY_H
+
+namespace Eigen {
+
+template<typename _MatrixType, int _UpLo = Lower, typename _Ordering = AMDOrdering<typename _MatrixType::StorageIndex> > class SupernodalLLT;
+
+namespace internal {
+
+template<typename _MatrixType, int _UpLo, typename _Ordering> struct traits<SupernodalLLT<_MatrixType,_UpLo,_Ordering> >
+{
+  typedef _MatrixType MatrixType;
+  typedef _Ordering OrderingType;
+  enum { UpLo = _UpLo };
+};
+
+template<typename Decomposition> struct supernodal_llt_session;
+
+} // end namespace internal
+
+/** \ingroup SparseCholesky_Module
+  * \class SupernodalLLT
+  * \brief A direct sparse LLT Cholesky factorization using dense kernels on supernodes
+  *
+  * This class provides a LL^T Cholesky factorization of sparse matrices that are selfadjoint and positive
+  * definite. The factorization allows for solving A.X = B where X and B can be either dense or sparse.
+  *
+  * In order to reduce the fill-in, a symmetric permutation P is applied prior to the factorization
+  * such that the factorized matrix is P A P^-1. P is the fill-reducing ordering followed by a postordering
+  * of the elimination tree.
+  *
+  * The consecutive columns of L sharing the same sparsity pattern below the diagonal are grouped into
+  * supernodes, which are stored as dense column-major blocks. The factorization is left-looking: each supernode
+  * gathers the updates of its descendants with dense matrix products, and is then factorized with a dense
+  * LLT and a triangular solve. Unlike SimplicialLLT, the work is thus mostly performed by the matrix-matrix
+  * kernels of Eigen, which makes this class much faster on matrices with large supernodes, such as the
+  * discretizations of 3D problems.
+  *
+  * When Eigen is multi-threaded (see \ref TopicMultiThreading), independent subtrees of the elimination tree
+  * are factorized concurrently, and the supernodes close to the root, which are the largest ones, are
+  * factorized one after the other with multi-threaded dense kernels.
+  *
+  * \tparam _MatrixType the type of the sparse matrix A, it must be a SparseMatrix<>
+  * \tparam _UpLo the triangular part that will be used for the computations. It can be Lower
+  *               or Upper. Default is Lower.
+  * \tparam _Ordering The ordering method to use, either AMDOrdering<> or NaturalOrdering<>. Default is AMDOrdering<>
+  *
+  * \implsparsesolverconcept
+  *
+  * \sa class SimplicialLLT, class AMDOrdering, class NaturalOrdering
+  */
+template<typename _MatrixType, int _UpLo, typename _Ordering>
+class SupernodalLLT : public SparseSolverBase<SupernodalLLT<_MatrixType,_UpLo,_Ordering> >
+{
+    typedef SparseSolverBase<SupernodalLLT> Base;
+    using Base::m_isInitialized;
+    template<typename Decomposition> friend struct internal::supernodal_llt_session;
+
+  public:
+    typedef _MatrixType MatrixType;
+    typedef _Ordering OrderingType;
+    enum { UpLo = _UpLo };
+    typedef typename MatrixType::Scalar Scalar;
+    typedef typename MatrixType::RealScalar RealScalar;
+    typedef typename MatrixType::StorageIndex StorageIndex;
+    typedef SparseMatrix<Scalar,ColMajor,StorageIndex> CholMatrixType;
+    typedef Matrix<Scalar,Dynamic,1> VectorType;
+    typedef Matrix<StorageIndex,Dynamic,1> VectorI;
+
+    enum {
+      ColsAtCompileTime = MatrixType::ColsAtCompileTime,
+      MaxColsAtCompileTime = MatrixType::MaxColsAtCompileTime
+    };
+
+    /** Default constructor */
+    SupernodalLLT()
+      : m_info(Success), m_factorizationIsOk(false), m_analysisIsOk(false), m_size(0)
+    {}
+
+    /** Constructs and performs the LLT factorization of \a matrix */
+    explicit SupernodalLLT(const MatrixType& matrix)
+      : m_info(Success), m_factorizationIsOk(false), m_analysisIsOk(false), m_size(0)
+    {
+      compute(matrix);
+    }
+
+    inline Index rows() const { return m_size; }
+    inline Index cols() const { return m_size; }
+
+    /** \brief Reports whether previous computation was successful.
+      *
+      * \returns \c Success if computation was successful,
+      *          \c NumericalIssue if the matrix appears not to be positive definite.
+      */
+    ComputationInfo info() const
+    {
+      eigen_assert(m_isInitialized && "Decomposition is not initialized.");
+      return m_info;
+    }
+
+    /** \returns the permutation P
+      * \sa permutationPinv() */
+    const PermutationMatrix<Dynamic,Dynamic,StorageIndex>& permutationP() const
+    { return m_P; }
+
+    /** \returns the inverse P^-1 of the permutation P
+      * \sa permutationP() */
+    const PermutationMatrix<Dynamic,Dynamic,StorageIndex>& permutationPinv() const
+    { return m_Pinv; }
+
+    /** \returns the number of supernodes of the factor L */
+    Index supernodeCount() const
+    {
+      eigen_assert(m_analysisIsOk && "You must first call analyzePattern()");
+      return m_supernodeStart.size()-1;
+    }
+
+    /** \returns a copy of the factor L as a sparse matrix
+      *
+      * \warning The factor is internally stored in a supernodal format, so this function has to copy it.
+      */
+    CholMatrixType matrixL() const;
+
+    /** Computes the sparse Cholesky decomposition of \a matrix */
+    SupernodalLLT& compute(const MatrixType& matrix)
+    {
+      analyzePattern(matrix);
+      factorize(matrix);
+      return *this;
+    }
+
+    /** Performs a symbolic decomposition on the sparcity of \a matrix.
+      *
+      * This function is particularly useful when solving for several problems having the same structure.
+      *
+      * \sa factorize()
+      */
+    void analyzePattern(const MatrixType& a);
+
+    /** Performs a numeric decomposition of \a matrix
+      *
+      * The given matrix must has the same sparcity than the matrix on which the symbolic decomposition has been performed.
+      *
+      * \sa analyzePattern()
+      */
+    void factorize(const MatrixType& a);
+
+    /** \returns the determinant of the underlying matrix from the current factorization */
+    Scalar determinant() const
+    {
+      eigen_assert(m_factorizationIsOk && "Supernodal LLT not factorized");
+      Scalar detL(1);
+      for(Index s=0; s<supernodeCount(); ++s)
+        detL *= supernode(s).topRows(supernodeWidth(s)).diagonal().prod();
+      return numext::abs2(detL);
+    }
+
+#ifndef EIGEN_PARSED_BY_DOXYGEN
+    /** \internal */
+    template<typename Rhs,typename Dest>
+    void _solve_impl(const MatrixBase<Rhs> &b, MatrixBase<Dest> &dest) const;
+
+    /** \internal */
+    template<typename Rhs,typename Dest>
+    void _solve_impl(const SparseMatrixBase<Rhs> &b, SparseMatrixBase<Dest> &dest) const
+    {
+      internal::solve_sparse_through_dense_panels(*this, b, dest);
+    }
+#endif // EIGEN_PARSED_BY_DOXYGEN
+
+  protected:
+    typedef Map<Matrix<Scalar,Dynamic,Dynamic>, 0, OuterStride<> > SupernodeMap;
+    typedef Map<const Matrix<Scalar,Dynamic,Dynamic>, 0, OuterStride<> > ConstSupernodeMap;
+
+    // scratch buffers of the numerical factorization of a supernode
+    struct Workspace {
+      Matrix<Scalar,Dynamic,Dynamic> update;
+      VectorI relativeRows; // position of each row of the matrix in the current supernode
+    };
+
+    Index supernodeWidth(Index s) const { return m_supernodeStart(s+1) - m_supernodeStart(s); }
+    Index supernodeRows(Index s) const { return m_rowStart(s+1) - m_rowStart(s); }
+    const StorageIndex* supernodeRowIndices(Index s) const { return m_rowIndices.data() + m_rowStart(s); }
+    SupernodeMap supernode(Index s)
+    {
+      return SupernodeMap(m_values.data() + m_valueStart(s), supernodeRows(s), supernodeWidth(s), OuterStride<>(supernodeRows(s)));
+    }
+    ConstSupernodeMap supernode(Index s) const
+    {
+      return ConstSupernodeMap(m_values.data() + m_valueStart(s), supernodeRows(s), supernodeWidth(s), OuterStride<>(supernodeRows(s)));
+    }
+
+    void permutedLowerPart(const MatrixType& a, CholMatrixType& ap) const
+    {
+      ap.resize(a.rows(), a.cols());
+      ap.template selfadjointView<Lower>() = a.template selfadjointView<UpLo>().twistedBy(m_P);
+    }
+
+    bool factorizeSupernode(Index s, const CholMatrixType& ap, Workspace& workspace);
+
+    mutable ComputationInfo m_info;
+    bool m_factorizationIsOk;
+    bool m_analysisIsOk;
+    Index m_size;
+
+    PermutationMatrix<Dynamic,Dynamic,StorageIndex> m_P;     // the permutation
+    PermutationMatrix<Dynamic,Dynamic,StorageIndex> m_Pinv;  // the inverse permutation
+
+    VectorI m_supernodeStart;             // first column of each supernode
+    VectorI m_supernodeParent;            // parent of each supernode in the elimination tree, or -1
+    VectorI m_rowStart;                   // start of the rows of each supernode in m_rowIndices
+    VectorI m_rowIndices;                 // sorted rows of each supernode, starting with its own columns
+    VectorI m_updateStart;                // start of the updating descendants of each supernode in m_updates
+    VectorI m_updates;                    // the descendants updating each supernode, by increasing index
+    Matrix<Index,Dynamic,1> m_valueStart; // start of each dense supernode in m_values
+    VectorType m_values;
+};
+
+template<typename MatrixType, int UpLo, typename Ordering>
+void SupernodalLLT<MatrixType,UpLo,Ordering>::analyzePattern(const MatrixType& a)
+{
+  eigen_assert(a.rows()==a.cols());
+  const StorageIndex size = internal::convert_index<StorageIndex>(a.rows());
+  m_size = size;
+
+  // fill-reducing ordering
+  if(!internal::is_same<OrderingType,NaturalOrdering<Index> >::value)
+  {
+    CholMatrixType C;
+    C = a.template selfadjointView<UpLo>();
+    OrderingType ordering;
+    ordering(C,m_Pinv);
+  }
+  else
+    m_Pinv.resize(0);
+  if(m_Pinv.size()>0) m_P = m_Pinv.inverse();
+  else                m_P.setIdentity(size);
+
+  // elimination tree and column counts of L, as in SimplicialCholeskyBase::analyzePattern_preordered
+  CholMatrixType ap(size,size);
+  ap.template selfadjointView<Upper>() = a.template selfadjointView<UpLo>().twistedBy(m_P);
+  VectorI parent(size), counts(size), tags(size);
+  for(StorageIndex k = 0; k < size; ++k)
+  {
+    parent(k) = -1;
+    tags(k) = k;
+    counts(k) = 0;
+    for(typename CholMatrixType::InnerIterator it(ap,k); it; ++it)
+    {
+      StorageIndex i = it.index();
+      if(i < k)
+      {
+        for(; tags(i) != k; i = parent(i))
+        {
+          if(parent(i) == -1)
+            parent(i) = k;
+          counts(i)++;
+          tags(i) = k;
+        }
+      }
+    }
+  }
+
+  // postorder the elimination tree such that the subtrees, and thus the supernodes, are made of consecutive columns
+  {
+    VectorI treeParent(size+1), post;
+    for(StorageIndex k = 0; k < size; ++k)
+      treeParent(k) = parent(k) == -1 ? size : parent(k);
+    treeParent(size) = size;
+    internal::treePostorder(size, treeParent, post);
+    PermutationMatrix<Dynamic,Dynamic,StorageIndex> postorder(size);
+    VectorI postParent(size), postCounts(size);
+    for(StorageIndex k = 0; k < size; ++k)
+    {
+      postorder.indices()(k) = post(k);
+      postParent(post(k)) = parent(k) == -1 ? -1 : post(parent(k));
+      postCounts(post(k)) = counts(k);
+    }
+    m_P = postorder * m_P;
+    m_Pinv = m_P.inverse();
+    parent.swap(postParent);
+    counts.swap(postCounts);
+  }
+
+  // fundamental supernodes: a column is merged with its only child when the child has the same pattern below it
+  VectorI childCount = VectorI::Zero(size);
+  for(StorageIndex k = 0; k < size; ++k)
+    if(parent(k) != -1)
+      childCount(parent(k))++;
+  std::vector<StorageIndex> starts;
+  VectorI columnSupernode(size);
+  for(StorageIndex k = 0; k < size; ++k)
+  {
+    if(k==0 || parent(k-1)!=k || counts(k-1)!=counts(k)+1 || childCount(k)!=1)
+      starts.push_back(k);
+    columnSupernode(k) = StorageIndex(starts.size()-1);
+  }
+  starts.push_back(size);
+  const Index supernodes = starts.size()-1;
+  m_supernodeStart = Map<VectorI>(starts.data(), starts.size());
+  m_supernodeParent.resize(supernodes);
+  for(Index s = 0; s < supernodes; ++s)
+  {
+    StorageIndex p = parent(m_supernodeStart(s+1)-1);
+    m_supernodeParent(s) = p == -1 ? -1 : columnSupernode(p);
+  }
+
+  // rows of the supernodes: the union of the patterns of their columns in A and of their children
+  CholMatrixType lower;
+  permutedLowerPart(a, lower);
+  VectorI firstChild = VectorI::Constant(supernodes, -1), nextChild(supernodes);
+  for(Index s = supernodes-1; s >= 0; --s)
+  {
+    StorageIndex p = m_supernodeParent(s);
+    if(p != -1)
+    {
+      nextChild(s) = firstChild(p);
+      firstChild(p) = StorageIndex(s);
+    }
+  }
+  std::vector<StorageIndex> rowIndices;
+  VectorI marker = VectorI::Constant(size, -1);
+  m_rowStart.resize(supernodes+1);
+  m_rowStart(0) = 0;
+  for(Index s = 0; s < supernodes; ++s)
+  {
+    const StorageIndex first = m_supernodeStart(s), end = m_supernodeStart(s+1);
+    for(StorageIndex j = first; j < end; ++j)
+      rowIndices.push_back(j);
+    for(StorageIndex j = first; j < end; ++j)
+    {
+      for(typename CholMatrixType::InnerIterator it(lower,j); it; ++it)
+      {
+        StorageIndex i = it.index();
+        if(i >= end && marker(i) != s)
+        {
+          marker(i) = StorageIndex(s);
+          rowIndices.push_back(i);
+        }
+      }
+    }
+    for(StorageIndex c = firstChild(s); c != -1; c = nextChild(c))
+    {
+      for(StorageIndex k = m_rowStart(c); k < m_rowStart(c+1); ++k)
+      {
+        StorageIndex i = rowIndices[k];
+        if(i >= end && marker(i) != s)
+        {
+          marker(i) = StorageIndex(s);
+          rowIndices.push_back(i);
+        }
+      }
+    }
+    std::sort(rowIndices.begin() + m_rowStart(s) + (end-first), rowIndices.end());
+    m_rowStart(s+1) = StorageIndex(rowIndices.size());
+    eigen_internal_assert(m_rowStart(s+1)-m_rowStart(s) == counts(first)+1);
+  }
+  m_rowIndices = Map<VectorI>(rowIndices.data(), rowIndices.size());
+
+  // descendants updating each supernode: those having rows within its columns
+  VectorI updateCounts = VectorI::Zero(supernodes);
+  for(int pass = 0; pass < 2; ++pass)
+  {
+    if(pass==1)
+    {
+      m_updateStart.resize(supernodes+1);
+      m_updateStart(0) = 0;
+      for(Index s = 0; s < supernodes; ++s)
+        m_updateStart(s+1) = m_updateStart(s) + updateCounts(s);
+      m_updates.resize(m_updateStart(supernodes));
+      updateCounts.setZero();
+    }
+    for(Index d = 0; d < supernodes; ++d)
+    {
+      StorageIndex last = -1;
+      for(StorageIndex k = m_rowStart(d) + StorageIndex(supernodeWidth(d)); k < m_rowStart(d+1); ++k)
+      {
+        StorageIndex s = columnSupernode(m_rowIndices(k));
+        if(s != last)
+        {
+          if(pass==1)
+            m_updates(m_updateStart(s) + updateCounts(s)) = StorageIndex(d);
+          updateCounts(s)++;
+          last = s;
+        }
+      }
+    }
+  }
+
+  m_valueStart.resize(supernodes+1);
+  m_valueStart(0) = 0;
+  for(Index s = 0; s < supernodes; ++s)
+    m_valueStart(s+1) = m_valueStart(s) + supernodeRows(s) * supernodeWidth(s);
+  m_values.resize(m_valueStart(supernodes));
+
+  m_isInitialized     = true;
+  m_info              = Success;
+  m_analysisIsOk      = true;
+  m_factorizationIsOk = false;
+}
+
+template<typename MatrixType, int UpLo, typename Ordering>
+bool SupernodalLLT<MatrixType,UpLo,Ordering>::factorizeSupernode(Index s, const CholMatrixType& ap, Workspace& workspace)
+{
+  const Index first = m_supernodeStart(s);
+  const Index width = supernodeWidth(s);
+  const Index rows = supernodeRows(s);
+  const StorageIndex* rowIndices = supernodeRowIndices(s);
+  SupernodeMap L = supernode(s);
+
+  // scatter the columns of A, whose patterns are included in the one of the supernode but are not sorted
+  workspace.relativeRows.resize(m_size);
+  for(Index k = 0; k < rows; ++k)
+    workspace.relativeRows(rowIndices[k]) = StorageIndex(k);
+  L.setZero();
+  for(Index j = 0; j < width; ++j)
+    for(typename CholMatrixType::InnerIterator it(ap,first+j); it; ++it)
+      L(workspace.relativeRows(it.index()),j) = it.value();
+
+  // apply the updates of the descendants: L(rows,cols) -= Ld(rows,:) * Ld(cols,:)^*
+  for(StorageIndex u = m_updateStart(s); u < m_updateStart(s+1); ++u)
+  {
+    const Index d = m_updates(u);
+    const StorageIndex* dRowIndices = supernodeRowIndices(d);
+    const Index dRows = supernodeRows(d);
+    const Index p0 = std::lower_bound(dRowIndices, dRowIndices+dRows, StorageIndex(first)) - dRowIndices;
+    const Index p1 = std::lower_bound(dRowIndices+p0, dRowIndices+dRows, StorageIndex(first+width)) - dRowIndices;
+    const Index m = dRows - p0;
+    const Index n = p1 - p0;
+    ConstSupernodeMap Ld = const_cast<const SupernodalLLT*>(this)->supernode(d);
+    workspace.update.resize(m, n);
+    workspace.update.noalias() = Ld.bottomRows(m) * Ld.middleRows(p0, n).adjoint();
+
+    // the rows of the descendant are a subset of the ones of the supernode
+    for(Index j = 0; j < n; ++j)
+    {
+      Index col = dRowIndices[p0+j] - first;
+      for(Index i = j; i < m; ++i)
+        L(workspace.relativeRows(dRowIndices[p0+i]), col) -= workspace.update(i,j);
+    }
+  }
+
+  // dense factorization of the diagonal block, and triangular solve of the rows below it
+  Block<SupernodeMap> L11(L, 0, 0, width, width);
+  if(internal::llt_inplace<Scalar,Lower>::blocked(L11) >= 0)
+    return false;
+  if(rows > width)
+  {
+    Block<SupernodeMap> L21(L, width, 0, rows-width, width);
+    L11.template triangularView<Lower>().adjoint().template solveInPlace<OnTheRight>(L21);
+  }
+  return true;
+}
+
+namespace internal {
+
+/** \internal
+  * Factorizes independent subtrees of supernodes concurrently. Each subtree is a range of consecutive supernodes
+  * ending at its root. The subtrees are assigned to a fixed number of bins, and each thread factorizes the bins
+  * i, i+threads, etc., in case OpenMP provides fewer threads than requested. */
+template<typename Decomposition>
+struct supernodal_llt_session
+{
+  typedef typename Decomposition::CholMatrixType CholMatrixType;
+  typedef typename Decomposition::StorageIndex StorageIndex;
+
+  supernodal_llt_session(Decomposition& llt, const CholMatrixType& ap, const std::vector<std::vector<StorageIndex> >& bins,
+                         const Matrix<StorageIndex,Dynamic,1>& firstDescendant, std::vector<char>& ok)
+    : m_llt(llt), m_ap(ap), m_bins(bins), m_firstDescendant(firstDescendant), m_ok(ok)
+  {}
+
+  void operator()(Index i, Index threads) const
+  {
+    typename Decomposition::Workspace workspace;
+    for(std::size_t b = i; b < m_bins.size(); b += threads)
+    {
+      for(std::size_t t = 0; t < m_bins[b].size() && m_ok[b]; ++t)
+      {
+        StorageIndex root = m_bins[b][t];
+        for(Index s = m_firstDescendant(root); s <= root && m_ok[b]; ++s)
+          m_ok[b] = m_llt.factorizeSupernode(s, m_ap, workspace);
+      }
+    }
+  }
+
+  Decomposition& m_llt;
+  const CholMatrixType& m_ap;
+  const std::vector<std::vector<StorageIndex> >& m_bins;
+  const Matrix<StorageIndex,Dynamic,1>& m_firstDescendant;
+  std::vector<char>& m_ok;
+};
+
+} // end namespace internal
+
+template<typename MatrixType, int UpLo, typename Ordering>
+void SupernodalLLT<MatrixType,UpLo,Ordering>::factorize(const MatrixType& a)
+{
+  eigen_assert(m_analysisIsOk && "You must first call analyzePattern()");
+  eigen_assert(a.rows()==a.cols() && a.rows()==m_size);
+  CholMatrixType ap;
+  permutedLowerPart(a, ap);
+
+  const Index supernodes = supernodeCount();
+  std::vector<char> done(supernodes, 0);
+  bool ok = true;
+
+#if defined(EIGEN_HAS_OPENMP) || defined(EIGEN_HAS_PARALLEL_EXECUTOR)
+  {
+    // the number of flops of each subtree, and its first supernode
+    std::vector<double> work(supernodes);
+    VectorI firstDescendant(supernodes);
+    for(Index s = 0; s < supernodes; ++s)
+      firstDescendant(s) = StorageIndex(s);
+    double totalWork = 0;
+    for(Index s = 0; s < supernodes; ++s)
+    {
+      work[s] += double(supernodeWidth(s)) * double(supernodeRows(s)) * double(supernodeRows(s));
+      StorageIndex p = m_supernodeParent(s);
+      if(p != -1)
+      {
+        work[p] += work[s];
+        firstDescendant(p) = (std::min)(firstDescendant(p), firstDescendant(s));
+      }
+      else
+        totalWork += work[s];
+    }
+
+    // the subtrees are mostly made of dense updates, hence the threshold of the dense products
+    Index threads = internal::parallel_threads_for_work(totalWork, internal::gemm_min_task_size);
+    if(threads>1)
+    {
+      VectorI firstChild = VectorI::Constant(supernodes, -1), nextChild(supernodes);
+      for(Index s = supernodes-1; s >= 0; --s)
+      {
+        StorageIndex p = m_supernodeParent(s);
+        if(p != -1)
+        {
+          nextChild(s) = firstChild(p);
+          firstChild(p) = StorageIndex(s);
+        }
+      }
+
+      // split the largest subtree, starting from the whole forest, until it is small enough to be balanced.
+      // The chains of supernodes having a single child cannot be split: they are left to the sequential pass
+      // below, and the splitting stops once the largest subtree is a chain down to a leaf.
+      const std::size_t maxSubtrees = std::size_t(4*threads);
+      typedef std::pair<double,StorageIndex> WorkItem;
+      std::vector<WorkItem> subtrees;
+      double subtreesWork = 0;
+      for(Index s = 0; s < supernodes; ++s)
+      {
+        if(m_supernodeParent(s) == -1)
+        {
+          subtrees.push_back(WorkItem(work[s], StorageIndex(s)));
+          subtreesWork += work[s];
+        }
+      }
+      std::make_heap(subtrees.begin(), subtrees.end());
+      while(!subtrees.empty() && subtrees.size() < maxSubtrees && subtrees.front().first * double(threads) > subtreesWork)
+      {
+        StorageIndex root = subtrees.front().second, branch = root;
+        while(firstChild(branch) != -1 && nextChild(firstChild(branch)) == -1)
+          branch = firstChild(branch);
+        if(firstChild(branch) == -1)
+          break;
+        std::pop_heap(subtrees.begin(), subtrees.end());
+        subtrees.pop_back();
+        subtreesWork -= work[root];
+        for(StorageIndex c = firstChild(branch); c != -1; c = nextChild(c))
+        {
+          subtrees.push_back(WorkItem(work[c], c));
+          std::push_heap(subtrees.begin(), subtrees.end());
+          subtreesWork += work[c];
+        }
+      }
+
+      if(subtrees.size() > 1)
+      {
+        // assign the largest subtrees first, each to the least loaded bin
+        std::sort_heap(subtrees.begin(), subtrees.end());
+        std::vector<std::vector<StorageIndex> > bins(threads);
+        std::vector<double> load(threads, 0.);
+        for(std::size_t k = subtrees.size(); k-- > 0;)
+        {
+          Index b = std::min_element(load.begin(), load.end()) - load.begin();
+          bins[b].push_back(subtrees[k].second);
+          load[b] += subtrees[k].first;
+          for(Index s = firstDescendant(subtrees[k].second); s <= subtrees[k].second; ++s)
+            done[s] = 1;
+        }
+        std::vector<char> binOk(threads, 1);
+        internal::run_parallel_session(internal::supernodal_llt_session<SupernodalLLT>(*this, ap, bins, firstDescendant, binOk), threads);
+        ok = std::find(binOk.begin(), binOk.end(), 0) == binOk.end();
+      }
+    }
+  }
+#endif
+
+  // the remaining supernodes, by increasing index such that the descendants are factorized first
+  Workspace workspace;
+  for(Index s = 0; s < supernodes && ok; ++s)
+    if(!done[s])
+      ok = factorizeSupernode(s, ap, workspace);
+
+  m_info = ok ? Success : NumericalIssue;
+  m_factorizationIsOk = true;
+}
+
+template<typename MatrixType, int UpLo, typename Ordering>
+template<typename Rhs,typename Dest>
+void SupernodalLLT<MatrixType,UpLo,Ordering>::_solve_impl(const MatrixBase<Rhs> &b, MatrixBase<Dest> &dest) const
+{
+  eigen_assert(m_factorizationIsOk && "The decomposition is not in a valid state for solving, you must first call either compute() or analyzePattern()/factorize()");
+  eigen_assert(m_size==b.rows());
+
+  if(m_info!=Success)
+    return;
+
+  dest = m_P * b;
+
+  Matrix<typename Dest::Scalar,Dynamic,Dynamic> tmp;
+  const Index supernodes = supernodeCount();
+  // L X = B: solve for the columns of each supernode, and update the rows below them
+  for(Index s = 0; s < supernodes; ++s)
+  {
+    const Index first = m_supernodeStart(s), width = supernodeWidth(s), rows = supernodeRows(s);
+    const StorageIndex* rowIndices = supernodeRowIndices(s);
+    ConstSupernodeMap L = supernode(s);
+    L.topRows(width).template triangularView<Lower>().solveInPlace(dest.middleRows(first, width));
+    if(rows > width)
+    {
+      tmp.noalias() = L.bottomRows(rows-width) * dest.middleRows(first, width);
+      for(Index k = 0; k < rows-width; ++k)
+        dest.row(rowIndices[width+k]) -= tmp.row(k);
+    }
+  }
+  // L^* X = B: gather the rows below each supernode, and solve for its columns
+  for(Index s = supernodes-1; s >= 0; --s)
+  {
+    const Index first = m_supernodeStart(s), width = supernodeWidth(s), rows = supernodeRows(s);
+    const StorageIndex* rowIndices = supernodeRowIndices(s);
+    ConstSupernodeMap L = supernode(s);
+    if(rows > width)
+    {
+      tmp.resize(rows-width, dest.cols());
+      for(Index k = 0; k < rows-width; ++k)
+        tmp.row(k) = dest.row(rowIndices[width+k]);
+      dest.middleRows(first, width).noalias() -= L.bottomRows(rows-width).adjoint() * tmp;
+    }
+    L.topRows(width).template triangularView<Lower>().adjoint().solveInPlace(dest.middleRows(first, width));
+  }
+
+  dest = m_Pinv * dest;
+}
+
+template<typename MatrixType, int UpLo, typename Ordering>
+typename SupernodalLLT<MatrixType,UpLo,Ordering>::CholMatrixType SupernodalLLT<MatrixType,UpLo,Ordering>::matrixL() const
+{
+  eigen_assert(m_factorizationIsOk && "Supernodal LLT not factorized");
+  CholMatrixType res(m_size, m_size);
+  VectorI sizes(m_size);
+  for(Index s = 0; s < supernodeCount(); ++s)
+    for(Index j = 0; j < supernodeWidth(s); ++j)
+      sizes(m_supernodeStart(s)+j) = StorageIndex(supernodeRows(s)-j);
+  res.reserve(sizes);
+  for(Index s = 0; s < supernodeCount(); ++s)
+  {
+    const StorageIndex* rowIndices = supernodeRowIndices(s);
+    ConstSupernodeMap L = supernode(s);
+    for(Index j = 0; j < L.cols(); ++j)
+      for(Index k = j; k < L.rows(); ++k)
+        res.insert(rowIndices[k], m_supernodeStart(s)+j) = L(k,j);
+  }
+  res.makeCompressed();
+  return res;
+}
+
+} // end namespace Eigen
+
+#endif // EIGEN_SUPERNODAL_CHOLESKY_H
@@ -14,8 +14,159 @@ namespace Eigen {
 
 namespace internal {
 
+#if defined(EIGEN_HAS_OPENMP) || defined(EIGEN_HAS_PARALLEL_EXECUTOR)
+
+/** \internal \returns the number of threads to use for the product of two sparse matrices,
+  * from an estimate of its number of multiply-adds. */
+template<typename LhsEval, typename RhsEval>
+Index sparse_sparse_product_threads(const LhsEval& lhsEval, const RhsEval& rhsEval, Index depth, Index cols)
+{
+  // each non zero of the rhs is multiplied by a column of the lhs
+  double work = double(rhsEval.nonZerosEstimate()) * double(lhsEval.nonZerosEstimate()) / double((std::max)(depth,Index(1)));
+  return (std::min)(parallel_threads_for_work(work, sparse_min_task_size), cols);
+}
+
+/** \internal
+  * One pass of the multi-threaded product of two sparse matrices into the compressed matrix res.
+  * The symbolic pass stores the number of non zeros of each column j of res in its outer index j+1.
+  * Once these counts are turned into the outer indices, the numeric pass fills the columns in place.
+  * Each thread uses its own dense scratch buffers of the size of a column. */
+template<typename Lhs, typename Rhs, typename ResultType>
+struct conservative_sparse_sparse_product_session
+{
+  typedef typename remove_all<Rhs>::type::Scalar RhsScalar;
+  typedef typename remove_all<ResultType>::type::Scalar ResScalar;
+  typedef typename remove_all<ResultType>::type::StorageIndex StorageIndex;
+
+  conservative_sparse_sparse_product_session(const evaluator<Lhs>& lhsEval, const evaluator<Rhs>& rhsEval, ResultType& res,
+                                             Index rows, Index cols, bool numeric, bool sortedInsertion)
+    : m_lhsEval(lhsEval), m_rhsEval(rhsEval), m_res(res), m_rows(rows), m_cols(cols),
+      m_numeric(numeric), m_sortedInsertion(sortedInsertion)
+  {}
+
+  void operator()(Index i, Index threads) const
+  {
+    Index j0, j1;
+    StorageIndex* outer = m_res.outerIndexPtr();
+    if(m_numeric)
+    {
+      // split the columns such that each thread computes the same number of non zeros
+      Index nnz = outer[m_cols];
+      j0 = std::lower_bound(outer, outer+m_cols, StorageIndex(double(nnz)*double(i)/double(threads))) - outer;
+      j1 = i+1==threads ? m_cols
+                        : std::lower_bound(outer, outer+m_cols, StorageIndex(double(nnz)*double(i+1)/double(threads))) - outer;
+    }
+    else
+    {
+      j0 = m_cols*i/threads;
+      j1 = m_cols*(i+1)/threads;
+    }
+    if(j1<=j0)
+      return;
+
+    ei_declare_aligned_stack_constructed_variable(bool,      mask,    m_rows, 0);
+    ei_declare_aligned_stack_constructed_variable(ResScalar, values,  (m_numeric ? m_rows : 0), 0);
+    ei_declare_aligned_stack_constructed_variable(Index,     indices, m_rows, 0);
+    std::memset(mask,0,sizeof(bool)*m_rows);
+
+    for(Index j=j0; j<j1; ++j)
+    {
+      Index nnz = 0;
+      for (typename evaluator<Rhs>::InnerIterator rhsIt(m_rhsEval, j); rhsIt; ++rhsIt)
+      {
+        RhsScalar y = rhsIt.value();
+        for (typename evaluator<Lhs>::InnerIterator lhsIt(m_lhsEval, rhsIt.index()); lhsIt; ++lhsIt)
+        {
+          Index k = lhsIt.index();
+          if(!mask[k])
+          {
+            mask[k] = true;
+            if(m_numeric)
+              values[k] = lhsIt.value() * y;
+            indices[nnz] = k;
+            ++nnz;
+          }
+          else if(m_numeric)
+            values[k] += lhsIt.value() * y;
+        }
+      }
+
+      if(!m_numeric)
+      {
+        outer[j+1] = StorageIndex(nnz);
+        for(Index k=0; k<nnz; ++k)
+          mask[indices[k]] = false;
+        continue;
+      }
+
+      eigen_internal_assert(outer[j+1]-outer[j]==nnz);
+      if(m_sortedInsertion && nnz>1)
+        std::sort(indices,indices+nnz);
+      StorageIndex* resIndices = m_res.innerIndexPtr() + outer[j];
+      ResScalar* resValues = m_res.valuePtr() + outer[j];
+      for(Index k=0; k<nnz; ++k)
+      {
+        Index r = indices[k];
+        resIndices[k] = StorageIndex(r);
+        resValues[k] = values[r];
+        mask[r] = false;
+      }
+    }
+  }
+
+  const evaluator<Lhs>& m_lhsEval;
+  const evaluator<Rhs>& m_rhsEval;
+  ResultType& m_res;
+  Index m_rows, m_cols;
+  bool m_numeric;
+  bool m_sortedInsertion;
+};
+
+/** \internal
+  * Multi-threaded product of two sparse matrices into the sparse matrix res, through OpenMP or
+  * the registered ParallelExecutor. \returns false, leaving res untouched, if the product is too
+  * small to be worth it. */
+template<typename Lhs, typename Rhs, typename Scalar, int Options, typename StorageIndex>
+bool conservative_sparse_sparse_product_parallel(const evaluator<Lhs>& lhsEval, const evaluator<Rhs>& rhsEval,
+                                                 SparseMatrix<Scalar,Options,StorageIndex>& res,
+                                                 Index rows, Index depth, Index cols, bool sortedInsertion)
+{
+  typedef SparseMatrix<Scalar,Options,StorageIndex> ResultType;
+  typedef conservative_sparse_sparse_product_session<Lhs,Rhs,ResultType> Session;
+
+  Index threads = sparse_sparse_product_threads(lhsEval, rhsEval, depth, cols);
+  if(threads<=1)
+    return false;
+  eigen_assert(res.outerSize()==cols && res.innerSize()==rows);
+
+  Eigen::initParallel();
+  res.setZero();
+  // the sessions fill the outer indices and the storage of a compressed matrix
+  res.makeCompressed();
+
+  // symbolic pass, and prefix sum of the number of non zeros per column
+  run_parallel_session(Session(lhsEval, rhsEval, res, rows, cols, false, sortedInsertion), threads);
+  StorageIndex* outer = res.outerIndexPtr();
+  for(Index j=0; j<cols; ++j)
+    outer[j+1] += outer[j];
+
+  // numeric pass into the preallocated storage
+  res.resizeNonZeros(outer[cols]);
+  run_parallel_session(Session(lhsEval, rhsEval, res, rows, cols, true, sortedInsertion), threads);
+  return true;
+}
+
+#endif
+
 template<typename Lhs, typename Rhs, typename ResultType>
-static void conservative_sparse_sparse_product_impl(const Lhs& lhs, const Rhs& rhs, ResultType& res, bool sortedInsertion = false)
+bool conservative_sparse_sparse_product_parallel(const evaluator<Lhs>&, const evaluator<Rhs>&, ResultType&, Index, Index, Index, bool)
+{
+  return false;
+}
+
+// \returns true if the inner indices of the columns of res are sorted
+template<typename Lhs, typename Rhs, typename ResultType>
+static bool conservative_sparse_sparse_product_impl(const Lhs& lhs, const Rhs& rhs, ResultType& res, bool sortedInsertion = false)
 {
   typedef typename remove_all<Lhs>::type::Scalar LhsScalar;
   typedef typename remove_all<Rhs>::type::Scalar RhsScalar;
@@ -25,16 +176,20 @@ static void conservative_sparse_sparse_product_impl(const Lhs& lhs, const Rhs& r
   Index rows = lhs.innerSize();
   Index cols = rhs.outerSize();
   eigen_assert(lhs.outerSize() == rhs.innerSize());
-  
+
+  evaluator<Lhs> lhsEval(lhs);
+  evaluator<Rhs> rhsEval(rhs);
+
+  // The multi-threaded product always sorts the columns of res, since it is done in parallel.
+  if(conservative_sparse_sparse_product_parallel(lhsEval, rhsEval, res, rows, lhs.outerSize(), cols, true))
+    return true;
+
   ei_declare_aligned_stack_constructed_variable(bool,   mask,     rows, 0);
   ei_declare_aligned_stack_constructed_variable(ResScalar, values,   rows, 0);
   ei_declare_aligned_stack_constructed_variable(Index,  indices,  rows, 0);
   
   std::memset(mask,0,sizeof(bool)*rows);
 
-  evaluator<Lhs> lhsEval(lhs);
-  evaluator<Rhs> rhsEval(rhs);
-  
   // estimate the number of non zero entries
   // given a rhs column containing Y non zeros, we assume that the respective Y columns
   // of the lhs differs in average of one non zeros, thus the number of non zeros for
@@ -117,6 +272,7 @@ static void conservative_sparse_sparse_product_impl(const Lhs& lhs, const Rhs& r
     }
   }
   res.finalize();
+  return sortedInsertion;
 }
 
 
@@ -155,8 +311,12 @@ struct conservative_sparse_sparse_product_selector<Lhs,Rhs,ResultType,ColMajor,C
     else
     {
       ColMajorMatrixAux resCol(lhs.rows(),rhs.cols());
-      // ressort to transpose to sort the entries
-      internal::conservative_sparse_sparse_product_impl<Lhs,Rhs,ColMajorMatrixAux>(lhs, rhs, resCol, false);
+      // ressort to transpose to sort the entries, unless they are already sorted
+      if(internal::conservative_sparse_sparse_product_impl<Lhs,Rhs,ColMajorMatrixAux>(lhs, rhs, resCol, false))
+      {
+        res = resCol.markAsRValue();
+        return;
+      }
       RowMajorMatrix resRow(resCol);
       res = resRow.markAsRValue();
     }
@@ -445,6 +445,12 @@ class SparseMatrix
     template<typename InputIterators,typename DupFunctor>
     void setFromTriplets(const InputIterators& begin, const InputIterators& end, DupFunctor dup_func);
 
+    template<typename InputIterators>
+    void setFromSortedTriplets(const InputIterators& begin, const InputIterators& end);
+
+    template<typename InputIterators,typename DupFunctor>
+    void setFromSortedTriplets(const InputIterators& begin, const InputIterators& end, DupFunctor dup_func);
+
     void sumupDuplicates() { collapseDuplicates(internal::scalar_sum_op<Scalar,Scalar>()); }
 
     template<typename DupFunctor>
@@ -916,12 +922,279 @@ private:
 
 namespace internal {
 
+#if defined(EIGEN_HAS_OPENMP) || defined(EIGEN_HAS_PARALLEL_EXECUTOR)
+
+// Check whether T::iterator_category does exist
+template<typename T>
+struct has_iterator_category
+{
+  template <typename C> static meta_yes testCategory(C const *, typename C::iterator_category const * = 0);
+  template <typename C> static meta_no  testCategory(...);
+
+  enum { value = sizeof(testCategory<T>(static_cast<T*>(0))) == sizeof(meta_yes) };
+};
+
+// Check whether InputIterator is a pointer or a random access iterator, without requiring iterator_traits
+template<typename InputIterator, bool HasCategory = has_iterator_category<InputIterator>::value>
+struct is_random_access_iterator
+{
+  enum { value = is_convertible<typename InputIterator::iterator_category, std::random_access_iterator_tag>::value };
+};
+
+template<typename InputIterator>
+struct is_random_access_iterator<InputIterator,false> { enum { value = 0 }; };
+
+template<typename T>
+struct is_random_access_iterator<T*,false> { enum { value = 1 }; };
+
+/** \internal
+  * One pass of the multi-threaded construction of a compressed matrix from a range of triplets.
+  * The triplets are split into a fixed number of chunks, each with its own histogram of outer indices, and
+  * the outer indices are split into as many ranges. Since OpenMP might provide fewer threads than requested,
+  * each thread processes the chunks (resp. ranges) i, i+threads, etc. of the current pass.
+  *  - CountPass:    counts the triplets of each chunk per outer index.
+  *  - ScanPass:     turns the counts of each outer index into offsets relative to the outer index, and sums
+  *                  the sizes of the outer indices of each range.
+  *  - OffsetPass:   makes the offsets absolute, given the start positions of the ranges.
+  *  - ScatterPass:  copies the triplets into temporary buffers, grouped by outer index, in the input order.
+  *  - CollapsePass: sorts each inner vector and collapses its duplicates, storing its final size into mat.
+  *  - CopyPass:     copies the inner vectors to their final position in mat. */
+template<typename InputIterator, typename SparseMatrixType, typename DupFunctor>
+struct set_from_triplets_session
+{
+  typedef typename SparseMatrixType::Scalar Scalar;
+  typedef typename SparseMatrixType::StorageIndex StorageIndex;
+  typedef Matrix<StorageIndex,Dynamic,Dynamic> CountMatrix;
+  typedef Matrix<StorageIndex,Dynamic,1> IndexVector;
+  typedef Matrix<Scalar,Dynamic,1> ScalarVector;
+  enum { IsRowMajor = SparseMatrixType::IsRowMajor };
+  enum Pass { CountPass, ScanPass, OffsetPass, ScatterPass, CollapsePass, CopyPass };
+
+  set_from_triplets_session(const InputIterator& begin, Index size, SparseMatrixType& mat, DupFunctor dup_func, Index chunks,
+                            CountMatrix& counts, IndexVector& starts, IndexVector& rangeSizes,
+                            IndexVector& indices, ScalarVector& values, Pass pass)
+    : m_begin(begin), m_size(size), m_mat(mat), m_dup_func(dup_func), m_chunks(chunks), m_counts(counts), m_starts(starts),
+      m_rangeSizes(rangeSizes), m_indices(indices), m_values(values), m_pass(pass)
+  {}
+
+  void operator()(Index i, Index threads) const
+  {
+    for(Index b=i; b<m_chunks; b+=threads)
+    {
+      switch(m_pass)
+      {
+        case CountPass:    count(b); break;
+        case ScanPass:     scan(b); break;
+        case OffsetPass:   offset(b); break;
+        case ScatterPass:  scatter(b); break;
+        case CollapsePass: collapse(b); break;
+        case CopyPass:     copy(b); break;
+      }
+    }
+  }
+
+  Index chunkStart(Index b) const { return Index(double(m_size)*double(b)/double(m_chunks)); }
+  Index outerStart(Index b) const { return Index(double(m_mat.outerSize())*double(b)/double(m_chunks)); }
+
+  // ranges of outer indices with the same number of triplets, once the start positions are known
+  Index balancedOuterStart(Index b) const
+  {
+    const StorageIndex* starts = m_starts.data();
+    return std::lower_bound(starts, starts+m_mat.outerSize(), StorageIndex(chunkStart(b))) - starts;
+  }
+
+  void count(Index b) const
+  {
+    StorageIndex* counts = m_counts.col(b).data();
+    InputIterator end = m_begin + chunkStart(b+1);
+    for(InputIterator it = m_begin + chunkStart(b); it!=end; ++it)
+    {
+      eigen_assert(it->row()>=0 && it->row()<m_mat.rows() && it->col()>=0 && it->col()<m_mat.cols());
+      counts[IsRowMajor ? it->row() : it->col()]++;
+    }
+  }
+
+  void scan(Index b) const
+  {
+    StorageIndex rangeSize = 0;
+    for(Index j=outerStart(b); j<outerStart(b+1); ++j)
+    {
+      StorageIndex size = 0;
+      for(Index c=0; c<m_chunks; ++c)
+      {
+        StorageIndex tmp = m_counts(j,c);
+        m_counts(j,c) = size;
+        size += tmp;
+      }
+      m_starts(j) = size;
+      rangeSize += size;
+    }
+    m_rangeSizes(b) = rangeSize;
+  }
+
+  void offset(Index b) const
+  {
+    StorageIndex start = m_rangeSizes(b);
+    for(Index j=outerStart(b); j<outerStart(b+1); ++j)
+    {
+      StorageIndex size = m_starts(j);
+      m_starts(j) = start;
+      for(Index c=0; c<m_chunks; ++c)
+        m_counts(j,c) += start;
+      start += size;
+    }
+  }
+
+  void scatter(Index b) const
+  {
+    StorageIndex* positions = m_counts.col(b).data();
+    InputIterator end = m_begin + chunkStart(b+1);
+    for(InputIterator it = m_begin + chunkStart(b); it!=end; ++it)
+    {
+      StorageIndex p = positions[IsRowMajor ? it->row() : it->col()]++;
+      m_indices(p) = convert_index<StorageIndex>(IsRowMajor ? it->col() : it->row());
+      m_values(p) = it->value();
+    }
+  }
+
+  void collapse(Index b) const
+  {
+    // pairs (inner index, position) such that sorting them keeps the duplicates in the input order
+    std::vector<std::pair<StorageIndex,StorageIndex> > order;
+    std::vector<Scalar> values;
+    StorageIndex* outer = m_mat.outerIndexPtr();
+    Index end = b+1==m_chunks ? m_mat.outerSize() : balancedOuterStart(b+1);
+    for(Index j=balancedOuterStart(b); j<end; ++j)
+    {
+      StorageIndex start = m_starts(j);
+      StorageIndex stop = m_starts(j+1);
+      StorageIndex* indices = m_indices.data();
+      if(std::adjacent_find(indices+start, indices+stop, std::greater_equal<StorageIndex>()) == indices+stop)
+      {
+        outer[j+1] = stop-start;
+        continue;
+      }
+      order.clear();
+      for(StorageIndex k=start; k<stop; ++k)
+        order.push_back(std::make_pair(indices[k], k));
+      std::sort(order.begin(), order.end());
+      values.clear();
+      StorageIndex size = 0;
+      for(std::size_t k=0; k<order.size(); ++k)
+      {
+        if(size>0 && indices[start+size-1]==order[k].first)
+        {
+          values.back() = m_dup_func(values.back(), m_values(order[k].second));
+        }
+        else
+        {
+          values.push_back(m_values(order[k].second));
+          indices[start+size] = order[k].first;
+          ++size;
+        }
+      }
+      std::copy(values.begin(), values.end(), m_values.data()+start);
+      outer[j+1] = size;
+    }
+  }
+
+  void copy(Index b) const
+  {
+    const StorageIndex* outer = m_mat.outerIndexPtr();
+    Index end = b+1==m_chunks ? m_mat.outerSize() : balancedOuterStart(b+1);
+    for(Index j=balancedOuterStart(b); j<end; ++j)
+    {
+      StorageIndex start = m_starts(j);
+      StorageIndex size = outer[j+1]-outer[j];
+      std::copy(m_indices.data()+start, m_indices.data()+start+size, m_mat.innerIndexPtr()+outer[j]);
+      std::copy(m_values.data()+start, m_values.data()+start+size, m_mat.valuePtr()+outer[j]);
+    }
+  }
+
+  InputIterator m_begin;
+  Index m_size;
+  SparseMatrixType& m_mat;
+  DupFunctor m_dup_func;
+  Index m_chunks;
+  CountMatrix& m_counts;
+  IndexVector& m_starts;
+  IndexVector& m_rangeSizes;
+  IndexVector& m_indices;
+  ScalarVector& m_values;
+  Pass m_pass;
+};
+
+/** \internal
+  * Multi-threaded set_from_triplets, which builds the compressed matrix directly rather than through
+  * a transposed copy. \returns false if the construction should rather be sequential. */
+template<typename InputIterator, typename SparseMatrixType, typename DupFunctor>
+bool set_from_triplets_parallel(const InputIterator& begin, const InputIterator& end, SparseMatrixType& mat, DupFunctor dup_func,
+                                true_type)
+{
+  typedef set_from_triplets_session<InputIterator,SparseMatrixType,DupFunctor> Session;
+  typedef typename SparseMatrixType::StorageIndex StorageIndex;
+  Index size = end - begin;
+  Index outerSize = mat.outerSize();
+  // each thread has a histogram of the outer indices, which must not outweigh its triplets
+  Index threads = (std::min)(parallel_threads_for_work(double(size), sparse_min_task_size), size/(std::max)(outerSize,Index(1)));
+  if(threads<=1)
+    return false;
+
+  // one chunk of triplets per requested thread
+  Index chunks = threads;
+  typename Session::CountMatrix counts = Session::CountMatrix::Zero(outerSize, chunks);
+  typename Session::IndexVector starts(outerSize+1);
+  typename Session::IndexVector rangeSizes(chunks);
+  typename Session::IndexVector indices(size);
+  typename Session::ScalarVector values(size);
+  mat.resize(mat.rows(), mat.cols());
+
+  #define EIGEN_SET_FROM_TRIPLETS_PASS(PASS) \
+    run_parallel_session(Session(begin, size, mat, dup_func, chunks, counts, starts, rangeSizes, indices, values, Session::PASS), threads)
+  EIGEN_SET_FROM_TRIPLETS_PASS(CountPass);
+  EIGEN_SET_FROM_TRIPLETS_PASS(ScanPass);
+  StorageIndex start = 0;
+  for(Index b=0; b<chunks; ++b)
+  {
+    StorageIndex rangeSize = rangeSizes(b);
+    rangeSizes(b) = start;
+    start += rangeSize;
+  }
+  EIGEN_SET_FROM_TRIPLETS_PASS(OffsetPass);
+  starts(outerSize) = convert_index<StorageIndex>(size);
+  EIGEN_SET_FROM_TRIPLETS_PASS(ScatterPass);
+  EIGEN_SET_FROM_TRIPLETS_PASS(CollapsePass);
+  StorageIndex* outer = mat.outerIndexPtr();
+  outer[0] = 0;
+  for(Index j=0; j<outerSize; ++j)
+    outer[j+1] += outer[j];
+  mat.resizeNonZeros(outer[outerSize]);
+  EIGEN_SET_FROM_TRIPLETS_PASS(CopyPass);
+  #undef EIGEN_SET_FROM_TRIPLETS_PASS
+  return true;
+}
+
+template<typename InputIterator, typename SparseMatrixType, typename DupFunctor>
+bool set_from_triplets_parallel(const InputIterator&, const InputIterator&, SparseMatrixType&, DupFunctor, false_type)
+{
+  return false;
+}
+
+#endif
+
 template<typename InputIterator, typename SparseMatrixType, typename DupFunctor>
 void set_from_triplets(const InputIterator& begin, const InputIterator& end, SparseMatrixType& mat, DupFunctor dup_func)
 {
   enum { IsRowMajor = SparseMatrixType::IsRowMajor };
   typedef typename SparseMatrixType::Scalar Scalar;
   typedef typename SparseMatrixType::StorageIndex StorageIndex;
+
+#if defined(EIGEN_HAS_OPENMP) || defined(EIGEN_HAS_PARALLEL_EXECUTOR)
+  typedef typename conditional<is_random_access_iterator<InputIterator>::value, true_type, false_type>::type IsRandomAccess;
+  if(set_from_triplets_parallel(begin, end, mat, dup_func, IsRandomAccess()))
+    return;
+#endif
+
   SparseMatrix<Scalar,IsRowMajor?ColMajor:RowMajor,StorageIndex> trMat(mat.rows(),mat.cols());
 
   if(begin!=end)
@@ -948,6 +1221,51 @@ void set_from_triplets(const InputIterator& begin, const InputIterator& end, Spa
   mat = trMat;
 }
 
+template<typename InputIterator, typename SparseMatrixType, typename DupFunctor>
+void set_from_sorted_triplets(const InputIterator& begin, const InputIterator& end, SparseMatrixType& mat, DupFunctor dup_func)
+{
+  enum { IsRowMajor = SparseMatrixType::IsRowMajor };
+  typedef typename SparseMatrixType::StorageIndex StorageIndex;
+
+  // pass 1: count the triplets, which bounds the number of non zeros
+  Index size = 0;
+  for(InputIterator it(begin); it!=end; ++it)
+    ++size;
+
+  // pass 2: append the triplets inner-vector after inner-vector, collapsing the consecutive duplicates
+  mat.resize(mat.rows(), mat.cols());
+  mat.resizeNonZeros(size);
+  StorageIndex* outer = mat.outerIndexPtr();
+  StorageIndex* indices = mat.innerIndexPtr();
+  typename SparseMatrixType::Scalar* values = mat.valuePtr();
+  StorageIndex count = 0;
+  Index j = 0;
+  for(InputIterator it(begin); it!=end; ++it)
+  {
+    eigen_assert(it->row()>=0 && it->row()<mat.rows() && it->col()>=0 && it->col()<mat.cols());
+    Index outerIndex = IsRowMajor ? it->row() : it->col();
+    StorageIndex innerIndex = convert_index<StorageIndex>(IsRowMajor ? it->col() : it->row());
+    eigen_assert(outerIndex>=j && "the triplets must be sorted by outer index");
+    if(outerIndex==j && count>outer[j])
+    {
+      eigen_assert(innerIndex>=indices[count-1] && "the triplets of an inner vector must be sorted by inner index");
+      if(innerIndex==indices[count-1])
+      {
+        values[count-1] = dup_func(values[count-1], it->value());
+        continue;
+      }
+    }
+    for(; j<outerIndex; ++j)
+      outer[j+1] = count;
+    indices[count] = innerIndex;
+    values[count] = it->value();
+    ++count;
+  }
+  for(; j<mat.outerSize(); ++j)
+    outer[j+1] = count;
+  mat.resizeNonZeros(count);
+}
+
 }
 
 
@@ -1011,6 +1329,34 @@ void SparseMatrix<Scalar,_Options,_StorageIndex>::setFromTriplets(const InputIte
   internal::set_from_triplets<InputIterators, SparseMatrix<Scalar,_Options,_StorageIndex>, DupFunctor>(begin, end, *this, dup_func);
 }
 
+/** Fill the matrix \c *this with the list of \em triplets defined by the iterator range \a begin - \a end, which
+  * must be sorted by outer index, and then by inner index, i.e., by column and row for a column-major matrix and by
+  * row and column for a row-major one. Duplicated elements are summed up.
+  *
+  * Unlike setFromTriplets, this requires neither a temporary transposed matrix nor a sorting pass: the triplets
+  * are read twice and directly appended to the compressed matrix. See setFromTriplets for the other requirements.
+  *
+  * \sa setFromTriplets
+  */
+template<typename Scalar, int _Options, typename _StorageIndex>
+template<typename InputIterators>
+void SparseMatrix<Scalar,_Options,_StorageIndex>::setFromSortedTriplets(const InputIterators& begin, const InputIterators& end)
+{
+  internal::set_from_sorted_triplets<InputIterators, SparseMatrix<Scalar,_Options,_StorageIndex> >(begin, end, *this, internal::scalar_sum_op<Scalar,Scalar>());
+}
+
+/** The same as setFromSortedTriplets but when duplicates are met the functor \a dup_func is applied:
+  * \code
+  * value = dup_func(OldValue, NewValue)
+  * \endcode
+  */
+template<typename Scalar, int _Options, typename _StorageIndex>
+template<typename InputIterators,typename DupFunctor>
+void SparseMatrix<Scalar,_Options,_StorageIndex>::setFromSortedTriplets(const InputIterators& begin, const InputIterators& end, DupFunctor dup_func)
+{
+  internal::set_from_sorted_triplets<InputIterators, SparseMatrix<Scalar,_Options,_StorageIndex>, DupFunctor>(begin, end, *this, dup_func);
+}
+
 /** \internal */
 template<typename Scalar, int _Options, typename _StorageIndex>
 template<typename DupFunctor>
@@ -14,6 +14,120 @@ namespace Eigen {
 
 namespace internal {
 
+#if defined(EIGEN_HAS_OPENMP) || defined(EIGEN_HAS_PARALLEL_EXECUTOR)
+
+/** \internal
+  * Multi-threaded product of two sparse matrices with pruning. Since the number of non zeros of each
+  * column is only known once it is computed and pruned, each slice of columns is first computed into its
+  * own buffer, and the buffers are then copied into the compressed storage of res in parallel. */
+template<typename Lhs, typename Rhs, typename ResultType>
+struct sparse_sparse_product_with_pruning_session
+{
+  typedef typename remove_all<Rhs>::type::Scalar RhsScalar;
+  typedef typename remove_all<ResultType>::type::Scalar ResScalar;
+  typedef typename remove_all<ResultType>::type::RealScalar RealScalar;
+  typedef typename remove_all<ResultType>::type::StorageIndex StorageIndex;
+  typedef CompressedStorage<ResScalar,StorageIndex> Buffer;
+
+  sparse_sparse_product_with_pruning_session(const evaluator<Lhs>& lhsEval, const evaluator<Rhs>& rhsEval, ResultType& res,
+                                             std::vector<Buffer>& buffers, Index rows, Index cols,
+                                             double ratioColRes, const RealScalar& tolerance, bool copy)
+    : m_lhsEval(lhsEval), m_rhsEval(rhsEval), m_res(res), m_buffers(buffers), m_rows(rows), m_cols(cols),
+      m_ratioColRes(ratioColRes), m_tolerance(tolerance), m_copy(copy)
+  {}
+
+  // the slices are assigned round-robin, since OpenMP might run fewer threads than slices
+  void operator()(Index i, Index threads) const
+  {
+    Index slices = Index(m_buffers.size());
+    for(Index b=i; b<slices; b+=threads)
+    {
+      Index j0 = m_cols*b/slices;
+      Index j1 = m_cols*(b+1)/slices;
+      if(m_copy)
+        copySlice(b, j0);
+      else
+        computeSlice(b, j0, j1);
+    }
+  }
+
+  void computeSlice(Index b, Index j0, Index j1) const
+  {
+    Buffer& buffer = m_buffers[b];
+    StorageIndex* outer = m_res.outerIndexPtr();
+    AmbiVector<ResScalar,StorageIndex> tempVector(m_rows);
+    for (Index j=j0; j<j1; ++j)
+    {
+      tempVector.init(m_ratioColRes);
+      tempVector.setZero();
+      for (typename evaluator<Rhs>::InnerIterator rhsIt(m_rhsEval, j); rhsIt; ++rhsIt)
+      {
+        tempVector.restart();
+        RhsScalar x = rhsIt.value();
+        for (typename evaluator<Lhs>::InnerIterator lhsIt(m_lhsEval, rhsIt.index()); lhsIt; ++lhsIt)
+          tempVector.coeffRef(lhsIt.index()) += lhsIt.value() * x;
+      }
+      Index start = buffer.size();
+      for (typename AmbiVector<ResScalar,StorageIndex>::Iterator it(tempVector,m_tolerance); it; ++it)
+        buffer.append(it.value(), it.index());
+      outer[j+1] = StorageIndex(buffer.size()-start);
+    }
+  }
+
+  void copySlice(Index b, Index j0) const
+  {
+    Buffer& buffer = m_buffers[b];
+    Index start = m_res.outerIndexPtr()[j0];
+    std::copy(buffer.valuePtr(), buffer.valuePtr()+buffer.size(), m_res.valuePtr()+start);
+    std::copy(buffer.indexPtr(), buffer.indexPtr()+buffer.size(), m_res.innerIndexPtr()+start);
+    Buffer().swap(buffer);
+  }
+
+  const evaluator<Lhs>& m_lhsEval;
+  const evaluator<Rhs>& m_rhsEval;
+  ResultType& m_res;
+  std::vector<Buffer>& m_buffers;
+  Index m_rows, m_cols;
+  double m_ratioColRes;
+  RealScalar m_tolerance;
+  bool m_copy;
+};
+
+/** \internal \returns false, leaving res untouched, if the product is too small to be worth multi-threading. */
+template<typename Lhs, typename Rhs, typename Scalar, int Options, typename StorageIndex>
+bool sparse_sparse_product_with_pruning_parallel(const evaluator<Lhs>& lhsEval, const evaluator<Rhs>& rhsEval,
+                                                 SparseMatrix<Scalar,Options,StorageIndex>& res, Index rows, Index depth, Index cols,
+                                                 double ratioColRes, const typename NumTraits<Scalar>::Real& tolerance)
+{
+  typedef SparseMatrix<Scalar,Options,StorageIndex> ResultType;
+  typedef sparse_sparse_product_with_pruning_session<Lhs,Rhs,ResultType> Session;
+
+  Index threads = sparse_sparse_product_threads(lhsEval, rhsEval, depth, cols);
+  if(threads<=1)
+    return false;
+
+  Eigen::initParallel();
+  res.setZero();
+  // the sessions fill the outer indices and the storage of a compressed matrix
+  res.makeCompressed();
+  std::vector<typename Session::Buffer> buffers(threads);
+  run_parallel_session(Session(lhsEval, rhsEval, res, buffers, rows, cols, ratioColRes, tolerance, false), threads);
+  StorageIndex* outer = res.outerIndexPtr();
+  for(Index j=0; j<cols; ++j)
+    outer[j+1] += outer[j];
+  res.resizeNonZeros(outer[cols]);
+  run_parallel_session(Session(lhsEval, rhsEval, res, buffers, rows, cols, ratioColRes, tolerance, true), threads);
+  return true;
+}
+
+#endif
+
+template<typename Lhs, typename Rhs, typename ResultType>
+bool sparse_sparse_product_with_pruning_parallel(const evaluator<Lhs>&, const evaluator<Rhs>&, ResultType&, Index, Index, Index,
+                                                 double, const typename ResultType::RealScalar&)
+{
+  return false;
+}
 
 // perform a pseudo in-place sparse * sparse product assuming all matrices are col major
 template<typename Lhs, typename Rhs, typename ResultType>
@@ -31,9 +145,6 @@ static void sparse_sparse_product_with_pruning_impl(const Lhs& lhs, const Rhs& r
   //Index size = lhs.outerSize();
   eigen_assert(lhs.outerSize() == rhs.innerSize());
 
-  // allocate a temporary buffer
-  AmbiVector<ResScalar,StorageIndex> tempVector(rows);
-
   // mimics a resizeByInnerOuter:
   if(ResultType::IsRowMajor)
     res.resize(cols, rows);
@@ -50,9 +161,15 @@ static void sparse_sparse_product_with_pruning_impl(const Lhs& lhs, const Rhs& r
   // per column of the lhs.
   // Therefore, we have nnz(lhs*rhs) = nnz(lhs) + nnz(rhs)
   Index estimated_nnz_prod = lhsEval.nonZerosEstimate() + rhsEval.nonZerosEstimate();
+  double ratioColRes = double(estimated_nnz_prod)/(double(lhs.rows())*double(rhs.cols()));
+
+  if(sparse_sparse_product_with_pruning_parallel(lhsEval, rhsEval, res, rows, lhs.outerSize(), cols, ratioColRes, tolerance))
+    return;
+
+  // allocate a temporary buffer
+  AmbiVector<ResScalar,StorageIndex> tempVector(rows);
 
   res.reserve(estimated_nnz_prod);
-  double ratioColRes = double(estimated_nnz_prod)/(double(lhs.rows())*double(rhs.cols()));
   for (Index j=0; j<cols; ++j)
   {
     // FIXME:
@@ -23,7 +23,7 @@ namespace internal {
   */
 template<typename Scalar>
 EIGEN_DONT_INLINE
-void sparselu_gemm(Index m, Index n, Index d, const Scalar* A, Index lda, const Scalar* B, Index ldb, Scalar* C, Index ldc)
+void sparselu_gemm_kernel(Index m, Index n, Index d, const Scalar* A, Index lda, const Scalar* B, Index ldb, Scalar* C, Index ldc)
 {
   using namespace Eigen::internal;
   
@@ -273,6 +273,54 @@ void sparselu_gemm(Index m, Index n, Index d, const Scalar* A, Index lda, const
 }
 #undef KMADD
 
+#if defined(EIGEN_HAS_OPENMP) || defined(EIGEN_HAS_PARALLEL_EXECUTOR)
+/** \internal
+  * Splits the rows of A and C of sparselu_gemm into one block per thread. The blocks start at aligned rows,
+  * such that the kernel can process them as the whole product. */
+template<typename Scalar>
+struct sparselu_gemm_session
+{
+  enum { PacketSize = packet_traits<Scalar>::size };
+
+  sparselu_gemm_session(Index m, Index n, Index d, const Scalar* A, Index lda, const Scalar* B, Index ldb, Scalar* C, Index ldc)
+    : m_m(m), m_n(n), m_d(d), m_A(A), m_lda(lda), m_B(B), m_ldb(ldb), m_C(C), m_ldc(ldc)
+  {}
+
+  void operator()(Index i, Index threads) const
+  {
+    Index i0 = internal::first_default_aligned(m_A,m_m);
+    Index blockRows = ((m_m-i0) / threads) & ~Index(PacketSize-1);
+    Index r0 = i==0 ? 0 : i0 + i*blockRows;
+    Index r1 = i+1==threads ? m_m : i0 + (i+1)*blockRows;
+    sparselu_gemm_kernel<Scalar>(r1-r0, m_n, m_d, m_A+r0, m_lda, m_B, m_ldb, m_C+r0, m_ldc);
+  }
+
+  Index m_m, m_n, m_d;
+  const Scalar* m_A;
+  Index m_lda;
+  const Scalar* m_B;
+  Index m_ldb;
+  Scalar* m_C;
+  Index m_ldc;
+};
+#endif
+
+/** \internal
+  * Computes C += A * B with sparselu_gemm_kernel, whose requirements apply. The rows of large products
+  * are distributed over the threads of Eigen.
+  */
+template<typename Scalar>
+void sparselu_gemm(Index m, Index n, Index d, const Scalar* A, Index lda, const Scalar* B, Index ldb, Scalar* C, Index ldc)
+{
+#if defined(EIGEN_HAS_OPENMP) || defined(EIGEN_HAS_PARALLEL_EXECUTOR)
+  enum { MinBlockRows = 8*packet_traits<Scalar>::size };
+  Index threads = (std::min)(parallel_threads_for_work(double(m)*double(n)*double(d), gemm_min_task_size), m/MinBlockRows);
+  if(threads>1)
+    return run_parallel_session(sparselu_gemm_session<Scalar>(m, n, d, A, lda, B, ldb, C, ldc), threads);
+#endif
+  sparselu_gemm_kernel<Scalar>(m, n, d, A, lda, B, ldb, C, ldc);
+}
+
 } // namespace internal
 
 } // namespace Eigen
@@ -15,6 +15,7 @@
 #include <Eigen/Core>
 
 #include <unsupported/Eigen/FFT>
+#include <unsupported/Eigen/CXX11/Tensor>
 
 using namespace Eigen;
 using namespace std;
@@ -37,6 +38,9 @@ template <> string nameof<long double>() {return "long double";}
 #ifndef NDATA
 #define NDATA 1000000
 #endif
+#ifndef NTHREADS
+#define NTHREADS 4
+#endif
 
 using namespace Eigen;
 
@@ -94,6 +98,58 @@ void bench(int nfft,bool fwd,bool unscaled=false, bool halfspec=false)
     cout << " NFFT=" << nfft << "  " << (double(1e-6*nfft*nits)/timer.value()) << " MS/s  " << mflops << "MFLOPS\n";
 }
 
+// Same transforms with the Tensor module, as a batch of NDATA/nfft FFTs along
+// the first dimension of a tensor, evaluated on a pool of NTHREADS threads when
+// compiled with -DEIGEN_USE_THREADS.
+template <typename T>
+void bench_tensor(int nfft,bool fwd)
+{
+    typedef typename NumTraits<T>::Real Scalar;
+    typedef typename std::complex<Scalar> Complex;
+    int nits = NDATA/nfft;
+    Tensor<T,2> inbuf(nfft,nits);
+    Tensor<Complex,2> outbuf(nfft,nits);
+    Tensor<Complex,2> invbuf(nfft,nits);
+    inbuf.setZero();
+    Eigen::array<int,1> dims;
+    dims[0] = 0;
+#ifdef EIGEN_USE_THREADS
+    ThreadPool pool(NTHREADS);
+    ThreadPoolDevice device(&pool, NTHREADS);
+#else
+    DefaultDevice device;
+#endif
+
+    outbuf.device(device) = inbuf.template fft<BothParts, FFT_FORWARD>(dims);
+
+    BenchTimer timer;
+    timer.reset();
+    for (int k=0;k<8;++k) {
+        timer.start();
+        if (fwd)
+            outbuf.device(device) = inbuf.template fft<BothParts, FFT_FORWARD>(dims);
+        else
+            invbuf.device(device) = outbuf.template fft<BothParts, FFT_REVERSE>(dims);
+        timer.stop();
+    }
+
+    cout << "tensor " << nameof<Scalar>() << " ";
+    double mflops = 5.*nfft*log2((double)nfft) / (1e6 * timer.value() / (double)nits );
+    if ( NumTraits<T>::IsComplex ) {
+        cout << "complex";
+    }else{
+        cout << "real   ";
+        mflops /= 2;
+    }
+
+    if (fwd)
+        cout << " fwd";
+    else
+        cout << " inv";
+
+    cout << " NFFT=" << nfft << "  " << (double(1e-6*nfft*nits)/timer.value()) << " MS/s  " << mflops << "MFLOPS\n";
+}
+
 int main(int argc,char ** argv)
 {
     bench<complex<float> >(NFFT,true);
@@ -111,5 +167,12 @@ int main(int argc,char ** argv)
     bench<complex<long double> >(NFFT,false);
     bench<long double>(NFFT,true);
     bench<long double>(NFFT,false);
+
+    bench_tensor<complex<float> >(NFFT,true);
+    bench_tensor<complex<float> >(NFFT,false);
+    bench_tensor<float>(NFFT,true);
+    bench_tensor<complex<double> >(NFFT,true);
+    bench_tensor<complex<double> >(NFFT,false);
+    bench_tensor<double>(NFFT,true);
     return 0;
 }
@@ -0,0 +1,71 @@
+// g++ -O3 -DNDEBUG -march=native -I.. bench_batched_product.cpp -o bench_batched_product && ./bench_batched_product
+
+#include <iostream>
+#include <vector>
+#include <Eigen/Core>
+#include <bench/BenchTimer.h>
+
+using namespace Eigen;
+
+template<typename MatrixType>
+EIGEN_DONT_INLINE void product_loop(MatrixType* dst, const MatrixType* lhs, const MatrixType* rhs, Index count)
+{
+  for(Index b=0; b<count; ++b)
+    dst[b].noalias() = lhs[b].lazyProduct(rhs[b]);
+}
+
+template<typename MatrixType>
+EIGEN_DONT_INLINE void product_batched(MatrixType* dst, const MatrixType* lhs, const MatrixType* rhs, Index count)
+{
+  batchedProduct(dst, lhs, rhs, count);
+}
+
+template<typename MatrixType> void bench(const std::string& label)
+{
+  typedef std::vector<MatrixType,aligned_allocator<MatrixType> > Array;
+  // keep the working set around 4MB
+  Index count = (std::max)(Index(64), Index(4*1024*1024 / (3*sizeof(MatrixType))));
+  int tries = 5;
+  int rep = (std::max)(1, int(2e8 / (double(count) * MatrixType::RowsAtCompileTime * MatrixType::RowsAtCompileTime * MatrixType::RowsAtCompileTime)));
+  Array lhs(count), rhs(count), dst(count);
+  for(Index b=0; b<count; ++b)
+  {
+    lhs[b].setRandom();
+    rhs[b].setRandom();
+  }
+
+  BenchTimer t;
+  std::cout.precision(3);
+
+  BENCH(t, tries, rep, product_loop(&dst[0], &lhs[0], &rhs[0], count));
+  double loop = t.best(REAL_TIMER);
+  BENCH(t, tries, rep, product_batched(&dst[0], &lhs[0], &rhs[0], count));
+  double batched = t.best(REAL_TIMER);
+
+  double products = double(count) * double(rep);
+  std::cout << label << "\tlazyProduct: " << 1e-6*products/loop << " M prod/s"
+            << "\tbatchedProduct: " << 1e-6*products/batched << " M prod/s"
+            << "\tspeedup: " << loop/batched << "\n";
+}
+
+int main()
+{
+  bench<Matrix<float,3,3> >  ("float   3x3");
+  bench<Matrix<float,4,4> >  ("float   4x4");
+  bench<Matrix<float,5,5> >  ("float   5x5");
+  bench<Matrix<float,6,6> >  ("float   6x6");
+  bench<Matrix<float,7,7> >  ("float   7x7");
+  bench<Matrix<float,8,8> >  ("float   8x8");
+  bench<Matrix<float,12,12> >("float 12x12");
+  bench<Matrix<float,16,16> >("float 16x16");
+  bench<Matrix<float,32,32> >("float 32x32");
+  bench<Matrix<double,3,3> > ("double  3x3");
+  bench<Matrix<double,4,4> > ("double  4x4");
+  bench<Matrix<double,5,5> > ("double  5x5");
+  bench<Matrix<double,6,6> > ("double  6x6");
+  bench<Matrix<double,7,7> > ("double  7x7");
+  bench<Matrix<double,8,8> > ("double  8x8");
+  bench<Matrix<double,16,16> >("double 16x16");
+  bench<Matrix<double,32,32> >("double 32x32");
+  return 0;
+}
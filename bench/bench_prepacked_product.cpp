@@ -0,0 +1,54 @@
+// g++ -O3 -DNDEBUG -march=native -I.. bench_prepacked_product.cpp -o bench_prepacked_product && ./bench_prepacked_product
+
+#include <iostream>
+#include <Eigen/Core>
+#include <bench/BenchTimer.h>
+
+using namespace Eigen;
+
+template<typename MatrixType>
+EIGEN_DONT_INLINE void product(MatrixType& dst, const MatrixType& lhs, const MatrixType& rhs)
+{
+  dst.noalias() = lhs * rhs;
+}
+
+template<typename MatrixType>
+EIGEN_DONT_INLINE void product_prepacked(MatrixType& dst, const PrepackedLhs<MatrixType>& lhs, const MatrixType& rhs)
+{
+  dst = lhs * rhs;
+}
+
+// products of a rows x depth matrix by many depth x cols matrices, as in the layers of a neural network
+template<typename MatrixType> void bench(const char* label, Index rows, Index depth, Index cols)
+{
+  MatrixType lhs = MatrixType::Random(rows, depth);
+  MatrixType rhs = MatrixType::Random(depth, cols);
+  MatrixType dst(rows, cols);
+  PrepackedLhs<MatrixType> packed(lhs, cols);
+
+  int tries = 5;
+  int rep = (std::max)(1, int(1e9 / (double(rows) * double(depth) * double(cols))));
+  BenchTimer t;
+  std::cout.precision(3);
+
+  BENCH(t, tries, rep, product(dst, lhs, rhs));
+  double regular = t.best(REAL_TIMER);
+  BENCH(t, tries, rep, product_prepacked(dst, packed, rhs));
+  double prepacked = t.best(REAL_TIMER);
+
+  double flops = 2. * double(rows) * double(depth) * double(cols) * double(rep);
+  std::cout << label << " " << rows << "x" << depth << " * " << depth << "x" << cols
+            << "\tproduct: " << 1e-9*flops/regular << " GFLOPS"
+            << "\tprepacked: " << 1e-9*flops/prepacked << " GFLOPS"
+            << "\tspeedup: " << regular/prepacked << "\n";
+}
+
+int main()
+{
+  const Index sizes[][3] = { {64,64,16}, {128,128,32}, {256,256,32}, {256,256,128}, {512,512,64}, {1024,1024,64}, {1024,1024,256} };
+  for(int i=0; i<7; ++i)
+    bench<MatrixXf>("float ", sizes[i][0], sizes[i][1], sizes[i][2]);
+  for(int i=0; i<7; ++i)
+    bench<MatrixXd>("double", sizes[i][0], sizes[i][1], sizes[i][2]);
+  return 0;
+}
@@ -0,0 +1,61 @@
+// g++ -O3 -DNDEBUG -march=native -I.. bench_widened_product.cpp -o bench_widened_product && ./bench_widened_product
+
+#include <iostream>
+#include <Eigen/Core>
+#include <bench/BenchTimer.h>
+
+using namespace Eigen;
+
+typedef Matrix<signed char,Dynamic,Dynamic> MatrixXs8;
+
+EIGEN_DONT_INLINE void product_casted(MatrixXi& dst, const MatrixXs8& lhs, const MatrixXs8& rhs)
+{
+  dst.noalias() = lhs.cast<int>() * rhs.cast<int>();
+}
+
+EIGEN_DONT_INLINE void product_widened(MatrixXi& dst, const MatrixXs8& lhs, const MatrixXs8& rhs)
+{
+  dst = widenedProduct<int>(lhs, rhs);
+}
+
+EIGEN_DONT_INLINE void product_float(MatrixXf& dst, const MatrixXf& lhs, const MatrixXf& rhs)
+{
+  dst.noalias() = lhs * rhs;
+}
+
+// int8 x int8 -> int32 products, as in quantized inference, compared to int32 and float products
+void bench(Index rows, Index depth, Index cols)
+{
+  MatrixXs8 lhs = MatrixXi::Random(rows, depth).unaryExpr([](int x) { return x>>24; }).cast<signed char>();
+  MatrixXs8 rhs = MatrixXi::Random(depth, cols).unaryExpr([](int x) { return x>>24; }).cast<signed char>();
+  MatrixXf lhsf = lhs.cast<float>(), rhsf = rhs.cast<float>();
+  MatrixXi dst(rows, cols);
+  MatrixXf dstf(rows, cols);
+
+  int tries = 5;
+  int rep = (std::max)(1, int(1e9 / (double(rows) * double(depth) * double(cols))));
+  BenchTimer t;
+  std::cout.precision(3);
+
+  BENCH(t, tries, rep, product_casted(dst, lhs, rhs));
+  double casted = t.best(REAL_TIMER);
+  BENCH(t, tries, rep, product_widened(dst, lhs, rhs));
+  double widened = t.best(REAL_TIMER);
+  BENCH(t, tries, rep, product_float(dstf, lhsf, rhsf));
+  double flt = t.best(REAL_TIMER);
+
+  double ops = 2. * double(rows) * double(depth) * double(cols) * double(rep);
+  std::cout << rows << "x" << depth << " * " << depth << "x" << cols
+            << "\tint32: " << 1e-9*ops/casted << " GOPS"
+            << "\twidened int8: " << 1e-9*ops/widened << " GOPS"
+            << "\tfloat: " << 1e-9*ops/flt << " GFLOPS"
+            << "\tspeedup: " << casted/widened << "\n";
+}
+
+int main()
+{
+  const Index sizes[][3] = { {64,64,64}, {128,128,128}, {256,256,256}, {512,512,512}, {1024,1024,64}, {1024,1024,1024} };
+  for(int i=0; i<6; ++i)
+    bench(sizes[i][0], sizes[i][1], sizes[i][2]);
+  return 0;
+}
@@ -0,0 +1,4 @@
+// Multi-threaded variant of gemvt.cpp, to be compiled with OpenMP enabled, e.g.:
+//   CXX_FLAGS="-fopenmp" ./run.sh gemvt_mt gemv_settings.txt
+#define EIGEN_PARALLELIZE_GEMV
+#include "gemvt.cpp"
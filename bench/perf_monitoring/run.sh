@@ -4,6 +4,7 @@
 # ./run.sh lazy_gemm lazy_gemm_settings.txt
 # ./run.sh gemv gemv_settings.txt
 # ./run.sh trmv_up gemv_square_settings.txt
+# CXX_FLAGS="-fopenmp" ./run.sh gemv_mt gemv_settings.txt
 # ...
 
 # Examples of environment variables to be set:
@@ -0,0 +1,4 @@
+// Multi-threaded variant of trmv_upt.cpp, to be compiled with OpenMP enabled, e.g.:
+//   CXX_FLAGS="-fopenmp" ./run.sh trmv_upt_mt gemv_square_settings.txt
+#define EIGEN_PARALLELIZE_GEMV
+#include "trmv_upt.cpp"
@@ -71,6 +71,7 @@
 #define EIGEN_PARDISO_LLT  160
 #define EIGEN_CG  170
 #define EIGEN_CG_PRECOND  180
+#define EIGEN_SUPERNODAL_LLT  190
 
 using namespace Eigen;
 using namespace std; 
@@ -189,6 +190,11 @@ void printStatheader(std::ofstream& out)
   out << "   <PACKAGE> EIGEN </PACKAGE> \n"; 
   out << "  </SOLVER> \n"; 
   
+  out <<"  <SOLVER ID='" << EIGEN_SUPERNODAL_LLT << "'>\n"; 
+  out << "   <TYPE> LLT SN</TYPE> \n";
+  out << "   <PACKAGE> EIGEN </PACKAGE> \n"; 
+  out << "  </SOLVER> \n"; 
+  
   out <<"  <SOLVER ID='" << EIGEN_CG << "'>\n"; 
   out << "   <TYPE> CG </TYPE> \n";
   out << "   <PACKAGE> EIGEN </PACKAGE> \n"; 
@@ -432,6 +438,11 @@ void SelectSolvers(const SparseMatrix<Scalar>&A, unsigned int sym, Matrix<Scalar
       SimplicialLLT<SpMat, Lower> solver; 
       call_directsolver(solver,EIGEN_SIMPLICIAL_LLT, A, b, refX,statFile); 
     }
+    {
+      cout << "\nSolving with SUPERNODAL LLT ... \n"; 
+      SupernodalLLT<SpMat, Lower> solver; 
+      call_directsolver(solver,EIGEN_SUPERNODAL_LLT, A, b, refX,statFile); 
+    }
     
     // CHOLMOD
     #ifdef EIGEN_CHOLMOD_SUPPORT
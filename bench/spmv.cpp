@@ -7,6 +7,7 @@
 #include <algorithm>
 #include "BenchTimer.h"
 #include "BenchSparseUtil.h"
+#include <unsupported/Eigen/SparseExtra>
 
 #define SPMV_BENCH(CODE) BENCH(t,tries,repeats,CODE);
 
@@ -113,6 +114,16 @@ int main(int argc, char *argv[])
       std::cout << t.value()/repeats << endl;
     }
 
+    // eigen SELL-C-sigma matrices
+    {
+      SellCSigmaMatrix<Scalar> sell(sm), sellTr(sm.transpose());
+      SPMV_BENCH(res.noalias() += sell * dv; )
+      std::cout << "Eigen SELL  " << t.value()/repeats << "\t";
+
+      SPMV_BENCH(res.noalias() += sellTr * dv; )
+      std::cout << t.value()/repeats << endl;
+    }
+
     // CSparse
     #ifdef CSPARSE
     {
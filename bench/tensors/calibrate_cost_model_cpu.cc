@@ -0,0 +1,72 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// Measures the parameters of TensorCostModel<ThreadPoolDevice> on this
+// machine, and compares elementwise evaluations of various sizes with the
+// default and the measured parameters.
+//
+// Usage: calibrate_cost_model_cpu [num_threads]
+
+#define EIGEN_USE_THREADS
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <unsupported/Eigen/CXX11/Tensor>
+
+using namespace Eigen;
+using namespace std;
+
+typedef TensorCostModel<ThreadPoolDevice> CostModel;
+
+// Returns the best time in microseconds of evaluating a elementwise
+// expression of the given size.
+double time_us(const ThreadPoolDevice& device, Index size) {
+  Tensor<float, 1> a(size), b(size), c(size);
+  a.setRandom();
+  b.setRandom();
+  const int iterations = static_cast<int>(numext::maxi<Index>(1, (Index(1) << 24) / size));
+  double best = NumTraits<double>::infinity();
+  for (int run = 0; run < 5; ++run) {
+    const chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+      c.device(device) = a * b + a;
+    }
+    const chrono::steady_clock::time_point end = chrono::steady_clock::now();
+    best = numext::mini(best, chrono::duration<double, micro>(end - start).count() / iterations);
+  }
+  return best;
+}
+
+int main(int argc, char** argv) {
+  const int num_threads = argc > 1 ? atoi(argv[1]) : static_cast<int>(thread::hardware_concurrency());
+  ThreadPool pool(num_threads);
+  ThreadPoolDevice device(&pool, num_threads);
+
+  const TensorCostModelParameters defaults = CostModel::defaultParameters();
+  const TensorCostModelParameters params = calibrateTensorCostModel(device);
+
+  cout << "TensorCostModelParameters params;\n"
+       << "params.device_cycles_per_compute_cycle = " << params.device_cycles_per_compute_cycle << ";\n"
+       << "params.load_cycles_per_byte = " << params.load_cycles_per_byte << ";\n"
+       << "params.store_cycles_per_byte = " << params.store_cycles_per_byte << ";\n"
+       << "params.startup_cycles = " << params.startup_cycles << ";\n"
+       << "params.per_thread_cycles = " << params.per_thread_cycles << ";\n"
+       << "params.task_size = " << params.task_size << ";\n"
+       << "TensorCostModel<ThreadPoolDevice>::setParameters(params);\n\n";
+
+  cout << "size\tdefault (us)\tcalibrated (us)\n";
+  for (Index size = 1 << 10; size <= (1 << 24); size *= 4) {
+    CostModel::setParameters(defaults);
+    const double default_us = time_us(device, size);
+    CostModel::setParameters(params);
+    const double calibrated_us = time_us(device, size);
+    cout << size << "\t" << default_us << "\t" << calibrated_us << "\n";
+  }
+  return 0;
+}
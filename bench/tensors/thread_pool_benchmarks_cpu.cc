@@ -0,0 +1,200 @@
+#define EIGEN_USE_THREADS
+
+#include <chrono>
+#include <utility>
+#include <vector>
+
+#include "tensor_benchmarks.h"
+
+// Splits the threads of the pool into 2 steal partitions, mimicking a dual
+// socket machine.
+static void SetTwoStealPartitions(Eigen::ThreadPool* pool, int threads) {
+  std::vector<std::pair<unsigned, unsigned> > partitions(threads);
+  const unsigned half = threads / 2;
+  for (int i = 0; i < threads; ++i) {
+    partitions[i] = static_cast<unsigned>(i) < half
+                        ? std::make_pair(0u, half)
+                        : std::make_pair(half, static_cast<unsigned>(threads));
+  }
+  pool->SetStealPartitions(partitions);
+}
+
+// Contractions sharded over the pool, stealing from the whole pool or from
+// the partition of the thief first.
+#define BM_ContractionSteal(NAME, PARTITIONED, D)                         \
+  static void BM_##NAME##_##D(int iters, int threads) {                   \
+    StopBenchmarkTiming();                                                \
+    Eigen::ThreadPool pool(threads);                                      \
+    if (PARTITIONED && threads >= 2) SetTwoStealPartitions(&pool, threads); \
+    Eigen::ThreadPoolDevice device(&pool, threads);                       \
+    BenchmarkSuite<Eigen::ThreadPoolDevice, float> suite(device, D, D, D); \
+    suite.contraction(iters);                                             \
+  }                                                                       \
+  BENCHMARK_RANGE(BM_##NAME##_##D, 2, 64);
+
+BM_ContractionSteal(ContractionGlobalSteal, false, 256);
+BM_ContractionSteal(ContractionGlobalSteal, false, 1024);
+BM_ContractionSteal(ContractionPartitionedSteal, true, 256);
+BM_ContractionSteal(ContractionPartitionedSteal, true, 1024);
+
+static void Spin(int micros) {
+  const auto end = std::chrono::steady_clock::now() +
+                   std::chrono::microseconds(micros);
+  while (std::chrono::steady_clock::now() < end) {
+  }
+}
+
+// Time to start a task while all the threads of the pool are busy with a
+// backlog of 32 tasks of 50us each per thread.
+#define BM_TaskLatency(NAME, HIGH_PRIORITY)                               \
+  static void BM_##NAME(int iters, int threads) {                         \
+    StopBenchmarkTiming();                                                \
+    Eigen::ThreadPool pool(threads);                                      \
+    for (int iter = 0; iter < iters; ++iter) {                            \
+      const int backlog = 32 * threads;                                   \
+      Eigen::Barrier drained(backlog);                                    \
+      for (int i = 0; i < backlog; ++i) {                                 \
+        pool.Schedule([&drained]() {                                      \
+          Spin(50);                                                       \
+          drained.Notify();                                               \
+        });                                                               \
+      }                                                                   \
+      Eigen::Notification started;                                        \
+      StartBenchmarkTiming();                                             \
+      if (HIGH_PRIORITY) {                                                \
+        pool.ScheduleHighPriority([&started]() { started.Notify(); });    \
+      } else {                                                            \
+        pool.Schedule([&started]() { started.Notify(); });                \
+      }                                                                   \
+      started.Wait();                                                     \
+      StopBenchmarkTiming();                                              \
+      drained.Wait();                                                     \
+    }                                                                     \
+  }                                                                       \
+  BENCHMARK_RANGE(BM_##NAME, 2, 64);
+
+BM_TaskLatency(NormalPriorityLatency, false);
+BM_TaskLatency(HighPriorityLatency, true);
+
+// A graph of 200 small ops whose forced evaluations and contraction packing
+// buffers are temporaries, with the default aligned_malloc based allocation or
+// with the temporaries served by an ArenaAllocator.
+#define BM_TemporaryAllocation(NAME, USE_ARENA)                            \
+  static void BM_##NAME(int iters, int threads) {                          \
+    StopBenchmarkTiming();                                                 \
+    Eigen::ThreadPool pool(threads);                                       \
+    Eigen::ArenaAllocator arena;                                           \
+    Eigen::ThreadPoolDevice device(&pool, threads, NULL,                   \
+                                   USE_ARENA ? &arena : NULL);             \
+    Eigen::Tensor<float, 2> a(64, 64);                                     \
+    Eigen::Tensor<float, 2> b(64, 64);                                     \
+    a.setRandom();                                                         \
+    b.setRandom();                                                         \
+    Eigen::array<Eigen::IndexPair<int>, 1> dims{{Eigen::IndexPair<int>(1, 0)}}; \
+    StartBenchmarkTiming();                                                \
+    for (int iter = 0; iter < iters; ++iter) {                             \
+      for (int op = 0; op < 100; ++op) {                                   \
+        b.device(device) = (a.contract(b, dims).eval() * 0.01f).tanh();    \
+        b.device(device) = (b + a.eval()).sqrt().abs();                    \
+      }                                                                    \
+    }                                                                      \
+    StopBenchmarkTiming();                                                 \
+  }                                                                        \
+  BENCHMARK_RANGE(BM_##NAME, 1, 16);
+
+BM_TemporaryAllocation(TemporariesDefaultAllocator, false);
+BM_TemporaryAllocation(TemporariesArenaAllocator, true);
+
+// Overhead of a temporary buffer of the given size in KB, allocated by every
+// thread of the pool, which touches each of its pages once. Large buffers
+// are mmap-ed by malloc, and thus page faulted in on every allocation.
+#define BM_AllocateTemp(NAME, USE_ARENA)                                   \
+  static void BM_##NAME(int iters, int size_kb) {                          \
+    StopBenchmarkTiming();                                                 \
+    const int threads = 4;                                                 \
+    Eigen::ThreadPool pool(threads);                                       \
+    Eigen::ArenaAllocator arena;                                           \
+    Eigen::ThreadPoolDevice device(&pool, threads, NULL,                   \
+                                   USE_ARENA ? &arena : NULL);             \
+    const size_t size = static_cast<size_t>(size_kb) * 1024;               \
+    StartBenchmarkTiming();                                                \
+    Eigen::Barrier done(threads);                                          \
+    for (int t = 0; t < threads; ++t) {                                    \
+      pool.Schedule([&]() {                                                \
+        for (int iter = 0; iter < iters; ++iter) {                         \
+          char* buffer = static_cast<char*>(device.allocate_temp(size));   \
+          for (size_t i = 0; i < size; i += 4096) buffer[i] = 1;           \
+          device.deallocate_temp(buffer);                                  \
+        }                                                                  \
+        done.Notify();                                                     \
+      });                                                                  \
+    }                                                                      \
+    done.Wait();                                                           \
+    StopBenchmarkTiming();                                                 \
+  }                                                                        \
+  BENCHMARK_RANGE(BM_##NAME, 1, 65536);
+
+BM_AllocateTemp(AllocateTempDefault, false);
+BM_AllocateTemp(AllocateTempArena, true);
+
+// Cumulative sum of a [batch, 1M] tensor along the long axis, which is the
+// innermost one, or of a [1M, batch] tensor along the outermost axis.
+#define BM_CumSum(NAME, LONG_AXIS)                                         \
+  static void BM_##NAME(int iters, int threads) {                          \
+    StopBenchmarkTiming();                                                 \
+    Eigen::ThreadPool pool(threads);                                       \
+    Eigen::ThreadPoolDevice device(&pool, threads);                        \
+    const int batch = 16;                                                  \
+    const int size = 1 << 20;                                              \
+    const int rows = LONG_AXIS == 1 ? batch : size;                        \
+    const int cols = LONG_AXIS == 1 ? size : batch;                        \
+    Eigen::Tensor<float, 2, Eigen::RowMajor> a(rows, cols);                \
+    Eigen::Tensor<float, 2, Eigen::RowMajor> b(a.dimensions());            \
+    a.setRandom();                                                         \
+    StartBenchmarkTiming();                                                \
+    for (int iter = 0; iter < iters; ++iter) {                             \
+      b.device(device) = a.cumsum(LONG_AXIS);                              \
+    }                                                                      \
+    StopBenchmarkTiming();                                                 \
+    SetBenchmarkFlopsProcessed(static_cast<int64_t>(rows) * cols * iters); \
+  }                                                                        \
+  BENCHMARK_RANGE(BM_##NAME, 1, 32);
+
+BM_CumSum(CumSumInnerAxis, 1);
+BM_CumSum(CumSumOuterAxis, 0);
+
+// Layer normalization of a [batch, 1024] tensor, with the fused normalize() or
+// with the equivalent expression made of reductions, evaluated before they are
+// broadcast, and broadcasts.
+#define BM_LayerNorm(NAME, FUSED)                                          \
+  static void BM_##NAME(int iters, int threads) {                          \
+    StopBenchmarkTiming();                                                 \
+    Eigen::ThreadPool pool(threads);                                       \
+    Eigen::ThreadPoolDevice device(&pool, threads);                        \
+    const int batch = 4096;                                                \
+    const int features = 1024;                                             \
+    Eigen::Tensor<float, 2, Eigen::RowMajor> a(batch, features);           \
+    Eigen::Tensor<float, 2, Eigen::RowMajor> b(a.dimensions());            \
+    a.setRandom();                                                         \
+    Eigen::array<int, 1> dims{{1}};                                        \
+    Eigen::array<int, 2> reshaped{{batch, 1}};                             \
+    Eigen::array<int, 2> bcast{{1, features}};                             \
+    StartBenchmarkTiming();                                                \
+    for (int iter = 0; iter < iters; ++iter) {                             \
+      if (FUSED) {                                                         \
+        b.device(device) = a.normalize(dims, 1e-5f);                       \
+      } else {                                                             \
+        b.device(device) =                                                 \
+            a - a.mean(dims).eval().reshape(reshaped).broadcast(bcast);    \
+        b.device(device) =                                                 \
+            b * ((b.square().mean(dims) + 1e-5f).rsqrt())                  \
+                    .eval().reshape(reshaped).broadcast(bcast);            \
+      }                                                                    \
+    }                                                                      \
+    StopBenchmarkTiming();                                                 \
+    SetBenchmarkFlopsProcessed(static_cast<int64_t>(batch) * features * iters); \
+  }                                                                        \
+  BENCHMARK_RANGE(BM_##NAME, 1, 32);
+
+BM_LayerNorm(LayerNormFused, true);
+BM_LayerNorm(LayerNormReductions, false);
@@ -0,0 +1,62 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// Measures the best blocking sizes of the float and double matrix products on this machine,
+// and stores them in a file to be loaded by loadProductBlockingSizes() of the ProductBlockingTuner module.
+//
+// Usage: tune-product-blocking-sizes output_file [k m n]...
+// Without explicit product sizes, square products of sizes 64 to 2048 are tuned.
+
+#include <iostream>
+#include <cstdlib>
+#include <vector>
+#include <unsupported/Eigen/ProductBlockingTuner>
+
+using namespace Eigen;
+using namespace std;
+
+template<typename Scalar>
+void tune(const char* name, Index k, Index m, Index n)
+{
+  Index kc, mc, nc;
+  double speedup = autotuneProductBlockingSizes<Scalar>(k, m, n, kc, mc, nc);
+  cout << name << " " << k << "x" << m << "x" << n << ": ";
+  if(speedup>1)
+    cout << "kc=" << kc << " mc=" << mc << " nc=" << nc << ", " << (speedup-1)*100 << "% faster\n";
+  else
+    cout << "default blocking sizes\n";
+}
+
+int main(int argc, char** argv)
+{
+  if(argc<2 || (argc-2)%3!=0)
+  {
+    cerr << "usage: " << argv[0] << " output_file [k m n]...\n";
+    return 1;
+  }
+
+  vector<Index> sizes;
+  for(int i=2; i<argc; ++i)
+    sizes.push_back(atoi(argv[i]));
+  if(sizes.empty())
+    for(Index s=64; s<=2048; s*=2)
+      for(int d=0; d<3; ++d)
+        sizes.push_back(s);
+
+  for(size_t i=0; i<sizes.size(); i+=3)
+  {
+    tune<float>("float", sizes[i], sizes[i+1], sizes[i+2]);
+    tune<double>("double", sizes[i], sizes[i+1], sizes[i+2]);
+  }
+
+  if(!saveProductBlockingSizes(argv[1]))
+  {
+    cerr << "cannot write " << argv[1] << "\n";
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,271 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <sstream>
+#include <cstring>
+
+#include "main.h"
+
+// Make sure it's possible to forward declare Eigen::bfloat16
+namespace Eigen {
+struct bfloat16;
+}
+
+using Eigen::bfloat16;
+
+void test_conversion()
+{
+  using Eigen::bfloat16_impl::__bfloat16_raw;
+
+  // Conversion from float.
+  VERIFY_IS_EQUAL(bfloat16(1.0f).value, 0x3f80);
+  VERIFY_IS_EQUAL(bfloat16(0.5f).value, 0x3f00);
+  VERIFY_IS_EQUAL(bfloat16(0.33333f).value, 0x3eab);
+  VERIFY_IS_EQUAL(bfloat16(0.0f).value, 0x0000);
+  VERIFY_IS_EQUAL(bfloat16(-0.0f).value, 0x8000);
+  VERIFY_IS_EQUAL(bfloat16(3.38953139e38f).value, 0x7f7f);
+  VERIFY_IS_EQUAL(bfloat16((std::numeric_limits<float>::max)()).value, 0x7f80);  // Rounds to infinity.
+
+  // Denormals.
+  VERIFY_IS_EQUAL(bfloat16(-9.18355e-41f).value, 0x8001);
+  VERIFY_IS_EQUAL(bfloat16(9.18355e-41f).value, 0x0001);
+
+  // Verify round-to-nearest-even behavior.
+  float val1 = float(bfloat16(__bfloat16_raw(0x3f80)));
+  float val2 = float(bfloat16(__bfloat16_raw(0x3f81)));
+  float val3 = float(bfloat16(__bfloat16_raw(0x3f82)));
+  VERIFY_IS_EQUAL(bfloat16(0.5f * (val1 + val2)).value, 0x3f80);
+  VERIFY_IS_EQUAL(bfloat16(0.5f * (val2 + val3)).value, 0x3f82);
+
+  // Conversion from int.
+  VERIFY_IS_EQUAL(bfloat16(-1).value, 0xbf80);
+  VERIFY_IS_EQUAL(bfloat16(0).value, 0x0000);
+  VERIFY_IS_EQUAL(bfloat16(1).value, 0x3f80);
+  VERIFY_IS_EQUAL(bfloat16(2).value, 0x4000);
+  VERIFY_IS_EQUAL(bfloat16(3).value, 0x4040);
+
+  // Conversion from bool.
+  VERIFY_IS_EQUAL(bfloat16(false).value, 0x0000);
+  VERIFY_IS_EQUAL(bfloat16(true).value, 0x3f80);
+
+  // Conversion to float, which is exact.
+  VERIFY_IS_EQUAL(float(bfloat16(__bfloat16_raw(0x0000))), 0.0f);
+  VERIFY_IS_EQUAL(float(bfloat16(__bfloat16_raw(0x3f80))), 1.0f);
+  VERIFY_IS_EQUAL(float(bfloat16(__bfloat16_raw(0xc2f7))), -123.5f);
+  VERIFY_IS_APPROX(bfloat16(__bfloat16_raw(0x0001)), bfloat16(9.18355e-41f));
+
+  // NaNs and infinities.
+  VERIFY(!(numext::isinf)(float(bfloat16(3.38953139e38f))));  // Largest finite number.
+  VERIFY(!(numext::isnan)(float(bfloat16(0.0f))));
+  VERIFY((numext::isinf)(float(bfloat16(__bfloat16_raw(0xff80)))));
+  VERIFY((numext::isnan)(float(bfloat16(__bfloat16_raw(0xff81)))));
+  VERIFY((numext::isinf)(float(bfloat16(__bfloat16_raw(0x7f80)))));
+  VERIFY((numext::isnan)(float(bfloat16(__bfloat16_raw(0x7f81)))));
+
+  // NaNs whose payload lies in the truncated bits must not become infinities.
+  VERIFY((numext::isnan)(bfloat16(std::numeric_limits<float>::signaling_NaN())));
+  const unsigned int nan_bits = 0x7f800001u;
+  float nan_low_payload;
+  std::memcpy(&nan_low_payload, &nan_bits, sizeof(float));
+  VERIFY((numext::isnan)(bfloat16(nan_low_payload)));
+
+  // Exactly same checks as above, just directly on the bfloat16 representation.
+  VERIFY(!(numext::isinf)(bfloat16(__bfloat16_raw(0x7f7f))));
+  VERIFY(!(numext::isnan)(bfloat16(__bfloat16_raw(0x0000))));
+  VERIFY((numext::isinf)(bfloat16(__bfloat16_raw(0xff80))));
+  VERIFY((numext::isnan)(bfloat16(__bfloat16_raw(0xff81))));
+  VERIFY((numext::isinf)(bfloat16(__bfloat16_raw(0x7f80))));
+  VERIFY((numext::isnan)(bfloat16(__bfloat16_raw(0x7f81))));
+
+#if !EIGEN_COMP_MSVC
+  // Visual Studio errors out on divisions by 0
+  VERIFY((numext::isnan)(bfloat16(0.0 / 0.0)));
+  VERIFY((numext::isinf)(bfloat16(1.0 / 0.0)));
+  VERIFY((numext::isinf)(bfloat16(-1.0 / 0.0)));
+#endif
+}
+
+void test_numtraits()
+{
+  std::cout << "epsilon       = " << NumTraits<bfloat16>::epsilon() << "  (0x" << std::hex << NumTraits<bfloat16>::epsilon().value << ")" << std::endl;
+  std::cout << "highest       = " << NumTraits<bfloat16>::highest() << "  (0x" << std::hex << NumTraits<bfloat16>::highest().value << ")" << std::endl;
+  std::cout << "lowest        = " << NumTraits<bfloat16>::lowest() << "  (0x" << std::hex << NumTraits<bfloat16>::lowest().value << ")" << std::endl;
+  std::cout << "min           = " << (std::numeric_limits<bfloat16>::min)() << "  (0x" << std::hex << bfloat16((std::numeric_limits<bfloat16>::min)()).value << ")" << std::endl;
+  std::cout << "denorm min    = " << (std::numeric_limits<bfloat16>::denorm_min)() << "  (0x" << std::hex << bfloat16((std::numeric_limits<bfloat16>::denorm_min)()).value << ")" << std::endl;
+  std::cout << "infinity      = " << NumTraits<bfloat16>::infinity() << "  (0x" << std::hex << NumTraits<bfloat16>::infinity().value << ")" << std::endl;
+  std::cout << "quiet nan     = " << NumTraits<bfloat16>::quiet_NaN() << "  (0x" << std::hex << NumTraits<bfloat16>::quiet_NaN().value << ")" << std::endl;
+  std::cout << std::dec;
+
+  VERIFY(NumTraits<bfloat16>::IsSigned);
+
+  VERIFY_IS_EQUAL( std::numeric_limits<bfloat16>::infinity().value, bfloat16(std::numeric_limits<float>::infinity()).value );
+  VERIFY_IS_EQUAL( std::numeric_limits<bfloat16>::quiet_NaN().value, bfloat16(std::numeric_limits<float>::quiet_NaN()).value );
+  VERIFY_IS_EQUAL( float(NumTraits<bfloat16>::epsilon()), 1.f/128.f );
+  VERIFY_IS_EQUAL( float((std::numeric_limits<bfloat16>::min)()), (std::numeric_limits<float>::min)() );
+  VERIFY( (std::numeric_limits<bfloat16>::denorm_min)() > bfloat16(0.f) );
+  VERIFY( (std::numeric_limits<bfloat16>::min)()/bfloat16(2) > bfloat16(0.f) );
+  VERIFY_IS_EQUAL( (std::numeric_limits<bfloat16>::denorm_min)()/bfloat16(2), bfloat16(0.f) );
+}
+
+void test_arithmetic()
+{
+  VERIFY_IS_EQUAL(float(bfloat16(2) + bfloat16(2)), 4);
+  VERIFY_IS_EQUAL(float(bfloat16(2) + bfloat16(-2)), 0);
+  VERIFY_IS_APPROX(bfloat16(0.33333f) + bfloat16(0.66667f), bfloat16(1.0f));
+  VERIFY_IS_EQUAL(float(bfloat16(2.0f) * bfloat16(-5.5f)), -11.0f);
+  VERIFY_IS_APPROX(bfloat16(1.0f) / bfloat16(3.0f), bfloat16(0.33333f));
+  VERIFY_IS_EQUAL(float(-bfloat16(4096.0f)), -4096.0f);
+  VERIFY_IS_EQUAL(float(-bfloat16(-4096.0f)), 4096.0f);
+  // the range of float is preserved
+  VERIFY_IS_EQUAL(float(bfloat16(1e30f) * bfloat16(1e-30f)), 1.0f);
+}
+
+void test_comparison()
+{
+  VERIFY(bfloat16(1.0f) > bfloat16(0.5f));
+  VERIFY(bfloat16(0.5f) < bfloat16(1.0f));
+  VERIFY(!(bfloat16(1.0f) < bfloat16(0.5f)));
+  VERIFY(!(bfloat16(0.5f) > bfloat16(1.0f)));
+
+  VERIFY(!(bfloat16(4.0f) > bfloat16(4.0f)));
+  VERIFY(!(bfloat16(4.0f) < bfloat16(4.0f)));
+
+  VERIFY(!(bfloat16(0.0f) < bfloat16(-0.0f)));
+  VERIFY(!(bfloat16(-0.0f) < bfloat16(0.0f)));
+  VERIFY(!(bfloat16(0.0f) > bfloat16(-0.0f)));
+  VERIFY(!(bfloat16(-0.0f) > bfloat16(0.0f)));
+
+  VERIFY(bfloat16(0.2f) > bfloat16(-1.0f));
+  VERIFY(bfloat16(-1.0f) < bfloat16(0.2f));
+  VERIFY(bfloat16(-16.0f) < bfloat16(-15.0f));
+
+  VERIFY(bfloat16(1.0f) == bfloat16(1.0f));
+  VERIFY(bfloat16(1.0f) != bfloat16(2.0f));
+
+#if !EIGEN_COMP_MSVC
+  // Visual Studio errors out on divisions by 0
+  VERIFY(!(bfloat16(0.0 / 0.0) == bfloat16(0.0 / 0.0)));
+  VERIFY(bfloat16(0.0 / 0.0) != bfloat16(0.0 / 0.0));
+
+  VERIFY(!(bfloat16(1.0) == bfloat16(0.0 / 0.0)));
+  VERIFY(!(bfloat16(1.0) < bfloat16(0.0 / 0.0)));
+  VERIFY(!(bfloat16(1.0) > bfloat16(0.0 / 0.0)));
+  VERIFY(bfloat16(1.0) != bfloat16(0.0 / 0.0));
+
+  VERIFY(bfloat16(1.0) < bfloat16(1.0 / 0.0));
+  VERIFY(bfloat16(1.0) > bfloat16(-1.0 / 0.0));
+#endif
+}
+
+void test_basic_functions()
+{
+  VERIFY_IS_EQUAL(float(numext::abs(bfloat16(3.5f))), 3.5f);
+  VERIFY_IS_EQUAL(float(abs(bfloat16(-3.5f))), 3.5f);
+
+  VERIFY_IS_EQUAL(float(numext::floor(bfloat16(3.5f))), 3.0f);
+  VERIFY_IS_EQUAL(float(floor(bfloat16(-3.5f))), -4.0f);
+
+  VERIFY_IS_EQUAL(float(numext::ceil(bfloat16(3.5f))), 4.0f);
+  VERIFY_IS_EQUAL(float(ceil(bfloat16(-3.5f))), -3.0f);
+
+  VERIFY_IS_APPROX(numext::sqrt(bfloat16(0.0f)), bfloat16(0.0f));
+  VERIFY_IS_APPROX(sqrt(bfloat16(4.0f)), bfloat16(2.0f));
+
+  VERIFY_IS_APPROX(numext::pow(bfloat16(0.0f), bfloat16(1.0f)), bfloat16(0.0f));
+  VERIFY_IS_APPROX(pow(bfloat16(2.0f), bfloat16(2.0f)), bfloat16(4.0f));
+
+  VERIFY_IS_EQUAL(float(numext::exp(bfloat16(0.0f))), 1.0f);
+  VERIFY_IS_APPROX(exp(bfloat16(EIGEN_PI)), bfloat16(20.f + float(EIGEN_PI)));
+
+  VERIFY_IS_EQUAL(float(numext::expm1(bfloat16(0.0f))), 0.0f);
+  VERIFY_IS_APPROX(expm1(bfloat16(2.0f)), bfloat16(6.3890561f));
+
+  VERIFY_IS_EQUAL(float(numext::log(bfloat16(1.0f))), 0.0f);
+  VERIFY_IS_APPROX(log(bfloat16(10.0f)), bfloat16(2.30273f));
+
+  VERIFY_IS_EQUAL(float(numext::log1p(bfloat16(0.0f))), 0.0f);
+  VERIFY_IS_APPROX(log1p(bfloat16(10.0f)), bfloat16(2.3978953f));
+
+  VERIFY_IS_APPROX(numext::cos(bfloat16(3.5f)), bfloat16(cosf(3.5f)));
+  VERIFY_IS_APPROX(numext::sin(bfloat16(3.5f)), bfloat16(sinf(3.5f)));
+  VERIFY_IS_APPROX(numext::tan(bfloat16(3.5f)), bfloat16(tanf(3.5f)));
+}
+
+void test_array()
+{
+  typedef Array<bfloat16,1,Dynamic> ArrayXbf;
+  Index size = internal::random<Index>(1,10);
+  Index i = internal::random<Index>(0,size-1);
+  ArrayXbf a1 = ArrayXbf::Random(size), a2 = ArrayXbf::Random(size);
+  VERIFY_IS_APPROX( a1+a1, bfloat16(2)*a1 );
+  VERIFY( (a1.abs() >= bfloat16(0)).all() );
+  VERIFY_IS_APPROX( (a1*a1).sqrt(), a1.abs() );
+
+  VERIFY( ((a1.min)(a2) <= (a1.max)(a2)).all() );
+  a1(i) = bfloat16(-10.);
+  VERIFY_IS_EQUAL( a1.minCoeff(), bfloat16(-10.) );
+  a1(i) = bfloat16(10.);
+  VERIFY_IS_EQUAL( a1.maxCoeff(), bfloat16(10.) );
+
+  std::stringstream ss;
+  ss << a1;
+
+  // large enough arrays to exercise the packet paths, which compute in float
+  typedef Array<bfloat16,Dynamic,1> ArrayXbfc;
+  size = internal::random<Index>(1,200);
+  ArrayXbfc b1 = ArrayXbfc::Random(size), b2 = ArrayXbfc::Random(size) + bfloat16(2);
+  ArrayXf f1 = b1.cast<float>(), f2 = b2.cast<float>();
+  VERIFY( ((-b1).cast<float>() == -f1).all() );
+  VERIFY( (b1.abs().cast<float>() == f1.abs()).all() );
+  VERIFY( ((b1+b2) == (f1+f2).cast<bfloat16>()).all() );
+  VERIFY( ((b1*b2) == (f1*f2).cast<bfloat16>()).all() );
+  VERIFY( ((b1/b2) == (f1/f2).cast<bfloat16>()).all() );
+  VERIFY( ((b1.min)(b2).cast<float>() == (f1.min)(f2)).all() );
+  VERIFY( ((b1.max)(b2).cast<float>() == (f1.max)(f2)).all() );
+  VERIFY_IS_APPROX( b2.sqrt(), f2.sqrt().cast<bfloat16>() );
+  VERIFY_IS_APPROX( b1.exp(), f1.exp().cast<bfloat16>() );
+  VERIFY_IS_APPROX( b2.log(), f2.log().cast<bfloat16>() );
+  VERIFY_IS_EQUAL( b1.minCoeff(), bfloat16(f1.minCoeff()) );
+  VERIFY_IS_EQUAL( b1.maxCoeff(), bfloat16(f1.maxCoeff()) );
+  VERIFY_IS_APPROX( b1.abs().sum(), bfloat16(f1.abs().sum()) );
+}
+
+void test_product()
+{
+  typedef Matrix<bfloat16,Dynamic,Dynamic> MatrixXbf;
+  Index rows  = internal::random<Index>(1,EIGEN_TEST_MAX_SIZE);
+  Index cols  = internal::random<Index>(1,EIGEN_TEST_MAX_SIZE);
+  Index depth = internal::random<Index>(1,EIGEN_TEST_MAX_SIZE);
+  MatrixXbf Ab = MatrixXbf::Random(rows,depth);
+  MatrixXbf Bb = MatrixXbf::Random(depth,cols);
+  MatrixXbf Cb = MatrixXbf::Random(rows,cols);
+  MatrixXf Af = Ab.cast<float>();
+  MatrixXf Bf = Bb.cast<float>();
+  MatrixXf Cf = Cb.cast<float>();
+  VERIFY_IS_APPROX(Cb.noalias()+=Ab*Bb, (Cf.noalias()+=Af*Bf).cast<bfloat16>());
+
+  Matrix<bfloat16,Dynamic,Dynamic,RowMajor> Db = Ab.transpose();
+  VERIFY_IS_APPROX(Cb.noalias()=Db.transpose()*Bb, (Af*Bf).cast<bfloat16>());
+  VERIFY_IS_APPROX(Cb.noalias()=bfloat16(-2)*Ab*Bb, (-2.f*Af*Bf).cast<bfloat16>());
+
+  // the matrix products accumulate in float: 4096 is exact while bfloat16(256)+bfloat16(1)==bfloat16(256)
+  MatrixXbf Eb = MatrixXbf::Ones(8,4096) * MatrixXbf::Ones(4096,9);
+  VERIFY_IS_EQUAL(Eb, MatrixXbf::Constant(8,9,bfloat16(4096)));
+}
+
+EIGEN_DECLARE_TEST(bfloat16_float)
+{
+  CALL_SUBTEST(test_numtraits());
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST(test_conversion());
+    CALL_SUBTEST(test_arithmetic());
+    CALL_SUBTEST(test_comparison());
+    CALL_SUBTEST(test_basic_functions());
+    CALL_SUBTEST(test_array());
+    CALL_SUBTEST(test_product());
+  }
+}
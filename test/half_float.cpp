@@ -109,7 +109,12 @@ void test_numtraits()
 
   VERIFY_IS_EQUAL( std::numeric_limits<half>::infinity().x, half(std::numeric_limits<float>::infinity()).x );
   VERIFY_IS_EQUAL( std::numeric_limits<half>::quiet_NaN().x, half(std::numeric_limits<float>::quiet_NaN()).x );
+#ifdef EIGEN_HAS_FP16_C
+  // the F16C conversions quieten signaling NaNs, as required by IEEE 754
+  VERIFY( (numext::isnan)(half(std::numeric_limits<float>::signaling_NaN())) );
+#else
   VERIFY_IS_EQUAL( std::numeric_limits<half>::signaling_NaN().x, half(std::numeric_limits<float>::signaling_NaN()).x );
+#endif
   VERIFY( (std::numeric_limits<half>::min)() > half(0.f) );
   VERIFY( (std::numeric_limits<half>::denorm_min)() > half(0.f) );
   VERIFY( (std::numeric_limits<half>::min)()/half(2) > half(0.f) );
@@ -255,6 +260,23 @@ void test_array()
 
   std::stringstream ss;
   ss << a1;
+
+  // large enough arrays to exercise the packet paths, which compute in float
+  typedef Array<half,Dynamic,1> ArrayXhc;
+  size = internal::random<Index>(1,200);
+  ArrayXhc b1 = ArrayXhc::Random(size), b2 = ArrayXhc::Random(size) + half(2);
+  ArrayXf f1 = b1.cast<float>(), f2 = b2.cast<float>();
+  VERIFY( ((-b1).cast<float>() == -f1).all() );
+  VERIFY( (b1.abs().cast<float>() == f1.abs()).all() );
+  VERIFY( ((b1/b2) == (f1/f2).cast<half>()).all() );
+  VERIFY( ((b1.min)(b2).cast<float>() == (f1.min)(f2)).all() );
+  VERIFY( ((b1.max)(b2).cast<float>() == (f1.max)(f2)).all() );
+  VERIFY_IS_APPROX( b2.sqrt(), f2.sqrt().cast<half>() );
+  VERIFY_IS_APPROX( b1.exp(), f1.exp().cast<half>() );
+  VERIFY_IS_APPROX( b2.log(), f2.log().cast<half>() );
+  VERIFY_IS_EQUAL( b1.minCoeff(), half(f1.minCoeff()) );
+  VERIFY_IS_EQUAL( b1.maxCoeff(), half(f1.maxCoeff()) );
+  VERIFY_IS_APPROX( b1.abs().sum(), half(f1.abs().sum()) );
 }
 
 void test_product()
@@ -270,6 +292,13 @@ void test_product()
   MatrixXf Bf = Bh.cast<float>();
   MatrixXf Cf = Ch.cast<float>();
   VERIFY_IS_APPROX(Ch.noalias()+=Ah*Bh, (Cf.noalias()+=Af*Bf).cast<half>());
+
+  Matrix<half,Dynamic,Dynamic,RowMajor> Dh = Ah.transpose();
+  VERIFY_IS_APPROX(Ch.noalias()=Dh.transpose()*Bh, (Af*Bf).cast<half>());
+
+  // the matrix products accumulate in float: 4096 is exact while half(2048)+half(1)==half(2048)
+  MatrixXh Eh = MatrixXh::Ones(8,4096) * MatrixXh::Ones(4096,9);
+  VERIFY_IS_EQUAL(Eh, MatrixXh::Constant(8,9,half(4096)));
 }
 
 EIGEN_DECLARE_TEST(half_float)
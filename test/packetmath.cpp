@@ -636,10 +636,13 @@ EIGEN_DECLARE_TEST(packetmath)
     CALL_SUBTEST_4( packetmath<std::complex<float> >() );
     CALL_SUBTEST_5( packetmath<std::complex<double> >() );
     CALL_SUBTEST_6( packetmath<half>() );
+    CALL_SUBTEST_7( packetmath<bfloat16>() );
 
     CALL_SUBTEST_1( packetmath_notcomplex<float>() );
     CALL_SUBTEST_2( packetmath_notcomplex<double>() );
     CALL_SUBTEST_3( packetmath_notcomplex<int>() );
+    CALL_SUBTEST_6( packetmath_notcomplex<half>() );
+    CALL_SUBTEST_7( packetmath_notcomplex<bfloat16>() );
 
     CALL_SUBTEST_1( packetmath_real<float>() );
     CALL_SUBTEST_2( packetmath_real<double>() );
@@ -0,0 +1,67 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "main.h"
+#include <vector>
+
+template<typename DstType, typename LhsType, typename RhsType>
+void batched_product(Index count)
+{
+  std::vector<LhsType,aligned_allocator<LhsType> > lhs(count);
+  std::vector<RhsType,aligned_allocator<RhsType> > rhs(count);
+  std::vector<DstType,aligned_allocator<DstType> > dst(count);
+  for(Index b=0; b<count; ++b)
+  {
+    lhs[b].setRandom();
+    rhs[b].setRandom();
+  }
+
+  batchedProduct(&dst[0], &lhs[0], &rhs[0], count);
+  for(Index b=0; b<count; ++b)
+    VERIFY_IS_APPROX(dst[b], (lhs[b].lazyProduct(rhs[b])).eval());
+}
+
+// operands interleaved in a single buffer, like the slices of a 3D tensor
+template<typename MatrixType>
+void batched_product_strided(Index count)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef Matrix<Scalar,Dynamic,1> VectorType;
+  const Index size = MatrixType::SizeAtCompileTime;
+  const Index stride = 3*size + 1;
+  VectorType buffer = VectorType::Random(stride*count);
+  VectorType pristine = buffer;
+
+  batchedProduct(Map<MatrixType>(buffer.data() + 2*size), stride,
+                 Map<const MatrixType>(buffer.data()), stride,
+                 Map<const MatrixType>(buffer.data() + size), stride, count);
+  for(Index b=0; b<count; ++b)
+  {
+    const Scalar* base = pristine.data() + b*stride;
+    MatrixType ref = Map<const MatrixType>(base).lazyProduct(Map<const MatrixType>(base + size));
+    VERIFY_IS_APPROX(Map<MatrixType>(buffer.data() + b*stride + 2*size), ref);
+    VERIFY_IS_EQUAL(buffer(b*stride + 3*size), pristine(b*stride + 3*size));
+  }
+}
+
+EIGEN_DECLARE_TEST(product_batched)
+{
+  for(int i = 0; i < g_repeat; i++) {
+    Index count = internal::random<Index>(1,100);
+    CALL_SUBTEST_1(( batched_product<Matrix4f,Matrix4f,Matrix4f>(count) ));
+    CALL_SUBTEST_1(( batched_product<Matrix3f,Matrix3f,Matrix3f>(count) ));
+    CALL_SUBTEST_1(( batched_product<Matrix<float,5,2>,Matrix<float,5,7>,Matrix<float,7,2,RowMajor> >(count) ));
+    CALL_SUBTEST_2(( batched_product<Matrix<double,8,8>,Matrix<double,8,8,RowMajor>,Matrix<double,8,8> >(count) ));
+    CALL_SUBTEST_2(( batched_product<Matrix<double,3,1>,Matrix3d,Matrix<double,3,1> >(count) ));
+    CALL_SUBTEST_3(( batched_product<Matrix<float,32,32>,Matrix<float,32,32>,Matrix<float,32,32> >((std::min)(count, Index(20))) ));
+    CALL_SUBTEST_4(( batched_product<Matrix2cd,Matrix2cd,Matrix2cd>(count) ));
+    CALL_SUBTEST_4(( batched_product<Matrix<std::complex<float>,4,4,RowMajor>,Matrix4cf,Matrix4cf>(count) ));
+    CALL_SUBTEST_5(( batched_product<Matrix<int,6,6>,Matrix<int,6,6>,Matrix<int,6,6> >(count) ));
+    CALL_SUBTEST_6(( batched_product_strided<Matrix4f>(count) ));
+    CALL_SUBTEST_6(( batched_product_strided<Matrix<double,6,6,RowMajor> >(count) ));
+  }
+}
@@ -0,0 +1,107 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "main.h"
+
+template<typename LhsType, typename RhsType>
+void prepacked_product(Index rows, Index cols, Index depth)
+{
+  typedef typename LhsType::Scalar Scalar;
+  typedef Matrix<Scalar,Dynamic,Dynamic> ColMajorMatrix;
+  typedef Matrix<Scalar,Dynamic,Dynamic,RowMajor> RowMajorMatrix;
+
+  LhsType lhs = LhsType::Random(rows, depth);
+  RhsType rhs = RhsType::Random(depth, cols);
+  Scalar alpha = internal::random<Scalar>();
+
+  PrepackedLhs<LhsType> packed(lhs);
+  VERIFY_IS_EQUAL(packed.rows(), rows);
+  VERIFY_IS_EQUAL(packed.cols(), depth);
+
+  ColMajorMatrix res = packed * rhs;
+  ColMajorMatrix ref = lhs * rhs;
+  VERIFY_IS_APPROX(res, ref);
+
+  RowMajorMatrix resr(rows, cols);
+  resr.noalias() = packed * rhs;
+  VERIFY_IS_APPROX(resr, ref);
+
+  // accumulation, scaling and conjugation of the rhs
+  ColMajorMatrix res2 = ColMajorMatrix::Random(rows, cols);
+  ColMajorMatrix ref2 = res2;
+  packed.scaleAndAddTo(res2, (Scalar(2)*rhs).conjugate(), alpha);
+  ref2.noalias() += alpha * lhs * (Scalar(2)*rhs).conjugate();
+  VERIFY_IS_APPROX(res2, ref2);
+
+  // sub-blocks of the destination and of the rhs, and a packed sub-matrix
+  Index c = cols/2, d = depth/2;
+  res.leftCols(c) = packed * rhs.leftCols(c);
+  VERIFY_IS_APPROX(res.leftCols(c), lhs * rhs.leftCols(c));
+  PrepackedLhs<LhsType> packedBlock(lhs.rightCols(d));
+  ColMajorMatrix res3 = packedBlock * rhs.bottomRows(d);
+  VERIFY_IS_APPROX(res3, lhs.rightCols(d) * rhs.bottomRows(d));
+
+  // the packed matrix is reused
+  rhs.setRandom();
+  res = packed * rhs;
+  VERIFY_IS_APPROX(res, lhs * rhs);
+
+  // the destination aliases the rhs
+  typedef Matrix<Scalar,Dynamic,Dynamic,LhsType::IsRowMajor?RowMajor:ColMajor> SquareType;
+  SquareType square = SquareType::Random(depth, depth);
+  PrepackedLhs<SquareType> packedSquare(square);
+  ColMajorMatrix y = ColMajorMatrix::Random(depth, cols);
+  ColMajorMatrix refy = square * y;
+  y = packedSquare * y;
+  VERIFY_IS_APPROX(y, refy);
+  refy = square * (Scalar(2) * y);
+  y = packedSquare * (Scalar(2) * y);
+  VERIFY_IS_APPROX(y, refy);
+  refy = square * (y + y);
+  y = packedSquare * (y + y);
+  VERIFY_IS_APPROX(y, refy);
+
+  // a destination with a non unit inner stride
+  ColMajorMatrix z = ColMajorMatrix::Zero(2*rows, cols);
+  Map<ColMajorMatrix, 0, Stride<Dynamic,2> > zmap(z.data(), rows, cols, Stride<Dynamic,2>(2*rows, 2));
+  zmap = packed * rhs;
+  VERIFY_IS_APPROX(ColMajorMatrix(zmap), lhs * rhs);
+}
+
+template<typename Scalar>
+void prepacked_product_blocking(Index rows, Index cols, Index depth)
+{
+  // odd blocking sizes exercise the alignment of the packed blocks
+  typedef Matrix<Scalar,Dynamic,Dynamic> MatrixType;
+  clearProductBlockingSizes();
+  setProductBlockingSizes<Scalar,Scalar>(depth, rows, cols, 13, 7, 5);
+  setProductBlockingSizes<Scalar,Scalar>(depth, rows, rows, 13, 7, 5);
+  prepacked_product<MatrixType,MatrixType>(rows, cols, depth);
+  clearProductBlockingSizes();
+}
+
+EIGEN_DECLARE_TEST(product_prepacked)
+{
+  for(int i = 0; i < g_repeat; i++) {
+    Index rows  = internal::random<Index>(1,EIGEN_TEST_MAX_SIZE);
+    Index cols  = internal::random<Index>(1,EIGEN_TEST_MAX_SIZE);
+    Index depth = internal::random<Index>(1,EIGEN_TEST_MAX_SIZE);
+    TEST_SET_BUT_UNUSED_VARIABLE(rows)
+    TEST_SET_BUT_UNUSED_VARIABLE(cols)
+    TEST_SET_BUT_UNUSED_VARIABLE(depth)
+    CALL_SUBTEST_1(( prepacked_product<MatrixXf,MatrixXf>(rows, cols, depth) ));
+    CALL_SUBTEST_1(( prepacked_product<Matrix<float,Dynamic,Dynamic,RowMajor>,MatrixXf>(rows, cols, depth) ));
+    CALL_SUBTEST_2(( prepacked_product<MatrixXd,Matrix<double,Dynamic,Dynamic,RowMajor> >(rows, cols, depth) ));
+    CALL_SUBTEST_3(( prepacked_product<MatrixXcf,MatrixXcf>(rows, cols, depth) ));
+    CALL_SUBTEST_4(( prepacked_product<Matrix<std::complex<double>,Dynamic,Dynamic,RowMajor>,MatrixXcd>(rows, cols, depth) ));
+    CALL_SUBTEST_5(( prepacked_product<Matrix<float,40,30>,MatrixXf>(40, cols, 30) ));
+  }
+  CALL_SUBTEST_6(( prepacked_product_blocking<float>(internal::random<Index>(64,200), internal::random<Index>(64,200), internal::random<Index>(64,200)) ));
+  CALL_SUBTEST_6(( prepacked_product_blocking<double>(internal::random<Index>(64,200), internal::random<Index>(64,200), internal::random<Index>(64,200)) ));
+  CALL_SUBTEST_1(( prepacked_product<MatrixXf,MatrixXf>(500, 300, 700) ));
+  CALL_SUBTEST_2(( prepacked_product<MatrixXd,MatrixXd>(600, 200, 500) ));
+}
@@ -0,0 +1,102 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "main.h"
+
+template<typename MatrixType>
+MatrixType random_matrix(Index rows, Index cols, int low, int high)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  MatrixType m(rows, cols);
+  for(Index j=0; j<cols; ++j)
+    for(Index i=0; i<rows; ++i)
+      m(i,j) = Scalar(internal::random<int>(low, high));
+  return m;
+}
+
+template<typename LhsType, typename RhsType>
+void widened_product(Index rows, Index cols, Index depth, int low, int high)
+{
+  typedef Matrix<int,Dynamic,Dynamic> ColMajorMatrix;
+  typedef Matrix<int,Dynamic,Dynamic,RowMajor> RowMajorMatrix;
+
+  LhsType lhs = random_matrix<LhsType>(rows, depth, low, high);
+  RhsType rhs = random_matrix<RhsType>(depth, cols, low, high);
+  ColMajorMatrix ref = lhs.template cast<int>() * rhs.template cast<int>();
+
+  ColMajorMatrix res = widenedProduct<int>(lhs, rhs);
+  VERIFY_IS_EQUAL(res, ref);
+
+  RowMajorMatrix resr = widenedProduct<int>(lhs, rhs);
+  VERIFY_IS_EQUAL(resr, ref);
+
+  // accumulation
+  ColMajorMatrix res2 = random_matrix<ColMajorMatrix>(rows, cols, -1000, 1000);
+  ColMajorMatrix ref2 = res2 + ref;
+  widenedProduct<int>(lhs, rhs).addTo(res2);
+  VERIFY_IS_EQUAL(res2, ref2);
+
+  // sub-blocks and vectors
+  Index c = cols/2, d = depth/2;
+  res.leftCols(c) = widenedProduct<int>(lhs.rightCols(d), rhs.bottomRows(d).leftCols(c));
+  VERIFY_IS_EQUAL(res.leftCols(c), (lhs.rightCols(d).template cast<int>() * rhs.bottomRows(d).leftCols(c).template cast<int>()));
+  VectorXi v = widenedProduct<int>(lhs, rhs.col(0));
+  VERIFY_IS_EQUAL(v, ref.col(0));
+  RowVectorXi w = widenedProduct<int>(lhs.row(0), rhs);
+  VERIFY_IS_EQUAL(w, ref.row(0));
+
+  // destinations with a non unit inner stride
+  ColMajorMatrix z = ColMajorMatrix::Zero(2*rows, cols);
+  Map<ColMajorMatrix, 0, Stride<Dynamic,2> > zmap(z.data(), rows, cols, Stride<Dynamic,2>(2*rows, 2));
+  zmap = widenedProduct<int>(lhs, rhs);
+  VERIFY_IS_EQUAL(ColMajorMatrix(zmap), ref);
+  ColMajorMatrix t = ColMajorMatrix::Zero(2, rows);
+  t.row(1).transpose() = widenedProduct<int>(lhs, rhs.col(0));
+  VERIFY_IS_EQUAL(t.row(1).transpose(), ref.col(0));
+  VERIFY_IS_EQUAL((widenedProduct<int>(lhs.transpose(), lhs).eval()), (lhs.transpose().template cast<int>() * lhs.template cast<int>()));
+
+  // other accumulation types go through the casted product
+  Matrix<double,Dynamic,Dynamic> resd = widenedProduct<double>(lhs, rhs);
+  VERIFY_IS_APPROX(resd, ref.template cast<double>());
+}
+
+// the sums of the pairs of products wrap around on overflow, as pmaddwd does
+void pmaddpairs_overflow()
+{
+  const int minPairs = int(0x80008000u);
+  VERIFY_IS_EQUAL(internal::pmaddpairs<int>(minPairs, minPairs, 0), (std::numeric_limits<int>::min)());
+  VERIFY_IS_EQUAL(internal::pmaddpairs<int>(minPairs, minPairs, -1), (std::numeric_limits<int>::max)());
+  VERIFY_IS_EQUAL(internal::pmaddpairs<int>(minPairs, 0x00010001, 7), 7-65536);
+}
+
+typedef Matrix<signed char,Dynamic,Dynamic> MatrixXs8;
+typedef Matrix<signed char,Dynamic,Dynamic,RowMajor> RowMatrixXs8;
+typedef Matrix<unsigned char,Dynamic,Dynamic> MatrixXu8;
+typedef Matrix<short,Dynamic,Dynamic> MatrixXs16;
+typedef Matrix<short,Dynamic,Dynamic,RowMajor> RowMatrixXs16;
+
+EIGEN_DECLARE_TEST(product_widened)
+{
+  for(int i = 0; i < g_repeat; i++) {
+    Index rows  = internal::random<Index>(1,EIGEN_TEST_MAX_SIZE);
+    Index cols  = internal::random<Index>(1,EIGEN_TEST_MAX_SIZE);
+    Index depth = internal::random<Index>(1,EIGEN_TEST_MAX_SIZE);
+    TEST_SET_BUT_UNUSED_VARIABLE(rows)
+    TEST_SET_BUT_UNUSED_VARIABLE(depth)
+    CALL_SUBTEST_1(( widened_product<MatrixXs8,MatrixXs8>(rows, cols, depth, -128, 127) ));
+    CALL_SUBTEST_1(( widened_product<RowMatrixXs8,MatrixXs8>(rows, cols, depth, -128, 127) ));
+    CALL_SUBTEST_2(( widened_product<MatrixXu8,MatrixXu8>(rows, cols, depth, 0, 255) ));
+    CALL_SUBTEST_2(( widened_product<MatrixXu8,RowMatrixXs8>(rows, cols, depth, 0, 127) ));
+    CALL_SUBTEST_3(( widened_product<MatrixXs16,RowMatrixXs16>(rows, cols, depth, -2000, 2000) ));
+    CALL_SUBTEST_3(( widened_product<MatrixXs16,MatrixXs8>(rows, cols, depth, -128, 127) ));
+    CALL_SUBTEST_4(( widened_product<Matrix<signed char,13,7>,MatrixXs8>(13, cols, 7, -128, 127) ));
+  }
+  // depths larger than a packed block, odd and even
+  CALL_SUBTEST_1(( widened_product<MatrixXs8,MatrixXs8>(67, 45, 1031, -128, 127) ));
+  CALL_SUBTEST_3(( widened_product<MatrixXs16,MatrixXs16>(33, 21, 1024, -1000, 1000) ));
+  CALL_SUBTEST_4( pmaddpairs_overflow() );
+}
@@ -0,0 +1,98 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#define EIGEN_USE_RUNTIME_DISPATCH
+#include "main.h"
+
+template<typename Scalar, int LhsOrder, int RhsOrder>
+void dispatched_gemm(Index rows, Index cols, Index depth)
+{
+  typedef Matrix<Scalar,Dynamic,Dynamic,LhsOrder> LhsType;
+  typedef Matrix<Scalar,Dynamic,Dynamic,RhsOrder> RhsType;
+  typedef Matrix<Scalar,Dynamic,Dynamic> ResType;
+  LhsType lhs = LhsType::Random(rows, depth);
+  RhsType rhs = RhsType::Random(depth, cols);
+  ResType res = ResType::Random(rows, cols);
+  ResType ref = res;
+  Scalar alpha = internal::random<Scalar>();
+
+  res.noalias() += alpha * lhs * rhs;
+  ref.noalias() += alpha * lhs.lazyProduct(rhs);
+  VERIFY_IS_APPROX(res, ref);
+
+  // row major destination and sub-blocks
+  Matrix<Scalar,Dynamic,Dynamic,RowMajor> resr(rows, cols);
+  resr.noalias() = lhs * rhs;
+  VERIFY_IS_APPROX(resr, lhs.lazyProduct(rhs));
+  Index r = rows/2, c = cols/2, d = depth/2;
+  res.topLeftCorner(r, c).noalias() = lhs.topRightCorner(r, d) * rhs.bottomLeftCorner(d, c);
+  VERIFY_IS_APPROX(res.topLeftCorner(r, c), lhs.topRightCorner(r, d).lazyProduct(rhs.bottomLeftCorner(d, c)));
+}
+
+template<typename Scalar, int LhsOrder>
+void dispatched_gemv(Index rows, Index cols)
+{
+  typedef Matrix<Scalar,Dynamic,Dynamic,LhsOrder> LhsType;
+  typedef Matrix<Scalar,Dynamic,1> VectorType;
+  LhsType lhs = LhsType::Random(rows, cols);
+  VectorType rhs = VectorType::Random(cols);
+  VectorType res = VectorType::Random(rows);
+  VectorType ref = res;
+  Scalar alpha = internal::random<Scalar>();
+
+  res.noalias() += alpha * lhs * rhs;
+  ref.noalias() += alpha * lhs.lazyProduct(rhs);
+  VERIFY_IS_APPROX(res, ref);
+
+  // strided operands
+  Matrix<Scalar,Dynamic,Dynamic> tmp = Matrix<Scalar,Dynamic,Dynamic>::Random(3, (std::max)(rows, cols));
+  tmp.row(1).head(rows).noalias() = (lhs * tmp.row(0).head(cols).transpose()).transpose();
+  VERIFY_IS_APPROX(tmp.row(1).head(rows), (lhs.lazyProduct(tmp.row(0).head(cols).transpose())).transpose());
+  VectorType resT = lhs.transpose() * res;
+  VERIFY_IS_APPROX(resT, lhs.transpose().lazyProduct(res));
+}
+
+// a product run by a static initializer, possibly before the kernels of the variant are registered
+static const MatrixXf static_product = MatrixXf::Ones(64, 48) * MatrixXf::Ones(48, 32);
+
+void dispatch_selection()
+{
+  VERIFY_IS_EQUAL(static_product, MatrixXf::Constant(64, 32, 48));
+  // runtime_dispatch_variant.cpp registers its kernels from a static initializer
+  VERIFY(eigen_dispatch_slot(EIGEN_DISPATCH_ISA_AVX2_FMA)!=0);
+  const eigen_dispatch_kernels* kernels = internal::dispatchKernels();
+  if(internal::queryDispatchInstructionSet()>=EIGEN_DISPATCH_ISA_AVX2_FMA && EIGEN_DISPATCH_COMPILED_ISA<EIGEN_DISPATCH_ISA_AVX2_FMA)
+  {
+    VERIFY(kernels!=0);
+    VERIFY(kernels->isa==EIGEN_DISPATCH_ISA_AVX2_FMA);
+  }
+  else
+    VERIFY(kernels==0);
+}
+
+EIGEN_DECLARE_TEST(runtime_dispatch)
+{
+  CALL_SUBTEST_1( dispatch_selection() );
+  for(int i = 0; i < g_repeat; i++) {
+    Index rows  = internal::random<Index>(1,EIGEN_TEST_MAX_SIZE);
+    Index cols  = internal::random<Index>(1,EIGEN_TEST_MAX_SIZE);
+    Index depth = internal::random<Index>(1,EIGEN_TEST_MAX_SIZE);
+    TEST_SET_BUT_UNUSED_VARIABLE(rows)
+    TEST_SET_BUT_UNUSED_VARIABLE(cols)
+    TEST_SET_BUT_UNUSED_VARIABLE(depth)
+    CALL_SUBTEST_2(( dispatched_gemm<float,ColMajor,ColMajor>(rows, cols, depth) ));
+    CALL_SUBTEST_2(( dispatched_gemm<float,RowMajor,ColMajor>(rows, cols, depth) ));
+    CALL_SUBTEST_2(( dispatched_gemm<float,ColMajor,RowMajor>(rows, cols, depth) ));
+    CALL_SUBTEST_2(( dispatched_gemm<float,RowMajor,RowMajor>(rows, cols, depth) ));
+    CALL_SUBTEST_3(( dispatched_gemm<double,ColMajor,ColMajor>(rows, cols, depth) ));
+    CALL_SUBTEST_3(( dispatched_gemm<double,RowMajor,RowMajor>(rows, cols, depth) ));
+    CALL_SUBTEST_4(( dispatched_gemv<float,ColMajor>(rows, cols) ));
+    CALL_SUBTEST_4(( dispatched_gemv<float,RowMajor>(rows, cols) ));
+    CALL_SUBTEST_4(( dispatched_gemv<double,ColMajor>(rows, cols) ));
+    CALL_SUBTEST_4(( dispatched_gemv<double,RowMajor>(rows, cols) ));
+  }
+}
@@ -0,0 +1,9 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// Compiled with AVX2 and FMA enabled, see test/CMakeLists.txt
+#include <Eigen/RuntimeDispatch>
@@ -14,6 +14,17 @@ static long g_realloc_count = 0;
 
 #include "sparse.h"
 
+// orders triplets by outer index, and then by inner index
+template<bool IsRowMajor> struct triplet_storage_order_less
+{
+  template<typename TripletType>
+  bool operator()(const TripletType& a, const TripletType& b) const
+  {
+    if(IsRowMajor) return a.row()<b.row() || (a.row()==b.row() && a.col()<b.col());
+    else           return a.col()<b.col() || (a.col()==b.col() && a.row()<b.row());
+  }
+};
+
 template<typename SparseMatrixType> void sparse_basic(const SparseMatrixType& ref)
 {
   typedef typename SparseMatrixType::StorageIndex StorageIndex;
@@ -389,6 +400,16 @@ template<typename SparseMatrixType> void sparse_basic(const SparseMatrixType& re
     m.setFromTriplets(triplets.begin(), triplets.end(), [] (Scalar,Scalar b) { return b; });
     VERIFY_IS_APPROX(m, refMat_last);
 #endif
+
+    // sorted triplets, with the duplicates kept in their input order
+    std::stable_sort(triplets.begin(), triplets.end(), triplet_storage_order_less<SparseMatrixType::IsRowMajor>());
+    m.setFromSortedTriplets(triplets.begin(), triplets.end());
+    VERIFY(m.isCompressed());
+    VERIFY_IS_APPROX(m, refMat_sum);
+    m.setFromSortedTriplets(triplets.begin(), triplets.end(), std::multiplies<Scalar>());
+    VERIFY_IS_APPROX(m, refMat_prod);
+    m.setFromSortedTriplets(triplets.begin(), triplets.begin());
+    VERIFY_IS_EQUAL(m.nonZeros(), 0);
   }
   
   // test Map
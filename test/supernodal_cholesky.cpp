@@ -0,0 +1,64 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "sparse_solver.h"
+
+template<typename T, typename I> void test_supernodal_factor()
+{
+  // the factor of a 2D Laplacian has supernodes wider than one column, and must match the simplicial one
+  typedef SparseMatrix<T,0,I> SparseMatrixType;
+  const int n = internal::random<int>(5,20);
+  std::vector<Triplet<T,I> > triplets;
+  for(int i = 0; i < n; ++i)
+  {
+    for(int j = 0; j < n; ++j)
+    {
+      int k = i*n+j;
+      triplets.push_back(Triplet<T,I>(k,k,T(4)));
+      if(i>0) triplets.push_back(Triplet<T,I>(k,k-n,T(-1)));
+      if(j>0) triplets.push_back(Triplet<T,I>(k,k-1,T(-1)));
+    }
+  }
+  SparseMatrixType A(n*n,n*n);
+  A.setFromTriplets(triplets.begin(), triplets.end());
+
+  SupernodalLLT<SparseMatrixType, Lower> llt(A);
+  VERIFY(llt.info() == Success);
+  VERIFY(llt.supernodeCount() < A.cols());
+  SparseMatrixType L = llt.matrixL();
+  SparseMatrixType PAPt;
+  PAPt = A.template selfadjointView<Lower>().twistedBy(llt.permutationP());
+  SparseMatrixType LLt = L*L.adjoint();
+  VERIFY_IS_APPROX(LLt.toDense(), PAPt.toDense());
+}
+
+template<typename T, typename I> void test_supernodal_cholesky_T()
+{
+  typedef SparseMatrix<T,0,I> SparseMatrixType;
+  SupernodalLLT<SparseMatrixType, Lower> llt_colmajor_lower_amd;
+  SupernodalLLT<SparseMatrixType, Upper> llt_colmajor_upper_amd;
+  SupernodalLLT<SparseMatrixType, Lower, NaturalOrdering<I> > llt_colmajor_lower_nat;
+  SupernodalLLT<SparseMatrixType, Upper, NaturalOrdering<I> > llt_colmajor_upper_nat;
+
+  check_sparse_spd_solving(llt_colmajor_lower_amd);
+  check_sparse_spd_solving(llt_colmajor_upper_amd);
+
+  check_sparse_spd_determinant(llt_colmajor_lower_amd);
+  check_sparse_spd_determinant(llt_colmajor_upper_amd);
+
+  check_sparse_spd_solving(llt_colmajor_lower_nat, (std::min)(300,EIGEN_TEST_MAX_SIZE), 1000);
+  check_sparse_spd_solving(llt_colmajor_upper_nat, (std::min)(300,EIGEN_TEST_MAX_SIZE), 1000);
+
+  test_supernodal_factor<T,I>();
+}
+
+EIGEN_DECLARE_TEST(supernodal_cholesky)
+{
+  CALL_SUBTEST_1(( test_supernodal_cholesky_T<double,int>() ));
+  CALL_SUBTEST_2(( test_supernodal_cholesky_T<std::complex<double>, int>() ));
+  CALL_SUBTEST_3(( test_supernodal_cholesky_T<double,long int>() ));
+}
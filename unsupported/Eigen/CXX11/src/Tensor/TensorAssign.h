@@ -143,6 +143,18 @@ struct TensorEvaluator<const TensorAssignOp<LeftArgType, RightArgType>, Device>
     // by the rhs to the lhs.
     return m_rightImpl.evalSubExprsIfNeeded(m_leftImpl.data());
   }
+
+#ifdef EIGEN_USE_THREADS
+  template <typename EvalSubExprsCallback>
+  EIGEN_STRONG_INLINE void evalSubExprsIfNeededAsync(Scalar*, EvalSubExprsCallback done) {
+    eigen_assert(dimensions_match(m_leftImpl.dimensions(), m_rightImpl.dimensions()));
+    internal::eval_sub_exprs_async<TensorEvaluator<LeftArgType, Device> >::run(
+        m_leftImpl, nullptr, [this, done](bool) {
+          internal::eval_sub_exprs_async<TensorEvaluator<RightArgType, Device> >::run(
+              m_rightImpl, m_leftImpl.data(), [done](bool need_assign) { done(need_assign); });
+        });
+  }
+#endif  // EIGEN_USE_THREADS
   EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void cleanup() {
     m_leftImpl.cleanup();
     m_rightImpl.cleanup();
@@ -721,6 +721,12 @@ class TensorBase<Derived, ReadOnlyAccessors>
       return TensorTraceOp<const DimensionList<Index, NumDimensions>, const Derived>(derived(), in_dims);
     }
 
+    template <typename Dims> EIGEN_STRONG_INLINE
+    const TensorNormalizationOp<const Dims, const Derived>
+    normalize(const Dims& dims, const typename NumTraits<Scalar>::Real& epsilon = typename NumTraits<Scalar>::Real(0)) const {
+      return TensorNormalizationOp<const Dims, const Derived>(derived(), dims, epsilon);
+    }
+
     template <typename Broadcast> EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE
     const TensorBroadcastingOp<const Broadcast, const Derived>
     broadcast(const Broadcast& bcast) const {
@@ -1056,6 +1062,12 @@ class TensorBase : public TensorBase<Derived, ReadOnlyAccessors> {
       return TensorDevice<Derived, DeviceType>(dev, derived());
     }
 
+    // Select the async device on which to evaluate the expression.
+    template <typename DeviceType, typename DoneCallback>
+    TensorAsyncDevice<Derived, DeviceType, DoneCallback> device(const DeviceType& dev, DoneCallback done) {
+      return TensorAsyncDevice<Derived, DeviceType, DoneCallback>(dev, derived(), std::move(done));
+    }
+
  protected:
     EIGEN_DEVICE_FUNC
     EIGEN_STRONG_INLINE Derived& derived() { return *static_cast<Derived*>(this); }
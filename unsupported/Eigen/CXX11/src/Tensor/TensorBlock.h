@@ -155,6 +155,18 @@ struct TensorBlockCopyOp {
     typedef const Array<Scalar, Dynamic, 1> Src;
     typedef Array<Scalar, Dynamic, 1> Dst;
 
+    if (src_stride == 1 && dst_stride == 1) {
+      // Contiguous copy, which is vectorized.
+      typedef Map<Src> SrcMap;
+      typedef Map<Dst> DstMap;
+
+      const SrcMap src(src_base, num_coeff_to_copy);
+      DstMap dst(dst_base, num_coeff_to_copy);
+
+      dst = src;
+      return;
+    }
+
     typedef Map<Src, 0, InnerStride<> > SrcMap;
     typedef Map<Dst, 0, InnerStride<> > DstMap;
 
@@ -531,6 +543,86 @@ struct TensorBlockCwiseBinaryIO {
   }
 };
 
+/**
+ * \class TensorBlockFill
+ * \ingroup CXX11_Tensor_Module
+ *
+ * \brief Sets all the coefficients of a strided block to a constant.
+ *
+ * This is used by the evaluators whose blocks are partially made of constant
+ * coefficients (e.g. the padding of a TensorPaddingOp).
+ */
+template <typename Scalar, typename StorageIndex, int NumDims, int Layout>
+struct TensorBlockFill {
+  typedef DSizes<StorageIndex, NumDims> Dimensions;
+
+  struct BlockIteratorState {
+    StorageIndex stride, span;
+    StorageIndex size, count;
+  };
+
+  static EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void Run(
+      const Dimensions& block_sizes, const Dimensions& block_strides,
+      Scalar* data, const Scalar& value) {
+    // Merge the inner dims which are contiguous in memory.
+    int num_inner_dims = NumDims == 0 ? 0 : 1;
+    const int inner_dim = cond<Layout>()(0, NumDims - 1);
+    StorageIndex inner_dim_size = NumDims == 0 ? 1 : block_sizes[inner_dim];
+    const StorageIndex inner_stride = NumDims == 0 ? 1 : block_strides[inner_dim];
+    for (int i = 1; i < NumDims; ++i) {
+      const int dim = cond<Layout>()(i, NumDims - i - 1);
+      if (inner_stride != 1 || inner_dim_size != block_strides[dim]) {
+        break;
+      }
+      inner_dim_size *= block_sizes[dim];
+      ++num_inner_dims;
+    }
+
+    const int at_least_1_dim = NumDims <= 1 ? 1 : NumDims - 1;
+    array<BlockIteratorState, at_least_1_dim> block_iter_state;
+
+    // Initialize block iterator state. Squeeze away any dimension of size 1.
+    int num_squeezed_dims = 0;
+    for (int i = num_inner_dims; i < NumDims; ++i) {
+      const int dim = cond<Layout>()(i, NumDims - i - 1);
+      const StorageIndex size = block_sizes[dim];
+      if (size == 1) {
+        continue;
+      }
+      BlockIteratorState& state = block_iter_state[num_squeezed_dims];
+      state.stride = block_strides[dim];
+      state.span = state.stride * (size - 1);
+      state.size = size;
+      state.count = 0;
+      ++num_squeezed_dims;
+    }
+
+    typedef Array<Scalar, Dynamic, 1> Dst;
+    const StorageIndex block_total_size =
+        NumDims == 0 ? 1 : block_sizes.TotalSize();
+    StorageIndex index = 0;
+    for (StorageIndex i = 0; i < block_total_size; i += inner_dim_size) {
+      if (inner_stride == 1) {
+        Map<Dst>(data + index, inner_dim_size).setConstant(value);
+      } else {
+        Map<Dst, 0, InnerStride<> >(data + index, inner_dim_size,
+                                    InnerStride<>(inner_stride))
+            .setConstant(value);
+      }
+      // Update index.
+      for (int j = 0; j < num_squeezed_dims; ++j) {
+        BlockIteratorState& state = block_iter_state[j];
+        if (++state.count < state.size) {
+          index += state.stride;
+          break;
+        }
+        state.count = 0;
+        index -= state.span;
+      }
+    }
+  }
+};
+
 /**
  * \class TensorBlockView
  * \ingroup CXX11_Tensor_Module
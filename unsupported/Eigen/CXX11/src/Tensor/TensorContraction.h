@@ -152,6 +152,11 @@ struct TensorContractionParams {
 //   1. Elementwise Relu transformation following Conv2D.
 //   2. AddBias to the Conv2D output channels dimension.
 //
+// The kernel is invoked exactly once for every block of the output matrix,
+// right after the block is fully accumulated and while it is still in cache.
+// Blocks may be processed concurrently by the ThreadPoolDevice, so the kernel
+// must only touch the coefficients of the block it is given.
+//
 // The NoOpOutputKernel implements an output kernel that does absolutely nothing.
 struct NoOpOutputKernel {
   /**
@@ -500,6 +505,37 @@ struct TensorContractionEvaluatorBase
       } \
     }
 
+#define TENSOR_CONTRACTION_ASYNC_DISPATCH(METHOD, DONE, ALIGNMENT, ARGS, FN) \
+  if (this->m_lhs_inner_dim_contiguous) {                                    \
+    if (this->m_rhs_inner_dim_contiguous) {                                  \
+      if (this->m_rhs_inner_dim_reordered) {                                 \
+        (new METHOD<DONE, true, true, true, ALIGNMENT> ARGS)->FN;            \
+      } else {                                                               \
+        (new METHOD<DONE, true, true, false, ALIGNMENT> ARGS)->FN;           \
+      }                                                                      \
+    } else {                                                                 \
+      if (this->m_rhs_inner_dim_reordered) {                                 \
+        (new METHOD<DONE, true, false, true, ALIGNMENT> ARGS)->FN;           \
+      } else {                                                               \
+        (new METHOD<DONE, true, false, false, ALIGNMENT> ARGS)->FN;          \
+      }                                                                      \
+    }                                                                        \
+  } else {                                                                   \
+    if (this->m_rhs_inner_dim_contiguous) {                                  \
+      if (this->m_rhs_inner_dim_reordered) {                                 \
+        (new METHOD<DONE, false, true, true, ALIGNMENT> ARGS)->FN;           \
+      } else {                                                               \
+        (new METHOD<DONE, false, true, false, ALIGNMENT> ARGS)->FN;          \
+      }                                                                      \
+    } else {                                                                 \
+      if (this->m_rhs_inner_dim_reordered) {                                 \
+        (new METHOD<DONE, false, false, true, ALIGNMENT> ARGS)->FN;          \
+      } else {                                                               \
+        (new METHOD<DONE, false, false, false, ALIGNMENT> ARGS)->FN;         \
+      }                                                                      \
+    }                                                                        \
+  }
+
   EIGEN_DEVICE_FUNC void evalTo(Scalar* buffer) const {
    static_cast<const Derived*>(this)->template evalProduct<Unaligned>(buffer);
   }
@@ -578,8 +614,64 @@ struct TensorContractionEvaluatorBase
     }
     #endif
 
-    // columns in left side, rows in right side
     const Index k = this->m_k_size;
+    this->template evalGemmPartial<lhs_inner_dim_contiguous,
+                                   rhs_inner_dim_contiguous,
+                                   rhs_inner_dim_reordered,
+                                   Alignment, true>(buffer, 0, k);
+  }
+
+  template <bool lhs_inner_dim_contiguous, bool rhs_inner_dim_contiguous,
+      bool rhs_inner_dim_reordered, int Alignment>
+  #if !defined(EIGEN_HIPCC)
+  EIGEN_DEVICE_FUNC
+  #endif
+  void evalGemmPartialWithoutOutputKernel(
+      Scalar* buffer, Index k_start, Index k_end, void* packed_mem) const {
+    evalGemmPartial<lhs_inner_dim_contiguous, rhs_inner_dim_contiguous,
+                    rhs_inner_dim_reordered, Alignment,
+        /*use_output_kernel*/ false>(buffer, k_start, k_end, packed_mem);
+  }
+
+  // Blocking of evalGemmPartial over k_slice coefficients of the inner
+  // dimension.
+  EIGEN_DEVICE_FUNC void evalGemmPartialBlocking(Index k_slice, Index* kc,
+                                                 Index* mc, Index* nc) const {
+    typedef typename internal::remove_const<typename EvalLeftArgType::Scalar>::type LhsScalar;
+    typedef typename internal::remove_const<typename EvalRightArgType::Scalar>::type RhsScalar;
+    internal::TensorContractionBlocking<LhsScalar, RhsScalar, Index, internal::ShardByCol>
+        blocking(k_slice, this->m_i_size, this->m_j_size, 1);
+    *kc = blocking.kc();
+    *mc = numext::mini(this->m_i_size, blocking.mc());
+    *nc = numext::mini(this->m_j_size, blocking.nc());
+  }
+
+  // Bytes of the packed blocks of evalGemmPartial over k_slice coefficients
+  // of the inner dimension: the lhs block, aligned to EIGEN_MAX_ALIGN_BYTES,
+  // followed by the rhs block.
+  EIGEN_DEVICE_FUNC size_t evalGemmPartialPackedBytes(Index k_slice) const {
+    typedef typename internal::remove_const<typename EvalLeftArgType::Scalar>::type LhsScalar;
+    typedef typename internal::remove_const<typename EvalRightArgType::Scalar>::type RhsScalar;
+    Index kc, mc, nc;
+    evalGemmPartialBlocking(k_slice, &kc, &mc, &nc);
+    const size_t align = numext::maxi(EIGEN_MAX_ALIGN_BYTES, 1);
+    return divup<size_t>(mc * kc * sizeof(LhsScalar), align) * align +
+           kc * nc * sizeof(RhsScalar);
+  }
+
+  // Computes the partial product over the [k_start, k_end) range of the inner
+  // dimension into buffer, which is overwritten. The blocks are packed into
+  // packed_mem if set, which must hold evalGemmPartialPackedBytes(k_end -
+  // k_start) bytes, and into temporaries of the device otherwise.
+  template <bool lhs_inner_dim_contiguous, bool rhs_inner_dim_contiguous, bool rhs_inner_dim_reordered, int Alignment, bool use_output_kernel>
+  #if !defined(EIGEN_HIPCC)
+  EIGEN_DEVICE_FUNC
+  #endif
+  void evalGemmPartial(Scalar* buffer, Index k_start, Index k_end,
+                       void* packed_mem = NULL) const {
+    eigen_assert(k_end >= k_start && k_start >= 0 && k_end <= this->m_k_size);
+    // columns in left side, rows in right side
+    const Index k_slice = k_end - k_start;
 
     // rows in left side
     const Index m = this->m_i_size;
@@ -634,22 +726,23 @@ struct TensorContractionEvaluatorBase
     OutputMapper output(buffer, m);
 
     // Sizes of the blocks to load in cache. See the Goto paper for details.
-    internal::TensorContractionBlocking<LhsScalar, RhsScalar, Index, internal::ShardByCol> blocking(k, m, n, 1);
-    const Index kc = blocking.kc();
-    const Index mc = numext::mini(m, blocking.mc());
-    const Index nc = numext::mini(n, blocking.nc());
-    const Index sizeA = mc * kc;
-    const Index sizeB = kc * nc;
+    Index kc, mc, nc;
+    evalGemmPartialBlocking(k_slice, &kc, &mc, &nc);
 
-    LhsScalar* blockA = static_cast<LhsScalar *>(this->m_device.allocate(sizeA * sizeof(LhsScalar)));
-    RhsScalar* blockB = static_cast<RhsScalar *>(this->m_device.allocate(sizeB * sizeof(RhsScalar)));
+    // The rhs block ends the packed memory, after the aligned lhs block.
+    const size_t packed_bytes = evalGemmPartialPackedBytes(k_slice);
+    char* packed = static_cast<char*>(
+        packed_mem ? packed_mem : this->m_device.allocate_temp(packed_bytes));
+    LhsScalar* blockA = reinterpret_cast<LhsScalar*>(packed);
+    RhsScalar* blockB = reinterpret_cast<RhsScalar*>(
+        packed + packed_bytes - kc * nc * sizeof(RhsScalar));
 
     for(Index i2=0; i2<m; i2+=mc)
     {
       const Index actual_mc = numext::mini(i2+mc,m)-i2;
-      for (Index k2 = 0; k2 < k; k2 += kc) {
+      for (Index k2 = k_start; k2 < k_end; k2 += kc) {
         // make sure we don't overshoot right edge of left matrix, then pack vertical panel
-        const Index actual_kc = numext::mini(k2 + kc, k) - k2;
+        const Index actual_kc = numext::mini(k2 + kc, k_end) - k2;
         pack_lhs(blockA, lhs.getSubMapper(i2, k2), actual_kc, actual_mc, 0, 0);
 
         // series of horizontal blocks
@@ -665,7 +758,7 @@ struct TensorContractionEvaluatorBase
                Scalar(1), -1, -1, 0, 0);
 
           // We are done with this [i2, j2] output block.
-          if (k2 + kc >= k) {
+          if (use_output_kernel && k2 + kc >= k_end) {
             m_output_kernel(output_mapper, m_tensor_contraction_params, i2, j2,
                             actual_mc, actual_nc);
           }
@@ -673,8 +766,7 @@ struct TensorContractionEvaluatorBase
       }
     }
 
-    this->m_device.deallocate(blockA);
-    this->m_device.deallocate(blockB);
+    if (packed_mem == NULL) this->m_device.deallocate_temp(packed);
   }
 
   EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void cleanup() {
@@ -714,7 +806,10 @@ protected:
         !(std::is_same<Scalar, float>::value ||
           std::is_same<Scalar, double>::value) ||
         m_leftImpl.data() == NULL ||
-        m_rightImpl.data() == NULL) {
+        m_rightImpl.data() == NULL ||
+        // The libxsmm kernels don't invoke the output kernel.
+        !std::is_same<typename internal::remove_const<OutputKernelType>::type,
+                      NoOpOutputKernel>::value) {
       return;
     }
 
@@ -831,10 +926,10 @@ protected:
     RhsScalar* panelB = NULL;
 
     if (copyA) {
-      blockA = static_cast<LhsScalar*>(this->m_device.allocate(mc * kc * sizeof(LhsScalar)));
+      blockA = static_cast<LhsScalar*>(this->m_device.allocate_temp(mc * kc * sizeof(LhsScalar)));
     }
     if (copyB) {
-      panelB = static_cast<RhsScalar*>(this->m_device.allocate(nc_outer * stride_panelB * sizeof(RhsScalar)));
+      panelB = static_cast<RhsScalar*>(this->m_device.allocate_temp(nc_outer * stride_panelB * sizeof(RhsScalar)));
     }
 
     const Index kernel_stride_A = copyA ? stride_blockA : stride_A;
@@ -902,10 +997,10 @@ protected:
     }
 
     if (copyA) {
-      this->m_device.deallocate(blockA);
+      this->m_device.deallocate_temp(blockA);
     }
     if (copyB) {
-      this->m_device.deallocate(panelB);
+      this->m_device.deallocate_temp(panelB);
     }
   }
 #endif
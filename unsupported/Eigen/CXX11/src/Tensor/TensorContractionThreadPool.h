@@ -73,10 +73,60 @@ struct TensorEvaluator<const TensorContractionOp<Indices, LeftArgType, RightArgT
 
   template <int Alignment>
   void evalProduct(Scalar* buffer) const {
+    evalProductImpl<NoCallback, Alignment>(buffer, NoCallback());
+  }
+
+  template <typename EvalToCallback, int Alignment>
+  void evalProductAsync(Scalar* buffer, EvalToCallback done) const {
+    evalProductImpl<EvalToCallback, Alignment>(buffer, std::move(done));
+  }
+
+  // Evaluates the sub expressions, and then schedules the contraction into
+  // `dest` (or into a newly allocated result buffer when `dest` is NULL)
+  // without blocking the calling thread. `done` is called with the same
+  // value that evalSubExprsIfNeeded would return once the product is ready.
+  template <typename EvalSubExprsCallback>
+  void evalSubExprsIfNeededAsync(Scalar* dest, EvalSubExprsCallback done) {
+    internal::eval_sub_exprs_async<LeftEvaluator>::run(
+        this->m_leftImpl, nullptr, [this, dest, done](bool) {
+          internal::eval_sub_exprs_async<RightEvaluator>::run(
+              this->m_rightImpl, nullptr, [this, dest, done](bool) {
+                if (dest) {
+                  evalProductAsync<EvalSubExprsCallbackFalse<EvalSubExprsCallback>, Unaligned>(
+                      dest, EvalSubExprsCallbackFalse<EvalSubExprsCallback>(done));
+                } else {
+                  this->m_result = static_cast<Scalar*>(
+                      this->m_device.allocate(this->dimensions().TotalSize() * sizeof(Scalar)));
+                  evalProductAsync<EvalSubExprsCallbackTrue<EvalSubExprsCallback>, Unaligned>(
+                      this->m_result, EvalSubExprsCallbackTrue<EvalSubExprsCallback>(done));
+                }
+              });
+        });
+  }
+
+  template <typename DoneCallback, int Alignment>
+  void evalProductImpl(Scalar* buffer, DoneCallback done) const {
+    // This function computes a lot of heuristics in multiple steps, and it
+    // also has multiple exit points. To keep it sane, readable and all in one
+    // place, sync/async execution decision is made at runtime at the very end.
+    //
+    // (1) In sync mode we allocate Context on the stack, submit computations
+    //     to the device thread pool, and block on a barrier until it is
+    //     completed.
+    //
+    // (2) In async mode we allocate Context on the heap, and after all tasks
+    //     are finished, we call provided the done callback, and delete a
+    //     context from the heap.
+    static const bool IsEvalInSyncMode =
+        internal::is_same<DoneCallback, NoCallback>::value;
+
     const Index m = this->m_i_size;
     const Index n = this->m_j_size;
     const Index k = this->m_k_size;
-    if (m == 0 || n == 0 || k == 0) return;
+    if (m == 0 || n == 0 || k == 0) {
+      if (!IsEvalInSyncMode) done();
+      return;
+    }
 
 #if defined(EIGEN_VECTORIZE_AVX) && defined(EIGEN_USE_LIBXSMM)
     if (this->m_can_use_xsmm) {
@@ -91,6 +141,7 @@ struct TensorEvaluator<const TensorContractionOp<Indices, LeftArgType, RightArgT
       } else {
         ContextXsmm<Alignment>(this, buffer, m, n, k, blocking).run();
       }
+      if (!IsEvalInSyncMode) done();
       return;
     }
 #endif
@@ -152,9 +203,26 @@ struct TensorEvaluator<const TensorContractionOp<Indices, LeftArgType, RightArgT
     // model is not tuned. Remove this when the cost model is tuned.
     if (n == 1) num_threads = 1;
 
+    // Small outputs with a large inner dimension don't have enough parallelism
+    // over m and n: compute partial products over disjoint k ranges instead.
+    const int num_threads_by_k = numThreadsInnerDim(m, n, k);
+    if (shardByInnerDim(m, n, k, num_threads, num_threads_by_k)) {
+      if (IsEvalInSyncMode) {
+        EvalShardedByInnerDimContext<NoCallback, Alignment> ctx(
+            this, num_threads_by_k, buffer, m, n, k, NoCallback());
+        ctx.run();
+      } else {
+        (new EvalShardedByInnerDimContext<DoneCallback, Alignment>(
+             this, num_threads_by_k, buffer, m, n, k, std::move(done)))
+            ->run();
+      }
+      return;
+    }
+
     if (num_threads == 1) {
       TENSOR_CONTRACTION_DISPATCH(this->template evalProductSequential,
                                   Unaligned, (buffer));
+      if (!IsEvalInSyncMode) done();
       return;
     }
 
@@ -216,20 +284,94 @@ struct TensorEvaluator<const TensorContractionOp<Indices, LeftArgType, RightArgT
     // more important in this case.
     if ((shard_by_col ? nm : nn) == 1) parallel_pack = false;
 
-    #define CONTEXT_ARGS                                                        \
-  (this, num_threads, buffer, m, n, k, bm, bn, bk, nm, nn, nk, gm, gn, nm0, \
-   nn0, shard_by_col, parallel_pack)                                        \
+    if (IsEvalInSyncMode) {
+#define CONTEXT_ARGS                                                          \
+  (this, num_threads, buffer, m, n, k, bm, bn, bk, nm, nn, nk, gm, gn, nm0,   \
+   nn0, shard_by_col, parallel_pack, NoCallback())                            \
       .run()
-
-    TENSOR_CONTRACTION_DISPATCH(Context, Alignment, CONTEXT_ARGS);
-
+      TENSOR_CONTRACTION_DISPATCH(SyncContext, Alignment, CONTEXT_ARGS);
 #undef CONTEXT_ARGS
 
+    } else {
+#define CONTEXT_ARGS                                                          \
+  (this, num_threads, buffer, m, n, k, bm, bn, bk, nm, nn, nk, gm, gn, nm0,   \
+   nn0, shard_by_col, parallel_pack, std::move(done))
+      TENSOR_CONTRACTION_ASYNC_DISPATCH(Context, DoneCallback, Alignment,
+                                        CONTEXT_ARGS, run());
+#undef CONTEXT_ARGS
+    }
   }
 
-  // Context coordinates a single parallel gemm operation.
- template <bool lhs_inner_dim_contiguous, bool rhs_inner_dim_contiguous,
-            bool rhs_inner_dim_reordered, int Alignment>
+  // ------------------------------------------------------------------------ //
+
+  // Dummy struct to represent an empty DoneCallback.
+  struct NoCallback {
+    void operator()() {
+      eigen_assert(false && "NoCallback should never be called");
+    }
+  };
+
+  // Adapts the callback of evalSubExprsIfNeededAsync to evalProductAsync.
+  template <typename EvalSubExprsCallback>
+  struct EvalSubExprsCallbackTrue {
+    explicit EvalSubExprsCallbackTrue(EvalSubExprsCallback done) : done(done) {}
+    void operator()() { done(true); }
+    EvalSubExprsCallback done;
+  };
+  template <typename EvalSubExprsCallback>
+  struct EvalSubExprsCallbackFalse {
+    explicit EvalSubExprsCallbackFalse(EvalSubExprsCallback done) : done(done) {}
+    void operator()() { done(false); }
+    EvalSubExprsCallback done;
+  };
+
+  // ------------------------------------------------------------------------ //
+
+  // EvalParallelNotification will be used to notify main thread that the
+  // contraction is done. In async mode the context owns itself: the
+  // notification deletes it and then calls the done callback.
+  template <typename DoneCallback, typename Context>
+  class EvalParallelNotification {
+   public:
+    EvalParallelNotification(Context* ctx, DoneCallback done)
+        : ctx_(ctx), done_(std::move(done)) {}
+
+    void Notify() {
+      // Make a copy of done callback, because it will be destructed when we
+      // will delete context in the next line (EvalParallelNotification is a
+      // data member of Context class).
+      DoneCallback done_copy = std::move(done_);
+
+      // Delete parallel evaluation context.
+      delete ctx_;
+
+      // Now safely call the done callback.
+      done_copy();
+    }
+
+    void Wait() {}
+
+   private:
+    Context* ctx_;
+    DoneCallback done_;
+  };
+
+  template <typename Context>
+  class EvalParallelNotification<NoCallback, Context> {
+   public:
+    EvalParallelNotification(Context*, NoCallback) {}
+    void Notify() { done_.Notify(); }
+    void Wait() { done_.Wait(); }
+   private:
+    Eigen::Notification done_;
+  };
+
+  // Context coordinates a single parallel gemm operation. In async mode
+  // (DoneCallback other than NoCallback) it must be allocated on the heap, and
+  // deletes itself once the product is done.
+  template <typename DoneCallback, bool lhs_inner_dim_contiguous,
+            bool rhs_inner_dim_contiguous, bool rhs_inner_dim_reordered,
+            int Alignment>
   class Context {
    public:
     typedef internal::TensorContractionInputMapper<
@@ -257,8 +399,9 @@ struct TensorEvaluator<const TensorContractionOp<Indices, LeftArgType, RightArgT
     Context(const Self* self, int num_threads, Scalar* buffer, Index tm, Index tn,
             Index tk, Index bm, Index bn, Index bk, Index nm, Index nn, Index nk,
             Index gm, Index gn, Index nm0, Index nn0, bool shard_by_col,
-            bool parallel_pack)
-        : device_(self->m_device),
+            bool parallel_pack, DoneCallback done)
+        : done_(this, std::move(done)),
+          device_(self->m_device),
           lhs_(self->m_leftImpl, self->m_left_nocontract_strides,
                self->m_i_strides, self->m_left_contracting_strides,
                self->m_k_strides),
@@ -317,7 +460,7 @@ struct TensorEvaluator<const TensorContractionOp<Indices, LeftArgType, RightArgT
           divup<size_t>(bm_ * bk_ * sizeof(LhsScalar), align) * align;
       size_t rhs_size =
           divup<size_t>(bn_ * bk_ * sizeof(RhsScalar), align) * align;
-      packed_mem_ = static_cast<char*>(device_.allocate(
+      packed_mem_ = static_cast<char*>(device_.allocate_temp(
           (nm0_ * lhs_size + nn0_ * rhs_size) * std::min<size_t>(nk_, P - 1)));
       char* mem = static_cast<char*>(packed_mem_);
       for (Index x = 0; x < numext::mini<Index>(nk_, P - 1); x++) {
@@ -339,13 +482,13 @@ struct TensorEvaluator<const TensorContractionOp<Indices, LeftArgType, RightArgT
         for (Index m = 0; m < nm_; m++) delete[] state_kernel_[x][m];
         delete[] state_kernel_[x];
       }
-      device_.deallocate(packed_mem_);
+      device_.deallocate_temp(packed_mem_);
     }
 
     void run() {
       // Kick off packing of the first slice.
       signal_switch(0, 1);
-      // Wait for overall completion.
+      // Wait for overall completion (a no-op in async mode).
       // TODO(dvyukov): this wait can lead to deadlock.
       // If nthreads contractions are concurrently submitted from worker
       // threads, this wait will block all worker threads and the system will
@@ -354,7 +497,7 @@ struct TensorEvaluator<const TensorContractionOp<Indices, LeftArgType, RightArgT
     }
 
    private:
-    Notification done_;
+    EvalParallelNotification<DoneCallback, Context> done_;
     const Device& device_;
     LhsMapper lhs_;
     RhsMapper rhs_;
@@ -562,6 +705,8 @@ struct TensorEvaluator<const TensorContractionOp<Indices, LeftArgType, RightArgT
         signal_switch(k + 1,
                       parallel_pack_ ? nm_ + nn_ : (shard_by_col_ ? nn_ : nm_));
       } else {
+        // Note: in async mode this deletes the context, so no member may be
+        // accessed after this call.
         done_.Notify();
       }
     }
@@ -600,6 +745,208 @@ struct TensorEvaluator<const TensorContractionOp<Indices, LeftArgType, RightArgT
     void operator=(const Context&) = delete;
   };
 
+  template <bool lhs_inner_dim_contiguous, bool rhs_inner_dim_contiguous,
+            bool rhs_inner_dim_reordered, int Alignment>
+  using SyncContext =
+      Context<NoCallback, lhs_inner_dim_contiguous, rhs_inner_dim_contiguous,
+              rhs_inner_dim_reordered, Alignment>;
+
+  // EvalShardedByInnerDimContext splits the inner dimension into
+  // num_threads ranges, and contracts each range into its own m x n buffer
+  // (the first one being the result buffer). Once all the partial products are
+  // done, they are summed into the result in parallel, and the output kernel is
+  // applied to each range of columns as soon as it is summed. In async mode the
+  // context must be allocated on the heap and deletes itself when done.
+  template <typename DoneCallback, int Alignment>
+  class EvalShardedByInnerDimContext {
+   public:
+    EvalShardedByInnerDimContext(const Self* self, int num_threads,
+                                 Scalar* result, Index m, Index n, Index k,
+                                 DoneCallback done)
+        : evaluator_(self),
+          device_(self->m_device),
+          result_(result),
+          m_(m),
+          n_(n),
+          packed_bytes_(0),
+          packed_mem_(NULL),
+          done_(this, std::move(done)) {
+      // The gebp kernel assumes that the depth of all but the last block is a
+      // multiple of the packet size.
+      const Index packet_size = internal::packet_traits<RhsScalar>::size;
+      const Index kmultiple = packet_size <= 8 ? 8 : packet_size;
+      const Index num_blocks =
+          numext::mini<Index>(num_threads, divup<Index>(k, kmultiple));
+
+      Index start = 0;
+      block_start_.push_back(start);
+      for (Index blocks_left = num_blocks; blocks_left > 0 && start < k;
+           --blocks_left) {
+        const Index block_size =
+            kmultiple * divup<Index>(k - start, kmultiple * blocks_left);
+        start = numext::mini(start + block_size, k);
+        block_start_.push_back(start);
+      }
+
+      buffers_.push_back(result_);
+      for (size_t i = 1; i + 1 < block_start_.size(); ++i) {
+        buffers_.push_back(static_cast<Scalar*>(
+            device_.allocate_temp(m_ * n_ * sizeof(Scalar))));
+      }
+      pending_blocks_ = static_cast<Index>(buffers_.size());
+
+      // The packed blocks of all the slices are allocated at once.
+      const size_t align = numext::maxi(EIGEN_MAX_ALIGN_BYTES, 1);
+      for (size_t i = 0; i + 1 < block_start_.size(); ++i) {
+        packed_bytes_ = numext::maxi(
+            packed_bytes_,
+            divup<size_t>(evaluator_->evalGemmPartialPackedBytes(
+                              block_start_[i + 1] - block_start_[i]),
+                          align) * align);
+      }
+      packed_mem_ = static_cast<char*>(
+          device_.allocate_temp(packed_bytes_ * buffers_.size()));
+    }
+
+    ~EvalShardedByInnerDimContext() {
+      for (size_t i = 1; i < buffers_.size(); ++i)
+        device_.deallocate_temp(buffers_[i]);
+      device_.deallocate_temp(packed_mem_);
+    }
+
+    void run() {
+      for (Index b = 0; b < static_cast<Index>(buffers_.size()); ++b)
+        device_.enqueueNoNotification([this, b]() { processBlock(b); });
+      // Wait for overall completion (a no-op in async mode).
+      done_.Wait();
+    }
+
+   private:
+    void processBlock(Index b) {
+      evaluator_->template evalGemmPartialSlice<Alignment>(
+          buffers_[b], block_start_[b], block_start_[b + 1],
+          packed_mem_ + b * packed_bytes_);
+      if (pending_blocks_.fetch_sub(1) == 1) reduce();
+    }
+
+    // Adds the partial products into the result buffer, one range of columns
+    // at a time, and applies the output kernel to each range while it is
+    // still in cache.
+    void reduce() {
+      typedef internal::blas_data_mapper<Scalar, Index, ColMajor> OutputMapper;
+      const Index num_buffers = static_cast<Index>(buffers_.size());
+      const TensorOpCost cost(m_ * num_buffers * sizeof(Scalar),
+                              m_ * sizeof(Scalar), m_ * (num_buffers - 1));
+      device_.parallelForAsync(
+          n_, cost,
+          [this, num_buffers](Index first, Index last) {
+            typedef Map<Matrix<Scalar, Dynamic, 1> > VectorMap;
+            const Index offset = first * m_;
+            const Index size = (last - first) * m_;
+            VectorMap dst(result_ + offset, size);
+            for (Index b = 1; b < num_buffers; ++b)
+              dst += VectorMap(buffers_[b] + offset, size);
+            evaluator_->m_output_kernel(
+                OutputMapper(result_ + offset, m_),
+                evaluator_->m_tensor_contraction_params,
+                static_cast<Index>(0), first, m_, last - first);
+          },
+          [this]() {
+            // Note: in async mode this deletes the context.
+            done_.Notify();
+          });
+    }
+
+    const Self* evaluator_;
+    const Device& device_;
+    Scalar* const result_;
+    const Index m_;
+    const Index n_;
+    std::vector<Index> block_start_;
+    std::vector<Scalar*> buffers_;
+    size_t packed_bytes_;
+    char* packed_mem_;
+    std::atomic<Index> pending_blocks_;
+    EvalParallelNotification<DoneCallback, EvalShardedByInnerDimContext> done_;
+
+    EvalShardedByInnerDimContext(const EvalShardedByInnerDimContext&) = delete;
+    void operator=(const EvalShardedByInnerDimContext&) = delete;
+  };
+
+  template <int Alignment>
+  void evalGemmPartialSlice(Scalar* buffer, Index k_start, Index k_end,
+                            void* packed_mem) const {
+    TENSOR_CONTRACTION_DISPATCH(this->template evalGemmPartialWithoutOutputKernel,
+                                Alignment, (buffer, k_start, k_end, packed_mem));
+  }
+
+  // Decide whether the inner dimension sharding is better than sharding by
+  // rows or columns with num_threads threads.
+  bool shardByInnerDim(Index m, Index n, Index k, int num_threads,
+                       int num_threads_by_k) const {
+    const std::ptrdiff_t bufsize = m * n * sizeof(Scalar);
+    if (num_threads_by_k < 2 ||  // running single threaded or...
+        num_threads_by_k < num_threads ||  // less parallelism or...
+        // the per thread buffers don't fit into the L3 cache or...
+        bufsize > l3CacheSize() / num_threads_by_k ||
+        k / num_threads_by_k < 2 * Traits::nr) {  // k per thread is tiny.
+      return false;
+    }
+    // Both outer dimensions are tiny or...
+    return numext::maxi(m, n) / num_threads < Traits::nr ||
+           // k per thread is not small and one of the outer dimensions is
+           // tiny or sharding by k offers more parallelism.
+           (k / num_threads_by_k > 8 * Traits::nr &&
+            (numext::mini(m, n) < 2 * Traits::nr ||
+             num_threads_by_k > num_threads));
+  }
+
+  // Number of threads for the inner dimension sharding, trading the parallel
+  // speedup for the cost of reducing one extra m x n buffer per thread.
+  int numThreadsInnerDim(Index m, Index n, Index k) const {
+    const int output_packet_size = internal::unpacket_traits<PacketReturnType>::size;
+    const TensorOpCost cost = contractionCostPerInnerDim(m, n);
+    const double total_parallel_cost =
+        TensorCostModel<ThreadPoolDevice>::totalCost(k, cost);
+    const double reduction_cost = TensorCostModel<ThreadPoolDevice>::totalCost(
+        m * n, TensorOpCost(2 * sizeof(Scalar), sizeof(Scalar), 1, true,
+                            output_packet_size));
+    // Costs of starting the parallel evaluation and of each additional
+    // thread, as used by TensorCostModel::numThreads.
+    const TensorCostModelParameters params =
+        TensorCostModel<ThreadPoolDevice>::parameters();
+    int num_threads = 1;
+    double min_cost = total_parallel_cost;
+    for (int nt = 2; nt <= this->m_device.numThreads(); ++nt) {
+      const double parallel_cost =
+          total_parallel_cost / nt + params.startup_cycles +
+          nt * (reduction_cost / this->m_device.numThreads() +
+                params.per_thread_cycles);
+      if (parallel_cost < min_cost) {
+        num_threads = nt;
+        min_cost = parallel_cost;
+      }
+    }
+    return num_threads;
+  }
+
+  // Cost of computing one k slice of the whole m x n output.
+  TensorOpCost contractionCostPerInnerDim(Index m, Index n) const {
+    const int output_packet_size = internal::unpacket_traits<PacketReturnType>::size;
+    const int packed_size = std::min<int>(PacketType<LhsScalar, Device>::size,
+                                          PacketType<RhsScalar, Device>::size);
+    // Computations.
+    TensorOpCost cost(0, 0, static_cast<double>(m * n) / packed_size);
+    // Output stores.
+    cost += TensorOpCost(0, sizeof(CoeffReturnType), 0, true, output_packet_size);
+    TensorOpCost lhsCost = this->m_leftImpl.costPerCoeff(true) * m;
+    TensorOpCost rhsCost = this->m_rightImpl.costPerCoeff(true) * n;
+    // Since the inner gemm kernel is always sharded by column, the lhs
+    // load cost is negligible.
+    lhsCost.dropMemoryCost();
+    return cost + lhsCost + rhsCost;
+  }
+
   // Decide whether we want to shard m x n contraction by columns or by rows.
   static bool shardByCol(Index m, Index n, Index num_threads) {
     // Note: we are comparing both n and m against Traits::nr, it is not
@@ -744,10 +1091,6 @@ struct TensorEvaluator<const TensorContractionOp<Indices, LeftArgType, RightArgT
   }
 
 #if defined(EIGEN_VECTORIZE_AVX) && defined(EIGEN_USE_LIBXSMM)
-  // TODO(ezhulenev): Add support for output kernels and LIBXSMM.
-  static_assert(std::is_same<OutputKernelType, const NoOpOutputKernel>::value,
-                "XSMM does not support contraction output kernels.");
-
   template<int Alignment>
   class ContextXsmm {
    public:
@@ -868,11 +1211,11 @@ struct TensorEvaluator<const TensorContractionOp<Indices, LeftArgType, RightArgT
       // Do not use advanced ThreadPool queuing, just run a single long-standing
       // function in each thread.
       if (copyA) {
-        blocksA = static_cast<LhsScalar*>(device.allocate(
+        blocksA = static_cast<LhsScalar*>(device.allocate_temp(
             (blocks_m*bm)*(blocks_k*bk)*sizeof(LhsScalar)));
       }
       if (copyB) {
-        blocksB = static_cast<RhsScalar*>(device.allocate(
+        blocksB = static_cast<RhsScalar*>(device.allocate_temp(
             (blocks_n*bn)*(blocks_k*bk)*sizeof(RhsScalar)));
       }
 
@@ -883,10 +1226,10 @@ struct TensorEvaluator<const TensorContractionOp<Indices, LeftArgType, RightArgT
       workers_done.Wait();
 
       if (copyA) {
-        device.deallocate(blocksA);
+        device.deallocate_temp(blocksA);
       }
       if (copyB) {
-        device.deallocate(blocksB);
+        device.deallocate_temp(blocksB);
       }
     }
 
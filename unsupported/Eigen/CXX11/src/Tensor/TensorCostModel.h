@@ -154,6 +154,21 @@ class TensorOpCost {
   double compute_cycles_;
 };
 
+// Machine dependent parameters of the TensorCostModel. All the costs are
+// expressed in device cycles.
+struct TensorCostModelParameters {
+  // Scaling from Eigen compute cost to device cycles.
+  double device_cycles_per_compute_cycle;
+  // Cost of loading and storing one byte.
+  double load_cycles_per_byte;
+  double store_cycles_per_byte;
+  // Cost of starting a parallel evaluation, and of each additional thread.
+  double startup_cycles;
+  double per_thread_cycles;
+  // Ideal cost of a parallel task.
+  double task_size;
+};
+
 // TODO(rmlarsen): Implement a policy that chooses an "optimal" number of theads
 // in [1:max_threads] instead of just switching multi-threading off for small
 // work units.
@@ -168,13 +183,64 @@ class TensorCostModel {
   static const int kPerThreadCycles = 100000;
   static const int kTaskSize = 40000;
 
+  // Returns the default parameters of the cost model, based on the constants
+  // above.
+  static EIGEN_DEVICE_FUNC TensorCostModelParameters defaultParameters() {
+    // Cost of memory fetches from L2 cache. 64 is typical cache line size.
+    // 11 is L2 cache latency on Haswell.
+    // We don't know whether data is in L1, L2 or L3. But we are most interested
+    // in single-threaded computational time around 100us-10ms (smaller time
+    // is too small for parallelization, larger time is not interesting
+    // either because we are probably using all available threads already).
+    // And for the target time range, L2 seems to be what matters. Data set
+    // fitting into L1 is too small to take noticeable time. Data set fitting
+    // only into L3 presumably will take more than 10ms to load and process.
+    TensorCostModelParameters params;
+    params.device_cycles_per_compute_cycle = kDeviceCyclesPerComputeCycle;
+    params.load_cycles_per_byte = 1.0 / 64 * 11;
+    params.store_cycles_per_byte = 1.0 / 64 * 11;
+    params.startup_cycles = kStartupCycles;
+    params.per_thread_cycles = kPerThreadCycles;
+    params.task_size = kTaskSize;
+    return params;
+  }
+
+  // Returns the parameters currently used by the cost model.
+  static EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE TensorCostModelParameters
+  parameters() {
+#if defined(EIGEN_GPU_COMPILE_PHASE) || defined(SYCL_DEVICE_ONLY)
+    return defaultParameters();
+#else
+    return currentParameters().load();
+#endif
+  }
+
+  // Installs machine specific parameters, e.g. the ones measured by
+  // calibrateTensorCostModel(). This may be called while tensor expressions
+  // are evaluated by other threads, which then use either the previous or
+  // the new value of each parameter.
+  static void setParameters(const TensorCostModelParameters& params) {
+    eigen_assert(params.device_cycles_per_compute_cycle > 0);
+    eigen_assert(params.load_cycles_per_byte >= 0);
+    eigen_assert(params.store_cycles_per_byte >= 0);
+    eigen_assert(params.startup_cycles >= 0);
+    eigen_assert(params.per_thread_cycles > 0);
+    eigen_assert(params.task_size > 0);
+    currentParameters().store(params);
+  }
+
+  // Restores the default parameters.
+  static void resetParameters() { currentParameters().store(defaultParameters()); }
+
   // Returns the number of threads in [1:max_threads] to use for
   // evaluating an expression with the given output size and cost per
   // coefficient.
   static EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE int numThreads(
       double output_size, const TensorOpCost& cost_per_coeff, int max_threads) {
-    double cost = totalCost(output_size, cost_per_coeff);
-    double threads = (cost - kStartupCycles) / kPerThreadCycles + 0.9;
+    const TensorCostModelParameters params = parameters();
+    double cost = totalCost(output_size, cost_per_coeff, params);
+    double threads =
+        (cost - params.startup_cycles) / params.per_thread_cycles + 0.9;
     // Make sure we don't invoke undefined behavior when we convert to an int.
     threads = numext::mini<double>(threads, GenericNumTraits<int>::highest());
     return numext::mini(max_threads, numext::maxi<int>(1, threads));
@@ -185,27 +251,72 @@ class TensorCostModel {
   // granularity needs to be increased to mitigate parallelization overheads.
   static EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE double taskSize(
       double output_size, const TensorOpCost& cost_per_coeff) {
-    return totalCost(output_size, cost_per_coeff) / kTaskSize;
+    const TensorCostModelParameters params = parameters();
+    return totalCost(output_size, cost_per_coeff, params) / params.task_size;
   }
 
- private:
+  // Estimated cost in device cycles of evaluating output_size coefficients.
   static EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE double totalCost(
       double output_size, const TensorOpCost& cost_per_coeff) {
-    // Cost of memory fetches from L2 cache. 64 is typical cache line size.
-    // 11 is L2 cache latency on Haswell.
-    // We don't know whether data is in L1, L2 or L3. But we are most interested
-    // in single-threaded computational time around 100us-10ms (smaller time
-    // is too small for parallelization, larger time is not interesting
-    // either because we are probably using all available threads already).
-    // And for the target time range, L2 seems to be what matters. Data set
-    // fitting into L1 is too small to take noticeable time. Data set fitting
-    // only into L3 presumably will take more than 10ms to load and process.
-    const double kLoadCycles = 1.0 / 64 * 11;
-    const double kStoreCycles = 1.0 / 64 * 11;
-    // Scaling from Eigen compute cost to device cycles.
+    return totalCost(output_size, cost_per_coeff, parameters());
+  }
+
+ private:
+  static EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE double totalCost(
+      double output_size, const TensorOpCost& cost_per_coeff,
+      const TensorCostModelParameters& params) {
     return output_size *
-        cost_per_coeff.total_cost(kLoadCycles, kStoreCycles,
-                                  kDeviceCyclesPerComputeCycle);
+        cost_per_coeff.total_cost(params.load_cycles_per_byte,
+                                  params.store_cycles_per_byte,
+                                  params.device_cycles_per_compute_cycle);
+  }
+
+  // The parameters are read by the threads evaluating tensor expressions,
+  // hence each of them is an atomic.
+  struct AtomicParameters {
+    std::atomic<double> device_cycles_per_compute_cycle;
+    std::atomic<double> load_cycles_per_byte;
+    std::atomic<double> store_cycles_per_byte;
+    std::atomic<double> startup_cycles;
+    std::atomic<double> per_thread_cycles;
+    std::atomic<double> task_size;
+
+    explicit AtomicParameters(const TensorCostModelParameters& params) {
+      store(params);
+    }
+
+    TensorCostModelParameters load() const {
+      TensorCostModelParameters params;
+      params.device_cycles_per_compute_cycle =
+          device_cycles_per_compute_cycle.load(std::memory_order_relaxed);
+      params.load_cycles_per_byte =
+          load_cycles_per_byte.load(std::memory_order_relaxed);
+      params.store_cycles_per_byte =
+          store_cycles_per_byte.load(std::memory_order_relaxed);
+      params.startup_cycles = startup_cycles.load(std::memory_order_relaxed);
+      params.per_thread_cycles =
+          per_thread_cycles.load(std::memory_order_relaxed);
+      params.task_size = task_size.load(std::memory_order_relaxed);
+      return params;
+    }
+
+    void store(const TensorCostModelParameters& params) {
+      device_cycles_per_compute_cycle.store(
+          params.device_cycles_per_compute_cycle, std::memory_order_relaxed);
+      load_cycles_per_byte.store(params.load_cycles_per_byte,
+                                 std::memory_order_relaxed);
+      store_cycles_per_byte.store(params.store_cycles_per_byte,
+                                  std::memory_order_relaxed);
+      startup_cycles.store(params.startup_cycles, std::memory_order_relaxed);
+      per_thread_cycles.store(params.per_thread_cycles,
+                              std::memory_order_relaxed);
+      task_size.store(params.task_size, std::memory_order_relaxed);
+    }
+  };
+
+  static AtomicParameters& currentParameters() {
+    static AtomicParameters params(defaultParameters());
+    return params;
   }
 };
 
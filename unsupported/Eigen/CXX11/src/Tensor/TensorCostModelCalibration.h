@@ -0,0 +1,139 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#if defined(EIGEN_USE_THREADS) && !defined(EIGEN_CXX11_TENSOR_TENSOR_COST_MODEL_CALIBRATION_H)
+#define EIGEN_CXX11_TENSOR_TENSOR_COST_MODEL_CALIBRATION_H
+
+namespace Eigen {
+
+namespace internal {
+
+// Returns the smallest time in nanoseconds, over a few runs, of calling f
+// iterations times.
+template <typename Function>
+double calibration_time_ns(int iterations, Function f) {
+  typedef std::chrono::steady_clock Clock;
+  double best = NumTraits<double>::infinity();
+  for (int run = 0; run < 5; ++run) {
+    const Clock::time_point start = Clock::now();
+    for (int i = 0; i < iterations; ++i) f();
+    const Clock::time_point end = Clock::now();
+    best = numext::mini(
+        best, std::chrono::duration<double, std::nano>(end - start).count());
+  }
+  return best;
+}
+
+// Returns the time in nanoseconds of evaluating expr into dst, and the cost of
+// the evaluation as estimated by the cost model, per coefficient.
+template <typename Expression>
+double calibration_ns_per_coeff(TensorMap<Tensor<float, 1> >& dst,
+                                const Expression& expr, int iterations,
+                                TensorOpCost* cost) {
+  typedef TensorEvaluator<const Expression, DefaultDevice> Evaluator;
+  DefaultDevice device;
+  Evaluator evaluator(expr, device);
+  *cost = evaluator.costPerCoeff(
+      static_cast<bool>(Evaluator::PacketAccess));
+  const double ns =
+      calibration_time_ns(iterations, [&dst, &expr]() { dst = expr; });
+  return ns / (static_cast<double>(iterations) * dst.size());
+}
+
+// Returns the time in nanoseconds of scheduling num_tasks empty tasks on the
+// pool and waiting for their completion.
+inline double calibration_schedule_ns(ThreadPoolInterface* pool,
+                                      int num_tasks) {
+  return calibration_time_ns(100, [pool, num_tasks]() {
+    Barrier barrier(static_cast<unsigned int>(num_tasks));
+    for (int i = 0; i < num_tasks; ++i) {
+      pool->Schedule([&barrier]() { barrier.Notify(); });
+    }
+    barrier.Wait();
+  }) / 100;
+}
+
+}  // namespace internal
+
+/** Measures the parameters of TensorCostModel<ThreadPoolDevice> on the host.
+  *
+  * The device cycle is defined as the measured time of one compute cycle of
+  * the cost model, i.e. of one vectorized addition or multiplication. Loads
+  * and stores are measured on a buffer that fits in the L2 cache, which is
+  * what matters for the expressions the cost model is used on. The scheduling
+  * overheads are measured on the pool of \a device, and scaled by
+  * \a overhead_factor, the minimal ratio of useful work to parallelization
+  * overhead.
+  *
+  * The measurement takes a fraction of a second and perturbs the pool. Its
+  * result is typically installed once at startup with
+  * TensorCostModel<ThreadPoolDevice>::setParameters().
+  */
+inline TensorCostModelParameters calibrateTensorCostModel(
+    const ThreadPoolDevice& device, double overhead_factor = 10) {
+  eigen_assert(overhead_factor > 0);
+  TensorCostModelParameters params =
+      TensorCostModel<ThreadPoolDevice>::defaultParameters();
+
+  // Compute throughput: a polynomial evaluated on a buffer that fits in the L1
+  // cache, so that the memory accesses are negligible.
+  const Index l1_size = 2048;
+  Tensor<float, 1> a(l1_size);
+  Tensor<float, 1> b(l1_size);
+  a.setRandom();
+  TensorMap<Tensor<float, 1> > b_map(b.data(), l1_size);
+  const float c0 = 0.5f, c1 = 0.25f;
+  TensorOpCost cost;
+  const double poly_ns = internal::calibration_ns_per_coeff(
+      b_map,
+      ((((a * c0 + c1) * a + c0) * a + c1) * a + c0) * a + c1,
+      2000, &cost);
+  const double cycle_ns =
+      numext::maxi(poly_ns / cost.compute_cycles(), 1e-3);
+  params.device_cycles_per_compute_cycle = 1;
+
+  // Memory bandwidth: a fill measures stores, and a copy loads and stores.
+  const Index l2_size = numext::maxi<Index>(
+      l1_size, static_cast<Index>(l2CacheSize() / (2 * sizeof(float))));
+  Tensor<float, 1> src(l2_size);
+  Tensor<float, 1> dst(l2_size);
+  src.setRandom();
+  TensorMap<Tensor<float, 1> > dst_map(dst.data(), l2_size);
+  const int iterations = static_cast<int>(
+      numext::maxi<Index>(10, (Index(1) << 24) / l2_size));
+  const double store_ns = internal::calibration_ns_per_coeff(
+      dst_map, src.constant(1.0f), iterations, &cost);
+  const double copy_ns =
+      internal::calibration_ns_per_coeff(dst_map, src, iterations, &cost);
+  params.store_cycles_per_byte = store_ns / sizeof(float) / cycle_ns;
+  params.load_cycles_per_byte =
+      numext::maxi(copy_ns - store_ns, 0.0) / sizeof(float) / cycle_ns;
+
+  // Scheduling overheads: the round trip of a single task, the cost of each
+  // additional thread woken up, and the throughput of empty tasks.
+  ThreadPoolInterface* pool = device.getPool();
+  const int num_threads = device.numThreads();
+  const double startup_ns = internal::calibration_schedule_ns(pool, 1);
+  const double all_threads_ns =
+      internal::calibration_schedule_ns(pool, num_threads);
+  const double per_thread_ns =
+      num_threads > 1 ? (all_threads_ns - startup_ns) / (num_threads - 1)
+                      : startup_ns;
+  const int num_tasks = 64 * num_threads;
+  const double task_ns = internal::calibration_schedule_ns(pool, num_tasks) /
+                         num_tasks * num_threads;
+
+  params.startup_cycles = overhead_factor * startup_ns / cycle_ns;
+  params.per_thread_cycles =
+      numext::maxi(overhead_factor * per_thread_ns / cycle_ns, 1.0);
+  params.task_size = numext::maxi(overhead_factor * task_ns / cycle_ns, 1.0);
+  return params;
+}
+
+}  // namespace Eigen
+
+#endif  // EIGEN_CXX11_TENSOR_TENSOR_COST_MODEL_CALIBRATION_H
@@ -95,6 +95,22 @@ struct DefaultDevice {
   }
 };
 
+namespace internal {
+
+// Calls f on [0, n), split into shards of whole blocks which are evaluated in
+// parallel on the devices that support it (see the ThreadPoolDevice
+// specialization). Used by the evaluators that run their own loops on the
+// host, such as the FFT.
+template <typename Device>
+struct TensorParallelFor {
+  template <typename Function>
+  static void run(const Device&, Index n, const TensorOpCost&, Index /*block*/, Function f) {
+    f(0, n);
+  }
+};
+
+}  // namespace internal
+
 }  // namespace Eigen
 
 #endif // EIGEN_CXX11_TENSOR_TENSOR_DEVICE_DEFAULT_H
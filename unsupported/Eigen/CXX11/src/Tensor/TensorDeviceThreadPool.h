@@ -49,11 +49,186 @@ class Allocator {
   EIGEN_DEVICE_FUNC virtual void deallocate(void* buffer) const = 0;
 };
 
+// An Allocator that caches the freed buffers for reuse, to amortize the cost of
+// the temporary buffers allocated by every evaluation of a tensor expression.
+//
+// Buffer sizes are rounded up to size classes (4 classes per power of two).
+// Freed buffers are kept in free lists, one per size class, sharded by thread
+// so that threads rarely contend on the same mutex. An allocation first looks
+// into the free lists of the calling thread, then into the other ones if they
+// hold a buffer of the right class, and only allocates new memory when no
+// cached buffer of that class is left. Buffers smaller than a page are not
+// cached: malloc serves them from its per thread caches, which is faster than
+// the shared free lists.
+// Buffers are only returned to the system by Reset() (e.g. between the
+// evaluations of graphs with different shapes), by the destructor, or when the
+// cached memory would exceed max_cached_bytes.
+class ArenaAllocator : public Allocator {
+ public:
+  explicit ArenaAllocator(size_t max_cached_bytes = (std::numeric_limits<size_t>::max)(),
+                          int num_shards = 16)
+      : max_cached_bytes_(max_cached_bytes),
+        num_shards_(num_shards),
+        shards_(new Shard[num_shards]),
+        cached_bytes_(0),
+        num_system_allocations_(0) {
+    eigen_assert(num_shards > 0);
+    for (int c = 0; c < kNumSizeClasses; ++c) num_cached_[c] = 0;
+  }
+
+  ~ArenaAllocator() override {
+    Reset();
+    delete[] shards_;
+  }
+
+  void* allocate(size_t num_bytes) const override {
+    const int size_class = SizeClass(num_bytes);
+    if (size_class < kNumSizeClasses &&
+        num_cached_[size_class].load(std::memory_order_relaxed) > 0) {
+      const int first = CurrentShard();
+      for (int i = 0; i < num_shards_; ++i) {
+        Shard& shard = shards_[(first + i) % num_shards_];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        Header* header = shard.free_list[size_class];
+        if (header != NULL) {
+          shard.free_list[size_class] = header->next;
+          --num_cached_[size_class];
+          cached_bytes_ -= ClassSize(size_class);
+          return reinterpret_cast<char*>(header) + kHeaderSize;
+        }
+      }
+    }
+    const size_t size =
+        size_class < kNumSizeClasses ? ClassSize(size_class) : num_bytes;
+    ++num_system_allocations_;
+    Header* header = static_cast<Header*>(internal::aligned_malloc(kHeaderSize + size));
+    header->size_class = size_class;
+    header->next = NULL;
+    return reinterpret_cast<char*>(header) + kHeaderSize;
+  }
+
+  void deallocate(void* buffer) const override {
+    if (buffer == NULL) return;
+    Header* header = reinterpret_cast<Header*>(static_cast<char*>(buffer) - kHeaderSize);
+    const int size_class = header->size_class;
+    if (size_class >= kNumSizeClasses ||
+        cached_bytes_.fetch_add(ClassSize(size_class)) + ClassSize(size_class) > max_cached_bytes_) {
+      if (size_class < kNumSizeClasses) cached_bytes_ -= ClassSize(size_class);
+      internal::aligned_free(header);
+      return;
+    }
+    Shard& shard = shards_[CurrentShard()];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    header->next = shard.free_list[size_class];
+    shard.free_list[size_class] = header;
+    ++num_cached_[size_class];
+  }
+
+  // Returns all the cached buffers to the system. Buffers currently in use
+  // remain valid, and are cached again when deallocated.
+  void Reset() {
+    for (int i = 0; i < num_shards_; ++i) {
+      std::lock_guard<std::mutex> lock(shards_[i].mutex);
+      for (int c = 0; c < kNumSizeClasses; ++c) {
+        Header* header = shards_[i].free_list[c];
+        while (header != NULL) {
+          Header* next = header->next;
+          --num_cached_[c];
+          cached_bytes_ -= ClassSize(c);
+          internal::aligned_free(header);
+          header = next;
+        }
+        shards_[i].free_list[c] = NULL;
+      }
+    }
+  }
+
+  // Memory held in the free lists, in bytes.
+  size_t cachedBytes() const { return cached_bytes_; }
+
+  // Number of buffers that were not served from the free lists.
+  size_t numSystemAllocations() const { return num_system_allocations_; }
+
+ private:
+  // Buffers are preceded by a header, which keeps them aligned to
+  // EIGEN_MAX_ALIGN_BYTES.
+  struct Header {
+    Header* next;
+    int size_class;
+  };
+  static const size_t kHeaderSize = 64;
+  static_assert(EIGEN_MAX_ALIGN_BYTES <= 64 && sizeof(Header) <= 64,
+                "The buffer header must preserve the alignment");
+
+  // The smallest class holds a page of 4096 bytes, and larger buffers get 4
+  // classes per power of two up to 2^40 bytes.
+  static const int kMinLog2 = 12;
+  static const int kMaxLog2 = 40;
+  static const int kNumSizeClasses = 1 + 4 * (kMaxLog2 - kMinLog2);
+
+  struct Shard {
+    Shard() {
+      for (int c = 0; c < kNumSizeClasses; ++c) free_list[c] = NULL;
+    }
+    std::mutex mutex;
+    Header* free_list[kNumSizeClasses];
+    // Prevent false sharing.
+    char pad_[128];
+  };
+
+  // Returns kNumSizeClasses for the buffers that are not cached.
+  static int SizeClass(size_t num_bytes) {
+    if (num_bytes < (size_t(1) << kMinLog2)) return kNumSizeClasses;
+    if (num_bytes == (size_t(1) << kMinLog2)) return 0;
+    // 2^log2 <= num_bytes - 1 < 2^(log2 + 1).
+    int log2 = 0;
+    for (size_t v = num_bytes - 1; v > 1; v >>= 1) ++log2;
+    if (log2 >= kMaxLog2) return kNumSizeClasses;
+    const int quarter = static_cast<int>((num_bytes - 1) >> (log2 - 2)) - 4;
+    return 1 + 4 * (log2 - kMinLog2) + quarter;
+  }
+
+  static size_t ClassSize(int size_class) {
+    if (size_class == 0) return size_t(1) << kMinLog2;
+    const int log2 = kMinLog2 + (size_class - 1) / 4;
+    const size_t quarter = (size_class - 1) % 4;
+    return (5 + quarter) << (log2 - 2);
+  }
+
+  int CurrentShard() const {
+#ifdef EIGEN_THREAD_LOCAL
+    // The thread id hash doesn't depend on the allocator, compute it once.
+    EIGEN_THREAD_LOCAL size_t thread_hash =
+        std::hash<std::thread::id>()(std::this_thread::get_id());
+#else
+    const size_t thread_hash = std::hash<std::thread::id>()(std::this_thread::get_id());
+#endif
+    return static_cast<int>(thread_hash % static_cast<size_t>(num_shards_));
+  }
+
+  const size_t max_cached_bytes_;
+  const int num_shards_;
+  Shard* shards_;
+  // Number of buffers of each class in the free lists, which lets the
+  // allocations skip the shards when none is cached.
+  mutable std::atomic<int> num_cached_[kNumSizeClasses];
+  mutable std::atomic<size_t> cached_bytes_;
+  mutable std::atomic<size_t> num_system_allocations_;
+
+  ArenaAllocator(const ArenaAllocator&) = delete;
+  void operator=(const ArenaAllocator&) = delete;
+};
+
 // Build a thread pool device on top the an existing pool of threads.
 struct ThreadPoolDevice {
-  // The ownership of the thread pool remains with the caller.
-  ThreadPoolDevice(ThreadPoolInterface* pool, int num_cores, Allocator* allocator = NULL)
-      : pool_(pool), num_threads_(num_cores), allocator_(allocator) { }
+  // The ownership of the thread pool and of the allocators remains with the
+  // caller. If set, the scratch allocator serves the temporary buffers of the
+  // evaluators (see allocate_temp), e.g. an ArenaAllocator to reuse them
+  // across evaluations.
+  ThreadPoolDevice(ThreadPoolInterface* pool, int num_cores, Allocator* allocator = NULL,
+                   Allocator* scratch_allocator = NULL)
+      : pool_(pool), num_threads_(num_cores), allocator_(allocator),
+        scratch_allocator_(scratch_allocator) { }
 
   EIGEN_STRONG_INLINE void* allocate(size_t num_bytes) const {
     return allocator_ ? allocator_->allocate(num_bytes)
@@ -68,12 +243,17 @@ struct ThreadPoolDevice {
     }
   }
 
-    EIGEN_STRONG_INLINE void* allocate_temp(size_t num_bytes) const {
-    return allocate(num_bytes);
+  EIGEN_STRONG_INLINE void* allocate_temp(size_t num_bytes) const {
+    return scratch_allocator_ ? scratch_allocator_->allocate(num_bytes)
+        : allocate(num_bytes);
   }
 
   EIGEN_STRONG_INLINE void deallocate_temp(void* buffer) const {
-    deallocate(buffer);
+    if (scratch_allocator_) {
+      scratch_allocator_->deallocate(buffer);
+    } else {
+      deallocate(buffer);
+    }
   }
 
   EIGEN_STRONG_INLINE void memcpy(void* dst, const void* src, size_t n) const {
@@ -153,12 +333,131 @@ struct ThreadPoolDevice {
       return;
     }
 
-    // Calculate block size based on (1) the iteration cost and (2) parallel
-    // efficiency. We want blocks to be not too small to mitigate
-    // parallelization overheads; not too large to mitigate tail
-    // effect and potential load imbalance and we also want number
-    // of blocks to be evenly dividable across threads.
+    const ParallelForBlock block = calculateParallelForBlock(n, cost, block_align);
+
+    // Recursively divide size into halves until we reach block_size.
+    // Division code rounds mid to block_size, so we are guaranteed to get
+    // block_count leaves that do actual computations.
+    const Index block_size = block.size;
+    Barrier barrier(static_cast<unsigned int>(block.count));
+    std::function<void(Index, Index)> handleRange;
+    handleRange = [=, &handleRange, &barrier, &f](Index first, Index last) {
+      if (last - first <= block_size) {
+        // Single block or less, execute directly.
+        f(first, last);
+        barrier.Notify();
+        return;
+      }
+      // Split into halves and submit to the pool.
+      Index mid = first + divup((last - first) / 2, block_size) * block_size;
+      pool_->Schedule([=, &handleRange]() { handleRange(mid, last); });
+      handleRange(first, mid);
+    };
+    handleRange(0, n);
+    barrier.Wait();
+  }
+
+  // Convenience wrapper for parallelFor that does not align blocks.
+  void parallelFor(Index n, const TensorOpCost& cost,
+                   std::function<void(Index, Index)> f) const {
+    parallelFor(n, cost, NULL, std::move(f));
+  }
+
+  // parallelForAsync executes f with [0, n) arguments in parallel like
+  // parallelFor, but returns without waiting for completion: done is called,
+  // on whichever thread executes the last block, once all the blocks are
+  // processed. The blocks are the same as the ones of parallelFor. The caller
+  // may process some blocks itself, hence done can run on the calling thread
+  // before parallelForAsync returns, e.g. when the work is not worth
+  // parallelizing. It must not need any lock held by the caller.
+  void parallelForAsync(Index n, const TensorOpCost& cost,
+                        std::function<Index(Index)> block_align,
+                        std::function<void(Index, Index)> f,
+                        std::function<void()> done) const {
+    typedef TensorCostModel<ThreadPoolDevice> CostModel;
+    if (n <= 1 || numThreads() == 1 ||
+        CostModel::numThreads(n, cost, static_cast<int>(numThreads())) == 1) {
+      f(0, n);
+      done();
+      return;
+    }
+
+    const ParallelForBlock block = calculateParallelForBlock(n, cost, block_align);
+    ParallelForAsyncContext* const ctx =
+        new ParallelForAsyncContext(block.count, std::move(f), std::move(done));
+
+    // Same recursive division as in parallelFor. The context is deleted, and
+    // the done callback called, by the thread completing the last block.
+    const Index block_size = block.size;
+    ThreadPoolInterface* pool = pool_;
+    ctx->handle_range = [ctx, pool, block_size](Index first, Index last) {
+      while (last - first > block_size) {
+        // Split into halves and submit the second one to the pool.
+        const Index mid = first + divup((last - first) / 2, block_size) * block_size;
+        pool->Schedule([ctx, mid, last]() { ctx->handle_range(mid, last); });
+        last = mid;
+      }
+      ctx->f(first, last);
+      if (ctx->count.fetch_sub(1) == 1) delete ctx;
+    };
+
+    if (block.count <= numThreads()) {
+      // Save a thread hop by processing the first block in the caller thread.
+      ctx->handle_range(0, n);
+    } else {
+      // Otherwise the caller would process more blocks than the pool threads.
+      pool_->Schedule([ctx, n]() { ctx->handle_range(0, n); });
+    }
+  }
+
+  // Convenience wrapper for parallelForAsync that does not align blocks.
+  void parallelForAsync(Index n, const TensorOpCost& cost,
+                        std::function<void(Index, Index)> f,
+                        std::function<void()> done) const {
+    parallelForAsync(n, cost, NULL, std::move(f), std::move(done));
+  }
+
+  // Thread pool accessor.
+  ThreadPoolInterface* getPool() const { return pool_; }
+
+  // Allocator accessor.
+  Allocator* allocator() const { return allocator_; }
+
+  // Scratch allocator accessor.
+  Allocator* scratchAllocator() const { return scratch_allocator_; }
 
+ private:
+  // Size and count of the blocks processed by parallelFor.
+  struct ParallelForBlock {
+    Index size;
+    Index count;
+  };
+
+  // The state of a parallelForAsync, shared by the threads processing its
+  // blocks.
+  struct ParallelForAsyncContext {
+    ParallelForAsyncContext(Index block_count,
+                            std::function<void(Index, Index)> block_f,
+                            std::function<void()> done_callback)
+        : count(block_count), f(std::move(block_f)),
+          done(std::move(done_callback)) {}
+    ~ParallelForAsyncContext() { done(); }
+
+    std::atomic<Index> count;
+    std::function<void(Index, Index)> f;
+    std::function<void()> done;
+    std::function<void(Index, Index)> handle_range;
+  };
+
+  // Calculates the block size based on (1) the iteration cost and (2) parallel
+  // efficiency. We want blocks to be not too small to mitigate
+  // parallelization overheads; not too large to mitigate tail
+  // effect and potential load imbalance and we also want number
+  // of blocks to be evenly dividable across threads.
+  ParallelForBlock calculateParallelForBlock(
+      Index n, const TensorOpCost& cost,
+      std::function<Index(Index)> block_align) const {
+    typedef TensorCostModel<ThreadPoolDevice> CostModel;
     double block_size_f = 1.0 / CostModel::taskSize(1, cost);
     const Index max_oversharding_factor = 4;
     Index block_size = numext::mini(
@@ -208,45 +507,29 @@ struct ThreadPoolDevice {
       }
     }
 
-    // Recursively divide size into halves until we reach block_size.
-    // Division code rounds mid to block_size, so we are guaranteed to get
-    // block_count leaves that do actual computations.
-    Barrier barrier(static_cast<unsigned int>(block_count));
-    std::function<void(Index, Index)> handleRange;
-    handleRange = [=, &handleRange, &barrier, &f](Index first, Index last) {
-      if (last - first <= block_size) {
-        // Single block or less, execute directly.
-        f(first, last);
-        barrier.Notify();
-        return;
-      }
-      // Split into halves and submit to the pool.
-      Index mid = first + divup((last - first) / 2, block_size) * block_size;
-      pool_->Schedule([=, &handleRange]() { handleRange(mid, last); });
-      handleRange(first, mid);
-    };
-    handleRange(0, n);
-    barrier.Wait();
-  }
-
-  // Convenience wrapper for parallelFor that does not align blocks.
-  void parallelFor(Index n, const TensorOpCost& cost,
-                   std::function<void(Index, Index)> f) const {
-    parallelFor(n, cost, NULL, std::move(f));
+    ParallelForBlock block = { block_size, block_count };
+    return block;
   }
 
-  // Thread pool accessor.
-  ThreadPoolInterface* getPool() const { return pool_; }
-
-  // Allocator accessor.
-  Allocator* allocator() const { return allocator_; }
-
- private:
   ThreadPoolInterface* pool_;
   int num_threads_;
   Allocator* allocator_;
+  Allocator* scratch_allocator_;
+};
+
+namespace internal {
+
+template <>
+struct TensorParallelFor<ThreadPoolDevice> {
+  template <typename Function>
+  static void run(const ThreadPoolDevice& device, Index n, const TensorOpCost& cost,
+                  Index block, Function f) {
+    device.parallelFor(n, cost,
+                       [block](Index size) { return divup(size, block) * block; }, f);
+  }
 };
 
+}  // end namespace internal
 
 }  // end namespace Eigen
 
@@ -279,6 +279,13 @@ struct DSizes : array<DenseIndex, NumDims> {
   }
   EIGEN_DEVICE_FUNC explicit DSizes(const array<DenseIndex, NumDims>& a) : Base(a) { }
 
+  template <typename OtherIndex>
+  EIGEN_DEVICE_FUNC explicit DSizes(const array<OtherIndex, NumDims>& a) {
+    for (int i = 0 ; i < NumDims; ++i) {
+      (*this)[i] = static_cast<DenseIndex>(a[i]);
+    }
+  }
+
   EIGEN_DEVICE_FUNC explicit DSizes(const DenseIndex i0) {
     eigen_assert(NumDims == 1);
     (*this)[0] = i0;
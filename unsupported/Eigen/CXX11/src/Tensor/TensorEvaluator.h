@@ -23,6 +23,37 @@ namespace Eigen {
   * leading to lvalues (slicing, reshaping, etc...)
   */
 
+#ifdef EIGEN_USE_THREADS
+namespace internal {
+
+template <typename T> struct eval_sub_exprs_async_void { typedef void type; };
+
+/** \internal
+  * Evaluates the sub expressions of \a evaluator, and then calls done(need_assign) with the value that
+  * evalSubExprsIfNeeded() would return. The evaluators which compute their sub expressions in the thread pool
+  * (e.g. the contractions) implement evalSubExprsIfNeededAsync() to return before this computation completes,
+  * the other ones are evaluated synchronously in the calling thread.
+  */
+template <typename Evaluator, typename Enable = void>
+struct eval_sub_exprs_async {
+  template <typename Pointer, typename EvalSubExprsCallback>
+  static EIGEN_STRONG_INLINE void run(Evaluator& evaluator, Pointer data, EvalSubExprsCallback done) {
+    done(evaluator.evalSubExprsIfNeeded(data));
+  }
+};
+
+template <typename Evaluator>
+struct eval_sub_exprs_async<Evaluator, typename eval_sub_exprs_async_void<decltype(
+    std::declval<Evaluator&>().evalSubExprsIfNeededAsync(nullptr, std::function<void(bool)>()))>::type> {
+  template <typename Pointer, typename EvalSubExprsCallback>
+  static EIGEN_STRONG_INLINE void run(Evaluator& evaluator, Pointer data, EvalSubExprsCallback done) {
+    evaluator.evalSubExprsIfNeededAsync(data, std::move(done));
+  }
+};
+
+}  // end namespace internal
+#endif  // EIGEN_USE_THREADS
+
 // Generic evaluator
 template<typename Derived, typename Device>
 struct TensorEvaluator
@@ -378,6 +409,14 @@ struct TensorEvaluator<const TensorCwiseUnaryOp<UnaryOp, ArgType>, Device>
     m_argImpl.evalSubExprsIfNeeded(NULL);
     return true;
   }
+
+#ifdef EIGEN_USE_THREADS
+  template <typename EvalSubExprsCallback>
+  EIGEN_STRONG_INLINE void evalSubExprsIfNeededAsync(Scalar*, EvalSubExprsCallback done) {
+    internal::eval_sub_exprs_async<TensorEvaluator<ArgType, Device> >::run(
+        m_argImpl, nullptr, [done](bool) { done(true); });
+  }
+#endif  // EIGEN_USE_THREADS
   EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void cleanup() {
     m_argImpl.cleanup();
   }
@@ -469,6 +508,18 @@ struct TensorEvaluator<const TensorCwiseBinaryOp<BinaryOp, LeftArgType, RightArg
     m_rightImpl.evalSubExprsIfNeeded(NULL);
     return true;
   }
+
+#ifdef EIGEN_USE_THREADS
+  template <typename EvalSubExprsCallback>
+  EIGEN_STRONG_INLINE void evalSubExprsIfNeededAsync(CoeffReturnType*, EvalSubExprsCallback done) {
+    // Evaluate the left and then the right sub expression.
+    internal::eval_sub_exprs_async<TensorEvaluator<LeftArgType, Device> >::run(
+        m_leftImpl, nullptr, [this, done](bool) {
+          internal::eval_sub_exprs_async<TensorEvaluator<RightArgType, Device> >::run(
+              m_rightImpl, nullptr, [done](bool) { done(true); });
+        });
+  }
+#endif  // EIGEN_USE_THREADS
   EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void cleanup() {
     m_leftImpl.cleanup();
     m_rightImpl.cleanup();
@@ -591,6 +642,20 @@ struct TensorEvaluator<const TensorCwiseTernaryOp<TernaryOp, Arg1Type, Arg2Type,
     m_arg3Impl.evalSubExprsIfNeeded(NULL);
     return true;
   }
+
+#ifdef EIGEN_USE_THREADS
+  template <typename EvalSubExprsCallback>
+  EIGEN_STRONG_INLINE void evalSubExprsIfNeededAsync(CoeffReturnType*, EvalSubExprsCallback done) {
+    internal::eval_sub_exprs_async<TensorEvaluator<Arg1Type, Device> >::run(
+        m_arg1Impl, nullptr, [this, done](bool) {
+          internal::eval_sub_exprs_async<TensorEvaluator<Arg2Type, Device> >::run(
+              m_arg2Impl, nullptr, [this, done](bool) {
+                internal::eval_sub_exprs_async<TensorEvaluator<Arg3Type, Device> >::run(
+                    m_arg3Impl, nullptr, [done](bool) { done(true); });
+              });
+        });
+  }
+#endif  // EIGEN_USE_THREADS
   EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void cleanup() {
     m_arg1Impl.cleanup();
     m_arg2Impl.cleanup();
@@ -682,6 +747,20 @@ struct TensorEvaluator<const TensorSelectOp<IfArgType, ThenArgType, ElseArgType>
     m_elseImpl.evalSubExprsIfNeeded(NULL);
     return true;
   }
+
+#ifdef EIGEN_USE_THREADS
+  template <typename EvalSubExprsCallback>
+  EIGEN_STRONG_INLINE void evalSubExprsIfNeededAsync(CoeffReturnType*, EvalSubExprsCallback done) {
+    internal::eval_sub_exprs_async<TensorEvaluator<IfArgType, Device> >::run(
+        m_condImpl, nullptr, [this, done](bool) {
+          internal::eval_sub_exprs_async<TensorEvaluator<ThenArgType, Device> >::run(
+              m_thenImpl, nullptr, [this, done](bool) {
+                internal::eval_sub_exprs_async<TensorEvaluator<ElseArgType, Device> >::run(
+                    m_elseImpl, nullptr, [done](bool) { done(true); });
+              });
+        });
+  }
+#endif  // EIGEN_USE_THREADS
   EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void cleanup() {
     m_condImpl.cleanup();
     m_thenImpl.cleanup();
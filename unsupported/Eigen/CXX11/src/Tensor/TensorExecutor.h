@@ -138,8 +138,9 @@ class TensorExecutor<Expression, DefaultDevice, Vectorizable,
       evaluator.getResourceRequirements(&resources);
       MergeResourceRequirements(resources, &block_shape, &block_total_size);
 
-      TensorBlockMapper block_mapper(evaluator.dimensions(), block_shape,
-                                     block_total_size);
+      TensorBlockMapper block_mapper(
+          typename TensorBlockMapper::Dimensions(evaluator.dimensions()),
+          block_shape, block_total_size);
       block_total_size = block_mapper.block_dims_total_size();
 
       Scalar* data = static_cast<Scalar*>(
@@ -280,13 +281,14 @@ class TensorExecutor<Expression, ThreadPoolDevice, Vectorizable, /*Tileable*/ tr
       TensorOpCost cost = evaluator.costPerCoeff(Vectorizable);
       double taskSize = TensorCostModel<ThreadPoolDevice>::taskSize(1, cost);
       size_t block_size = static_cast<size_t>(1.0 / taskSize);
-      TensorBlockMapper block_mapper(evaluator.dimensions(), block_shape,
-                                     block_size);
+      TensorBlockMapper block_mapper(
+          typename TensorBlockMapper::Dimensions(evaluator.dimensions()),
+          block_shape, block_size);
       block_size = block_mapper.block_dims_total_size();
       const size_t aligned_blocksize =
           EIGEN_MAX_ALIGN_BYTES *
           divup<size_t>(block_size * sizeof(Scalar), EIGEN_MAX_ALIGN_BYTES);
-      void* buf = device.allocate((num_threads + 1) * aligned_blocksize);
+      void* buf = device.allocate_temp((num_threads + 1) * aligned_blocksize);
       device.parallelFor(
           block_mapper.total_block_count(), cost * block_size,
           [=, &device, &evaluator, &block_mapper](StorageIndex first,
@@ -303,12 +305,192 @@ class TensorExecutor<Expression, ThreadPoolDevice, Vectorizable, /*Tileable*/ tr
               evaluator.evalBlock(&block);
             }
           });
-      device.deallocate(buf);
+      device.deallocate_temp(buf);
     }
     evaluator.cleanup();
   }
 };
 
+/** \internal
+ * Asynchronous evaluation on the thread pool: runAsync() only schedules the
+ * evaluation of the expression and returns immediately, `done` is called once
+ * the result is fully computed, from one of the pool threads or, when the
+ * calling thread evaluates some blocks itself, possibly from the calling
+ * thread before runAsync() returns. The expression
+ * evaluator is kept on the heap until then, while the tensors referenced by
+ * the expression and the device must outlive the evaluation.
+ */
+template <typename Expression, typename DoneCallback, bool Vectorizable,
+          bool Tileable>
+class TensorAsyncExecutor<Expression, ThreadPoolDevice, DoneCallback,
+                          Vectorizable, Tileable> {
+ public:
+  typedef typename Expression::Index StorageIndex;
+  typedef TensorEvaluator<Expression, ThreadPoolDevice> Evaluator;
+
+  static EIGEN_STRONG_INLINE void runAsync(const Expression& expr,
+                                           const ThreadPoolDevice& device,
+                                           DoneCallback done) {
+    TensorAsyncExecutorContext* const ctx =
+        new TensorAsyncExecutorContext(expr, device, std::move(done));
+
+    const auto on_eval_subexprs = [ctx, &device](bool need_assign) -> void {
+      if (!need_assign) {
+        delete ctx;
+        return;
+      }
+
+      typedef EvalRange<Evaluator, StorageIndex, Vectorizable> EvalRange;
+      const StorageIndex size = array_prod(ctx->evaluator.dimensions());
+      device.parallelForAsync(
+          size, ctx->evaluator.costPerCoeff(Vectorizable),
+          EvalRange::alignBlockSize,
+          [ctx](StorageIndex first, StorageIndex last) {
+            EvalRange::run(&ctx->evaluator, first, last);
+          },
+          [ctx]() { delete ctx; });
+    };
+
+    internal::eval_sub_exprs_async<Evaluator>::run(ctx->evaluator, nullptr,
+                                                   on_eval_subexprs);
+  }
+
+ private:
+  struct TensorAsyncExecutorContext {
+    TensorAsyncExecutorContext(const Expression& expr,
+                               const ThreadPoolDevice& thread_pool,
+                               DoneCallback done)
+        : evaluator(expr, thread_pool), on_done(std::move(done)) {}
+
+    ~TensorAsyncExecutorContext() {
+      evaluator.cleanup();
+      on_done();
+    }
+
+    Evaluator evaluator;
+
+   private:
+    DoneCallback on_done;
+  };
+};
+
+template <typename Expression, typename DoneCallback, bool Vectorizable>
+class TensorAsyncExecutor<Expression, ThreadPoolDevice, DoneCallback,
+                          Vectorizable, /*Tileable*/ true> {
+ public:
+  typedef typename traits<Expression>::Scalar Scalar;
+  typedef typename remove_const<Scalar>::type ScalarNoConst;
+
+  typedef TensorEvaluator<Expression, ThreadPoolDevice> Evaluator;
+  typedef typename traits<Expression>::Index StorageIndex;
+
+  static const int NumDims = traits<Expression>::NumDimensions;
+  typedef TensorBlockMapper<ScalarNoConst, StorageIndex, NumDims,
+                            Evaluator::Layout>
+      BlockMapper;
+
+  static EIGEN_STRONG_INLINE void runAsync(const Expression& expr,
+                                           const ThreadPoolDevice& device,
+                                           DoneCallback done) {
+    TensorAsyncExecutorContext* const ctx =
+        new TensorAsyncExecutorContext(expr, device, std::move(done));
+
+    const Index total_size = array_prod(ctx->evaluator.dimensions());
+    const Index cache_size = device.firstLevelCacheSize() / sizeof(Scalar);
+    const bool tile = total_size >= cache_size;
+
+    const auto on_eval_subexprs = [ctx, &device, tile](bool need_assign) -> void {
+      if (!need_assign) {
+        delete ctx;
+        return;
+      }
+
+      if (!tile) {
+        // TODO(andydavis) Reduce block management overhead for small tensors.
+        typedef EvalRange<Evaluator, StorageIndex, Vectorizable> EvalRange;
+        const StorageIndex size = array_prod(ctx->evaluator.dimensions());
+        device.parallelForAsync(
+            size, ctx->evaluator.costPerCoeff(Vectorizable),
+            EvalRange::alignBlockSize,
+            [ctx](StorageIndex first, StorageIndex last) {
+              EvalRange::run(&ctx->evaluator, first, last);
+            },
+            [ctx]() { delete ctx; });
+        return;
+      }
+
+      TensorBlockShapeType block_shape = kSkewedInnerDims;
+      Index block_total_size = 0;
+      // Query expression tree for desired block size/shape.
+      std::vector<internal::TensorOpResourceRequirements> resources;
+      ctx->evaluator.getResourceRequirements(&resources);
+      MergeResourceRequirements(resources, &block_shape, &block_total_size);
+      const int num_threads = device.numThreads();
+
+      // Estimate minimum block size based on cost.
+      const TensorOpCost cost = ctx->evaluator.costPerCoeff(Vectorizable);
+      const double taskSize = TensorCostModel<ThreadPoolDevice>::taskSize(1, cost);
+      size_t block_size = static_cast<size_t>(1.0 / taskSize);
+      ctx->block_mapper = new BlockMapper(
+          typename BlockMapper::Dimensions(ctx->evaluator.dimensions()),
+          block_shape, block_size);
+      block_size = ctx->block_mapper->block_dims_total_size();
+      const size_t aligned_blocksize =
+          EIGEN_MAX_ALIGN_BYTES *
+          divup<size_t>(block_size * sizeof(Scalar), EIGEN_MAX_ALIGN_BYTES);
+      ctx->buf = device.allocate_temp((num_threads + 1) * aligned_blocksize);
+      device.parallelForAsync(
+          ctx->block_mapper->total_block_count(), cost * block_size,
+          [ctx, &device, num_threads, aligned_blocksize](StorageIndex first,
+                                                         StorageIndex last) {
+            // currentThreadId() returns -1 if called from a thread not in the
+            // thread pool, such as the thread scheduling the evaluation.
+            const int thread_idx = device.currentThreadId();
+            eigen_assert(thread_idx >= -1 && thread_idx < num_threads);
+            EIGEN_UNUSED_VARIABLE(num_threads);
+            Scalar* thread_buf = reinterpret_cast<Scalar*>(
+                static_cast<char*>(ctx->buf) +
+                aligned_blocksize * (thread_idx + 1));
+            for (StorageIndex i = first; i < last; ++i) {
+              auto block = ctx->block_mapper->GetBlockForIndex(i, thread_buf);
+              ctx->evaluator.evalBlock(&block);
+            }
+          },
+          [ctx]() { delete ctx; });
+    };
+
+    internal::eval_sub_exprs_async<Evaluator>::run(ctx->evaluator, nullptr,
+                                                   on_eval_subexprs);
+  }
+
+ private:
+  struct TensorAsyncExecutorContext {
+    TensorAsyncExecutorContext(const Expression& expr,
+                               const ThreadPoolDevice& thread_pool,
+                               DoneCallback done)
+        : device(thread_pool),
+          evaluator(expr, thread_pool),
+          block_mapper(NULL),
+          buf(NULL),
+          on_done(std::move(done)) {}
+
+    ~TensorAsyncExecutorContext() {
+      if (buf) device.deallocate_temp(buf);
+      delete block_mapper;
+      evaluator.cleanup();
+      on_done();
+    }
+
+    const ThreadPoolDevice& device;
+    Evaluator evaluator;
+    BlockMapper* block_mapper;
+    void* buf;
+
+   private:
+    DoneCallback on_done;
+  };
+};
+
 #endif  // EIGEN_USE_THREADS
 
 
@@ -10,8 +10,7 @@
 #ifndef EIGEN_CXX11_TENSOR_TENSOR_FFT_H
 #define EIGEN_CXX11_TENSOR_TENSOR_FFT_H
 
-// This code requires the ability to initialize arrays of constant
-// values directly inside a class.
+// This code requires lambdas, std::shared_ptr and std::mutex.
 #if __cplusplus >= 201103L || EIGEN_COMP_MSVC >= 1900
 
 namespace Eigen {
@@ -22,8 +21,6 @@ namespace Eigen {
   * \brief Tensor FFT class.
   *
   * TODO:
-  * Vectorize the Cooley Tukey and the Bluestein algorithm
-  * Add support for multithreaded evaluation
   * Improve the performance on GPU
   */
 
@@ -84,6 +81,240 @@ struct nested<TensorFFTOp<FFT, XprType, FFTResultType, FFTDirection>, 1, typenam
   typedef TensorFFTOp<FFT, XprType, FFTResultType, FFTDirection> type;
 };
 
+/** \internal
+  * Precomputed data of the FFTs of a given size in a given direction.
+  *
+  * Sizes that are powers of two are transformed by an iterative Cooley Tukey
+  * algorithm, which permutes the input in bit reversed order and then merges
+  * the sub FFTs four at a time (plus one radix 2 stage if the number of stages
+  * is odd). The twiddle factors of each stage are stored contiguously so that
+  * the butterflies are computed with packets of complex numbers.
+  *
+  * Other sizes are transformed by Bluestein's algorithm, as a convolution
+  * computed with FFTs of a power of two fft_size >= 2 * size - 1: the plan
+  * also holds the chirp of the input and the FFT of the convolution kernel,
+  * scaled by 1 / fft_size.
+  */
+template <typename RealScalar>
+struct TensorFFTPlan {
+  typedef std::complex<RealScalar> ComplexScalar;
+
+  TensorFFTPlan(Index n, int direction) : size(n), fft_size(n) {
+    eigen_assert(n > 0);
+    const bool is_power_of_two = !(n & (n - 1));
+    if (!is_power_of_two) {
+      fft_size = 2;
+      while (fft_size < 2 * n - 1) fft_size *= 2;
+    }
+
+    // Bit reversal permutation.
+    Index log2_fft_size = 0;
+    while ((Index(1) << log2_fft_size) < fft_size) ++log2_fft_size;
+    bit_reverse.resize(fft_size);
+    for (Index i = 0; i < fft_size; ++i) {
+      Index reversed = 0;
+      for (Index b = 0; b < log2_fft_size; ++b) {
+        reversed |= ((i >> b) & 1) << (log2_fft_size - 1 - b);
+      }
+      bit_reverse[i] = reversed;
+    }
+
+    // The stage merging the sub FFTs of size h uses the twiddle factors
+    // exp(-i * pi * k / h) for k < h, stored at offset h - 1.
+    twiddles.resize(numext::maxi<Index>(fft_size - 1, 1));
+    for (Index h = 1; h < fft_size; h *= 2) {
+      for (Index k = 0; k < h; ++k) {
+        const double arg = -EIGEN_PI * static_cast<double>(k) / static_cast<double>(h);
+        twiddles[h - 1 + k] = ComplexScalar(static_cast<RealScalar>(std::cos(arg)),
+                                            static_cast<RealScalar>(std::sin(arg)));
+      }
+    }
+
+    if (!is_power_of_two) {
+      // chirp[j] = exp(-+ i * pi * j^2 / n), where j^2 is reduced modulo 2n
+      // to compute the argument accurately for large transforms.
+      chirp.resize(n + 1);
+      Index j2 = 0;
+      for (Index j = 0; j <= n; ++j) {
+        const double arg = EIGEN_PI * static_cast<double>(j2) / static_cast<double>(n);
+        const std::complex<double> tmp(std::cos(arg), direction == FFT_FORWARD ? -std::sin(arg) : std::sin(arg));
+        chirp[j] = static_cast<ComplexScalar>(tmp);
+        j2 = (j2 + 2 * j + 1) % (2 * n);
+      }
+
+      kernel_fft.resize(fft_size);
+      std::fill(kernel_fft.begin(), kernel_fft.end(), ComplexScalar(0, 0));
+      for (Index j = 0; j < n; ++j) {
+        kernel_fft[j] = numext::conj(chirp[j]);
+      }
+      for (Index j = fft_size - n; j < fft_size; ++j) {
+        kernel_fft[j] = numext::conj(chirp[fft_size - j]);
+      }
+      transform<FFT_FORWARD>(&kernel_fft[0]);
+      const RealScalar scale = RealScalar(1) / static_cast<RealScalar>(fft_size);
+      for (Index j = 0; j < fft_size; ++j) {
+        kernel_fft[j] *= scale;
+      }
+    }
+  }
+
+  bool isBluestein() const { return fft_size != size; }
+
+  // Transforms the fft_size coefficients of data in place, without scaling.
+  template <int Dir>
+  void transform(ComplexScalar* data) const {
+    typedef typename packet_traits<ComplexScalar>::type Packet;
+    const Index PacketSize = unpacket_traits<Packet>::size;
+
+    for (Index i = 0; i < fft_size; ++i) {
+      const Index j = bit_reverse[i];
+      if (j > i) std::swap(data[i], data[j]);
+    }
+
+    Index h = 1;
+    Index log2_fft_size = 0;
+    while ((Index(1) << log2_fft_size) < fft_size) ++log2_fft_size;
+    if (log2_fft_size % 2 == 1) {
+      for (Index i = 0; i < fft_size; i += 2) {
+        const ComplexScalar tmp = data[i + 1];
+        data[i + 1] = data[i] - tmp;
+        data[i] += tmp;
+      }
+      h = 2;
+    }
+    for (; 4 * h <= fft_size; h *= 4) {
+      const ComplexScalar* tw1 = &twiddles[h - 1];
+      const ComplexScalar* tw2 = &twiddles[2 * h - 1];
+      for (Index base = 0; base < fft_size; base += 4 * h) {
+        ComplexScalar* x = data + base;
+        Index k = 0;
+        for (; k + PacketSize <= h; k += PacketSize) {
+          radix4<Dir, Packet>(x, h, k, tw1, tw2);
+        }
+        for (; k < h; ++k) {
+          radix4<Dir, ComplexScalar>(x, h, k, tw1, tw2);
+        }
+      }
+    }
+  }
+
+  // Merges the coefficients k of the 4 sub FFTs of size h starting at x, as
+  // two radix 2 stages.
+  template <int Dir, typename Packet>
+  static EIGEN_STRONG_INLINE void radix4(ComplexScalar* x, Index h, Index k,
+                                         const ComplexScalar* tw1, const ComplexScalar* tw2) {
+    Packet w1 = ploadu<Packet>(tw1 + k);
+    Packet w2 = ploadu<Packet>(tw2 + k);
+    if (Dir == FFT_REVERSE) {
+      w1 = pconj(w1);
+      w2 = pconj(w2);
+    }
+    const Packet x0 = ploadu<Packet>(x + k);
+    const Packet t1 = pmul(w1, ploadu<Packet>(x + k + h));
+    const Packet x2 = ploadu<Packet>(x + k + 2 * h);
+    const Packet t3 = pmul(w1, ploadu<Packet>(x + k + 3 * h));
+    const Packet a = padd(x0, t1);
+    const Packet b = psub(x0, t1);
+    const Packet tc = pmul(w2, padd(x2, t3));
+    // Multiply by exp(-+ i * pi / 2) = -+i.
+    const Packet wd = pmul(w2, psub(x2, t3));
+    const Packet td = Dir == FFT_FORWARD ? pconj(pcplxflip(wd)) : pcplxflip(pconj(wd));
+    pstoreu(x + k, padd(a, tc));
+    pstoreu(x + k + h, padd(b, td));
+    pstoreu(x + k + 2 * h, psub(a, tc));
+    pstoreu(x + k + 3 * h, psub(b, td));
+  }
+
+  // Computes the unscaled FFT of the size coefficients of data in place,
+  // using work as scratch memory of fft_size coefficients for Bluestein's
+  // algorithm.
+  template <int Dir>
+  void run(ComplexScalar* data, ComplexScalar* work) const {
+    if (!isBluestein()) {
+      transform<Dir>(data);
+      return;
+    }
+    for (Index j = 0; j < size; ++j) {
+      work[j] = data[j] * chirp[j];
+    }
+    for (Index j = size; j < fft_size; ++j) {
+      work[j] = ComplexScalar(0, 0);
+    }
+    transform<FFT_FORWARD>(work);
+    typedef typename packet_traits<ComplexScalar>::type Packet;
+    const Index PacketSize = unpacket_traits<Packet>::size;
+    Index j = 0;
+    for (; j + PacketSize <= fft_size; j += PacketSize) {
+      pstoreu(work + j, pmul(ploadu<Packet>(work + j), ploadu<Packet>(&kernel_fft[j])));
+    }
+    for (; j < fft_size; ++j) {
+      work[j] *= kernel_fft[j];
+    }
+    transform<FFT_REVERSE>(work);
+    for (j = 0; j < size; ++j) {
+      data[j] = work[j] * chirp[j];
+    }
+  }
+
+  // Number of floating point operations of a transform.
+  double flops() const {
+    double log2_fft_size = 0;
+    while ((Index(1) << static_cast<int>(log2_fft_size)) < fft_size) ++log2_fft_size;
+    const double flops = 5.0 * static_cast<double>(fft_size) * log2_fft_size;
+    return isBluestein() ? 2 * flops + 18.0 * static_cast<double>(fft_size) : flops;
+  }
+
+  Index size;
+  Index fft_size;
+  std::vector<Index> bit_reverse;
+  std::vector<ComplexScalar> twiddles;
+  std::vector<ComplexScalar> chirp;
+  std::vector<ComplexScalar> kernel_fft;
+};
+
+/** \internal
+  * Process wide cache of the plans of the FFTs, keyed by size and direction,
+  * so that the twiddle factors are computed once rather than for every
+  * evaluation of an FFT expression.
+  */
+template <typename RealScalar>
+class TensorFFTPlanCache {
+ public:
+  typedef TensorFFTPlan<RealScalar> Plan;
+
+  // The cache is flushed when it grows larger than this number of plans.
+  static const size_t kMaxPlans = 64;
+
+  static std::shared_ptr<const Plan> get(Index size, int direction) {
+    const std::pair<Index, int> key(size, direction);
+    {
+      std::lock_guard<std::mutex> lock(mutex());
+      typename PlanMap::const_iterator it = plans().find(key);
+      if (it != plans().end()) return it->second;
+    }
+    // Compute the plan without holding the lock, a concurrent computation of
+    // the same plan is harmless.
+    std::shared_ptr<const Plan> plan = std::make_shared<const Plan>(size, direction);
+    std::lock_guard<std::mutex> lock(mutex());
+    if (plans().size() >= kMaxPlans) plans().clear();
+    plans()[key] = plan;
+    return plan;
+  }
+
+ private:
+  typedef std::map<std::pair<Index, int>, std::shared_ptr<const Plan> > PlanMap;
+
+  static std::mutex& mutex() {
+    static std::mutex m;
+    return m;
+  }
+
+  static PlanMap& plans() {
+    static PlanMap m;
+    return m;
+  }
+};
+
 }  // end namespace internal
 
 template <typename FFT, typename XprType, int FFTResultType, int FFTDir>
@@ -166,13 +397,13 @@ struct TensorEvaluator<const TensorFFTOp<FFT, ArgType, FFTResultType, FFTDir>, D
     return m_dimensions;
   }
 
-  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE bool evalSubExprsIfNeeded(OutputScalar* data) {
+  EIGEN_STRONG_INLINE bool evalSubExprsIfNeeded(OutputScalar* data) {
     m_impl.evalSubExprsIfNeeded(NULL);
     if (data) {
       evalToBuf(data);
       return false;
     } else {
-      m_data = (CoeffReturnType*)m_device.allocate(sizeof(CoeffReturnType) * m_size);
+      m_data = (CoeffReturnType*)m_device.allocate_temp(sizeof(CoeffReturnType) * m_size);
       evalToBuf(m_data);
       return true;
     }
@@ -180,7 +411,7 @@ struct TensorEvaluator<const TensorFFTOp<FFT, ArgType, FFTResultType, FFTDir>, D
 
   EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void cleanup() {
     if (m_data) {
-      m_device.deallocate(m_data);
+      m_device.deallocate_temp(m_data);
       m_data = NULL;
     }
     m_impl.cleanup();
@@ -205,341 +436,116 @@ struct TensorEvaluator<const TensorFFTOp<FFT, ArgType, FFTResultType, FFTDir>, D
 
 
  private:
-  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void evalToBuf(OutputScalar* data) {
+  typedef internal::TensorFFTPlan<RealScalar> Plan;
+
+  // Lines along a dimension other than the innermost one are gathered by
+  // blocks of adjacent lines, which are contiguous in memory for each index
+  // along the dimension, so as to read and write whole cache lines.
+  static const Index kLineBlock = 16;
+  // Maximum number of coefficients of a block of lines.
+  static const Index kLineBlockCoeffs = 32768;
+
+  void evalToBuf(OutputScalar* data) {
+    typedef internal::TensorParallelFor<Device> ParallelFor;
     const bool write_to_out = internal::is_same<OutputScalar, ComplexScalar>::value;
-    ComplexScalar* buf = write_to_out ? (ComplexScalar*)data : (ComplexScalar*)m_device.allocate(sizeof(ComplexScalar) * m_size);
+    ComplexScalar* buf = write_to_out ? (ComplexScalar*)data : (ComplexScalar*)m_device.allocate_temp(sizeof(ComplexScalar) * m_size);
 
-    for (Index i = 0; i < m_size; ++i) {
-      buf[i] = MakeComplex<internal::is_same<InputScalar, RealScalar>::value>()(m_impl.coeff(i));
-    }
+    ParallelFor::run(m_device, m_size, m_impl.costPerCoeff(false) + TensorOpCost(0, sizeof(ComplexScalar), 0), 1,
+                     [this, buf](Index first, Index last) {
+      for (Index i = first; i < last; ++i) {
+        buf[i] = MakeComplex<internal::is_same<InputScalar, RealScalar>::value>()(m_impl.coeff(i));
+      }
+    });
 
     for (size_t i = 0; i < m_fft.size(); ++i) {
-      Index dim = m_fft[i];
+      const Index dim = m_fft[i];
       eigen_assert(dim >= 0 && dim < NumDims);
-      Index line_len = m_dimensions[dim];
+      const Index line_len = m_dimensions[dim];
       eigen_assert(line_len >= 1);
-      ComplexScalar* line_buf = (ComplexScalar*)m_device.allocate(sizeof(ComplexScalar) * line_len);
-      const bool is_power_of_two = isPowerOfTwo(line_len);
-      const Index good_composite = is_power_of_two ? 0 : findGoodComposite(line_len);
-      const Index log_len = is_power_of_two ? getLog2(line_len) : getLog2(good_composite);
-
-      ComplexScalar* a = is_power_of_two ? NULL : (ComplexScalar*)m_device.allocate(sizeof(ComplexScalar) * good_composite);
-      ComplexScalar* b = is_power_of_two ? NULL : (ComplexScalar*)m_device.allocate(sizeof(ComplexScalar) * good_composite);
-      ComplexScalar* pos_j_base_powered = is_power_of_two ? NULL : (ComplexScalar*)m_device.allocate(sizeof(ComplexScalar) * (line_len + 1));
-      if (!is_power_of_two) {
-        // Compute twiddle factors
-        //   t_n = exp(sqrt(-1) * pi * n^2 / line_len)
-        // for n = 0, 1,..., line_len-1.
-        // For n > 2 we use the recurrence t_n = t_{n-1}^2 / t_{n-2} * t_1^2
-
-        // The recurrence is correct in exact arithmetic, but causes
-        // numerical issues for large transforms, especially in
-        // single-precision floating point.
-        //
-        // pos_j_base_powered[0] = ComplexScalar(1, 0);
-        // if (line_len > 1) {
-        //   const ComplexScalar pos_j_base = ComplexScalar(
-        //       numext::cos(M_PI / line_len), numext::sin(M_PI / line_len));
-        //   pos_j_base_powered[1] = pos_j_base;
-        //   if (line_len > 2) {
-        //     const ComplexScalar pos_j_base_sq = pos_j_base * pos_j_base;
-        //     for (int i = 2; i < line_len + 1; ++i) {
-        //       pos_j_base_powered[i] = pos_j_base_powered[i - 1] *
-        //           pos_j_base_powered[i - 1] /
-        //           pos_j_base_powered[i - 2] *
-        //           pos_j_base_sq;
-        //     }
-        //   }
-        // }
-        // TODO(rmlarsen): Find a way to use Eigen's vectorized sin
-        // and cosine functions here.
-        for (int j = 0; j < line_len + 1; ++j) {
-          double arg = ((EIGEN_PI * j) * j) / line_len;
-          std::complex<double> tmp(numext::cos(arg), numext::sin(arg));
-          pos_j_base_powered[j] = static_cast<ComplexScalar>(tmp);
-        }
-      }
-
-      for (Index partial_index = 0; partial_index < m_size / line_len; ++partial_index) {
-        const Index base_offset = getBaseOffsetFromIndex(partial_index, dim);
-
-        // get data into line_buf
-        const Index stride = m_strides[dim];
-        if (stride == 1) {
-          m_device.memcpy(line_buf, &buf[base_offset], line_len*sizeof(ComplexScalar));
-        } else {
-          Index offset = base_offset;
-          for (int j = 0; j < line_len; ++j, offset += stride) {
-            line_buf[j] = buf[offset];
-          }
-        }
-
-        // process the line
-        if (is_power_of_two) {
-          processDataLineCooleyTukey(line_buf, line_len, log_len);
-        }
-        else {
-          processDataLineBluestein(line_buf, line_len, good_composite, log_len, a, b, pos_j_base_powered);
-        }
-
-        // write back
-        if (FFTDir == FFT_FORWARD && stride == 1) {
-          m_device.memcpy(&buf[base_offset], line_buf, line_len*sizeof(ComplexScalar));
-        } else {
-          Index offset = base_offset;
-          const ComplexScalar div_factor =  ComplexScalar(1.0 / line_len, 0);
-          for (int j = 0; j < line_len; ++j, offset += stride) {
-             buf[offset] = (FFTDir == FFT_FORWARD) ? line_buf[j] : line_buf[j] * div_factor;
-          }
-        }
-      }
-      m_device.deallocate(line_buf);
-      if (!is_power_of_two) {
-        m_device.deallocate(a);
-        m_device.deallocate(b);
-        m_device.deallocate(pos_j_base_powered);
-      }
+      std::shared_ptr<const Plan> plan = internal::TensorFFTPlanCache<RealScalar>::get(line_len, FFTDir);
+
+      const Index stride = m_strides[dim];
+      const Index line_block = stride == 1 ? 1 : numext::maxi<Index>(1, numext::mini(kLineBlock, kLineBlockCoeffs / line_len));
+      const Index num_lines = m_size / line_len;
+      const TensorOpCost line_cost(2 * sizeof(ComplexScalar) * line_len, 2 * sizeof(ComplexScalar) * line_len,
+                                   plan->flops());
+      const Plan& line_plan = *plan;
+      ParallelFor::run(m_device, num_lines, line_cost, line_block,
+                       [this, buf, dim, line_block, &line_plan](Index first, Index last) {
+        processLines(buf, dim, line_plan, line_block, first, last);
+      });
     }
 
     if(!write_to_out) {
-      for (Index i = 0; i < m_size; ++i) {
-        data[i] = PartOf<FFTResultType>()(buf[i]);
-      }
-      m_device.deallocate(buf);
+      ParallelFor::run(m_device, m_size, TensorOpCost(sizeof(ComplexScalar), sizeof(OutputScalar), 0), 1,
+                       [data, buf](Index first, Index last) {
+        for (Index i = first; i < last; ++i) {
+          data[i] = PartOf<FFTResultType>()(buf[i]);
+        }
+      });
+      m_device.deallocate_temp(buf);
     }
   }
 
-  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE static bool isPowerOfTwo(Index x) {
-    eigen_assert(x > 0);
-    return !(x & (x - 1));
-  }
-
-  // The composite number for padding, used in Bluestein's FFT algorithm
-  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE static Index findGoodComposite(Index n) {
-    Index i = 2;
-    while (i < 2 * n - 1) i *= 2;
-    return i;
-  }
-
-  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE static Index getLog2(Index m) {
-    Index log2m = 0;
-    while (m >>= 1) log2m++;
-    return log2m;
-  }
-
-  // Call Cooley Tukey algorithm directly, data length must be power of 2
-  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void processDataLineCooleyTukey(ComplexScalar* line_buf, Index line_len, Index log_len) {
-    eigen_assert(isPowerOfTwo(line_len));
-    scramble_FFT(line_buf, line_len);
-    compute_1D_Butterfly<FFTDir>(line_buf, line_len, log_len);
-  }
-
-  // Call Bluestein's FFT algorithm, m is a good composite number greater than (2 * n - 1), used as the padding length
-  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void processDataLineBluestein(ComplexScalar* line_buf, Index line_len, Index good_composite, Index log_len, ComplexScalar* a, ComplexScalar* b, const ComplexScalar* pos_j_base_powered) {
-    Index n = line_len;
-    Index m = good_composite;
-    ComplexScalar* data = line_buf;
-
-    for (Index i = 0; i < n; ++i) {
-      if(FFTDir == FFT_FORWARD) {
-        a[i] = data[i] * numext::conj(pos_j_base_powered[i]);
-      }
-      else {
-        a[i] = data[i] * pos_j_base_powered[i];
-      }
-    }
-    for (Index i = n; i < m; ++i) {
-      a[i] = ComplexScalar(0, 0);
-    }
-
-    for (Index i = 0; i < n; ++i) {
-      if(FFTDir == FFT_FORWARD) {
-        b[i] = pos_j_base_powered[i];
-      }
-      else {
-        b[i] = numext::conj(pos_j_base_powered[i]);
-      }
-    }
-    for (Index i = n; i < m - n; ++i) {
-      b[i] = ComplexScalar(0, 0);
-    }
-    for (Index i = m - n; i < m; ++i) {
-      if(FFTDir == FFT_FORWARD) {
-        b[i] = pos_j_base_powered[m-i];
-      }
-      else {
-        b[i] = numext::conj(pos_j_base_powered[m-i]);
+  // Computes the FFTs of the lines [first, last) along dim, by blocks of up
+  // to line_block adjacent lines.
+  void processLines(ComplexScalar* buf, Index dim, const Plan& plan, Index line_block,
+                    Index first, Index last) const {
+    const Index line_len = m_dimensions[dim];
+    const Index stride = m_strides[dim];
+    const ComplexScalar div_factor = ComplexScalar(RealScalar(1) / static_cast<RealScalar>(line_len), 0);
+
+    const Index scratch_size = (stride == 1 ? 0 : line_block * line_len) + (plan.isBluestein() ? plan.fft_size : 0);
+    ComplexScalar* scratch = scratch_size == 0 ? NULL : (ComplexScalar*)m_device.allocate_temp(sizeof(ComplexScalar) * scratch_size);
+    ComplexScalar* lines = scratch;
+    ComplexScalar* work = stride == 1 ? scratch : scratch + line_block * line_len;
+
+    for (Index partial_index = first; partial_index < last;) {
+      const Index base_offset = getBaseOffsetFromIndex(partial_index, dim);
+
+      if (stride == 1) {
+        // The line is contiguous, transform it in place.
+        ComplexScalar* line = &buf[base_offset];
+        plan.template run<FFTDir>(line, work);
+        if (FFTDir == FFT_REVERSE) {
+          for (Index j = 0; j < line_len; ++j) {
+            line[j] *= div_factor;
+          }
+        }
+        ++partial_index;
+        continue;
       }
-    }
-
-    scramble_FFT(a, m);
-    compute_1D_Butterfly<FFT_FORWARD>(a, m, log_len);
-
-    scramble_FFT(b, m);
-    compute_1D_Butterfly<FFT_FORWARD>(b, m, log_len);
-
-    for (Index i = 0; i < m; ++i) {
-      a[i] *= b[i];
-    }
-
-    scramble_FFT(a, m);
-    compute_1D_Butterfly<FFT_REVERSE>(a, m, log_len);
 
-    //Do the scaling after ifft
-    for (Index i = 0; i < m; ++i) {
-      a[i] /= m;
-    }
+      // The lines partial_index, partial_index + 1, ... start at consecutive
+      // offsets up to the next multiple of stride.
+      const Index num_lines = numext::mini(numext::mini(line_block, last - partial_index),
+                                           stride - partial_index % stride);
 
-    for (Index i = 0; i < n; ++i) {
-      if(FFTDir == FFT_FORWARD) {
-        data[i] = a[i] * numext::conj(pos_j_base_powered[i]);
-      }
-      else {
-        data[i] = a[i] * pos_j_base_powered[i];
+      // get data into lines
+      Index offset = base_offset;
+      for (Index j = 0; j < line_len; ++j, offset += stride) {
+        for (Index l = 0; l < num_lines; ++l) {
+          lines[l * line_len + j] = buf[offset + l];
+        }
       }
-    }
-  }
 
-  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE static void scramble_FFT(ComplexScalar* data, Index n) {
-    eigen_assert(isPowerOfTwo(n));
-    Index j = 1;
-    for (Index i = 1; i < n; ++i){
-      if (j > i) {
-        std::swap(data[j-1], data[i-1]);
+      // process the lines
+      for (Index l = 0; l < num_lines; ++l) {
+        plan.template run<FFTDir>(lines + l * line_len, work);
       }
-      Index m = n >> 1;
-      while (m >= 2 && j > m) {
-        j -= m;
-        m >>= 1;
-      }
-      j += m;
-    }
-  }
-
-  template <int Dir>
-  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void butterfly_2(ComplexScalar* data) {
-    ComplexScalar tmp = data[1];
-    data[1] = data[0] - data[1];
-    data[0] += tmp;
-  }
-
-  template <int Dir>
-  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void butterfly_4(ComplexScalar* data) {
-    ComplexScalar tmp[4];
-    tmp[0] = data[0] + data[1];
-    tmp[1] = data[0] - data[1];
-    tmp[2] = data[2] + data[3];
-    if (Dir == FFT_FORWARD) {
-      tmp[3] = ComplexScalar(0.0, -1.0) * (data[2] - data[3]);
-    } else {
-      tmp[3] = ComplexScalar(0.0, 1.0) * (data[2] - data[3]);
-    }
-    data[0] = tmp[0] + tmp[2];
-    data[1] = tmp[1] + tmp[3];
-    data[2] = tmp[0] - tmp[2];
-    data[3] = tmp[1] - tmp[3];
-  }
-
-  template <int Dir>
-  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void butterfly_8(ComplexScalar* data) {
-    ComplexScalar tmp_1[8];
-    ComplexScalar tmp_2[8];
-
-    tmp_1[0] = data[0] + data[1];
-    tmp_1[1] = data[0] - data[1];
-    tmp_1[2] = data[2] + data[3];
-    if (Dir == FFT_FORWARD) {
-      tmp_1[3] = (data[2] - data[3]) * ComplexScalar(0, -1);
-    } else {
-      tmp_1[3] = (data[2] - data[3]) * ComplexScalar(0, 1);
-    }
-    tmp_1[4] = data[4] + data[5];
-    tmp_1[5] = data[4] - data[5];
-    tmp_1[6] = data[6] + data[7];
-    if (Dir == FFT_FORWARD) {
-      tmp_1[7] = (data[6] - data[7]) * ComplexScalar(0, -1);
-    } else {
-      tmp_1[7] = (data[6] - data[7]) * ComplexScalar(0, 1);
-    }
-    tmp_2[0] = tmp_1[0] + tmp_1[2];
-    tmp_2[1] = tmp_1[1] + tmp_1[3];
-    tmp_2[2] = tmp_1[0] - tmp_1[2];
-    tmp_2[3] = tmp_1[1] - tmp_1[3];
-    tmp_2[4] = tmp_1[4] + tmp_1[6];
-// SQRT2DIV2 = sqrt(2)/2
-#define SQRT2DIV2 0.7071067811865476
-    if (Dir == FFT_FORWARD) {
-      tmp_2[5] = (tmp_1[5] + tmp_1[7]) * ComplexScalar(SQRT2DIV2, -SQRT2DIV2);
-      tmp_2[6] = (tmp_1[4] - tmp_1[6]) * ComplexScalar(0, -1);
-      tmp_2[7] = (tmp_1[5] - tmp_1[7]) * ComplexScalar(-SQRT2DIV2, -SQRT2DIV2);
-    } else {
-      tmp_2[5] = (tmp_1[5] + tmp_1[7]) * ComplexScalar(SQRT2DIV2, SQRT2DIV2);
-      tmp_2[6] = (tmp_1[4] - tmp_1[6]) * ComplexScalar(0, 1);
-      tmp_2[7] = (tmp_1[5] - tmp_1[7]) * ComplexScalar(-SQRT2DIV2, SQRT2DIV2);
-    }
-    data[0] = tmp_2[0] + tmp_2[4];
-    data[1] = tmp_2[1] + tmp_2[5];
-    data[2] = tmp_2[2] + tmp_2[6];
-    data[3] = tmp_2[3] + tmp_2[7];
-    data[4] = tmp_2[0] - tmp_2[4];
-    data[5] = tmp_2[1] - tmp_2[5];
-    data[6] = tmp_2[2] - tmp_2[6];
-    data[7] = tmp_2[3] - tmp_2[7];
-  }
 
-  template <int Dir>
-  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void butterfly_1D_merge(
-      ComplexScalar* data, Index n, Index n_power_of_2) {
-    // Original code:
-    // RealScalar wtemp = std::sin(M_PI/n);
-    // RealScalar wpi =  -std::sin(2 * M_PI/n);
-    const RealScalar wtemp = m_sin_PI_div_n_LUT[n_power_of_2];
-    const RealScalar wpi = (Dir == FFT_FORWARD)
-                               ? m_minus_sin_2_PI_div_n_LUT[n_power_of_2]
-                               : -m_minus_sin_2_PI_div_n_LUT[n_power_of_2];
-
-    const ComplexScalar wp(wtemp, wpi);
-    const ComplexScalar wp_one = wp + ComplexScalar(1, 0);
-    const ComplexScalar wp_one_2 = wp_one * wp_one;
-    const ComplexScalar wp_one_3 = wp_one_2 * wp_one;
-    const ComplexScalar wp_one_4 = wp_one_3 * wp_one;
-    const Index n2 = n / 2;
-    ComplexScalar w(1.0, 0.0);
-    for (Index i = 0; i < n2; i += 4) {
-       ComplexScalar temp0(data[i + n2] * w);
-       ComplexScalar temp1(data[i + 1 + n2] * w * wp_one);
-       ComplexScalar temp2(data[i + 2 + n2] * w * wp_one_2);
-       ComplexScalar temp3(data[i + 3 + n2] * w * wp_one_3);
-       w = w * wp_one_4;
-
-       data[i + n2] = data[i] - temp0;
-       data[i] += temp0;
-
-       data[i + 1 + n2] = data[i + 1] - temp1;
-       data[i + 1] += temp1;
-
-       data[i + 2 + n2] = data[i + 2] - temp2;
-       data[i + 2] += temp2;
-
-       data[i + 3 + n2] = data[i + 3] - temp3;
-       data[i + 3] += temp3;
+      // write back
+      offset = base_offset;
+      for (Index j = 0; j < line_len; ++j, offset += stride) {
+        for (Index l = 0; l < num_lines; ++l) {
+          buf[offset + l] = (FFTDir == FFT_FORWARD) ? lines[l * line_len + j] : lines[l * line_len + j] * div_factor;
+        }
+      }
+      partial_index += num_lines;
     }
-  }
 
- template <int Dir>
-  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void compute_1D_Butterfly(
-      ComplexScalar* data, Index n, Index n_power_of_2) {
-    eigen_assert(isPowerOfTwo(n));
-    if (n > 8) {
-      compute_1D_Butterfly<Dir>(data, n / 2, n_power_of_2 - 1);
-      compute_1D_Butterfly<Dir>(data + n / 2, n / 2, n_power_of_2 - 1);
-      butterfly_1D_merge<Dir>(data, n, n_power_of_2);
-    } else if (n == 8) {
-      butterfly_8<Dir>(data);
-    } else if (n == 4) {
-      butterfly_4<Dir>(data);
-    } else if (n == 2) {
-      butterfly_2<Dir>(data);
+    if (scratch) {
+      m_device.deallocate_temp(scratch);
     }
   }
 
@@ -568,11 +574,6 @@ struct TensorEvaluator<const TensorFFTOp<FFT, ArgType, FFTResultType, FFTDir>, D
     return result;
   }
 
-  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE Index getIndexFromOffset(Index base, Index omitted_dim, Index offset) const {
-    Index result = base + offset * m_strides[omitted_dim] ;
-    return result;
-  }
-
  protected:
   Index m_size;
   const FFT& m_fft;
@@ -581,79 +582,6 @@ struct TensorEvaluator<const TensorFFTOp<FFT, ArgType, FFTResultType, FFTDir>, D
   TensorEvaluator<ArgType, Device> m_impl;
   CoeffReturnType* m_data;
   const Device& m_device;
-
-  // This will support a maximum FFT size of 2^32 for each dimension
-  // m_sin_PI_div_n_LUT[i] = (-2) * std::sin(M_PI / std::pow(2,i)) ^ 2;
-  const RealScalar m_sin_PI_div_n_LUT[32] = {
-    RealScalar(0.0),
-    RealScalar(-2),
-    RealScalar(-0.999999999999999),
-    RealScalar(-0.292893218813453),
-    RealScalar(-0.0761204674887130),
-    RealScalar(-0.0192147195967696),
-    RealScalar(-0.00481527332780311),
-    RealScalar(-0.00120454379482761),
-    RealScalar(-3.01181303795779e-04),
-    RealScalar(-7.52981608554592e-05),
-    RealScalar(-1.88247173988574e-05),
-    RealScalar(-4.70619042382852e-06),
-    RealScalar(-1.17654829809007e-06),
-    RealScalar(-2.94137117780840e-07),
-    RealScalar(-7.35342821488550e-08),
-    RealScalar(-1.83835707061916e-08),
-    RealScalar(-4.59589268710903e-09),
-    RealScalar(-1.14897317243732e-09),
-    RealScalar(-2.87243293150586e-10),
-    RealScalar( -7.18108232902250e-11),
-    RealScalar(-1.79527058227174e-11),
-    RealScalar(-4.48817645568941e-12),
-    RealScalar(-1.12204411392298e-12),
-    RealScalar(-2.80511028480785e-13),
-    RealScalar(-7.01277571201985e-14),
-    RealScalar(-1.75319392800498e-14),
-    RealScalar(-4.38298482001247e-15),
-    RealScalar(-1.09574620500312e-15),
-    RealScalar(-2.73936551250781e-16),
-    RealScalar(-6.84841378126949e-17),
-    RealScalar(-1.71210344531737e-17),
-    RealScalar(-4.28025861329343e-18)
-  };
-
-  // m_minus_sin_2_PI_div_n_LUT[i] = -std::sin(2 * M_PI / std::pow(2,i));
-  const RealScalar m_minus_sin_2_PI_div_n_LUT[32] = {
-    RealScalar(0.0),
-    RealScalar(0.0),
-    RealScalar(-1.00000000000000e+00),
-    RealScalar(-7.07106781186547e-01),
-    RealScalar(-3.82683432365090e-01),
-    RealScalar(-1.95090322016128e-01),
-    RealScalar(-9.80171403295606e-02),
-    RealScalar(-4.90676743274180e-02),
-    RealScalar(-2.45412285229123e-02),
-    RealScalar(-1.22715382857199e-02),
-    RealScalar(-6.13588464915448e-03),
-    RealScalar(-3.06795676296598e-03),
-    RealScalar(-1.53398018628477e-03),
-    RealScalar(-7.66990318742704e-04),
-    RealScalar(-3.83495187571396e-04),
-    RealScalar(-1.91747597310703e-04),
-    RealScalar(-9.58737990959773e-05),
-    RealScalar(-4.79368996030669e-05),
-    RealScalar(-2.39684498084182e-05),
-    RealScalar(-1.19842249050697e-05),
-    RealScalar(-5.99211245264243e-06),
-    RealScalar(-2.99605622633466e-06),
-    RealScalar(-1.49802811316901e-06),
-    RealScalar(-7.49014056584716e-07),
-    RealScalar(-3.74507028292384e-07),
-    RealScalar(-1.87253514146195e-07),
-    RealScalar(-9.36267570730981e-08),
-    RealScalar(-4.68133785365491e-08),
-    RealScalar(-2.34066892682746e-08),
-    RealScalar(-1.17033446341373e-08),
-    RealScalar(-5.85167231706864e-09),
-    RealScalar(-2.92583615853432e-09)
-  };
 };
 
 }  // end namespace Eigen
@@ -0,0 +1,538 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_CXX11_TENSOR_TENSOR_NORMALIZATION_H
+#define EIGEN_CXX11_TENSOR_TENSOR_NORMALIZATION_H
+
+namespace Eigen {
+
+/** \class TensorNormalization
+  * \ingroup CXX11_Tensor_Module
+  *
+  * \brief Tensor normalization class.
+  *
+  * Computes (x - mean) / sqrt(variance + epsilon), where the mean and the
+  * biased variance of x are reduced along the given dimensions and broadcast
+  * back to the dimensions of x. The moments are computed in a single pass
+  * over the input (Welford's algorithm), and the result is streamed by a
+  * second pass, whereas the equivalent expression made of reductions and
+  * broadcasts materializes each reduction and reads the input 4 to 5 times.
+  */
+
+namespace internal {
+template<typename Dims, typename XprType>
+struct traits<TensorNormalizationOp<Dims, XprType> > : public traits<XprType>
+{
+  typedef typename XprType::Scalar Scalar;
+  typedef traits<XprType> XprTraits;
+  typedef typename XprTraits::StorageKind StorageKind;
+  typedef typename XprTraits::Index Index;
+  typedef typename XprType::Nested Nested;
+  typedef typename remove_reference<Nested>::type _Nested;
+  static const int NumDimensions = XprTraits::NumDimensions;
+  static const int Layout = XprTraits::Layout;
+  typedef typename XprTraits::PointerType PointerType;
+};
+
+template<typename Dims, typename XprType>
+struct eval<TensorNormalizationOp<Dims, XprType>, Eigen::Dense>
+{
+  typedef const TensorNormalizationOp<Dims, XprType>& type;
+};
+
+template<typename Dims, typename XprType>
+struct nested<TensorNormalizationOp<Dims, XprType>, 1, typename eval<TensorNormalizationOp<Dims, XprType> >::type>
+{
+  typedef TensorNormalizationOp<Dims, XprType> type;
+};
+
+// Mean and sum of the squared deviations from the mean of count coefficients.
+template <typename Scalar>
+struct WelfordMoments
+{
+  EIGEN_STRONG_INLINE WelfordMoments() : count(0), mean(Scalar(0)), m2(Scalar(0)) {}
+
+  // Merges the moments of a disjoint set of coefficients (Chan et al.).
+  EIGEN_STRONG_INLINE void merge(Index other_count, const Scalar& other_mean, const Scalar& other_m2) {
+    const Index total = count + other_count;
+    const Scalar delta = other_mean - mean;
+    const Scalar weight = static_cast<Scalar>(other_count) / static_cast<Scalar>(total);
+    mean += delta * weight;
+    m2 += other_m2 + delta * delta * static_cast<Scalar>(count) * weight;
+    count = total;
+  }
+
+  Index count;
+  Scalar mean;
+  Scalar m2;
+};
+
+// Moments of the size contiguous coefficients of an evaluator starting at
+// first, computed by blocks of kBlockSize coefficients: the block is summed,
+// its squared deviations from its mean are summed while it is in the L1
+// cache, and its moments are merged with the ones of the previous blocks.
+template <typename Evaluator, bool Vectorized>
+struct ContiguousMoments
+{
+  typedef typename Evaluator::Scalar Scalar;
+  static const Index kBlockSize = 256;
+
+  static WelfordMoments<Scalar> run(const Evaluator& eval, Index first, Index size) {
+    WelfordMoments<Scalar> moments;
+    for (Index block = first; block < first + size; block += kBlockSize) {
+      const Index block_end = numext::mini(block + kBlockSize, first + size);
+      Scalar sum(0);
+      for (Index i = block; i < block_end; ++i) {
+        sum += eval.coeff(i);
+      }
+      const Scalar mean = sum / static_cast<Scalar>(block_end - block);
+      Scalar m2(0);
+      for (Index i = block; i < block_end; ++i) {
+        const Scalar delta = eval.coeff(i) - mean;
+        m2 += delta * delta;
+      }
+      moments.merge(block_end - block, mean, m2);
+    }
+    return moments;
+  }
+};
+
+template <typename Evaluator>
+struct ContiguousMoments<Evaluator, true>
+{
+  typedef typename Evaluator::Scalar Scalar;
+  typedef typename Evaluator::PacketReturnType Packet;
+  static const Index kBlockSize = 256;
+
+  static WelfordMoments<Scalar> run(const Evaluator& eval, Index first, Index size) {
+    const Index PacketSize = unpacket_traits<Packet>::size;
+    WelfordMoments<Scalar> moments;
+    for (Index block = first; block < first + size; block += kBlockSize) {
+      const Index block_end = numext::mini(block + kBlockSize, first + size);
+      const Index packet_end = block + ((block_end - block) / PacketSize) * PacketSize;
+      Packet psum = pset1<Packet>(Scalar(0));
+      for (Index i = block; i < packet_end; i += PacketSize) {
+        psum = padd(psum, eval.template packet<Unaligned>(i));
+      }
+      Scalar sum = predux(psum);
+      for (Index i = packet_end; i < block_end; ++i) {
+        sum += eval.coeff(i);
+      }
+      const Scalar mean = sum / static_cast<Scalar>(block_end - block);
+      const Packet pmean = pset1<Packet>(mean);
+      Packet pm2 = pset1<Packet>(Scalar(0));
+      for (Index i = block; i < packet_end; i += PacketSize) {
+        const Packet delta = psub(eval.template packet<Unaligned>(i), pmean);
+        pm2 = pmadd(delta, delta, pm2);
+      }
+      Scalar m2 = predux(pm2);
+      for (Index i = packet_end; i < block_end; ++i) {
+        const Scalar delta = eval.coeff(i) - mean;
+        m2 += delta * delta;
+      }
+      moments.merge(block_end - block, mean, m2);
+    }
+    return moments;
+  }
+};
+
+// Moments of the coefficients r * stride + p of an evaluator, for r in
+// [0, count) and p in [first, last), computed for all p at once with the
+// Welford update of each coefficient in turn.
+template <typename Evaluator, bool Vectorized>
+struct StridedMoments
+{
+  typedef typename Evaluator::Scalar Scalar;
+
+  static void run(const Evaluator& eval, Index stride, Index count, Index first, Index last,
+                  Scalar* mean, Scalar* m2) {
+    for (Index p = first; p < last; ++p) {
+      mean[p] = Scalar(0);
+      m2[p] = Scalar(0);
+    }
+    for (Index r = 0; r < count; ++r) {
+      const Scalar inv_count = Scalar(1) / static_cast<Scalar>(r + 1);
+      for (Index p = first; p < last; ++p) {
+        const Scalar x = eval.coeff(r * stride + p);
+        const Scalar delta = x - mean[p];
+        mean[p] += delta * inv_count;
+        m2[p] += delta * (x - mean[p]);
+      }
+    }
+  }
+};
+
+template <typename Evaluator>
+struct StridedMoments<Evaluator, true>
+{
+  typedef typename Evaluator::Scalar Scalar;
+  typedef typename Evaluator::PacketReturnType Packet;
+
+  static void run(const Evaluator& eval, Index stride, Index count, Index first, Index last,
+                  Scalar* mean, Scalar* m2) {
+    const Index PacketSize = unpacket_traits<Packet>::size;
+    const Index packet_last = first + ((last - first) / PacketSize) * PacketSize;
+    for (Index p = first; p < last; ++p) {
+      mean[p] = Scalar(0);
+      m2[p] = Scalar(0);
+    }
+    for (Index r = 0; r < count; ++r) {
+      const Scalar inv_count = Scalar(1) / static_cast<Scalar>(r + 1);
+      const Packet pinv_count = pset1<Packet>(inv_count);
+      for (Index p = first; p < packet_last; p += PacketSize) {
+        const Packet x = eval.template packet<Unaligned>(r * stride + p);
+        Packet pmean = ploadu<Packet>(mean + p);
+        const Packet delta = psub(x, pmean);
+        pmean = pmadd(delta, pinv_count, pmean);
+        pstoreu(mean + p, pmean);
+        pstoreu(m2 + p, pmadd(delta, psub(x, pmean), ploadu<Packet>(m2 + p)));
+      }
+      for (Index p = packet_last; p < last; ++p) {
+        const Scalar x = eval.coeff(r * stride + p);
+        const Scalar delta = x - mean[p];
+        mean[p] += delta * inv_count;
+        m2[p] += delta * (x - mean[p]);
+      }
+    }
+  }
+};
+
+} // end namespace internal
+
+
+template<typename Dims, typename XprType>
+class TensorNormalizationOp : public TensorBase<TensorNormalizationOp<Dims, XprType>, ReadOnlyAccessors>
+{
+  public:
+    typedef typename Eigen::internal::traits<TensorNormalizationOp>::Scalar Scalar;
+    typedef typename Eigen::NumTraits<Scalar>::Real RealScalar;
+    typedef typename XprType::CoeffReturnType CoeffReturnType;
+    typedef typename Eigen::internal::nested<TensorNormalizationOp>::type Nested;
+    typedef typename Eigen::internal::traits<TensorNormalizationOp>::StorageKind StorageKind;
+    typedef typename Eigen::internal::traits<TensorNormalizationOp>::Index Index;
+
+    EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE TensorNormalizationOp(const XprType& expr, const Dims& dims, const RealScalar& epsilon)
+      : m_xpr(expr), m_dims(dims), m_epsilon(epsilon) {
+    }
+
+    EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE
+    const Dims& dims() const { return m_dims; }
+
+    EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE
+    const RealScalar& epsilon() const { return m_epsilon; }
+
+    EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE
+    const typename internal::remove_all<typename XprType::Nested>::type& expression() const { return m_xpr; }
+
+  protected:
+    typename XprType::Nested m_xpr;
+    const Dims m_dims;
+    const RealScalar m_epsilon;
+};
+
+
+// Eval as rvalue
+template<typename Dims, typename ArgType, typename Device>
+struct TensorEvaluator<const TensorNormalizationOp<Dims, ArgType>, Device>
+{
+  typedef TensorNormalizationOp<Dims, ArgType> XprType;
+  static const int NumDims = internal::array_size<typename TensorEvaluator<ArgType, Device>::Dimensions>::value;
+  static const int NumReducedDims = internal::array_size<Dims>::value;
+  typedef typename XprType::Index Index;
+  typedef DSizes<Index, NumDims> Dimensions;
+  typedef typename XprType::Scalar Scalar;
+  typedef typename XprType::CoeffReturnType CoeffReturnType;
+  typedef typename PacketType<CoeffReturnType, Device>::type PacketReturnType;
+  static const int PacketSize = internal::unpacket_traits<PacketReturnType>::size;
+
+  enum {
+    IsAligned = false,
+    PacketAccess = TensorEvaluator<ArgType, Device>::PacketAccess,
+    BlockAccess = false,
+    Layout = TensorEvaluator<ArgType, Device>::Layout,
+    CoordAccess = false,
+    RawAccess = false
+  };
+
+  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE TensorEvaluator(const XprType& op, const Device& device)
+    : m_impl(op.expression(), device), m_device(device), m_epsilon(op.epsilon()),
+      m_preservedSize(1), m_reducedSize(1), m_mean(NULL), m_scale(NULL)
+  {
+    EIGEN_STATIC_ASSERT((NumDims > 0), YOU_MADE_A_PROGRAMMING_MISTAKE);
+    EIGEN_STATIC_ASSERT((NumReducedDims <= NumDims), YOU_MADE_A_PROGRAMMING_MISTAKE);
+
+    for (int i = 0; i < NumDims; ++i) {
+      m_reduced[i] = false;
+    }
+    const Dims& op_dims = op.dims();
+    for (int i = 0; i < NumReducedDims; ++i) {
+      eigen_assert(op_dims[i] >= 0);
+      eigen_assert(op_dims[i] < NumDims);
+      eigen_assert(!m_reduced[op_dims[i]]);
+      m_reduced[op_dims[i]] = true;
+    }
+
+    const Dimensions& dims = m_impl.dimensions();
+    for (int i = 0; i < NumDims; ++i) {
+      m_dimensions[i] = dims[i];
+      if (m_reduced[i]) {
+        m_reducedSize *= dims[i];
+      } else {
+        m_preservedSize *= dims[i];
+      }
+    }
+
+    // The reduced dimensions are the innermost ones when they come first
+    // in memory order, and the outermost ones when they come last.
+    bool reduced_first = true;
+    bool reduced_last = true;
+    for (int k = 0; k < NumDims; ++k) {
+      const int i = static_cast<int>(Layout) == static_cast<int>(ColMajor) ? k : NumDims - 1 - k;
+      if (k < NumReducedDims) {
+        reduced_first = reduced_first && m_reduced[i];
+      }
+      if (k < NumDims - NumReducedDims) {
+        reduced_last = reduced_last && !m_reduced[i];
+      }
+    }
+    m_kind = reduced_first ? kInnerReduced : (reduced_last ? kOuterReduced : kGeneric);
+    m_fastReducedSize = internal::TensorIntDivisor<Index>(numext::maxi<Index>(m_reducedSize, 1));
+    m_fastPreservedSize = internal::TensorIntDivisor<Index>(numext::maxi<Index>(m_preservedSize, 1));
+
+    // Strides of the input, and of the preserved dimensions in the tensor of
+    // the moments.
+    Index input_stride = 1;
+    Index preserved_stride = 1;
+    for (int k = 0; k < NumDims; ++k) {
+      const int i = static_cast<int>(Layout) == static_cast<int>(ColMajor) ? k : NumDims - 1 - k;
+      m_strides[i] = input_stride;
+      m_fastStrides[i] = internal::TensorIntDivisor<Index>(input_stride);
+      input_stride *= dims[i];
+      m_preservedStrides[i] = m_reduced[i] ? 0 : preserved_stride;
+      if (!m_reduced[i]) {
+        preserved_stride *= dims[i];
+      }
+    }
+  }
+
+  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE const Dimensions& dimensions() const { return m_dimensions; }
+
+  EIGEN_STRONG_INLINE bool evalSubExprsIfNeeded(Scalar* /*data*/) {
+    m_impl.evalSubExprsIfNeeded(NULL);
+    m_mean = static_cast<Scalar*>(m_device.allocate_temp(m_preservedSize * sizeof(Scalar)));
+    m_scale = static_cast<Scalar*>(m_device.allocate_temp(m_preservedSize * sizeof(Scalar)));
+    computeMoments();
+    return true;
+  }
+
+  EIGEN_STRONG_INLINE void cleanup() {
+    if (m_mean) {
+      m_device.deallocate_temp(m_mean);
+      m_device.deallocate_temp(m_scale);
+      m_mean = NULL;
+      m_scale = NULL;
+    }
+    m_impl.cleanup();
+  }
+
+  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE CoeffReturnType coeff(Index index) const
+  {
+    const Index p = preservedIndex(index);
+    return (m_impl.coeff(index) - m_mean[p]) * m_scale[p];
+  }
+
+  template<int LoadMode>
+  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE PacketReturnType packet(Index index) const
+  {
+    EIGEN_STATIC_ASSERT((PacketSize > 1), YOU_MADE_A_PROGRAMMING_MISTAKE)
+    eigen_assert(index + PacketSize - 1 < m_preservedSize * m_reducedSize);
+
+    if (m_kind == kInnerReduced) {
+      // The packet is normalized with a single mean unless it straddles 2
+      // groups of reduced coefficients.
+      const Index p = index / m_fastReducedSize;
+      if (index + PacketSize <= (p + 1) * m_reducedSize) {
+        return internal::pmul(internal::psub(m_impl.template packet<LoadMode>(index),
+                                             internal::pset1<PacketReturnType>(m_mean[p])),
+                              internal::pset1<PacketReturnType>(m_scale[p]));
+      }
+    } else if (m_kind == kOuterReduced) {
+      // The means of consecutive coefficients are consecutive, unless the
+      // packet wraps around the end of the tensor of the moments.
+      const Index p = index - (index / m_fastPreservedSize) * m_preservedSize;
+      if (p + PacketSize <= m_preservedSize) {
+        return internal::pmul(internal::psub(m_impl.template packet<LoadMode>(index),
+                                             internal::ploadu<PacketReturnType>(m_mean + p)),
+                              internal::ploadu<PacketReturnType>(m_scale + p));
+      }
+    }
+
+    EIGEN_ALIGN_MAX typename internal::remove_const<CoeffReturnType>::type values[PacketSize];
+    for (int i = 0; i < PacketSize; ++i) {
+      values[i] = coeff(index + i);
+    }
+    return internal::pload<PacketReturnType>(values);
+  }
+
+  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE TensorOpCost costPerCoeff(bool vectorized) const {
+    const double compute_cost = m_kind == kGeneric ? NumDims * (TensorOpCost::DivCost<Index>() +
+                                                                TensorOpCost::MulCost<Index>() +
+                                                                TensorOpCost::AddCost<Index>())
+                                                   : TensorOpCost::DivCost<Index>();
+    return m_impl.costPerCoeff(vectorized) +
+           TensorOpCost(2 * sizeof(Scalar), 0, compute_cost, vectorized, PacketSize) +
+           TensorOpCost(0, 0, TensorOpCost::AddCost<Scalar>() + TensorOpCost::MulCost<Scalar>(),
+                        vectorized, PacketSize);
+  }
+
+  EIGEN_DEVICE_FUNC typename Eigen::internal::traits<XprType>::PointerType data() const { return NULL; }
+
+ protected:
+  typedef internal::TensorParallelFor<Device> ParallelFor;
+  static const bool Vectorized = TensorEvaluator<ArgType, Device>::PacketAccess && (PacketSize > 1);
+
+  enum Kind { kInnerReduced, kOuterReduced, kGeneric };
+
+  // Index of the coefficient of the tensor of the moments used to normalize
+  // the coefficient index of the input.
+  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE Index preservedIndex(Index index) const {
+    if (m_kind == kInnerReduced) {
+      return index / m_fastReducedSize;
+    } else if (m_kind == kOuterReduced) {
+      return index - (index / m_fastPreservedSize) * m_preservedSize;
+    }
+    Index result = 0;
+    for (int k = NumDims - 1; k > 0; --k) {
+      const int i = static_cast<int>(Layout) == static_cast<int>(ColMajor) ? k : NumDims - 1 - k;
+      const Index idx = index / m_fastStrides[i];
+      result += idx * m_preservedStrides[i];
+      index -= idx * m_strides[i];
+    }
+    const int inner = static_cast<int>(Layout) == static_cast<int>(ColMajor) ? 0 : NumDims - 1;
+    return result + index * m_preservedStrides[inner];
+  }
+
+  // Index of the first coefficient of the input normalized by the
+  // coefficient p of the tensor of the moments.
+  Index firstInput(Index p) const {
+    Index result = 0;
+    for (int k = NumDims - 1; k >= 0; --k) {
+      const int i = static_cast<int>(Layout) == static_cast<int>(ColMajor) ? k : NumDims - 1 - k;
+      if (!m_reduced[i]) {
+        const Index idx = p / m_preservedStrides[i];
+        result += idx * m_strides[i];
+        p -= idx * m_preservedStrides[i];
+      }
+    }
+    return result;
+  }
+
+  // Stores the mean and the inverse of the standard deviation of variance of
+  // each group of reduced coefficients in m_mean and m_scale.
+  void computeMoments() {
+    Scalar* mean = m_mean;
+    Scalar* scale = m_scale;
+    const Index reduced_size = m_reducedSize;
+    const Scalar epsilon = m_epsilon;
+    const TensorOpCost coeff_cost =
+        m_impl.costPerCoeff(Vectorized) +
+        TensorOpCost(0, 0, 3 * TensorOpCost::AddCost<Scalar>() + 2 * TensorOpCost::MulCost<Scalar>(),
+                     Vectorized, PacketSize);
+
+    if (m_kind == kInnerReduced) {
+      ParallelFor::run(m_device, m_preservedSize, coeff_cost * static_cast<double>(reduced_size), 1,
+                       [this, mean, scale, reduced_size, epsilon](Index first, Index last) {
+        for (Index p = first; p < last; ++p) {
+          const internal::WelfordMoments<Scalar> moments =
+              internal::ContiguousMoments<TensorEvaluator<ArgType, Device>, Vectorized>::run(
+                  m_impl, p * reduced_size, reduced_size);
+          mean[p] = moments.mean;
+          scale[p] = finalScale(moments.m2, reduced_size, epsilon);
+        }
+      });
+    } else if (m_kind == kOuterReduced) {
+      // The m2 of the moments are stored in scale until they're finalized.
+      const Index preserved_size = m_preservedSize;
+      ParallelFor::run(m_device, preserved_size, coeff_cost * static_cast<double>(reduced_size), PacketSize,
+                       [this, mean, scale, preserved_size, reduced_size, epsilon](Index first, Index last) {
+        // Update the moments of tiles of coefficients that fit in the cache.
+        const Index kTileSize = 1024;
+        for (Index tile = first; tile < last; tile += kTileSize) {
+          const Index tile_end = numext::mini(tile + kTileSize, last);
+          internal::StridedMoments<TensorEvaluator<ArgType, Device>, Vectorized>::run(
+              m_impl, preserved_size, reduced_size, tile, tile_end, mean, scale);
+          for (Index p = tile; p < tile_end; ++p) {
+            scale[p] = finalScale(scale[p], reduced_size, epsilon);
+          }
+        }
+      });
+    } else {
+      array<Index, NumDims> reduced_strides;
+      array<Index, NumDims> reduced_dims;
+      int num_reduced = 0;
+      for (int k = 0; k < NumDims; ++k) {
+        const int i = static_cast<int>(Layout) == static_cast<int>(ColMajor) ? k : NumDims - 1 - k;
+        if (m_reduced[i]) {
+          reduced_strides[num_reduced] = m_strides[i];
+          reduced_dims[num_reduced] = m_dimensions[i];
+          ++num_reduced;
+        }
+      }
+      ParallelFor::run(m_device, m_preservedSize, coeff_cost * static_cast<double>(reduced_size), 1,
+                       [this, mean, scale, reduced_size, epsilon, reduced_strides, reduced_dims, num_reduced](
+                           Index first, Index last) {
+        for (Index p = first; p < last; ++p) {
+          // Walk the reduced coefficients in memory order, with a Welford
+          // update for each of them.
+          array<Index, NumDims> coords;
+          for (int j = 0; j < num_reduced; ++j) coords[j] = 0;
+          Index offset = firstInput(p);
+          Scalar m(0);
+          Scalar m2(0);
+          for (Index r = 0; r < reduced_size; ++r) {
+            const Scalar x = m_impl.coeff(offset);
+            const Scalar delta = x - m;
+            m += delta / static_cast<Scalar>(r + 1);
+            m2 += delta * (x - m);
+            for (int j = 0; j < num_reduced; ++j) {
+              offset += reduced_strides[j];
+              if (++coords[j] < reduced_dims[j]) break;
+              offset -= coords[j] * reduced_strides[j];
+              coords[j] = 0;
+            }
+          }
+          mean[p] = m;
+          scale[p] = finalScale(m2, reduced_size, epsilon);
+        }
+      });
+    }
+  }
+
+  static EIGEN_STRONG_INLINE Scalar finalScale(const Scalar& m2, Index count, const Scalar& epsilon) {
+    return Scalar(1) / numext::sqrt(m2 / static_cast<Scalar>(count) + epsilon);
+  }
+
+  TensorEvaluator<ArgType, Device> m_impl;
+  const Device& m_device;
+  const Scalar m_epsilon;
+  Dimensions m_dimensions;
+  array<bool, NumDims> m_reduced;
+  Kind m_kind;
+  Index m_preservedSize;
+  Index m_reducedSize;
+  internal::TensorIntDivisor<Index> m_fastReducedSize;
+  internal::TensorIntDivisor<Index> m_fastPreservedSize;
+  array<Index, NumDims> m_strides;
+  array<internal::TensorIntDivisor<Index>, NumDims> m_fastStrides;
+  array<Index, NumDims> m_preservedStrides;
+  Scalar* m_mean;
+  Scalar* m_scale;
+};
+
+} // end namespace Eigen
+
+#endif // EIGEN_CXX11_TENSOR_TENSOR_NORMALIZATION_H
@@ -96,12 +96,16 @@ struct TensorEvaluator<const TensorPaddingOp<PaddingDimensions, ArgType>, Device
   enum {
     IsAligned = true,
     PacketAccess = TensorEvaluator<ArgType, Device>::PacketAccess,
-    BlockAccess = false,
+    BlockAccess = TensorEvaluator<ArgType, Device>::BlockAccess,
     Layout = TensorEvaluator<ArgType, Device>::Layout,
     CoordAccess = true,
     RawAccess = false
   };
 
+  typedef typename internal::remove_const<Scalar>::type ScalarNoConst;
+  typedef typename internal::TensorBlock<ScalarNoConst, Index, NumDims, Layout>
+      TensorBlock;
+
   EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE TensorEvaluator(const XprType& op, const Device& device)
       : m_impl(op.expression(), device), m_padding(op.padding()), m_paddingValue(op.padding_value())
   {
@@ -200,6 +204,53 @@ struct TensorEvaluator<const TensorPaddingOp<PaddingDimensions, ArgType>, Device
     return cost;
   }
 
+  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void getResourceRequirements(
+      std::vector<internal::TensorOpResourceRequirements>* resources) const {
+    m_impl.getResourceRequirements(resources);
+  }
+
+  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void block(
+      TensorBlock* output_block) const {
+    // The coefficients of the block which aren't padding form a sub block,
+    // which is read from the input in place into the output block.
+    const typename TensorBlock::Dimensions& block_sizes = output_block->block_sizes();
+    const typename TensorBlock::Dimensions& block_strides = output_block->block_strides();
+    typename TensorBlock::Dimensions input_block_sizes;
+    typename TensorBlock::Dimensions input_tensor_strides;
+    ScalarNoConst* data = output_block->data();
+    Index index = output_block->first_coeff_index();
+    Index input_index = 0;
+    bool has_input = true;
+    bool has_padding = false;
+    for (int k = 0; k < NumDims; ++k) {
+      const int i = static_cast<int>(Layout) == static_cast<int>(ColMajor) ? NumDims - 1 - k : k;
+      const Index idx = index / output_block->tensor_strides()[i];
+      index -= idx * output_block->tensor_strides()[i];
+      const Index first = numext::maxi<Index>(idx, m_padding[i].first);
+      const Index last = numext::mini<Index>(idx + block_sizes[i],
+                                             m_dimensions[i] - m_padding[i].second);
+      if (first >= last) {
+        has_input = false;
+        has_padding = true;
+        break;
+      }
+      has_padding = has_padding || last - first != block_sizes[i];
+      input_block_sizes[i] = last - first;
+      input_tensor_strides[i] = m_inputStrides[i];
+      input_index += (first - m_padding[i].first) * m_inputStrides[i];
+      data += (first - idx) * block_strides[i];
+    }
+    if (has_padding) {
+      internal::TensorBlockFill<ScalarNoConst, Index, NumDims, Layout>::Run(
+          block_sizes, block_strides, output_block->data(), m_paddingValue);
+    }
+    if (has_input) {
+      TensorBlock input_block(input_index, input_block_sizes, block_strides,
+                              input_tensor_strides, data);
+      m_impl.block(&input_block);
+    }
+  }
+
   EIGEN_DEVICE_FUNC EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE typename Eigen::internal::traits<XprType>::PointerType data() const { return NULL; }
 
   /// used by sycl
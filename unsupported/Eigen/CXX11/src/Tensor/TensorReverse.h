@@ -113,12 +113,16 @@ struct TensorEvaluator<const TensorReverseOp<ReverseDimensions, ArgType>, Device
   enum {
     IsAligned = false,
     PacketAccess = TensorEvaluator<ArgType, Device>::PacketAccess,
-    BlockAccess = false,
+    BlockAccess = TensorEvaluator<ArgType, Device>::BlockAccess,
     Layout = TensorEvaluator<ArgType, Device>::Layout,
     CoordAccess = false,  // to be implemented
     RawAccess = false
   };
 
+  typedef typename internal::TensorBlock<
+      typename internal::remove_const<Scalar>::type, Index, NumDims, Layout>
+      TensorBlock;
+
   EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE TensorEvaluator(const XprType& op,
                                                         const Device& device)
       : m_impl(op.expression(), device), m_reverse(op.reverse())
@@ -224,6 +228,43 @@ struct TensorEvaluator<const TensorReverseOp<ReverseDimensions, ArgType>, Device
            TensorOpCost(0, 0, compute_cost, false /* vectorized */, PacketSize);
   }
 
+  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void getResourceRequirements(
+      std::vector<internal::TensorOpResourceRequirements>* resources) const {
+    m_impl.getResourceRequirements(resources);
+  }
+
+  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void block(
+      TensorBlock* output_block) const {
+    // The input block is the output block mirrored along the reversed
+    // dimensions: it is read in place into the output block, which is then
+    // reversed in place.
+    const typename TensorBlock::Dimensions& block_sizes = output_block->block_sizes();
+    const typename TensorBlock::Dimensions& block_strides = output_block->block_strides();
+    typename TensorBlock::Dimensions tensor_strides;
+    Index index = output_block->first_coeff_index();
+    Index input_index = 0;
+    for (int k = 0; k < NumDims; ++k) {
+      const int i = static_cast<int>(Layout) == static_cast<int>(ColMajor) ? NumDims - 1 - k : k;
+      const Index idx = index / m_strides[i];
+      index -= idx * m_strides[i];
+      if (m_reverse[i]) {
+        input_index += (m_dimensions[i] - idx - block_sizes[i]) * m_strides[i];
+      } else {
+        input_index += idx * m_strides[i];
+      }
+      tensor_strides[i] = m_strides[i];
+    }
+    TensorBlock input_block(input_index, block_sizes, block_strides,
+                            tensor_strides, output_block->data());
+    m_impl.block(&input_block);
+
+    for (int i = 0; i < NumDims; ++i) {
+      if (m_reverse[i] && block_sizes[i] > 1) {
+        reverseBlockInPlace(i, block_sizes, block_strides, output_block->data());
+      }
+    }
+  }
+
   EIGEN_DEVICE_FUNC typename Eigen::internal::traits<XprType>::PointerType data() const { return NULL; }
 
   /// required by sycl in order to extract the accessor
@@ -232,6 +273,42 @@ struct TensorEvaluator<const TensorReverseOp<ReverseDimensions, ArgType>, Device
   ReverseDimensions functor() const { return m_reverse; }
 
  protected:
+  // Reverses the lines of a block along the given dimension.
+  static void reverseBlockInPlace(int dim, const typename TensorBlock::Dimensions& block_sizes,
+                                  const typename TensorBlock::Dimensions& block_strides,
+                                  typename internal::remove_const<Scalar>::type* data) {
+    typedef Array<typename internal::remove_const<Scalar>::type, Dynamic, 1> Line;
+    const Index size = block_sizes[dim];
+    const Index stride = block_strides[dim];
+    const Index num_lines = block_sizes.TotalSize() / size;
+    array<Index, NumDims> counts;
+    for (int i = 0; i < NumDims; ++i) {
+      counts[i] = 0;
+    }
+    Index offset = 0;
+    for (Index line = 0; line < num_lines; ++line) {
+      if (stride == 1) {
+        Map<Line>(data + offset, size).reverseInPlace();
+      } else {
+        for (Index j = 0, k = size - 1; j < k; ++j, --k) {
+          numext::swap(data[offset + j * stride], data[offset + k * stride]);
+        }
+      }
+      // Move to the next line, iterating over the other dimensions from the
+      // innermost one.
+      for (int k = 0; k < NumDims; ++k) {
+        const int i = static_cast<int>(Layout) == static_cast<int>(ColMajor) ? k : NumDims - 1 - k;
+        if (i == dim) continue;
+        if (++counts[i] < block_sizes[i]) {
+          offset += block_strides[i];
+          break;
+        }
+        offset -= (block_sizes[i] - 1) * block_strides[i];
+        counts[i] = 0;
+      }
+    }
+  }
+
   Dimensions m_dimensions;
   array<Index, NumDims> m_strides;
   TensorEvaluator<ArgType, Device> m_impl;
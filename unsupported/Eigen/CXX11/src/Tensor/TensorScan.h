@@ -77,7 +77,10 @@ protected:
   const bool m_exclusive;
 };
 
-template <typename Self, typename Reducer, typename Device>
+template <typename Self, typename Reducer, typename Device,
+          bool Vectorize =
+              (TensorEvaluator<typename Self::ChildType, Device>::PacketAccess &&
+               internal::reducer_traits<Reducer, Device>::PacketAccess)>
 struct ScanLauncher;
 
 // Eval as rvalue
@@ -92,6 +95,7 @@ struct TensorEvaluator<const TensorScanOp<Op, ArgType>, Device> {
   typedef typename XprType::CoeffReturnType CoeffReturnType;
   typedef typename PacketType<CoeffReturnType, Device>::type PacketReturnType;
   typedef TensorEvaluator<const TensorScanOp<Op, ArgType>, Device> Self;
+  typedef ArgType ChildType;
 
   enum {
     IsAligned = false,
@@ -208,10 +212,84 @@ protected:
   CoeffReturnType* m_output;
 };
 
+namespace internal {
+
+// Scans the coefficients [first, last) of the line starting at offset, on top
+// of the accumulator accum of the coefficients [0, first) of the line.
+template <typename Self>
+EIGEN_STRONG_INLINE void ReduceScalar(Self& self, Index offset, Index first, Index last,
+                                      typename Self::CoeffReturnType accum,
+                                      typename Self::CoeffReturnType* data) {
+  for (Index idx3 = first; idx3 < last; idx3++) {
+    Index curr = offset + idx3 * self.stride();
+
+    if (self.exclusive()) {
+      data[curr] = self.accumulator().finalize(accum);
+      self.accumulator().reduce(self.inner().coeff(curr), &accum);
+    } else {
+      self.accumulator().reduce(self.inner().coeff(curr), &accum);
+      data[curr] = self.accumulator().finalize(accum);
+    }
+  }
+}
+
+// Scans the coefficients [first, last) of the PacketSize adjacent lines
+// starting at offset at once, on top of their accumulators accum. The
+// coefficients of the lines are contiguous in memory for each index along the
+// scan axis since its stride is at least PacketSize.
+template <typename Self>
+EIGEN_STRONG_INLINE void ReducePacket(Self& self, Index offset, Index first, Index last,
+                                      typename Self::PacketReturnType accum,
+                                      typename Self::CoeffReturnType* data) {
+  typedef typename Self::PacketReturnType Packet;
+  for (Index idx3 = first; idx3 < last; idx3++) {
+    Index curr = offset + idx3 * self.stride();
+
+    if (self.exclusive()) {
+      internal::pstoreu<typename Self::CoeffReturnType, Packet>(
+          data + curr, self.accumulator().finalizePacket(accum));
+      self.accumulator().reducePacket(self.inner().template packet<Unaligned>(curr), &accum);
+    } else {
+      self.accumulator().reducePacket(self.inner().template packet<Unaligned>(curr), &accum);
+      internal::pstoreu<typename Self::CoeffReturnType, Packet>(
+          data + curr, self.accumulator().finalizePacket(accum));
+    }
+  }
+}
+
+// Scans the lines starting at idx1 + first, ..., idx1 + last - 1, where idx1
+// is the offset of a block of stride() * size() coefficients.
+template <typename Self, bool Vectorize>
+struct ReduceBlock {
+  EIGEN_STRONG_INLINE void operator()(Self& self, Index idx1, Index first, Index last,
+                                      typename Self::CoeffReturnType* data) {
+    for (Index idx2 = first; idx2 < last; idx2++) {
+      ReduceScalar(self, idx1 + idx2, 0, self.size(), self.accumulator().initialize(), data);
+    }
+  }
+};
+
+template <typename Self>
+struct ReduceBlock<Self, true> {
+  EIGEN_STRONG_INLINE void operator()(Self& self, Index idx1, Index first, Index last,
+                                      typename Self::CoeffReturnType* data) {
+    const Index PacketSize = unpacket_traits<typename Self::PacketReturnType>::size;
+    Index idx2 = first;
+    for (; idx2 + PacketSize <= last; idx2 += PacketSize) {
+      ReducePacket(self, idx1 + idx2, 0, self.size(),
+                   self.accumulator().template initializePacket<typename Self::PacketReturnType>(),
+                   data);
+    }
+    for (; idx2 < last; idx2++) {
+      ReduceScalar(self, idx1 + idx2, 0, self.size(), self.accumulator().initialize(), data);
+    }
+  }
+};
+
+}  // end namespace internal
+
 // CPU implementation of scan
-// TODO(ibab) This single-threaded implementation should be parallelized,
-// at least by running multiple scans at the same time.
-template <typename Self, typename Reducer, typename Device>
+template <typename Self, typename Reducer, typename Device, bool Vectorize>
 struct ScanLauncher {
   void operator()(Self& self, typename Self::CoeffReturnType *data) {
     Index total_size = internal::array_prod(self.dimensions());
@@ -219,29 +297,209 @@ struct ScanLauncher {
     // We fix the index along the scan axis to 0 and perform a
     // scan per remaining entry. The iteration is split into two nested
     // loops to avoid an integer division by keeping track of each idx1 and idx2.
+    // When the scan axis isn't the innermost dimension, PacketSize adjacent
+    // lines are scanned at once.
+    internal::ReduceBlock<Self, Vectorize> block_reducer;
     for (Index idx1 = 0; idx1 < total_size; idx1 += self.stride() * self.size()) {
-      for (Index idx2 = 0; idx2 < self.stride(); idx2++) {
-        // Calculate the starting offset for the scan
-        Index offset = idx1 + idx2;
-
-        // Compute the scan along the axis, starting at the calculated offset
-        typename Self::CoeffReturnType accum = self.accumulator().initialize();
-        for (Index idx3 = 0; idx3 < self.size(); idx3++) {
-          Index curr = offset + idx3 * self.stride();
-
-          if (self.exclusive()) {
-            data[curr] = self.accumulator().finalize(accum);
-            self.accumulator().reduce(self.inner().coeff(curr), &accum);
-          } else {
-            self.accumulator().reduce(self.inner().coeff(curr), &accum);
-            data[curr] = self.accumulator().finalize(accum);
-          }
+      block_reducer(self, idx1, 0, self.stride(), data);
+    }
+  }
+};
+
+#ifdef EIGEN_USE_THREADS
+
+namespace internal {
+
+// Reduces and scans ranges of coefficients of width <= PacketSize adjacent
+// lines for the two pass scan, one line at a time.
+template <typename Self, bool Vectorize>
+struct ReduceLines {
+  typedef typename Self::CoeffReturnType Scalar;
+
+  // Stores the accumulators of the coefficients [first, last) of the lines
+  // starting at offset in accums.
+  static void reduce(Self& self, Index offset, Index width, Index first, Index last,
+                     Scalar* accums) {
+    for (Index idx2 = 0; idx2 < width; idx2++) {
+      Scalar accum = self.accumulator().initialize();
+      for (Index idx3 = first; idx3 < last; idx3++) {
+        self.accumulator().reduce(self.inner().coeff(offset + idx2 + idx3 * self.stride()), &accum);
+      }
+      accums[idx2] = accum;
+    }
+  }
+
+  // Scans the coefficients [first, last) of the lines starting at offset on
+  // top of the accumulators accums.
+  static void scan(Self& self, Index offset, Index width, Index first, Index last,
+                   const Scalar* accums, Scalar* data) {
+    for (Index idx2 = 0; idx2 < width; idx2++) {
+      ReduceScalar(self, offset + idx2, first, last, accums[idx2], data);
+    }
+  }
+};
+
+// Reduces and scans PacketSize adjacent lines at once.
+template <typename Self>
+struct ReduceLines<Self, true> {
+  typedef typename Self::CoeffReturnType Scalar;
+  typedef typename Self::PacketReturnType Packet;
+  static const Index PacketSize = unpacket_traits<Packet>::size;
+
+  static void reduce(Self& self, Index offset, Index width, Index first, Index last,
+                     Scalar* accums) {
+    if (width < PacketSize) {
+      ReduceLines<Self, false>::reduce(self, offset, width, first, last, accums);
+      return;
+    }
+    Packet accum = self.accumulator().template initializePacket<Packet>();
+    for (Index idx3 = first; idx3 < last; idx3++) {
+      self.accumulator().reducePacket(
+          self.inner().template packet<Unaligned>(offset + idx3 * self.stride()), &accum);
+    }
+    pstoreu<Scalar, Packet>(accums, accum);
+  }
+
+  static void scan(Self& self, Index offset, Index width, Index first, Index last,
+                   const Scalar* accums, Scalar* data) {
+    if (width < PacketSize) {
+      ReduceLines<Self, false>::scan(self, offset, width, first, last, accums, data);
+      return;
+    }
+    ReducePacket(self, offset, first, last, ploadu<Packet>(accums), data);
+  }
+};
+
+}  // end namespace internal
+
+// Multithreaded implementation of scan. The lines are scanned independently,
+// by groups of PacketSize adjacent lines when vectorized, and the groups are
+// distributed over the threads of the pool. When there are fewer groups than
+// threads, the groups are also split along the scan axis into blocks, which
+// are scanned in two passes: the first pass reduces each block, and the second
+// one scans each block starting from the accumulation of the reductions of
+// the blocks that precede it. As for parallel reductions, this requires an
+// associative reducer without state.
+template <typename Self, typename Reducer, bool Vectorize>
+struct ScanLauncher<Self, Reducer, ThreadPoolDevice, Vectorize> {
+  typedef typename Self::CoeffReturnType Scalar;
+  typedef typename Self::PacketReturnType Packet;
+
+  // Lines shorter than twice this size aren't split into blocks.
+  static const Index kMinBlockSize = 4096;
+
+  void operator()(Self& self, Scalar* data) {
+    const ThreadPoolDevice& device = self.device();
+    const Index total_size = internal::array_prod(self.dimensions());
+    if (Reducer::IsStateful || device.numThreads() <= 1 || total_size == 0) {
+      ScanLauncher<Self, Reducer, DefaultDevice, Vectorize> launcher;
+      launcher(self, data);
+      return;
+    }
+
+    const Index stride = self.stride();
+    const Index size = self.size();
+    const Index PacketSize = Vectorize ? internal::unpacket_traits<Packet>::size : 1;
+    const Index group_width = stride >= PacketSize ? PacketSize : 1;
+    const Index groups_per_block = divup(stride, group_width);
+    const Index num_groups = (total_size / (stride * size)) * groups_per_block;
+
+    const TensorOpCost coeff_cost =
+        self.inner().costPerCoeff(Vectorize) +
+        TensorOpCost(0, sizeof(Scalar), internal::reducer_traits<Reducer, ThreadPoolDevice>::Cost);
+
+    if (num_groups >= device.numThreads() || size < 2 * kMinBlockSize) {
+      internal::ReduceBlock<Self, Vectorize> block_reducer;
+      device.parallelFor(
+          num_groups, coeff_cost * static_cast<double>(size * group_width),
+          [&self, data, stride, size, group_width, groups_per_block, &block_reducer](
+              Index first, Index last) {
+            // Scan the groups of each block of stride() * size() coefficients
+            // at once, so as to compute a single division per block.
+            for (Index group = first; group < last;) {
+              const Index block = group / groups_per_block;
+              const Index block_first = group - block * groups_per_block;
+              const Index block_last =
+                  numext::mini(groups_per_block, block_first + last - group);
+              block_reducer(self, block * stride * size, block_first * group_width,
+                            numext::mini(block_last * group_width, stride), data);
+              group += block_last - block_first;
+            }
+          });
+      return;
+    }
+
+    // Split the groups into blocks along the scan axis, so that there are at
+    // least as many blocks as threads.
+    const Index max_blocks_per_group = size / kMinBlockSize;
+    const Index block_size = divup(
+        size, numext::mini(max_blocks_per_group,
+                           numext::maxi<Index>(2, divup<Index>(device.numThreads(), num_groups))));
+    const Index blocks_per_group = divup(size, block_size);
+    const Index num_blocks = num_groups * blocks_per_group;
+    const TensorOpCost block_cost = coeff_cost * static_cast<double>(block_size * group_width);
+
+    // The accumulators of the group_width lines of each block.
+    Scalar* accums = static_cast<Scalar*>(
+        device.allocate_temp(num_blocks * group_width * sizeof(Scalar)));
+
+    // Returns the offset and the number of lines of the given group.
+    auto group_lines = [stride, size, group_width, groups_per_block](Index group, Index* width) {
+      const Index block = group / groups_per_block;
+      const Index idx2 = (group - block * groups_per_block) * group_width;
+      *width = numext::mini(group_width, stride - idx2);
+      return block * stride * size + idx2;
+    };
+
+    // Reduce each block.
+    device.parallelFor(num_blocks, block_cost, [&self, accums, size, block_size, group_width,
+                                                blocks_per_group, &group_lines](Index first, Index last) {
+      for (Index i = first; i < last; ++i) {
+        const Index group = i / blocks_per_group;
+        const Index begin = (i - group * blocks_per_group) * block_size;
+        Index width;
+        const Index offset = group_lines(group, &width);
+        internal::ReduceLines<Self, Vectorize>::reduce(self, offset, width, begin,
+                                                       numext::mini(begin + block_size, size),
+                                                       accums + i * group_width);
+      }
+    });
+
+    // Replace the reduction of each block with the accumulation of the
+    // reductions of the blocks that precede it.
+    for (Index group = 0; group < num_groups; ++group) {
+      Index width;
+      group_lines(group, &width);
+      for (Index idx2 = 0; idx2 < width; ++idx2) {
+        Scalar accum = self.accumulator().initialize();
+        for (Index i = group * blocks_per_group; i < (group + 1) * blocks_per_group; ++i) {
+          const Scalar block_accum = accums[i * group_width + idx2];
+          accums[i * group_width + idx2] = accum;
+          self.accumulator().reduce(block_accum, &accum);
         }
       }
     }
+
+    // Scan each block on top of the blocks that precede it.
+    device.parallelFor(num_blocks, block_cost, [&self, data, accums, size, block_size, group_width,
+                                                blocks_per_group, &group_lines](Index first, Index last) {
+      for (Index i = first; i < last; ++i) {
+        const Index group = i / blocks_per_group;
+        const Index begin = (i - group * blocks_per_group) * block_size;
+        Index width;
+        const Index offset = group_lines(group, &width);
+        internal::ReduceLines<Self, Vectorize>::scan(self, offset, width, begin,
+                                                     numext::mini(begin + block_size, size),
+                                                     accums + i * group_width, data);
+      }
+    });
+
+    device.deallocate_temp(accums);
   }
 };
 
+#endif  // EIGEN_USE_THREADS
+
 #if defined(EIGEN_USE_GPU) && (defined(EIGEN_GPUCC))
 
 // GPU implementation of scan
@@ -272,8 +530,8 @@ __global__ void ScanKernel(Self self, Index total_size, typename Self::CoeffRetu
 
 }
 
-template <typename Self, typename Reducer>
-struct ScanLauncher<Self, Reducer, GpuDevice> {
+template <typename Self, typename Reducer, bool Vectorize>
+struct ScanLauncher<Self, Reducer, GpuDevice, Vectorize> {
   void operator()(const Self& self, typename Self::CoeffReturnType* data) {
      Index total_size = internal::array_prod(self.dimensions());
      Index num_blocks = (total_size / self.size() + 63) / 64;
@@ -112,14 +112,18 @@ struct TensorEvaluator<const TensorShufflingOp<Shuffle, ArgType>, Device>
   enum {
     IsAligned = false,
     PacketAccess = (PacketType<CoeffReturnType, Device>::size > 1),
-    BlockAccess = false,
+    BlockAccess = TensorEvaluator<ArgType, Device>::BlockAccess,
     Layout = TensorEvaluator<ArgType, Device>::Layout,
     CoordAccess = false,  // to be implemented
     RawAccess = false
   };
 
+  typedef typename internal::TensorBlock<
+      typename internal::remove_const<Scalar>::type, Index, NumDims, Layout>
+      TensorBlock;
+
   EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE TensorEvaluator(const XprType& op, const Device& device)
-      : m_impl(op.expression(), device), m_shuffle(op.shufflePermutation())
+      : m_impl(op.expression(), device), m_device(device), m_shuffle(op.shufflePermutation())
   {
     const typename TensorEvaluator<ArgType, Device>::Dimensions& input_dims = m_impl.dimensions();
     const Shuffle& shuffle = op.shufflePermutation();
@@ -147,6 +151,7 @@ struct TensorEvaluator<const TensorShufflingOp<Shuffle, ArgType>, Device>
 
     for (int i = 0; i < NumDims; ++i) {
       m_inputStrides[i] = inputStrides[shuffle[i]];
+      m_unshuffledInputStrides[i] = inputStrides[i];
     }
   }
 
@@ -187,6 +192,35 @@ struct TensorEvaluator<const TensorShufflingOp<Shuffle, ArgType>, Device>
            TensorOpCost(0, 0, compute_cost, false /* vectorized */, PacketSize);
   }
 
+  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void getResourceRequirements(
+      std::vector<internal::TensorOpResourceRequirements>* resources) const {
+    // Square blocks, sized to fit in the L1 cache, minimize the number of
+    // cache lines touched by the strided side of the copy.
+    Eigen::Index block_total_size_max = numext::maxi<Eigen::Index>(
+        1, m_device.firstLevelCacheSize() / sizeof(Scalar));
+    resources->push_back(internal::TensorOpResourceRequirements(
+        internal::kUniformAllDims, block_total_size_max));
+    m_impl.getResourceRequirements(resources);
+  }
+
+  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void block(
+      TensorBlock* output_block) const {
+    // The input block is the output block with its dimensions unshuffled,
+    // and is written in place into the output block: the input is read
+    // along its innermost dimension, and the writes are strided within a
+    // block that fits in cache.
+    typename TensorBlock::Dimensions input_block_sizes;
+    typename TensorBlock::Dimensions input_block_strides;
+    for (int i = 0; i < NumDims; ++i) {
+      input_block_sizes[m_shuffle[i]] = output_block->block_sizes()[i];
+      input_block_strides[m_shuffle[i]] = output_block->block_strides()[i];
+    }
+    TensorBlock input_block(srcCoeff(output_block->first_coeff_index()),
+                            input_block_sizes, input_block_strides,
+                            m_unshuffledInputStrides, output_block->data());
+    m_impl.block(&input_block);
+  }
+
   EIGEN_DEVICE_FUNC typename Eigen::internal::traits<XprType>::PointerType data() const { return NULL; }
 
   // required by sycl
@@ -216,7 +250,9 @@ struct TensorEvaluator<const TensorShufflingOp<Shuffle, ArgType>, Device>
   Dimensions m_dimensions;
   array<Index, NumDims> m_outputStrides;
   array<Index, NumDims> m_inputStrides;
+  typename TensorBlock::Dimensions m_unshuffledInputStrides;
   TensorEvaluator<ArgType, Device> m_impl;
+  const Device& m_device;
   /// required by sycl
   Shuffle m_shuffle;
 };
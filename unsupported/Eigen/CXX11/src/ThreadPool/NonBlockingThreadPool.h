@@ -17,6 +17,9 @@ class ThreadPoolTempl : public Eigen::ThreadPoolInterface {
  public:
   typedef typename Environment::Task Task;
   typedef RunQueue<Task, 1024> Queue;
+  // Queue of the tasks scheduled with ScheduleHighPriority. These are expected
+  // to be few and short, so the queue is smaller.
+  typedef RunQueue<Task, 256> HighPriorityQueue;
 
   ThreadPoolTempl(int num_threads, Environment env = Environment())
       : ThreadPoolTempl(num_threads, true, env) {}
@@ -28,36 +31,40 @@ class ThreadPoolTempl : public Eigen::ThreadPoolInterface {
         allow_spinning_(allow_spinning),
         threads_(num_threads),
         queues_(num_threads),
-        coprimes_(num_threads),
+        high_priority_queues_(num_threads),
+        all_coprimes_(num_threads),
+        steal_partitions_(num_threads),
         waiters_(num_threads),
+        pending_high_priority_(0),
         blocked_(0),
         spinning_(0),
         done_(false),
         cancelled_(false),
         ec_(waiters_) {
     waiters_.resize(num_threads_);
+    // The partition encoding below stores thread indices on 16 bits.
+    eigen_plain_assert(num_threads_ < (1 << kMaxPartitionBits));
 
-    // Calculate coprimes of num_threads_.
-    // Coprimes are used for a random walk over all threads in Steal
+    // Calculate coprimes of all numbers [1, num_threads].
+    // Coprimes are used for random walks over all threads in Steal
     // and NonEmptyQueueIndex. Iteration is based on the fact that if we take
-    // a walk starting thread index t and calculate num_threads - 1 subsequent
+    // a random starting thread index t and calculate num_threads - 1 subsequent
     // indices as (t + coprime) % num_threads, we will cover all threads without
     // repetitions (effectively getting a presudo-random permutation of thread
     // indices).
-    for (int i = 1; i <= num_threads_; i++) {
-      unsigned a = i;
-      unsigned b = num_threads_;
-      // If GCD(a, b) == 1, then a and b are coprimes.
-      while (b != 0) {
-        unsigned tmp = a;
-        a = b;
-        b = tmp % b;
-      }
-      if (a == 1) {
-        coprimes_.push_back(i);
-      }
+    // The coprimes of smaller numbers are used to walk over steal partitions.
+    for (int i = 1; i <= num_threads_; ++i) {
+      all_coprimes_.emplace_back(i);
+      ComputeCoprimes(i, &all_coprimes_.back());
     }
     queues_.resize(num_threads_);
+    high_priority_queues_.resize(num_threads_);
+    // By default every thread steals from the whole pool.
+    steal_partitions_.resize(num_threads_);
+    for (int i = 0; i < num_threads_; i++) {
+      steal_partitions_[i].store(EncodePartition(0, num_threads_),
+                                 std::memory_order_relaxed);
+    }
 #ifndef EIGEN_THREAD_LOCAL
     init_barrier_.reset(new Barrier(num_threads_));
 #endif
@@ -84,15 +91,42 @@ class ThreadPoolTempl : public Eigen::ThreadPoolInterface {
       // Empty them to prevent their destructor from asserting.
       for (size_t i = 0; i < queues_.size(); i++) {
         queues_[i].Flush();
+        high_priority_queues_[i].Flush();
       }
     }
 
     // Join threads explicitly to avoid destruction order issues.
     threads_.resize(0);
     queues_.resize(0);
+    high_priority_queues_.resize(0);
+  }
+
+  // Partitions the threads into steal domains, e.g. one per NUMA node: thread
+  // i first tries to steal work from the threads in [partitions[i].first,
+  // partitions[i].second), and only then from the rest of the pool.
+  // Threads are not pinned by the pool; use an Environment whose CreateThread
+  // sets the affinity of the threads to make the partitions match the
+  // hardware topology.
+  void SetStealPartitions(const std::vector<std::pair<unsigned, unsigned> >& partitions) {
+    eigen_plain_assert(partitions.size() == static_cast<std::size_t>(num_threads_));
+    for (int i = 0; i < num_threads_; i++) {
+      const unsigned start = partitions[i].first;
+      const unsigned limit = partitions[i].second;
+      eigen_plain_assert(start < limit);
+      eigen_plain_assert(limit <= static_cast<unsigned>(num_threads_));
+      eigen_plain_assert(start <= static_cast<unsigned>(i) && static_cast<unsigned>(i) < limit);
+      steal_partitions_[i].store(EncodePartition(start, limit),
+                                 std::memory_order_relaxed);
+    }
   }
 
   void Schedule(std::function<void()> fn) {
+    ScheduleWithHint(std::move(fn), 0, num_threads_);
+  }
+
+  // Schedules fn preferably on the threads in [start, limit) when called from
+  // outside of the pool. Other threads can still steal it.
+  void ScheduleWithHint(std::function<void()> fn, int start, int limit) {
     Task t = env_.CreateTask(std::move(fn));
     PerThread* pt = GetPerThread();
     if (pt->pool == this) {
@@ -102,7 +136,8 @@ class ThreadPoolTempl : public Eigen::ThreadPoolInterface {
     } else {
       // A free-standing thread (or worker of another pool), push onto a random
       // queue.
-      Queue& q = queues_[Rand(&pt->rand) % queues_.size()];
+      eigen_plain_assert(0 <= start && start < limit && limit <= num_threads_);
+      Queue& q = queues_[start + Rand(&pt->rand) % (limit - start)];
       t = q.PushBack(std::move(t));
     }
     // Note: below we touch this after making w available to worker threads.
@@ -119,6 +154,29 @@ class ThreadPoolTempl : public Eigen::ThreadPoolInterface {
     }
   }
 
+  // Schedules a latency sensitive fn: workers run the high priority tasks
+  // before any task scheduled with Schedule.
+  void ScheduleHighPriority(std::function<void()> fn) {
+    Task t = env_.CreateTask(std::move(fn));
+    PerThread* pt = GetPerThread();
+    // Count the task before it becomes visible, so that workers look for it.
+    pending_high_priority_.fetch_add(1, std::memory_order_relaxed);
+    if (pt->pool == this) {
+      HighPriorityQueue& q = high_priority_queues_[pt->thread_id];
+      t = q.PushFront(std::move(t));
+    } else {
+      HighPriorityQueue& q =
+          high_priority_queues_[Rand(&pt->rand) % high_priority_queues_.size()];
+      t = q.PushBack(std::move(t));
+    }
+    if (!t.f) {
+      ec_.Notify(false);
+    } else {
+      pending_high_priority_.fetch_sub(1, std::memory_order_relaxed);
+      env_.ExecuteTask(t);  // Push failed, execute directly.
+    }
+  }
+
   void Cancel() {
     cancelled_ = true;
     done_ = true;
@@ -159,13 +217,22 @@ class ThreadPoolTempl : public Eigen::ThreadPoolInterface {
 #endif
   };
 
+  static const int kMaxPartitionBits = 16;
+  static const int kMaxThreads = 1 << kMaxPartitionBits;
+
   Environment env_;
   const int num_threads_;
   const bool allow_spinning_;
   MaxSizeVector<std::unique_ptr<Thread> > threads_;
   MaxSizeVector<Queue> queues_;
-  MaxSizeVector<unsigned> coprimes_;
+  MaxSizeVector<HighPriorityQueue> high_priority_queues_;
+  // all_coprimes_[i] contains the coprimes of i + 1.
+  MaxSizeVector<MaxSizeVector<unsigned> > all_coprimes_;
+  // Encoded [start, limit) range of the threads each thread steals from first.
+  MaxSizeVector<std::atomic<unsigned> > steal_partitions_;
   MaxSizeVector<EventCount::Waiter> waiters_;
+  // Number of tasks in the high priority queues, lets workers skip them.
+  std::atomic<unsigned> pending_high_priority_;
   std::atomic<unsigned> blocked_;
   std::atomic<bool> spinning_;
   std::atomic<bool> done_;
@@ -207,10 +274,12 @@ class ThreadPoolTempl : public Eigen::ThreadPoolInterface {
       // counter-productive for the types of I/O workloads the single thread
       // pools tend to be used for.
       while (!cancelled_) {
-        Task t = q.PopFront();
+        Task t = PopHighPriority(thread_id);
+        if (!t.f) t = q.PopFront();
         for (int i = 0; i < spin_count && !t.f; i++) {
           if (!cancelled_.load(std::memory_order_relaxed)) {
-            t = q.PopFront();
+            t = PopHighPriority(thread_id);
+            if (!t.f) t = q.PopFront();
           }
         }
         if (!t.f) {
@@ -224,15 +293,16 @@ class ThreadPoolTempl : public Eigen::ThreadPoolInterface {
       }
     } else {
       while (!cancelled_) {
-        Task t = q.PopFront();
+        Task t = PopHighPriority(thread_id);
+        if (!t.f) t = q.PopFront();
         if (!t.f) {
-          t = Steal();
+          t = Steal(thread_id);
           if (!t.f) {
             // Leave one thread spinning. This reduces latency.
             if (allow_spinning_ && !spinning_ && !spinning_.exchange(true)) {
               for (int i = 0; i < spin_count && !t.f; i++) {
                 if (!cancelled_.load(std::memory_order_relaxed)) {
-                  t = Steal();
+                  t = Steal(thread_id);
                 } else {
                   return;
                 }
@@ -253,15 +323,45 @@ class ThreadPoolTempl : public Eigen::ThreadPoolInterface {
     }
   }
 
-  // Steal tries to steal work from other worker threads in best-effort manner.
-  Task Steal() {
+  // Steal tries to steal work from other worker threads in best-effort manner:
+  // first from the steal partition of thread_id, then from the whole pool.
+  Task Steal(int thread_id) {
+    Task t = PopHighPriority(thread_id);
+    if (t.f) return t;
+    unsigned start, limit;
+    DecodePartition(steal_partitions_[thread_id].load(std::memory_order_relaxed),
+                    &start, &limit);
+    if (limit - start < static_cast<unsigned>(num_threads_)) {
+      t = StealRange(queues_, start, limit);
+      if (t.f) return t;
+    }
+    return StealRange(queues_, 0, num_threads_);
+  }
+
+  // Returns a high priority task if there is any, preferably from the own
+  // queue of thread_id.
+  Task PopHighPriority(int thread_id) {
+    if (pending_high_priority_.load(std::memory_order_relaxed) == 0) {
+      return Task();
+    }
+    Task t = high_priority_queues_[thread_id].PopFront();
+    if (!t.f) t = StealRange(high_priority_queues_, 0, num_threads_);
+    if (t.f) pending_high_priority_.fetch_sub(1, std::memory_order_relaxed);
+    return t;
+  }
+
+  // Tries to pop a task from the back of the queues [start, limit), visited in
+  // a pseudo-random order.
+  template <typename Queues>
+  Task StealRange(Queues& queues, unsigned start, unsigned limit) {
     PerThread* pt = GetPerThread();
-    const size_t size = queues_.size();
+    const unsigned size = limit - start;
+    const MaxSizeVector<unsigned>& coprimes = all_coprimes_[size - 1];
     unsigned r = Rand(&pt->rand);
-    unsigned inc = coprimes_[r % coprimes_.size()];
+    unsigned inc = coprimes[r % coprimes.size()];
     unsigned victim = r % size;
     for (unsigned i = 0; i < size; i++) {
-      Task t = queues_[victim].PopBack();
+      Task t = queues[start + victim].PopBack();
       if (t.f) {
         return t;
       }
@@ -288,7 +388,12 @@ class ThreadPoolTempl : public Eigen::ThreadPoolInterface {
       if (cancelled_) {
         return false;
       } else {
-        *t = queues_[victim].PopBack();
+        *t = high_priority_queues_[victim].PopBack();
+        if (t->f) {
+          pending_high_priority_.fetch_sub(1, std::memory_order_relaxed);
+        } else {
+          *t = queues_[victim].PopBack();
+        }
         return true;
       }
     }
@@ -326,11 +431,12 @@ class ThreadPoolTempl : public Eigen::ThreadPoolInterface {
   int NonEmptyQueueIndex() {
     PerThread* pt = GetPerThread();
     const size_t size = queues_.size();
+    const MaxSizeVector<unsigned>& coprimes = all_coprimes_[size - 1];
     unsigned r = Rand(&pt->rand);
-    unsigned inc = coprimes_[r % coprimes_.size()];
+    unsigned inc = coprimes[r % coprimes.size()];
     unsigned victim = r % size;
     for (unsigned i = 0; i < size; i++) {
-      if (!queues_[victim].Empty()) {
+      if (!queues_[victim].Empty() || !high_priority_queues_[victim].Empty()) {
         return victim;
       }
       victim += inc;
@@ -341,6 +447,31 @@ class ThreadPoolTempl : public Eigen::ThreadPoolInterface {
     return -1;
   }
 
+  static void ComputeCoprimes(int n, MaxSizeVector<unsigned>* coprimes) {
+    for (int i = 1; i <= n; i++) {
+      unsigned a = i;
+      unsigned b = n;
+      // If GCD(a, b) == 1, then a and b are coprimes.
+      while (b != 0) {
+        unsigned tmp = a;
+        a = b;
+        b = tmp % b;
+      }
+      if (a == 1) {
+        coprimes->push_back(i);
+      }
+    }
+  }
+
+  static unsigned EncodePartition(unsigned start, unsigned limit) {
+    return start | (limit << kMaxPartitionBits);
+  }
+
+  static void DecodePartition(unsigned val, unsigned* start, unsigned* limit) {
+    *limit = val >> kMaxPartitionBits;
+    *start = val & (kMaxThreads - 1);
+  }
+
   static EIGEN_STRONG_INLINE uint64_t GlobalThreadIdHash() {
     return std::hash<std::thread::id>()(std::this_thread::get_id());
   }
@@ -0,0 +1,67 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_CXX11_THREADPOOL_THREAD_POOL_EXECUTOR_H
+#define EIGEN_CXX11_THREADPOOL_THREAD_POOL_EXECUTOR_H
+
+namespace Eigen {
+
+// Runs the multi-threaded code paths of Eigen Core (e.g. dense matrix
+// products) on the threads of a ThreadPoolInterface instead of OpenMP.
+// Requires EIGEN_USE_PARALLEL_EXECUTOR to be defined before including Eigen:
+//
+//   Eigen::ThreadPool pool(8);
+//   Eigen::ThreadPoolExecutor executor(&pool);
+//   Eigen::setParallelExecutor(&executor);
+//   C.noalias() = A * B;  // runs on the threads of 'pool'
+//
+// The logical threads of a parallel session spin on each other, so they must
+// all be running at the same time. The calling thread runs the first of them
+// and the others are scheduled on the pool, and the sessions started by
+// different threads are serialized: at most NumThreads() - 1 tasks of a single
+// session are ever queued on the pool. This only holds if the pool is not
+// shared with another ThreadPoolExecutor. Nested sessions are not started,
+// neither from the pool threads nor from the calling thread of a session.
+class ThreadPoolExecutor : public ParallelExecutor {
+ public:
+  explicit ThreadPoolExecutor(ThreadPoolInterface* pool)
+      : pool_(pool), session_owner_(std::thread::id()) {}
+
+  int numThreads() const { return pool_->NumThreads(); }
+
+  bool inWorkerThread() const {
+    return pool_->CurrentThreadId() != -1 ||
+           session_owner_.load(std::memory_order_relaxed) == std::this_thread::get_id();
+  }
+
+  void run(Index n, const internal::parallel_task& task) {
+    eigen_assert(n >= 1 && n <= numThreads());
+    std::lock_guard<std::mutex> lock(session_mutex_);
+    session_owner_.store(std::this_thread::get_id(), std::memory_order_relaxed);
+    Barrier barrier(static_cast<unsigned int>(n - 1));
+    for (Index i = 1; i < n; ++i) {
+      pool_->Schedule([&task, &barrier, i]() {
+        task(i);
+        barrier.Notify();
+      });
+    }
+    task(0);
+    barrier.Wait();
+    session_owner_.store(std::thread::id(), std::memory_order_relaxed);
+  }
+
+  ThreadPoolInterface* pool() const { return pool_; }
+
+ private:
+  ThreadPoolInterface* pool_;
+  std::mutex session_mutex_;
+  std::atomic<std::thread::id> session_owner_;
+};
+
+}  // namespace Eigen
+
+#endif  // EIGEN_CXX11_THREADPOOL_THREAD_POOL_EXECUTOR_H
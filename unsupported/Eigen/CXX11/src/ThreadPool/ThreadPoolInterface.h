@@ -19,6 +19,21 @@ class ThreadPoolInterface {
   // Submits a closure to be run by a thread in the pool.
   virtual void Schedule(std::function<void()> fn) = 0;
 
+  // Submits a closure to be run preferably by the threads in the range
+  // [start, end) of the pool.
+  // If not implemented, calls Schedule.
+  virtual void ScheduleWithHint(std::function<void()> fn, int /*start*/,
+                                int /*end*/) {
+    Schedule(std::move(fn));
+  }
+
+  // Submits a latency sensitive closure, to be run before the closures
+  // submitted with Schedule.
+  // If not implemented, calls Schedule.
+  virtual void ScheduleHighPriority(std::function<void()> fn) {
+    Schedule(std::move(fn));
+  }
+
   // If implemented, stop processing the closures that have been enqueued.
   // Currently running closures may still be processed.
   // If not implemented, does nothing.
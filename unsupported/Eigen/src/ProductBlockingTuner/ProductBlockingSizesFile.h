@@ -0,0 +1,75 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_PRODUCT_BLOCKING_SIZES_FILE_H
+#define EIGEN_PRODUCT_BLOCKING_SIZES_FILE_H
+
+namespace Eigen {
+
+/** \ingroup ProductBlockingTuner_Module
+  *
+  * Adds the blocking sizes stored in the file \a filename by saveProductBlockingSizes() to the current ones.
+  *
+  * Each line of the file holds "lhs_code rhs_code k m n kc mc nc", where k, m, n are the smallest dimensions
+  * of the class of products. Lines starting with '#' are ignored.
+  *
+  * \returns false if the file cannot be read or contains invalid entries
+  *
+  * \sa saveProductBlockingSizes(), setProductBlockingSizes()
+  */
+inline bool loadProductBlockingSizes(const char* filename)
+{
+  std::FILE* file = std::fopen(filename, "r");
+  if(file==0)
+    return false;
+  char line[256];
+  bool ok = true;
+  while(std::fgets(line, sizeof(line), file))
+  {
+    if(line[0]=='#' || line[0]=='\n')
+      continue;
+    int lhs, rhs;
+    long k, m, n, kc, mc, nc;
+    if(std::sscanf(line, "%d %d %ld %ld %ld %ld %ld %ld", &lhs, &rhs, &k, &m, &n, &kc, &mc, &nc)!=8 || kc<=0 || mc<=0 || nc<=0)
+    {
+      ok = false;
+      continue;
+    }
+    internal::TunedBlockingSizes entry = { lhs, rhs, internal::blocking_shape_class(k, m, n), kc, mc, nc };
+    ok = internal::tuned_blocking_sizes().insert(entry) && ok;
+  }
+  std::fclose(file);
+  return ok;
+}
+
+/** \ingroup ProductBlockingTuner_Module
+  *
+  * Saves the current blocking sizes set by setProductBlockingSizes() or autotuneProductBlockingSizes()
+  * into the text file \a filename.
+  *
+  * \sa loadProductBlockingSizes()
+  */
+inline bool saveProductBlockingSizes(const char* filename)
+{
+  std::FILE* file = std::fopen(filename, "w");
+  if(file==0)
+    return false;
+  const internal::TunedBlockingSizesTable& table = internal::tuned_blocking_sizes();
+  std::fprintf(file, "# lhs_code rhs_code k m n kc mc nc\n");
+  for(int i=0; i<table.size(); ++i)
+  {
+    const internal::TunedBlockingSizes& e = table[i];
+    std::fprintf(file, "%d %d %ld %ld %ld %ld %ld %ld\n", e.lhs, e.rhs,
+                 1L<<((e.shape>>8)&15), 1L<<((e.shape>>4)&15), 1L<<(e.shape&15),
+                 long(e.kc), long(e.mc), long(e.nc));
+  }
+  return std::fclose(file)==0;
+}
+
+} // end namespace Eigen
+
+#endif // EIGEN_PRODUCT_BLOCKING_SIZES_FILE_H
@@ -0,0 +1,155 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_PRODUCT_BLOCKING_TUNER_H
+#define EIGEN_PRODUCT_BLOCKING_TUNER_H
+
+namespace Eigen {
+
+namespace internal {
+
+/* Measures the time of a k x m x n matrix product for various blocking sizes.
+ *
+ * The search starts from the blocking sizes of the cache size based heuristic, and scales each of kc, mc, nc
+ * in turn by 1/4, 1/2, 2 and 4, keeping the changes which speed up the product by more than 2%.
+ * Since the optimal sizes mostly depend on the cache hierarchy, two such passes are usually enough.
+ */
+template<typename Scalar>
+class product_blocking_tuner
+{
+    typedef Matrix<Scalar,Dynamic,Dynamic> MatrixType;
+    typedef gebp_traits<Scalar,Scalar> Traits;
+
+  public:
+    product_blocking_tuner(Index k, Index m, Index n, double minTime)
+      : m_lhs(MatrixType::Random(m,k)), m_rhs(MatrixType::Random(k,n)), m_res(m,n),
+        m_k(k), m_m(m), m_n(n), m_minTime(minTime)
+    {}
+
+    // \returns the best time of a product with the blocking sizes kc, mc, nc, or with the default ones if kc is 0
+    double measure(Index kc, Index mc, Index nc)
+    {
+      const int code = blocking_scalar_code<Scalar>::value;
+      if(kc==0)
+        tuned_blocking_sizes().erase(code, code, blocking_shape_class(m_k, m_m, m_n));
+      else
+        setProductBlockingSizes<Scalar,Scalar>(m_k, m_m, m_n, kc, mc, nc);
+
+      double best = NumTraits<double>::highest();
+      for(int repeat=0; repeat<3; ++repeat)
+      {
+        // increase the number of iterations until the timing is accurate enough
+        for(long iters=1; ; iters*=2)
+        {
+          std::clock_t start = std::clock();
+          for(long i=0; i<iters; ++i)
+            m_res.noalias() = m_lhs * m_rhs;
+          double elapsed = double(std::clock() - start) / CLOCKS_PER_SEC;
+          if(elapsed>=m_minTime)
+          {
+            best = (std::min)(best, elapsed/double(iters));
+            break;
+          }
+        }
+      }
+      return best;
+    }
+
+    // \returns x rounded to a multiple of step within [step, max(size,step)]
+    static Index round(double x, Index step, Index size)
+    {
+      Index r = (Index(x)/step)*step;
+      return (std::max)(step, (std::min)(r, ((size+step-1)/step)*step));
+    }
+
+    double run(Index& kc, Index& mc, Index& nc)
+    {
+      kc = m_k; mc = m_m; nc = m_n;
+      computeProductBlockingSizes<Scalar,Scalar>(kc, mc, nc);
+      const double defaultTime = measure(0, 0, 0);
+
+      Index best[3] = { kc, mc, nc };
+      const Index steps[3] = { 8, Index(Traits::mr), Index(Traits::nr) };
+      const Index sizes[3] = { m_k, m_m, m_n };
+      const double factors[4] = { 0.25, 0.5, 2, 4 };
+      double bestTime = measure(best[0], best[1], best[2]);
+      for(int pass=0; pass<2; ++pass)
+      {
+        for(int d=0; d<3; ++d)
+        {
+          const Index current = best[d];
+          for(int f=0; f<4; ++f)
+          {
+            Index candidate[3] = { best[0], best[1], best[2] };
+            candidate[d] = round(double(current)*factors[f], steps[d], sizes[d]);
+            if(candidate[d]==best[d])
+              continue;
+            double time = measure(candidate[0], candidate[1], candidate[2]);
+            if(time<0.98*bestTime)
+            {
+              bestTime = time;
+              best[0] = candidate[0]; best[1] = candidate[1]; best[2] = candidate[2];
+            }
+          }
+        }
+      }
+
+      kc = best[0]; mc = best[1]; nc = best[2];
+      if(bestTime<0.98*defaultTime)
+      {
+        setProductBlockingSizes<Scalar,Scalar>(m_k, m_m, m_n, kc, mc, nc);
+        return defaultTime/bestTime;
+      }
+      measure(0, 0, 0);
+      return 1;
+    }
+
+  protected:
+    MatrixType m_lhs, m_rhs, m_res;
+    Index m_k, m_m, m_n;
+    double m_minTime;
+};
+
+} // end namespace internal
+
+/** \ingroup ProductBlockingTuner_Module
+  *
+  * Measures the blocking sizes which perform best on the host for the products of \a m x \a k by \a k x \a n matrices
+  * of type \a Scalar, and registers them with setProductBlockingSizes() for this class of products if they
+  * outperform the default ones.
+  *
+  * The products are run sequentially, so that this function takes from a fraction of second to a few seconds
+  * depending on the sizes and on \a minTime, the minimal duration of each timing.
+  *
+  * \param[out] kc, mc, nc the selected blocking sizes
+  * \returns the speed up of the selected blocking sizes with respect to the default ones (1 if no better sizes were found)
+  *
+  * \sa saveProductBlockingSizes(), computeProductBlockingSizes
+  */
+template<typename Scalar>
+double autotuneProductBlockingSizes(Index k, Index m, Index n, Index& kc, Index& mc, Index& nc, double minTime = 0.02)
+{
+  const int threads = nbThreads();
+  setNbThreads(1);
+  internal::product_blocking_tuner<Scalar> tuner(k, m, n, minTime);
+  double speedup = tuner.run(kc, mc, nc);
+  setNbThreads(threads);
+  return speedup;
+}
+
+/** \ingroup ProductBlockingTuner_Module
+  * \overload */
+template<typename Scalar>
+double autotuneProductBlockingSizes(Index k, Index m, Index n, double minTime = 0.02)
+{
+  Index kc, mc, nc;
+  return autotuneProductBlockingSizes<Scalar>(k, m, n, kc, mc, nc, minTime);
+}
+
+} // end namespace Eigen
+
+#endif // EIGEN_PRODUCT_BLOCKING_TUNER_H
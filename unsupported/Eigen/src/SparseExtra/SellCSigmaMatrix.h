@@ -0,0 +1,388 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_SELL_C_SIGMA_MATRIX_H
+#define EIGEN_SELL_C_SIGMA_MATRIX_H
+
+namespace Eigen {
+
+/** \ingroup SparseExtra_Module
+  * \class SellCSigmaMatrix
+  *
+  * \brief A read-only sparse matrix in the sliced ELLPACK format, designed for fast sparse matrix * vector products
+  *
+  * \tparam _Scalar the scalar type, i.e. the type of the coefficients
+  * \tparam _StorageIndex the type of the indices. It has to be a \b signed type (e.g., short, int, std::ptrdiff_t). Default is \c int.
+  *
+  * The rows of the matrix are grouped into slices of C rows, where C is the number of scalars in a SIMD packet
+  * (see SliceHeight). Within a slice, the k-th non zeros of the C rows are stored contiguously, and the rows
+  * shorter than the longest one of the slice are padded with explicit zeros. A sparse matrix * vector product
+  * thus processes the C rows of a slice at once with packet multiply-adds, and only the coefficients of the
+  * vector have to be gathered one by one. The padding of a row multiplies the coefficient of the vector matching
+  * the last non zero of the row, hence an infinite coefficient yields NaN instead of an infinite result in the rows
+  * referring to it. The empty rows of the matrix always yield exact zeros.
+  *
+  * To limit the padding, the rows are sorted by decreasing number of non zeros within windows of \c sigma
+  * consecutive rows before being sliced. A larger \c sigma reduces the padding, while a smaller one keeps the
+  * accesses to the result and to the vector closer to the original ordering. With \c sigma equal to 1, the rows
+  * are not reordered. The ratio nonZeros()/storageSize() measures the efficiency of the storage.
+  *
+  * The slices are processed in parallel when Eigen is multi-threaded (see \ref TopicMultiThreading).
+  *
+  * This class implements only the product with a dense vector or matrix, and the iteration over the
+  * non zeros of a row. It can thus be used as the matrix of the ConjugateGradient and BiCGSTAB solvers, with
+  * either the IdentityPreconditioner or the DiagonalPreconditioner:
+  * \code
+  * SparseMatrix<double> A = ...;
+  * SellCSigmaMatrix<double> S(A);
+  * ConjugateGradient<SellCSigmaMatrix<double>, Lower|Upper> cg(S);
+  * x = cg.solve(b);
+  * \endcode
+  *
+  * \sa SparseMatrix
+  */
+template<typename _Scalar, typename _StorageIndex = int> class SellCSigmaMatrix;
+
+namespace internal {
+template<typename _Scalar, typename _StorageIndex>
+struct traits<SellCSigmaMatrix<_Scalar, _StorageIndex> >
+{
+  typedef _Scalar Scalar;
+  typedef _StorageIndex StorageIndex;
+  typedef Sparse StorageKind;
+  typedef MatrixXpr XprKind;
+  enum {
+    RowsAtCompileTime = Dynamic,
+    ColsAtCompileTime = Dynamic,
+    MaxRowsAtCompileTime = Dynamic,
+    MaxColsAtCompileTime = Dynamic,
+    Flags = RowMajorBit | NestByRefBit,
+    CoeffReadCost = NumTraits<Scalar>::ReadCost,
+    SupportedAccessPatterns = OuterRandomAccessPattern
+  };
+};
+}
+
+template<typename _Scalar, typename _StorageIndex>
+class SellCSigmaMatrix : public EigenBase<SellCSigmaMatrix<_Scalar, _StorageIndex> >
+{
+  public:
+    typedef _Scalar Scalar;
+    typedef typename NumTraits<Scalar>::Real RealScalar;
+    typedef _StorageIndex StorageIndex;
+    typedef typename internal::packet_traits<Scalar>::type Packet;
+
+    enum {
+      ColsAtCompileTime = Dynamic,
+      MaxColsAtCompileTime = Dynamic,
+      IsRowMajor = true,
+      /** The number of rows of a slice */
+      SliceHeight = internal::unpacket_traits<Packet>::size,
+      /** The default size of the sorting windows */
+      DefaultSigma = 32 * SliceHeight
+    };
+
+    class InnerIterator;
+
+    /** Default constructor yielding an empty \c 0 \c x \c 0 matrix */
+    SellCSigmaMatrix() : m_rows(0), m_cols(0), m_sigma(1), m_nonZeros(0), m_sliceOffsets(1)
+    {
+      m_sliceOffsets(0) = 0;
+    }
+
+    /** Constructs a SELL-C-sigma copy of the sparse matrix \a other, sorting the rows within windows of \a sigma rows */
+    template<typename OtherDerived>
+    explicit SellCSigmaMatrix(const SparseMatrixBase<OtherDerived>& other, Index sigma = DefaultSigma)
+    {
+      compute(other, sigma);
+    }
+
+    /** Copies the sparse matrix \a other into *this, sorting the rows within windows of \a sigma rows */
+    template<typename OtherDerived>
+    SellCSigmaMatrix& compute(const SparseMatrixBase<OtherDerived>& other, Index sigma = DefaultSigma);
+
+    inline Index rows() const { return m_rows; }
+    inline Index cols() const { return m_cols; }
+    inline Index outerSize() const { return m_rows; }
+    inline Index innerSize() const { return m_cols; }
+
+    /** \returns the number of non zeros, excluding the padding */
+    inline Index nonZeros() const { return m_nonZeros; }
+    /** \returns the number of stored coefficients, including the padding */
+    inline Index storageSize() const { return m_values.size(); }
+    /** \returns the size of the sorting windows */
+    inline Index sigma() const { return m_sigma; }
+    /** \returns the number of slices */
+    inline Index sliceCount() const { return m_sliceOffsets.size()-1; }
+
+    /** \returns a const pointer to the stored coefficients, slice after slice. Within a slice, the k-th coefficient
+      * of the row \c r of the slice is at position \c k*SliceHeight+r. */
+    inline const Scalar* valuePtr() const { return m_values.data(); }
+    /** \returns a const pointer to the column indices of the stored coefficients */
+    inline const StorageIndex* innerIndexPtr() const { return m_innerIndices.data(); }
+    /** \returns a const pointer to the starting positions of the slices, of size sliceCount()+1 */
+    inline const StorageIndex* sliceOffsetPtr() const { return m_sliceOffsets.data(); }
+    /** \returns a const pointer to the original rows of the stored rows, of size rows() */
+    inline const StorageIndex* rowIndexPtr() const { return m_rowIndices.data(); }
+    /** \returns a const pointer to the number of non zeros of the stored rows, of size rows() */
+    inline const StorageIndex* rowLengthPtr() const { return m_rowLengths.data(); }
+    /** \returns a const pointer to the positions of the original rows in the storage, of size rows() */
+    inline const StorageIndex* rowPositionPtr() const { return m_rowPositions.data(); }
+
+    /** \returns an expression of the product of *this with the dense vector or matrix \a x */
+    template<typename Rhs>
+    Product<SellCSigmaMatrix,Rhs> operator*(const MatrixBase<Rhs>& x) const
+    {
+      return Product<SellCSigmaMatrix,Rhs>(*this, x.derived());
+    }
+
+  protected:
+    typedef Matrix<Scalar,Dynamic,1> ScalarVector;
+    typedef Matrix<StorageIndex,Dynamic,1> IndexVector;
+
+    Index m_rows;
+    Index m_cols;
+    Index m_sigma;
+    Index m_nonZeros;
+    ScalarVector m_values;
+    IndexVector m_innerIndices;
+    IndexVector m_sliceOffsets;
+    IndexVector m_rowIndices;
+    IndexVector m_rowLengths;
+    IndexVector m_rowPositions;
+};
+
+/** \class SellCSigmaMatrix::InnerIterator
+  * \brief Iterates over the non zeros of a row of a SellCSigmaMatrix, by increasing column index */
+template<typename Scalar, typename StorageIndex>
+class SellCSigmaMatrix<Scalar,StorageIndex>::InnerIterator
+{
+  public:
+    InnerIterator(const SellCSigmaMatrix& mat, Index outer)
+      : m_outer(outer), m_id(0)
+    {
+      Index pos = mat.rowPositionPtr()[outer];
+      Index start = mat.sliceOffsetPtr()[pos / SliceHeight] + pos % SliceHeight;
+      m_values = mat.valuePtr() + start;
+      m_indices = mat.innerIndexPtr() + start;
+      m_end = mat.rowLengthPtr()[pos];
+    }
+
+    inline InnerIterator& operator++() { ++m_id; return *this; }
+
+    inline const Scalar& value() const { return m_values[m_id*SliceHeight]; }
+    inline StorageIndex index() const { return m_indices[m_id*SliceHeight]; }
+    inline Index outer() const { return m_outer; }
+    inline Index row() const { return m_outer; }
+    inline Index col() const { return index(); }
+
+    inline operator bool() const { return m_id < m_end; }
+
+  protected:
+    const Scalar* m_values;
+    const StorageIndex* m_indices;
+    Index m_outer;
+    Index m_id;
+    Index m_end;
+};
+
+namespace internal {
+
+template<typename StorageIndex>
+struct sell_c_sigma_row_length_greater
+{
+  sell_c_sigma_row_length_greater(const StorageIndex* outer) : m_outer(outer) {}
+  bool operator()(StorageIndex a, StorageIndex b) const
+  {
+    return m_outer[a+1]-m_outer[a] > m_outer[b+1]-m_outer[b];
+  }
+  const StorageIndex* m_outer;
+};
+
+} // end namespace internal
+
+template<typename Scalar, typename StorageIndex>
+template<typename OtherDerived>
+SellCSigmaMatrix<Scalar,StorageIndex>&
+SellCSigmaMatrix<Scalar,StorageIndex>::compute(const SparseMatrixBase<OtherDerived>& other, Index sigma)
+{
+  eigen_assert(sigma>0 && "the size of the sorting windows must be positive");
+  SparseMatrix<Scalar,RowMajor,StorageIndex> mat(other.derived());
+  mat.makeCompressed();
+  const StorageIndex* outer = mat.outerIndexPtr();
+
+  m_rows = mat.rows();
+  m_cols = mat.cols();
+  m_sigma = sigma;
+  m_nonZeros = mat.nonZeros();
+
+  // sort the rows by decreasing length within each window, keeping the original order of rows of equal length
+  m_rowIndices.resize(m_rows);
+  m_rowLengths.resize(m_rows);
+  m_rowPositions.resize(m_rows);
+  for(Index i=0; i<m_rows; ++i)
+    m_rowIndices(i) = StorageIndex(i);
+  for(Index w=0; w<m_rows; w+=sigma)
+  {
+    StorageIndex* first = m_rowIndices.data() + w;
+    std::stable_sort(first, first + (std::min)(sigma, m_rows-w), internal::sell_c_sigma_row_length_greater<StorageIndex>(outer));
+  }
+  for(Index p=0; p<m_rows; ++p)
+  {
+    Index i = m_rowIndices(p);
+    m_rowLengths(p) = outer[i+1] - outer[i];
+    m_rowPositions(i) = StorageIndex(p);
+  }
+
+  // each slice is as wide as its longest row, which is its first one unless the slice straddles two windows
+  Index slices = (m_rows + SliceHeight - 1) / SliceHeight;
+  m_sliceOffsets.resize(slices+1);
+  m_sliceOffsets(0) = 0;
+  for(Index s=0; s<slices; ++s)
+  {
+    Index start = s*SliceHeight;
+    StorageIndex width = m_rowLengths.segment(start, (std::min)(Index(SliceHeight), m_rows-start)).maxCoeff();
+    m_sliceOffsets(s+1) = m_sliceOffsets(s) + width * StorageIndex(SliceHeight);
+  }
+
+  m_values.setZero(m_sliceOffsets(slices));
+  m_innerIndices.resize(m_sliceOffsets(slices));
+  for(Index p=0; p<slices*SliceHeight; ++p)
+  {
+    Index s = p / SliceHeight;
+    Index width = (m_sliceOffsets(s+1) - m_sliceOffsets(s)) / SliceHeight;
+    Scalar* values = m_values.data() + m_sliceOffsets(s) + p % SliceHeight;
+    StorageIndex* indices = m_innerIndices.data() + m_sliceOffsets(s) + p % SliceHeight;
+    Index k = 0;
+    StorageIndex last = 0;
+    if(p<m_rows)
+    {
+      Index i = m_rowIndices(p);
+      for(; k<m_rowLengths(p); ++k)
+      {
+        values[k*SliceHeight] = mat.valuePtr()[outer[i]+k];
+        indices[k*SliceHeight] = last = mat.innerIndexPtr()[outer[i]+k];
+      }
+    }
+    // the padding refers to the last column of the row such that it does not load another coefficient of the vector,
+    // the padding of an empty row being skipped by the product
+    for(; k<width; ++k)
+      indices[k*SliceHeight] = last;
+  }
+  return *this;
+}
+
+namespace internal {
+
+/** \internal
+  * Performs dst += alpha * lhs * rhs for the slices [s0,s1) of lhs, where rhs is a dense column-major matrix
+  * of leading dimension rhsStride. */
+template<typename Scalar, typename StorageIndex, typename Dest>
+void sell_c_sigma_times_dense(const SellCSigmaMatrix<Scalar,StorageIndex>& lhs, const Scalar* rhs, Index rhsStride, Index rhsCols,
+                              Dest& dst, const Scalar& alpha, Index s0, Index s1)
+{
+  typedef SellCSigmaMatrix<Scalar,StorageIndex> LhsType;
+  typedef typename LhsType::Packet Packet;
+  enum { C = LhsType::SliceHeight };
+  const Scalar* values = lhs.valuePtr();
+  const StorageIndex* indices = lhs.innerIndexPtr();
+  const StorageIndex* offsets = lhs.sliceOffsetPtr();
+  const StorageIndex* rowIndices = lhs.rowIndexPtr();
+  const StorageIndex* rowLengths = lhs.rowLengthPtr();
+  const Index rows = lhs.rows();
+  const Packet pAlpha = pset1<Packet>(alpha);
+  EIGEN_ALIGN_MAX Scalar buffer[C];
+
+  for(Index c=0; c<rhsCols; ++c)
+  {
+    const Scalar* x = rhs + c*rhsStride;
+    for(Index s=s0; s<s1; ++s)
+    {
+      Packet acc = pset1<Packet>(Scalar(0));
+      for(Index k=offsets[s]; k<offsets[s+1]; k+=C)
+      {
+        // gather the coefficients of x matching the k-th non zeros of the rows of the slice
+        for(Index r=0; r<C; ++r)
+          buffer[r] = x[indices[k+r]];
+        acc = pmadd(pload<Packet>(values+k), pload<Packet>(buffer), acc);
+      }
+      pstore(buffer, pmul(pAlpha, acc));
+      Index end = (std::min)(Index(C), rows - s*C);
+      for(Index r=0; r<end; ++r)
+        if(rowLengths[s*C+r]>0)
+          dst.coeffRef(rowIndices[s*C+r], c) += buffer[r];
+    }
+  }
+}
+
+#if defined(EIGEN_HAS_OPENMP) || defined(EIGEN_HAS_PARALLEL_EXECUTOR)
+/** \internal
+  * Multi-threaded dst += alpha * lhs * rhs. The slices are split such that each thread processes the same number
+  * of stored coefficients. Each slice updates its own rows of dst, so that the threads do not need to synchronize. */
+template<typename Scalar, typename StorageIndex, typename Dest>
+struct sell_c_sigma_product_session
+{
+  sell_c_sigma_product_session(const SellCSigmaMatrix<Scalar,StorageIndex>& lhs, const Scalar* rhs, Index rhsStride, Index rhsCols,
+                               Dest& dst, const Scalar& alpha)
+    : m_lhs(lhs), m_rhs(rhs), m_rhsStride(rhsStride), m_rhsCols(rhsCols), m_dst(dst), m_alpha(alpha)
+  {}
+
+  void operator()(Index i, Index threads) const
+  {
+    const StorageIndex* offsets = m_lhs.sliceOffsetPtr();
+    Index slices = m_lhs.sliceCount();
+    double size = double(offsets[slices]);
+    Index s0 = std::lower_bound(offsets, offsets+slices, StorageIndex(size*double(i)/double(threads))) - offsets;
+    Index s1 = i+1==threads ? slices
+                            : std::lower_bound(offsets, offsets+slices, StorageIndex(size*double(i+1)/double(threads))) - offsets;
+    sell_c_sigma_times_dense(m_lhs, m_rhs, m_rhsStride, m_rhsCols, m_dst, m_alpha, s0, s1);
+  }
+
+  const SellCSigmaMatrix<Scalar,StorageIndex>& m_lhs;
+  const Scalar* m_rhs;
+  Index m_rhsStride;
+  Index m_rhsCols;
+  Dest& m_dst;
+  Scalar m_alpha;
+};
+#endif
+
+template<typename _Scalar, typename _StorageIndex, typename Rhs, int ProductType>
+struct generic_product_impl<SellCSigmaMatrix<_Scalar,_StorageIndex>, Rhs, SparseShape, DenseShape, ProductType>
+  : generic_product_impl_base<SellCSigmaMatrix<_Scalar,_StorageIndex>,Rhs,
+                              generic_product_impl<SellCSigmaMatrix<_Scalar,_StorageIndex>,Rhs,SparseShape,DenseShape,ProductType> >
+{
+  typedef SellCSigmaMatrix<_Scalar,_StorageIndex> Lhs;
+  typedef typename Product<Lhs,Rhs>::Scalar Scalar;
+
+  template<typename Dest>
+  static void scaleAndAddTo(Dest& dst, const Lhs& lhs, const Rhs& rhs, const Scalar& alpha)
+  {
+    EIGEN_STATIC_ASSERT((is_same<Scalar,typename Rhs::Scalar>::value), YOU_MIXED_DIFFERENT_NUMERIC_TYPES__YOU_NEED_TO_USE_THE_CAST_METHOD_OF_MATRIXBASE_TO_CAST_NUMERIC_TYPES_EXPLICITLY);
+    // the kernel reads the columns of rhs through a pointer, which requires a copy if they are not contiguous
+    Ref<const Matrix<Scalar,Dynamic,Dynamic,ColMajor>, 0, OuterStride<> > actualRhs(rhs);
+    const Scalar* rhsData = actualRhs.data();
+    Index rhsStride = actualRhs.outerStride();
+    Index rhsCols = actualRhs.cols();
+
+#if defined(EIGEN_HAS_OPENMP) || defined(EIGEN_HAS_PARALLEL_EXECUTOR)
+    Index threads = (std::min)(parallel_threads_for_work(double(lhs.storageSize())*double(rhsCols), sparse_min_task_size), lhs.sliceCount());
+    if(threads>1)
+    {
+      run_parallel_session(sell_c_sigma_product_session<Scalar,_StorageIndex,Dest>(lhs, rhsData, rhsStride, rhsCols, dst, alpha), threads);
+      return;
+    }
+#endif
+    sell_c_sigma_times_dense(lhs, rhsData, rhsStride, rhsCols, dst, alpha, 0, lhs.sliceCount());
+  }
+};
+
+} // end namespace internal
+
+} // end namespace Eigen
+
+#endif // EIGEN_SELL_C_SIGMA_MATRIX_H
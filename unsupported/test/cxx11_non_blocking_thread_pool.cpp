@@ -116,10 +116,126 @@ static void test_cancel()
   tp.Cancel();
 }
 
+static void test_steal_partitions()
+{
+  // Split the pool in 2 steal domains, and schedule tasks from inside and
+  // outside of the pool with hints.
+  const int kThreads = 8;
+  const int kTasks = 1000;
+  ThreadPool tp(kThreads);
+  std::vector<std::pair<unsigned, unsigned> > partitions(kThreads);
+  for (int i = 0; i < kThreads; ++i) {
+    partitions[i] = i < kThreads / 2 ? std::make_pair(0u, unsigned(kThreads / 2))
+                                     : std::make_pair(unsigned(kThreads / 2), unsigned(kThreads));
+  }
+  tp.SetStealPartitions(partitions);
+
+  std::atomic<int> running(0);
+  Eigen::Barrier done(2 * kTasks);
+  for (int i = 0; i < kTasks; ++i) {
+    const int start = i % 2 == 0 ? 0 : kThreads / 2;
+    tp.ScheduleWithHint([&]() {
+      running++;
+      tp.Schedule([&]() { done.Notify(); });
+      done.Notify();
+    }, start, start + kThreads / 2);
+  }
+  done.Wait();
+  VERIFY_IS_EQUAL(running.load(), kTasks);
+
+  // Block all the threads, then release a single one: it runs the task hinted
+  // to its partition first, and gets the one hinted to the other partition
+  // only by stealing from the whole pool.
+  Eigen::Barrier blocked(kThreads);
+  Eigen::Notification unblock[kThreads];
+  for (int i = 0; i < kThreads; ++i) {
+    tp.Schedule([&]() {
+      const int id = tp.CurrentThreadId();
+      blocked.Notify();
+      unblock[id].Wait();
+    });
+  }
+  blocked.Wait();
+
+  const int released = internal::random<int>(0, kThreads - 1);
+  const int start = released < kThreads / 2 ? 0 : kThreads / 2;
+  const int other_start = kThreads / 2 - start;
+  std::atomic<int> order(0);
+  int local_order = -1, local_thread = -1;
+  int other_order = -1, other_thread = -1;
+  Eigen::Barrier ran(2);
+  tp.ScheduleWithHint([&]() {
+    other_thread = tp.CurrentThreadId();
+    other_order = order++;
+    ran.Notify();
+  }, other_start, other_start + kThreads / 2);
+  tp.ScheduleWithHint([&]() {
+    local_thread = tp.CurrentThreadId();
+    local_order = order++;
+    ran.Notify();
+  }, start, start + kThreads / 2);
+  unblock[released].Notify();
+  ran.Wait();
+  VERIFY_IS_EQUAL(local_thread, released);
+  VERIFY_IS_EQUAL(local_order, 0);
+  VERIFY_IS_EQUAL(other_thread, released);
+  VERIFY_IS_EQUAL(other_order, 1);
+  for (int i = 0; i < kThreads; ++i) {
+    if (i != released) unblock[i].Notify();
+  }
+}
+
+static void test_high_priority()
+{
+  // Block the only worker, then check that the high priority task runs before
+  // the tasks scheduled earlier.
+  ThreadPool tp(1);
+  Eigen::Notification blocked, unblock;
+  tp.Schedule([&]() {
+    blocked.Notify();
+    unblock.Wait();
+  });
+  blocked.Wait();
+
+  const int kTasks = 10;
+  std::atomic<int> order(0);
+  std::vector<int> normal_order(kTasks, -1);
+  int high_priority_order = -1;
+  Eigen::Barrier done(kTasks + 1);
+  for (int i = 0; i < kTasks; ++i) {
+    tp.Schedule([&, i]() {
+      normal_order[i] = order++;
+      done.Notify();
+    });
+  }
+  tp.ScheduleHighPriority([&]() {
+    high_priority_order = order++;
+    done.Notify();
+  });
+  unblock.Notify();
+  done.Wait();
+
+  VERIFY_IS_EQUAL(high_priority_order, 0);
+  for (int i = 0; i < kTasks; ++i) VERIFY(normal_order[i] > 0);
+
+  // High priority tasks also run on a busy multi-threaded pool.
+  ThreadPool tp4(4);
+  Eigen::Barrier done4(400);
+  for (int i = 0; i < 200; ++i) {
+    tp4.Schedule([&]() {
+      tp4.ScheduleHighPriority([&]() { done4.Notify(); });
+      done4.Notify();
+    });
+  }
+  done4.Wait();
+}
+
 EIGEN_DECLARE_TEST(cxx11_non_blocking_thread_pool)
 {
   CALL_SUBTEST(test_create_destroy_empty_pool());
   CALL_SUBTEST(test_parallelism(true));
   CALL_SUBTEST(test_parallelism(false));
   CALL_SUBTEST(test_cancel());
+  CALL_SUBTEST(test_steal_partitions());
+  CALL_SUBTEST(test_high_priority());
 }
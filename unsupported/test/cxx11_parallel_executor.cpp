@@ -0,0 +1,609 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#define EIGEN_USE_THREADS
+#define EIGEN_USE_PARALLEL_EXECUTOR
+#define EIGEN_PARALLELIZE_GEMV
+#include "main.h"
+#include "Eigen/CXX11/ThreadPool"
+#include <Eigen/SparseCore>
+#include <Eigen/SparseCholesky>
+#include <Eigen/SparseLU>
+#include "Eigen/SparseExtra"
+#include <list>
+#include <typeinfo>
+
+// Forwards to a ThreadPoolExecutor while recording the parallel sessions.
+class CountingExecutor : public ThreadPoolExecutor {
+ public:
+  explicit CountingExecutor(ThreadPoolInterface* pool)
+      : ThreadPoolExecutor(pool), sessions(0), max_threads(0) {}
+
+  void run(Index n, const internal::parallel_task& task) {
+    ++sessions;
+    max_threads = (std::max)(max_threads, n);
+    task_types.push_back(&typeid(task));
+    ThreadPoolExecutor::run(n, task);
+  }
+
+  // Number of the recorded sessions started by run_parallel_session(Functor(...), ...).
+  template <typename Functor>
+  int sessionsOf() const {
+    int count = 0;
+    for (std::size_t k = 0; k < task_types.size(); ++k)
+      if (*task_types[k] == typeid(internal::parallel_task_adaptor<Functor>)) ++count;
+    return count;
+  }
+
+  int sessions;
+  Index max_threads;
+  std::vector<const std::type_info*> task_types;
+};
+
+template<typename MatrixType>
+static void test_gemm(Index rows, Index cols, Index depth)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef Matrix<Scalar,Dynamic,Dynamic,RowMajor> RowMatrixType;
+  MatrixType a = MatrixType::Random(rows, depth);
+  MatrixType b = MatrixType::Random(depth, cols);
+  RowMatrixType bt = b;
+  MatrixType ref = a.lazyProduct(b);
+
+  MatrixType c(rows, cols);
+  c.noalias() = a * b;
+  VERIFY_IS_APPROX(c, ref);
+  c.noalias() = a * bt;
+  VERIFY_IS_APPROX(c, ref);
+  c.noalias() += a * b;
+  VERIFY_IS_APPROX(c, Scalar(2)*ref);
+
+  RowMatrixType cr(rows, cols);
+  cr.noalias() = a * b;
+  VERIFY_IS_APPROX(cr, ref);
+}
+
+static void test_gemm_on_thread_pool()
+{
+  ThreadPool pool(4);
+  CountingExecutor executor(&pool);
+  setParallelExecutor(&executor);
+  VERIFY_IS_EQUAL(nbThreads(), 4);
+  VERIFY(parallelExecutor() == &executor);
+
+  test_gemm<MatrixXf>(300, 301, 257);
+  test_gemm<MatrixXd>(internal::random<int>(100,400), internal::random<int>(100,400), internal::random<int>(100,400));
+  test_gemm<MatrixXcf>(200, 123, 97);
+  VERIFY(executor.sessions > 0);
+  VERIFY(executor.max_threads > 1 && executor.max_threads <= 4);
+
+  // small products must stay single-threaded
+  int sessions = executor.sessions;
+  test_gemm<MatrixXd>(8, 8, 8);
+  VERIFY_IS_EQUAL(executor.sessions, sessions);
+
+  // explicitly disabled multi-threading
+  setNbThreads(1);
+  test_gemm<MatrixXf>(300, 300, 300);
+  VERIFY_IS_EQUAL(executor.sessions, sessions);
+  setNbThreads(0);
+
+  // no nested parallel sessions from within the pool
+  Barrier done(1);
+  pool.Schedule([&]() {
+    test_gemm<MatrixXf>(256, 256, 256);
+    done.Notify();
+  });
+  done.Wait();
+  VERIFY_IS_EQUAL(executor.sessions, sessions);
+
+  setParallelExecutor(0);
+  VERIFY(parallelExecutor() == 0);
+  test_gemm<MatrixXf>(300, 300, 300);
+  VERIFY_IS_EQUAL(executor.sessions, sessions);
+}
+
+// Several application threads running large products at once on the same executor.
+static void test_concurrent_gemm_on_thread_pool()
+{
+  ThreadPool pool(4);
+  ThreadPoolExecutor executor(&pool);
+  setParallelExecutor(&executor);
+
+  MatrixXf a = MatrixXf::Random(300, 257);
+  MatrixXf b = MatrixXf::Random(257, 301);
+  MatrixXf ref = a.lazyProduct(b);
+  MatrixXf c[2];
+  std::thread threads[2];
+  for(int t = 0; t < 2; ++t)
+    threads[t] = std::thread([&, t]() {
+      for(int k = 0; k < 10; ++k)
+        c[t].noalias() = a * b;
+    });
+  for(int t = 0; t < 2; ++t)
+  {
+    threads[t].join();
+    VERIFY_IS_APPROX(c[t], ref);
+  }
+
+  // a worker of another pool is an external thread for this executor
+  ThreadPool other(1);
+  MatrixXf d;
+  Barrier done(1);
+  other.Schedule([&]() {
+    d.noalias() = a * b;
+    done.Notify();
+  });
+  MatrixXf e = a * b;
+  done.Wait();
+  VERIFY_IS_APPROX(d, ref);
+  VERIFY_IS_APPROX(e, ref);
+
+  setParallelExecutor(0);
+}
+
+template<typename MatrixType>
+static void test_gemv(Index rows, Index cols)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef Matrix<Scalar,Dynamic,1> VectorType;
+  typedef Matrix<Scalar,1,Dynamic> RowVectorType;
+  MatrixType a = MatrixType::Random(rows, cols);
+  VectorType x = VectorType::Random(cols);
+  RowVectorType xt = RowVectorType::Random(rows);
+  VectorType y = VectorType::Random(rows);
+  RowVectorType yt = RowVectorType::Random(cols);
+
+  VectorType ref = y + Scalar(2) * a.lazyProduct(x);
+  y.noalias() += Scalar(2) * a * x;
+  VERIFY_IS_APPROX(y, ref);
+
+  RowVectorType reft = yt - xt.lazyProduct(a);
+  yt.noalias() -= xt * a;
+  VERIFY_IS_APPROX(yt, reft);
+
+  // non-unit increments on the result and the rhs
+  MatrixType y2 = MatrixType::Random(rows, 2);
+  MatrixType x2 = MatrixType::Random(cols, 2);
+  ref = y2.col(1) + a.lazyProduct(x2.col(1));
+  y2.col(1).noalias() += a * x2.col(1);
+  VERIFY_IS_APPROX(y2.col(1), ref);
+}
+
+template<int Mode, typename MatrixType>
+static void test_trmv(Index rows, Index cols)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef Matrix<Scalar,Dynamic,1> VectorType;
+  MatrixType a = MatrixType::Random(rows, cols);
+  MatrixType tri = a.template triangularView<Mode>();
+  VectorType x = VectorType::Random(cols);
+  VectorType y = VectorType::Random(rows);
+  VectorType xt = VectorType::Random(rows);
+  VectorType yt = VectorType::Random(cols);
+
+  VectorType ref = y + Scalar(3) * tri.lazyProduct(x);
+  y.noalias() += a.template triangularView<Mode>() * (Scalar(3) * x);
+  VERIFY_IS_APPROX(y, ref);
+
+  VectorType reft = yt + tri.transpose().lazyProduct(xt);
+  yt.noalias() += a.template triangularView<Mode>().transpose() * xt;
+  VERIFY_IS_APPROX(yt, reft);
+}
+
+template<typename MatrixType>
+static void test_trmv_all_modes(Index rows, Index cols)
+{
+  test_trmv<Lower,MatrixType>(rows, cols);
+  test_trmv<Upper,MatrixType>(rows, cols);
+  test_trmv<UnitLower,MatrixType>(rows, cols);
+  test_trmv<UnitUpper,MatrixType>(rows, cols);
+  test_trmv<StrictlyLower,MatrixType>(rows, cols);
+  test_trmv<StrictlyUpper,MatrixType>(rows, cols);
+}
+
+static void test_gemv_on_thread_pool()
+{
+  ThreadPool pool(4);
+  CountingExecutor executor(&pool);
+  setParallelExecutor(&executor);
+
+  // tall matrices are split by rows, wide ones by columns
+  test_gemv<MatrixXf>(1000, 300);
+  test_gemv<MatrixXd>(internal::random<int>(20,60), internal::random<int>(3000,5000));
+  test_gemv<Matrix<double,Dynamic,Dynamic,RowMajor> >(1000, 300);
+  test_gemv<Matrix<float,Dynamic,Dynamic,RowMajor> >(37, 4000);
+  test_gemv<MatrixXcd>(500, 301);
+  VERIFY(executor.sessions > 0);
+
+  int sessions = executor.sessions;
+  test_gemv<MatrixXf>(50, 50);
+  VERIFY_IS_EQUAL(executor.sessions, sessions);
+
+  test_trmv_all_modes<MatrixXf>(700, 700);
+  test_trmv_all_modes<MatrixXd>(internal::random<int>(300,900), internal::random<int>(300,900));
+  test_trmv_all_modes<Matrix<double,Dynamic,Dynamic,RowMajor> >(internal::random<int>(300,900), internal::random<int>(300,900));
+  test_trmv_all_modes<MatrixXcf>(400, 450);
+  VERIFY(executor.sessions > sessions);
+
+  setParallelExecutor(0);
+}
+
+template<int Mode, typename MatrixType, typename OtherType>
+static void test_trsm(Index size, Index cols)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  // keep the off-diagonal part small so that unit triangular matrices are well conditioned too
+  MatrixType a = MatrixType::Random(size, size) / Scalar(size);
+  a.diagonal().array() += Scalar(1);
+  OtherType b = OtherType::Random(size, cols);
+  OtherType bt = OtherType::Random(cols, size);
+
+  OtherType x = b;
+  a.template triangularView<Mode>().solveInPlace(x);
+  VERIFY_IS_APPROX(a.template triangularView<Mode>() * x, b);
+
+  OtherType xt = bt;
+  a.template triangularView<Mode>().template solveInPlace<OnTheRight>(xt);
+  VERIFY_IS_APPROX(xt * a.template triangularView<Mode>(), bt);
+}
+
+template<typename MatrixType>
+static void test_syrk(Index size, Index depth)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef Matrix<Scalar,Dynamic,Dynamic,RowMajor> RowMatrixType;
+  MatrixType a = MatrixType::Random(size, depth);
+  MatrixType b = MatrixType::Random(depth, size);
+  MatrixType c0 = MatrixType::Random(size, size);
+  MatrixType ref = c0 + a.lazyProduct(a.adjoint());
+
+  MatrixType c = c0;
+  c.template selfadjointView<Lower>().rankUpdate(a);
+  VERIFY_IS_APPROX(MatrixType(c.template triangularView<Lower>()), MatrixType(ref.template triangularView<Lower>()));
+  VERIFY_IS_APPROX(MatrixType(c.template triangularView<StrictlyUpper>()), MatrixType(c0.template triangularView<StrictlyUpper>()));
+
+  RowMatrixType cr = c0;
+  cr.template selfadjointView<Upper>().rankUpdate(a);
+  VERIFY_IS_APPROX(MatrixType(cr.template triangularView<Upper>()), MatrixType(ref.template triangularView<Upper>()));
+
+  ref = c0 + a.lazyProduct(b);
+  c = c0;
+  c.template triangularView<Upper>() += a * b;
+  VERIFY_IS_APPROX(MatrixType(c.template triangularView<Upper>()), MatrixType(ref.template triangularView<Upper>()));
+  VERIFY_IS_APPROX(MatrixType(c.template triangularView<StrictlyLower>()), MatrixType(c0.template triangularView<StrictlyLower>()));
+
+  MatrixType spd = a * a.adjoint();
+  spd.diagonal().array() += Scalar(size);
+  MatrixType rhs = MatrixType::Random(size, 3);
+  VERIFY_IS_APPROX(spd * spd.llt().solve(rhs), rhs);
+}
+
+static void test_level3_on_thread_pool()
+{
+  ThreadPool pool(4);
+  CountingExecutor executor(&pool);
+  setParallelExecutor(&executor);
+
+  typedef Matrix<double,Dynamic,Dynamic,RowMajor> RowMatrixXd;
+  test_trsm<Lower,MatrixXd,MatrixXd>(300, 400);
+  test_trsm<Upper,MatrixXd,RowMatrixXd>(internal::random<int>(100,400), internal::random<int>(100,400));
+  test_trsm<UnitLower,RowMatrixXd,MatrixXd>(257, 333);
+  test_trsm<UnitUpper,MatrixXcf,MatrixXcf>(200, 250);
+  VERIFY(executor.sessions > 0);
+
+  int sessions = executor.sessions;
+  test_trsm<Lower,MatrixXd,MatrixXd>(8, 8);
+  VERIFY_IS_EQUAL(executor.sessions, sessions);
+
+  test_syrk<MatrixXd>(internal::random<int>(200,500), internal::random<int>(100,300));
+  test_syrk<MatrixXf>(401, 257);
+  test_syrk<MatrixXcd>(230, 150);
+  VERIFY(executor.sessions > sessions);
+
+  setParallelExecutor(0);
+}
+
+template<typename SparseType>
+static SparseType random_sparse(Index rows, Index cols, double density)
+{
+  typedef typename SparseType::Scalar Scalar;
+  std::vector<Triplet<Scalar> > triplets;
+  for(Index j=0; j<cols; ++j)
+    for(Index i=0; i<rows; ++i)
+      if(internal::random<double>(0,1) < density)
+        triplets.push_back(Triplet<Scalar>(i, j, internal::random<Scalar>()));
+  SparseType m(rows, cols);
+  m.setFromTriplets(triplets.begin(), triplets.end());
+  return m;
+}
+
+template<typename SparseType>
+static bool has_sorted_inner_indices(const SparseType& m)
+{
+  for(Index j=0; j<m.outerSize(); ++j)
+  {
+    Index prev = -1;
+    for(typename SparseType::InnerIterator it(m, j); it; ++it)
+    {
+      if(it.index() <= prev)
+        return false;
+      prev = it.index();
+    }
+  }
+  return true;
+}
+
+template<typename LhsType, typename RhsType, typename ResType>
+static void test_spgemm(Index rows, Index depth, Index cols, double density)
+{
+  typedef typename ResType::Scalar Scalar;
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseType;
+  LhsType lhs = random_sparse<LhsType>(rows, depth, density);
+  RhsType rhs = random_sparse<RhsType>(depth, cols, density);
+  DenseType ref = DenseType(lhs).lazyProduct(DenseType(rhs));
+
+  ResType res = lhs * rhs;
+  VERIFY(res.isCompressed());
+  VERIFY(has_sorted_inner_indices(res));
+  VERIFY_IS_APPROX(DenseType(res), ref);
+
+  // the multi-threaded product accumulates in the same order as the sequential one
+  int threads = nbThreads();
+  setNbThreads(1);
+  ResType seq = lhs * rhs;
+  ResType seqPruned = (lhs * rhs).pruned(RealScalar(1), RealScalar(0.5));
+  setNbThreads(threads);
+  VERIFY_IS_EQUAL(res.nonZeros(), seq.nonZeros());
+  VERIFY_IS_EQUAL(DenseType(res), DenseType(seq));
+
+  ResType pruned = (lhs * rhs).pruned(RealScalar(1), RealScalar(0.5));
+  VERIFY(pruned.isCompressed());
+  VERIFY_IS_EQUAL(pruned.nonZeros(), seqPruned.nonZeros());
+  VERIFY_IS_EQUAL(DenseType(pruned), DenseType(seqPruned));
+  VERIFY(pruned.nonZeros() < res.nonZeros());
+}
+
+static void test_sparse_product_on_thread_pool()
+{
+  ThreadPool pool(4);
+  CountingExecutor executor(&pool);
+  setParallelExecutor(&executor);
+
+  typedef SparseMatrix<double,ColMajor> SpMat;
+  typedef SparseMatrix<double,RowMajor> RowSpMat;
+  test_spgemm<SpMat,SpMat,SpMat>(500, 400, 300, 0.05);
+  VERIFY(executor.sessions > 0);
+  test_spgemm<SpMat,SpMat,RowSpMat>(300, 400, 500, 0.05);
+  test_spgemm<RowSpMat,RowSpMat,RowSpMat>(internal::random<int>(200,600), 400, internal::random<int>(200,600), 0.05);
+  test_spgemm<RowSpMat,SpMat,SpMat>(400, 300, 400, 0.05);
+  test_spgemm<SpMat,RowSpMat,SpMat>(400, 300, 400, 0.05);
+  test_spgemm<SparseMatrix<std::complex<float> >,SparseMatrix<std::complex<float> >,SparseMatrix<std::complex<float> > >(300, 300, 300, 0.08);
+
+  // products too small to be worth it are sequential
+  int sessions = executor.sessions;
+  test_spgemm<SpMat,SpMat,SpMat>(30, 30, 30, 0.1);
+  VERIFY_IS_EQUAL(executor.sessions, sessions);
+
+  setParallelExecutor(0);
+}
+
+// An iterator providing only what setFromTriplets needs, without any iterator traits.
+template<typename T>
+class MinimalIterator {
+ public:
+  explicit MinimalIterator(const T* ptr) : m_ptr(ptr) {}
+  const T* operator->() const { return m_ptr; }
+  MinimalIterator& operator++() { ++m_ptr; return *this; }
+  bool operator!=(const MinimalIterator& other) const { return m_ptr != other.m_ptr; }
+
+ private:
+  const T* m_ptr;
+};
+
+template<typename SparseType>
+static void test_triplets(Index rows, Index cols, Index size)
+{
+  typedef typename SparseType::Scalar Scalar;
+  typedef Triplet<Scalar> T;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseType;
+  std::vector<T> triplets;
+  DenseType ref = DenseType::Zero(rows, cols);
+  for(Index k=0; k<size; ++k)
+  {
+    // a few full columns, and many duplicates
+    Index i = internal::random<Index>(0,rows-1);
+    Index j = k%7==0 ? internal::random<Index>(0,2) : internal::random<Index>(0,cols-1);
+    triplets.push_back(T(i, j, internal::random<Scalar>()));
+    ref(i,j) += triplets.back().value();
+  }
+
+  SparseType m(rows, cols);
+  m.setFromTriplets(triplets.begin(), triplets.end());
+  VERIFY(m.isCompressed());
+  VERIFY(has_sorted_inner_indices(m));
+  VERIFY_IS_APPROX(DenseType(m), ref);
+
+  // the duplicates are collapsed in the input order, like in the sequential construction
+  int threads = nbThreads();
+  setNbThreads(1);
+  SparseType seq(rows, cols), seqLast(rows, cols);
+  seq.setFromTriplets(triplets.begin(), triplets.end());
+  seqLast.setFromTriplets(triplets.begin(), triplets.end(), internal::scalar_difference_op<Scalar,Scalar>());
+  setNbThreads(threads);
+  VERIFY_IS_EQUAL(m.nonZeros(), seq.nonZeros());
+  VERIFY_IS_EQUAL(DenseType(m), DenseType(seq));
+  m.setFromTriplets(triplets.begin(), triplets.end(), internal::scalar_difference_op<Scalar,Scalar>());
+  VERIFY_IS_EQUAL(DenseType(m), DenseType(seqLast));
+
+  // non random access iterators are read sequentially
+  std::list<T> list(triplets.begin(), triplets.end());
+  m.setFromTriplets(list.begin(), list.end());
+  VERIFY_IS_EQUAL(DenseType(m), DenseType(seq));
+  // as well as the iterators without iterator_category
+  m.setFromTriplets(MinimalIterator<T>(triplets.data()), MinimalIterator<T>(triplets.data() + triplets.size()));
+  VERIFY_IS_EQUAL(DenseType(m), DenseType(seq));
+  // while the pointers are random access
+  m.setFromTriplets(triplets.data(), triplets.data() + triplets.size());
+  VERIFY_IS_EQUAL(DenseType(m), DenseType(seq));
+}
+
+static void test_set_from_triplets_on_thread_pool()
+{
+  ThreadPool pool(4);
+  CountingExecutor executor(&pool);
+  setParallelExecutor(&executor);
+
+  int sessions = executor.sessions;
+  test_triplets<SparseMatrix<double> >(300, 400, 100000);
+  VERIFY(executor.sessions > sessions);
+  test_triplets<SparseMatrix<double,RowMajor> >(internal::random<int>(1,500), internal::random<int>(1,500), 100000);
+  test_triplets<SparseMatrix<std::complex<float>,ColMajor,long int> >(50, 1000, 100000);
+
+  sessions = executor.sessions;
+  test_triplets<SparseMatrix<double> >(30, 40, 100);
+  VERIFY_IS_EQUAL(executor.sessions, sessions);
+
+  // and so are the matrices with more outer vectors than triplets, for which the histograms would dominate
+  test_triplets<SparseMatrix<double> >(2, 200000, 100000);
+  VERIFY_IS_EQUAL(executor.sessions, sessions);
+
+  setParallelExecutor(0);
+}
+
+static void test_sell_c_sigma_on_thread_pool()
+{
+  ThreadPool pool(4);
+  CountingExecutor executor(&pool);
+  setParallelExecutor(&executor);
+
+  typedef SparseMatrix<double,RowMajor> SpMat;
+  SpMat m = random_sparse<SpMat>(internal::random<int>(1000,2000), 1000, 0.05);
+  SellCSigmaMatrix<double> s(m);
+  VectorXd x = VectorXd::Random(m.cols());
+  MatrixXd X = MatrixXd::Random(m.cols(), 3);
+  int sessions = executor.sessions;
+  VERIFY_IS_APPROX(VectorXd(s * x), VectorXd(m * x));
+  VERIFY_IS_APPROX(MatrixXd(s * X), MatrixXd(m * X));
+  VERIFY(executor.sessions > sessions);
+
+  // each row is computed by a single thread in the same order
+  int threads = nbThreads();
+  setNbThreads(1);
+  VectorXd seq = s * x;
+  setNbThreads(threads);
+  VERIFY_IS_EQUAL(VectorXd(s * x), seq);
+
+  setParallelExecutor(0);
+}
+
+// the lower triangular part of the 7-point Laplacian on a n^3 grid, whose factors have large supernodes
+static SparseMatrix<double> laplacian_3d(int n)
+{
+  std::vector<Triplet<double> > triplets;
+  for(int i = 0; i < n; ++i)
+    for(int j = 0; j < n; ++j)
+      for(int k = 0; k < n; ++k)
+      {
+        int c = (i*n+j)*n+k;
+        triplets.push_back(Triplet<double>(c,c,6));
+        if(i>0) triplets.push_back(Triplet<double>(c,c-n*n,-1));
+        if(j>0) triplets.push_back(Triplet<double>(c,c-n,-1));
+        if(k>0) triplets.push_back(Triplet<double>(c,c-1,-1));
+      }
+  SparseMatrix<double> A(n*n*n,n*n*n);
+  A.setFromTriplets(triplets.begin(), triplets.end());
+  return A;
+}
+
+static void test_supernodal_llt_on_thread_pool()
+{
+  ThreadPool pool(4);
+  CountingExecutor executor(&pool);
+  setParallelExecutor(&executor);
+
+  // the elimination tree of a 3D Laplacian has large independent subtrees
+  typedef SparseMatrix<double> SpMat;
+  SpMat A = laplacian_3d(internal::random<int>(12,16));
+  MatrixXd b = MatrixXd::Random(A.rows(), 2);
+
+  // the dense kernels run sessions of their own, hence look for the one scheduling the subtrees
+  SupernodalLLT<SpMat> llt(A);
+  VERIFY(llt.info() == Success);
+  VERIFY_IS_EQUAL(executor.sessionsOf<internal::supernodal_llt_session<SupernodalLLT<SpMat> > >(), 1);
+  MatrixXd x = llt.solve(b);
+  VERIFY_IS_APPROX(MatrixXd(A.selfadjointView<Lower>() * x), b);
+
+  int threads = nbThreads();
+  setNbThreads(1);
+  SupernodalLLT<SpMat> seq(A);
+  setNbThreads(threads);
+  VERIFY(llt.matrixL().isApprox(seq.matrixL()));
+
+  // the elimination tree of a tridiagonal matrix is a chain, which is left to the sequential pass
+  typedef SupernodalLLT<SpMat,Lower,NaturalOrdering<int> > ChainLLT;
+  const int n = 60000;
+  std::vector<Triplet<double> > triplets;
+  for(int i = 0; i < n; ++i)
+  {
+    triplets.push_back(Triplet<double>(i,i,4));
+    if(i>0) triplets.push_back(Triplet<double>(i,i-1,-1));
+  }
+  SpMat T(n,n);
+  T.setFromTriplets(triplets.begin(), triplets.end());
+  MatrixXd c = MatrixXd::Random(n, 2);
+  ChainLLT chain(T);
+  VERIFY(chain.info() == Success);
+  VERIFY_IS_EQUAL(executor.sessionsOf<internal::supernodal_llt_session<ChainLLT> >(), 0);
+  x = chain.solve(c);
+  VERIFY_IS_APPROX(MatrixXd(T.selfadjointView<Lower>() * x), c);
+
+  setParallelExecutor(0);
+}
+
+static void test_sparselu_on_thread_pool()
+{
+  ThreadPool pool(4);
+  CountingExecutor executor(&pool);
+  setParallelExecutor(&executor);
+
+  // a non symmetric matrix with the pattern of a 3D Laplacian
+  typedef SparseMatrix<double> SpMat;
+  SpMat L = laplacian_3d(internal::random<int>(12,14));
+  SpMat A = L + SpMat(0.5 * L.transpose());
+  MatrixXd b = MatrixXd::Random(A.rows(), 2);
+
+  // the dense kernels run sessions of their own, hence look for the ones of the supernodal updates
+  SparseLU<SpMat> lu(A);
+  VERIFY(lu.info() == Success);
+  VERIFY(executor.sessionsOf<internal::sparselu_gemm_session<double> >() > 0);
+  MatrixXd x = lu.solve(b);
+  VERIFY_IS_APPROX(MatrixXd(A * x), b);
+
+  int threads = nbThreads();
+  setNbThreads(1);
+  SparseLU<SpMat> seq(A);
+  setNbThreads(threads);
+  VERIFY_IS_APPROX(x, MatrixXd(seq.solve(b)));
+  VERIFY_IS_APPROX(lu.logAbsDeterminant(), seq.logAbsDeterminant());
+
+  setParallelExecutor(0);
+}
+
+EIGEN_DECLARE_TEST(cxx11_parallel_executor)
+{
+  CALL_SUBTEST(test_gemm_on_thread_pool());
+  CALL_SUBTEST(test_concurrent_gemm_on_thread_pool());
+  CALL_SUBTEST(test_gemv_on_thread_pool());
+  CALL_SUBTEST(test_level3_on_thread_pool());
+  CALL_SUBTEST(test_sparse_product_on_thread_pool());
+  CALL_SUBTEST(test_sell_c_sigma_on_thread_pool());
+  CALL_SUBTEST(test_set_from_triplets_on_thread_pool());
+  CALL_SUBTEST(test_supernodal_llt_on_thread_pool());
+  CALL_SUBTEST(test_sparselu_on_thread_pool());
+}
@@ -381,6 +381,30 @@ static void test_large_contraction()
   }
 }
 
+template<int DataLayout>
+static void test_bfloat16_contraction()
+{
+  Tensor<bfloat16, 2, DataLayout> t_left(137, 300);
+  Tensor<bfloat16, 2, DataLayout> t_right(300, 23);
+  t_left.setRandom();
+  t_right.setRandom();
+
+  // Add a little offset so that the results won't be close to zero.
+  t_left += t_left.constant(bfloat16(1.0f));
+  t_right += t_right.constant(bfloat16(1.0f));
+
+  Tensor<float, 2, DataLayout> t_left_float = t_left.template cast<float>();
+  Tensor<float, 2, DataLayout> t_right_float = t_right.template cast<float>();
+
+  Eigen::array<DimPair, 1> dims = {{DimPair(1, 0)}};
+  Tensor<bfloat16, 2, DataLayout> t_result = t_left.contract(t_right, dims);
+  Tensor<float, 2, DataLayout> t_result_float = t_left_float.contract(t_right_float, dims);
+
+  for (int i = 0; i < t_result.size(); i++) {
+    VERIFY_IS_APPROX(t_result.data()[i], bfloat16(t_result_float.data()[i]));
+  }
+}
+
 template<int DataLayout>
 static void test_matrix_vector()
 {
@@ -581,6 +605,8 @@ EIGEN_DECLARE_TEST(cxx11_tensor_contraction)
   CALL_SUBTEST(test_consistency<RowMajor>());
   CALL_SUBTEST(test_large_contraction<ColMajor>());
   CALL_SUBTEST(test_large_contraction<RowMajor>());
+  CALL_SUBTEST(test_bfloat16_contraction<ColMajor>());
+  CALL_SUBTEST(test_bfloat16_contraction<RowMajor>());
   CALL_SUBTEST(test_matrix_vector<ColMajor>());
   CALL_SUBTEST(test_matrix_vector<RowMajor>());
   CALL_SUBTEST(test_tensor_vector<ColMajor>());
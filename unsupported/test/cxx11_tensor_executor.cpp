@@ -56,6 +56,114 @@ static void test_execute_binary_expr(Device d) {
   }
 }
 
+// Evaluates the expression into dst with the given executor, and checks that
+// the result matches the one of the non vectorized and non tiled executor.
+template <typename Device, bool Vectorizable, bool Tileable, typename Dst,
+          typename Expression>
+static void verify_execute_expr(Device d, Dst& dst, const Expression& expr) {
+  Dst golden(dst.dimensions());
+  using GoldenAssign = TensorAssignOp<Dst, const Expression>;
+  internal::TensorExecutor<const GoldenAssign, DefaultDevice, false,
+                           false>::run(GoldenAssign(golden, expr),
+                                       DefaultDevice());
+
+  using Assign = TensorAssignOp<Dst, const Expression>;
+  using Executor =
+      internal::TensorExecutor<const Assign, Device, Vectorizable, Tileable>;
+  Executor::run(Assign(dst, expr), d);
+
+  for (Index i = 0; i < dst.size(); ++i) {
+    VERIFY_IS_EQUAL(golden.data()[i], dst.data()[i]);
+  }
+}
+
+template <typename Device, bool Vectorizable, bool Tileable, int Layout>
+static void test_execute_shuffle(Device d) {
+  int d0 = internal::random<int>(100, 200);
+  int d1 = internal::random<int>(100, 200);
+  int d2 = internal::random<int>(10, 20);
+
+  Tensor<float, 3, Layout, int> src(d0, d1, d2);
+  src.setRandom();
+
+  Eigen::array<int, 3> shuffle = {{1, 2, 0}};
+  Tensor<float, 3, Layout, int> dst(d1, d2, d0);
+  verify_execute_expr<Device, Vectorizable, Tileable>(d, dst,
+                                                      src.shuffle(shuffle));
+
+  // Transpose of the result of a binary op, and binary op of a transpose.
+  Eigen::array<int, 3> transpose = {{1, 0, 2}};
+  Tensor<float, 3, Layout, int> transposed(d1, d0, d2);
+  verify_execute_expr<Device, Vectorizable, Tileable>(
+      d, transposed, (src + src).shuffle(transpose));
+  verify_execute_expr<Device, Vectorizable, Tileable>(
+      d, transposed, src.shuffle(transpose) + transposed);
+}
+
+template <typename Device, bool Vectorizable, bool Tileable, int Layout>
+static void test_execute_reverse(Device d) {
+  int d0 = internal::random<int>(100, 200);
+  int d1 = internal::random<int>(100, 200);
+  int d2 = internal::random<int>(10, 20);
+
+  Tensor<float, 3, Layout, int> src(d0, d1, d2);
+  src.setRandom();
+
+  Tensor<float, 3, Layout, int> dst(d0, d1, d2);
+  for (int r = 0; r < 8; ++r) {
+    Eigen::array<bool, 3> reverse = {{(r & 1) != 0, (r & 2) != 0, (r & 4) != 0}};
+    verify_execute_expr<Device, Vectorizable, Tileable>(d, dst,
+                                                        src.reverse(reverse));
+    verify_execute_expr<Device, Vectorizable, Tileable>(
+        d, dst, (src - src.reverse(reverse)).reverse(reverse));
+  }
+}
+
+template <typename Device, bool Vectorizable, bool Tileable, int Layout>
+static void test_execute_pad(Device d) {
+  int d0 = internal::random<int>(100, 200);
+  int d1 = internal::random<int>(100, 200);
+  int d2 = internal::random<int>(10, 20);
+
+  Tensor<float, 3, Layout, int> src(d0, d1, d2);
+  src.setRandom();
+
+  Eigen::array<std::pair<int, int>, 3> padding;
+  padding[0] = std::make_pair(internal::random<int>(0, 40), internal::random<int>(0, 40));
+  padding[1] = std::make_pair(internal::random<int>(0, 40), internal::random<int>(0, 40));
+  padding[2] = std::make_pair(internal::random<int>(0, 4), internal::random<int>(0, 4));
+
+  Tensor<float, 3, Layout, int> dst(d0 + padding[0].first + padding[0].second,
+                                    d1 + padding[1].first + padding[1].second,
+                                    d2 + padding[2].first + padding[2].second);
+  verify_execute_expr<Device, Vectorizable, Tileable>(d, dst,
+                                                      src.pad(padding, 1.5f));
+  verify_execute_expr<Device, Vectorizable, Tileable>(
+      d, dst, (src * src).pad(padding) + dst);
+}
+
+template <typename Device, bool Vectorizable, bool Tileable, int Layout>
+static void test_execute_slice(Device d) {
+  int d0 = internal::random<int>(100, 200);
+  int d1 = internal::random<int>(100, 200);
+  int d2 = internal::random<int>(10, 20);
+
+  Tensor<float, 3, Layout, int> src(d0, d1, d2);
+  src.setRandom();
+
+  Eigen::array<int, 3> offsets = {{internal::random<int>(0, d0 / 2),
+                                   internal::random<int>(0, d1 / 2),
+                                   internal::random<int>(0, d2 / 2)}};
+  Eigen::array<int, 3> extents = {{d0 - offsets[0], d1 - offsets[1] - 1,
+                                   d2 - offsets[2]}};
+
+  Tensor<float, 3, Layout, int> dst(extents[0], extents[1], extents[2]);
+  verify_execute_expr<Device, Vectorizable, Tileable>(
+      d, dst, src.slice(offsets, extents));
+  verify_execute_expr<Device, Vectorizable, Tileable>(
+      d, dst, (src + src).slice(offsets, extents) - dst);
+}
+
 #define CALL_SUBTEST_COMBINATIONS(NAME)                                        \
   CALL_SUBTEST((NAME<DefaultDevice, false, false, ColMajor>(default_device))); \
   CALL_SUBTEST((NAME<DefaultDevice, false, true, ColMajor>(default_device)));  \
@@ -82,6 +190,10 @@ EIGEN_DECLARE_TEST(cxx11_tensor_executor) {
   Eigen::ThreadPoolDevice tp_device(&tp, num_threads);
 
   CALL_SUBTEST_COMBINATIONS(test_execute_binary_expr);
+  CALL_SUBTEST_COMBINATIONS(test_execute_shuffle);
+  CALL_SUBTEST_COMBINATIONS(test_execute_reverse);
+  CALL_SUBTEST_COMBINATIONS(test_execute_pad);
+  CALL_SUBTEST_COMBINATIONS(test_execute_slice);
 }
 
 #undef CALL_SUBTEST_COMBINATIONS
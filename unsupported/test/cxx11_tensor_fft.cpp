@@ -253,6 +253,37 @@ static void test_fft_non_power_of_2_round_trip(int exponent) {
   }
 }
 
+// Compares the FFT along dim of a 2D tensor with the naive DFT, for sizes
+// computed by the radix 4 algorithm with or without a radix 2 stage, and by
+// Bluestein's algorithm.
+template <int DataLayout, int FFTDirection>
+static void test_fft_against_dft(int dim0, int dim1, int dim) {
+  Tensor<std::complex<double>, 2, DataLayout> input(dim0, dim1);
+  input.setRandom();
+
+  array<int, 1> fft;
+  fft[0] = dim;
+  Tensor<std::complex<double>, 2, DataLayout> output =
+      input.template fft<BothParts, FFTDirection>(fft);
+
+  const int n = input.dimension(dim);
+  const double sign = FFTDirection == FFT_FORWARD ? -1 : 1;
+  for (int i = 0; i < dim0; ++i) {
+    for (int j = 0; j < dim1; ++j) {
+      const int freq = dim == 0 ? i : j;
+      std::complex<double> expected(0, 0);
+      for (int k = 0; k < n; ++k) {
+        const double arg = sign * 2 * EIGEN_PI * ((static_cast<double>(k) * freq) / n);
+        expected += (dim == 0 ? input(k, j) : input(i, k)) * std::complex<double>(std::cos(arg), std::sin(arg));
+      }
+      if (FFTDirection == FFT_REVERSE) {
+        expected /= static_cast<double>(n);
+      }
+      VERIFY_IS_APPROX(output(i, j) + std::complex<double>(1, 1), expected + std::complex<double>(1, 1));
+    }
+  }
+}
+
 EIGEN_DECLARE_TEST(cxx11_tensor_fft) {
     test_fft_complex_input_golden();
     test_fft_real_input_golden();
@@ -301,4 +332,11 @@ EIGEN_DECLARE_TEST(cxx11_tensor_fft) {
     test_fft_real_input_energy<RowMajor, double, false,  Eigen::BothParts, FFT_FORWARD, 4>();
 
     test_fft_non_power_of_2_round_trip<float>(7);
+
+    test_fft_against_dft<ColMajor, FFT_FORWARD>(64, 3, 0);
+    test_fft_against_dft<ColMajor, FFT_REVERSE>(3, 128, 1);
+    test_fft_against_dft<RowMajor, FFT_FORWARD>(37, 19, 0);
+    test_fft_against_dft<RowMajor, FFT_REVERSE>(5, 100, 1);
+    test_fft_against_dft<ColMajor, FFT_FORWARD>(3, 2, 1);
+    test_fft_against_dft<RowMajor, FFT_REVERSE>(1, 5, 0);
 }
@@ -0,0 +1,140 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#define EIGEN_USE_THREADS
+
+#include "main.h"
+
+#include <Eigen/CXX11/Tensor>
+
+using Eigen::Tensor;
+using Eigen::array;
+
+// Normalizes the input along the reduced dimensions with explicit loops, in
+// double precision.
+template <int DataLayout, int NumReduced>
+static Tensor<double, 4, DataLayout> reference_normalize(const Tensor<float, 4, DataLayout>& input,
+                                                         const array<int, NumReduced>& dims, double epsilon) {
+  bool reduced[4] = {false, false, false, false};
+  for (int i = 0; i < NumReduced; ++i) reduced[dims[i]] = true;
+  // Key of the group of reduced coefficients of each coefficient.
+  Tensor<int, 4, DataLayout> key(input.dimensions());
+  int num_groups = 1;
+  array<int, 4> group_strides;
+  for (int i = 0; i < 4; ++i) {
+    group_strides[i] = reduced[i] ? 0 : num_groups;
+    if (!reduced[i]) num_groups *= static_cast<int>(input.dimension(i));
+  }
+  for (int i = 0; i < input.dimension(0); ++i) {
+    for (int j = 0; j < input.dimension(1); ++j) {
+      for (int k = 0; k < input.dimension(2); ++k) {
+        for (int l = 0; l < input.dimension(3); ++l) {
+          key(i, j, k, l) = i * group_strides[0] + j * group_strides[1] + k * group_strides[2] + l * group_strides[3];
+        }
+      }
+    }
+  }
+  std::vector<double> sum(num_groups, 0.0);
+  std::vector<double> sum_squares(num_groups, 0.0);
+  std::vector<int> count(num_groups, 0);
+  for (int i = 0; i < input.size(); ++i) {
+    sum[key.data()[i]] += input.data()[i];
+    count[key.data()[i]] += 1;
+  }
+  for (int i = 0; i < input.size(); ++i) {
+    const double delta = input.data()[i] - sum[key.data()[i]] / count[key.data()[i]];
+    sum_squares[key.data()[i]] += delta * delta;
+  }
+  Tensor<double, 4, DataLayout> result(input.dimensions());
+  for (int i = 0; i < input.size(); ++i) {
+    const int g = key.data()[i];
+    result.data()[i] = (input.data()[i] - sum[g] / count[g]) / std::sqrt(sum_squares[g] / count[g] + epsilon);
+  }
+  return result;
+}
+
+template <int DataLayout, int NumReduced>
+static void test_normalize(const array<int, NumReduced>& dims) {
+  Tensor<float, 4, DataLayout> input(5, 7, 11, 13);
+  input.setRandom();
+  // Offset the input to check that the variance doesn't suffer from
+  // cancellation.
+  input = input * 2.0f + 100.0f;
+  const float epsilon = 1e-3f;
+  Tensor<double, 4, DataLayout> expected = reference_normalize<DataLayout, NumReduced>(input, dims, epsilon);
+
+  Tensor<float, 4, DataLayout> result(input.dimensions());
+  result = input.normalize(dims, epsilon);
+  for (int i = 0; i < result.size(); ++i) {
+    VERIFY_IS_APPROX_OR_LESS_THAN(numext::abs(result.data()[i] - expected.data()[i]), 1e-3);
+  }
+
+  // The normalization of an expression matches the one of its value.
+  Tensor<float, 4, DataLayout> shifted = input - input.constant(100.0f);
+  Tensor<float, 4, DataLayout> fused(input.dimensions());
+  fused = (input - input.constant(100.0f)).normalize(dims);
+  Tensor<float, 4, DataLayout> explicit_normalized(input.dimensions());
+  explicit_normalized = shifted.normalize(dims);
+  for (int i = 0; i < fused.size(); ++i) {
+    VERIFY_IS_APPROX(fused.data()[i], explicit_normalized.data()[i]);
+  }
+
+  const int num_threads = internal::random<int>(2, 8);
+  Eigen::ThreadPool pool(num_threads);
+  Eigen::ThreadPoolDevice device(&pool, num_threads);
+  Tensor<float, 4, DataLayout> threaded(input.dimensions());
+  threaded.device(device) = input.normalize(dims, epsilon);
+  for (int i = 0; i < threaded.size(); ++i) {
+    VERIFY_IS_APPROX(threaded.data()[i], result.data()[i]);
+  }
+}
+
+template <int DataLayout>
+static void test_normalize_against_reductions() {
+  Tensor<float, 2, DataLayout> input(37, 129);
+  input.setRandom();
+  array<int, 1> reduced_dims = {{1}};
+  array<int, 2> reshaped_dims = {{37, 1}};
+  array<int, 2> bcast = {{1, 129}};
+
+  Tensor<float, 2, DataLayout> centered(input.dimensions());
+  centered = input - input.mean(reduced_dims).reshape(reshaped_dims).broadcast(bcast);
+  Tensor<float, 2, DataLayout> expected(input.dimensions());
+  expected = centered / centered.square().mean(reduced_dims).sqrt().reshape(reshaped_dims).broadcast(bcast);
+
+  Tensor<float, 2, DataLayout> result(input.dimensions());
+  result = input.normalize(reduced_dims);
+  for (int i = 0; i < result.size(); ++i) {
+    VERIFY_IS_APPROX_OR_LESS_THAN(numext::abs(result.data()[i] - expected.data()[i]), 1e-4f);
+  }
+}
+
+template <int DataLayout>
+static void test_normalize_layouts() {
+  // Reduction along the innermost dimensions, e.g. layer normalization.
+  array<int, 2> inner = DataLayout == ColMajor ? array<int, 2>{{0, 1}} : array<int, 2>{{3, 2}};
+  test_normalize<DataLayout, 2>(inner);
+  // Reduction along the outermost dimensions, e.g. batch normalization.
+  array<int, 3> outer = DataLayout == ColMajor ? array<int, 3>{{3, 1, 2}} : array<int, 3>{{0, 1, 2}};
+  test_normalize<DataLayout, 3>(outer);
+  // Reduction along dimensions that are neither.
+  array<int, 2> generic = {{1, 3}};
+  test_normalize<DataLayout, 2>(generic);
+  array<int, 1> middle = {{2}};
+  test_normalize<DataLayout, 1>(middle);
+  // Reduction along all the dimensions.
+  array<int, 4> all = {{0, 1, 2, 3}};
+  test_normalize<DataLayout, 4>(all);
+}
+
+EIGEN_DECLARE_TEST(cxx11_tensor_normalization)
+{
+  CALL_SUBTEST(test_normalize_layouts<ColMajor>());
+  CALL_SUBTEST(test_normalize_layouts<RowMajor>());
+  CALL_SUBTEST(test_normalize_against_reductions<ColMajor>());
+  CALL_SUBTEST(test_normalize_against_reductions<RowMajor>());
+}
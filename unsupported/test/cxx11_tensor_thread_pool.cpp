@@ -82,6 +82,31 @@ void test_multithread_compound_assignment()
   }
 }
 
+void test_async_multithread_elementwise()
+{
+  Tensor<float, 3> in1(200, 30, 70);
+  Tensor<float, 3> in2(200, 30, 70);
+  Tensor<double, 3> out(200, 30, 70);
+
+  in1.setRandom();
+  in2.setRandom();
+
+  Eigen::ThreadPool tp(internal::random<int>(3, 11));
+  Eigen::ThreadPoolDevice thread_pool_device(&tp, internal::random<int>(3, 11));
+
+  Eigen::Barrier b(1);
+  out.device(thread_pool_device, [&b]() { b.Notify(); }) = (in1 + in2 * 3.14f).cast<double>();
+  b.Wait();
+
+  for (int i = 0; i < 200; ++i) {
+    for (int j = 0; j < 30; ++j) {
+      for (int k = 0; k < 70; ++k) {
+        VERIFY_IS_APPROX(out(i, j, k), static_cast<double>(in1(i, j, k) + in2(i, j, k) * 3.14f));
+      }
+    }
+  }
+}
+
 template<int DataLayout>
 void test_multithread_contraction()
 {
@@ -122,6 +147,93 @@ void test_multithread_contraction()
   }
 }
 
+template<int DataLayout>
+void test_async_multithread_contraction()
+{
+  Tensor<float, 4, DataLayout> t_left(30, 50, 37, 31);
+  Tensor<float, 5, DataLayout> t_right(37, 31, 70, 2, 10);
+  Tensor<float, 5, DataLayout> t_result(30, 50, 70, 2, 10);
+  Tensor<float, 5, DataLayout> t_sum(30, 50, 70, 2, 10);
+
+  t_left.setRandom();
+  t_right.setRandom();
+
+  typedef Tensor<float, 1>::DimensionPair DimPair;
+  Eigen::array<DimPair, 2> dims({{DimPair(2, 0), DimPair(3, 1)}});
+
+  typedef Map<Matrix<float, Dynamic, Dynamic, DataLayout>> MapXf;
+  MapXf m_left(t_left.data(), 1500, 1147);
+  MapXf m_right(t_right.data(), 1147, 1400);
+  Matrix<float, Dynamic, Dynamic, DataLayout> m_result(1500, 1400);
+
+  Eigen::ThreadPool tp(4);
+  Eigen::ThreadPoolDevice thread_pool_device(&tp, 4);
+
+  // The contraction is evaluated directly into t_result, and into a temporary
+  // buffer when it is a sub expression of t_sum.
+  Eigen::Barrier b(2);
+  t_result.device(thread_pool_device, [&b]() { b.Notify(); }) = t_left.contract(t_right, dims);
+  t_sum.device(thread_pool_device, [&b]() { b.Notify(); }) = t_left.contract(t_right, dims) + t_result.constant(1.0f);
+  b.Wait();
+
+  m_result = m_left * m_right;
+
+  for (Index i = 0; i < t_result.size(); i++) {
+    VERIFY(&t_result.data()[i] != &m_result.data()[i]);
+    if (fabsf(t_result(i) - m_result(i)) >= 1e-4f) {
+      VERIFY_IS_APPROX(t_result(i), m_result(i));
+    }
+    if (fabsf(t_sum(i) - (m_result(i) + 1.0f)) >= 1e-4f) {
+      VERIFY_IS_APPROX(t_sum(i), m_result(i) + 1.0f);
+    }
+  }
+}
+
+// Pipelines many independent expressions through a pool that has fewer
+// threads than in-flight evaluations.
+template<int DataLayout>
+void test_async_multithread_many_exprs()
+{
+  const int num_exprs = 32;
+  std::vector<Tensor<float, 2, DataLayout> > lhs(num_exprs), rhs(num_exprs), out(num_exprs);
+  for (int e = 0; e < num_exprs; ++e) {
+    const Index m = internal::random<Index>(1, 100);
+    const Index k = internal::random<Index>(1, 100);
+    const Index n = internal::random<Index>(1, 100);
+    lhs[e].resize(m, k);
+    rhs[e].resize(k, n);
+    out[e].resize(m, n);
+    lhs[e].setRandom();
+    rhs[e].setRandom();
+  }
+
+  Eigen::ThreadPool tp(2);
+  Eigen::ThreadPoolDevice thread_pool_device(&tp, 2);
+
+  typedef Tensor<float, 1>::DimensionPair DimPair;
+  Eigen::array<DimPair, 1> dims({{DimPair(1, 0)}});
+
+  Eigen::Barrier b(num_exprs);
+  for (int e = 0; e < num_exprs; ++e) {
+    if (e % 2 == 0) {
+      out[e].device(thread_pool_device, [&b]() { b.Notify(); }) = lhs[e].contract(rhs[e], dims);
+    } else {
+      out[e].device(thread_pool_device, [&b]() { b.Notify(); }) = lhs[e].contract(rhs[e], dims).sqrt().abs();
+    }
+  }
+  b.Wait();
+
+  for (int e = 0; e < num_exprs; ++e) {
+    Tensor<float, 2, DataLayout> expected = lhs[e].contract(rhs[e], dims);
+    if (e % 2 == 1) expected = expected.sqrt().abs();
+    for (Index i = 0; i < expected.size(); ++i) {
+      if (!((numext::isnan)(expected(i)) && (numext::isnan)(out[e](i)))) {
+        VERIFY_IS_APPROX(out[e](i), expected(i));
+      }
+    }
+  }
+}
+
 template<int DataLayout>
 void test_contraction_corner_cases()
 {
@@ -306,6 +418,123 @@ static void test_multithread_contraction_with_output_kernel() {
   }
 }
 
+// Add a per-column bias and apply Relu to all output elements.
+struct BiasReluOutputKernel {
+  explicit BiasReluOutputKernel(const float* bias_data) : bias(bias_data) {}
+
+  template <typename Index, typename Scalar>
+  EIGEN_ALWAYS_INLINE void operator()(
+      const internal::blas_data_mapper<Scalar, Index, ColMajor>& output_mapper,
+      const TensorContractionParams&, Index, Index col_offset, Index num_rows,
+      Index num_cols) const {
+    for (Index j = 0; j < num_cols; ++j) {
+      const Scalar b = bias[col_offset + j];
+      for (Index i = 0; i < num_rows; ++i) {
+        output_mapper(i, j) = numext::maxi(output_mapper(i, j) + b, Scalar(0));
+      }
+    }
+  }
+
+  const float* bias;
+};
+
+// Checks that the output kernel sees every block exactly once, with the
+// right offsets, for both regular and inner dimension sharded contractions,
+// and for the sequential contraction on the default device.
+static void test_multithread_contraction_with_bias_relu_output_kernel(
+    Index m, Index k, Index n) {
+  typedef Tensor<float, 1>::DimensionPair DimPair;
+
+  const int num_threads = internal::random<int>(2, 11);
+  ThreadPool threads(num_threads);
+  Eigen::ThreadPoolDevice device(&threads, num_threads);
+
+  Tensor<float, 2> t_left(m, k);
+  Tensor<float, 2> t_right(k, n);
+  Tensor<float, 1> t_bias(n);
+  Tensor<float, 2> t_result(m, n);
+  Tensor<float, 2> t_result_default(m, n);
+
+  t_left.setRandom();
+  t_right.setRandom();
+  t_bias.setRandom();
+  t_result.setRandom();
+  t_result_default.setRandom();
+
+  Eigen::array<DimPair, 1> dims({{DimPair(1, 0)}});
+  t_result.device(device) =
+      t_left.contract(t_right, dims, BiasReluOutputKernel(t_bias.data()));
+  t_result_default =
+      t_left.contract(t_right, dims, BiasReluOutputKernel(t_bias.data()));
+
+  typedef Map<Eigen::MatrixXf> MapXf;
+  MapXf m_left(t_left.data(), m, k);
+  MapXf m_right(t_right.data(), k, n);
+  Eigen::MatrixXf m_result = m_left * m_right;
+  m_result.rowwise() += Map<Eigen::RowVectorXf>(t_bias.data(), n);
+  m_result = m_result.cwiseMax(0.0f);
+
+  for (Index i = 0; i < t_result.dimensions().TotalSize(); i++) {
+    if (numext::abs(t_result.data()[i] - m_result.data()[i]) >= 1e-3f) {
+      VERIFY_IS_APPROX(t_result.data()[i], m_result.data()[i]);
+    }
+    if (numext::abs(t_result_default.data()[i] - m_result.data()[i]) >= 1e-3f) {
+      VERIFY_IS_APPROX(t_result_default.data()[i], m_result.data()[i]);
+    }
+  }
+}
+
+// Contractions with a small output and a large inner dimension are sharded
+// by the inner dimension.
+template<int DataLayout>
+void test_sharded_by_inner_dim_contraction()
+{
+  typedef Tensor<float, 1>::DimensionPair DimPair;
+
+  const int num_threads = internal::random<int>(4, 16);
+  ThreadPool threads(num_threads);
+  Eigen::ThreadPoolDevice device(&threads, num_threads);
+
+  const Index m = internal::random<Index>(1, 100);
+  const Index n = internal::random<Index>(1, 100);
+  const Index k = internal::random<Index>(20000, 50000);
+
+  Tensor<float, 2, DataLayout> t_left(m, k);
+  Tensor<float, 2, DataLayout> t_right(k, n);
+  Tensor<float, 2, DataLayout> t_result(m, n);
+  Tensor<float, 2, DataLayout> t_result_sqrt(m, n);
+  Tensor<float, 2, DataLayout> t_result_async(m, n);
+
+  // Keep the entries positive for the sqrt output kernel.
+  t_left.setRandom();
+  t_right.setRandom();
+  t_left = t_left.abs();
+  t_right = t_right.abs();
+  // Put trash in the results to verify contraction clears output memory.
+  t_result.setRandom();
+  t_result_sqrt.setRandom();
+  t_result_async.setRandom();
+
+  Eigen::array<DimPair, 1> dims({{DimPair(1, 0)}});
+
+  t_result.device(device) = t_left.contract(t_right, dims);
+  t_result_sqrt.device(device) = t_left.contract(t_right, dims, SqrtOutputKernel());
+  Eigen::Barrier b(1);
+  t_result_async.device(device, [&b]() { b.Notify(); }) = t_left.contract(t_right, dims);
+  b.Wait();
+
+  typedef Map<Eigen::Matrix<float, Dynamic, Dynamic, DataLayout>> MapXf;
+  MapXf m_left(t_left.data(), m, k);
+  MapXf m_right(t_right.data(), k, n);
+  Eigen::Matrix<float, Dynamic, Dynamic, DataLayout> m_result = m_left * m_right;
+
+  for (Index i = 0; i < t_result.dimensions().TotalSize(); i++) {
+    VERIFY_IS_APPROX(t_result.data()[i], m_result.data()[i]);
+    VERIFY_IS_APPROX(t_result_sqrt.data()[i], std::sqrt(m_result.data()[i]));
+    VERIFY_IS_APPROX(t_result_async.data()[i], m_result.data()[i]);
+  }
+}
+
 template<int DataLayout>
 void test_full_contraction() {
   int contract_size1 = internal::random<int>(1, 500);
@@ -364,6 +593,100 @@ void test_multithreaded_reductions() {
   VERIFY_IS_APPROX(full_redux(), full_redux_tp());
 }
 
+template<int DataLayout, bool Exclusive>
+void test_multithreaded_scan() {
+  const int num_threads = internal::random<int>(3, 11);
+  ThreadPool thread_pool(num_threads);
+  Eigen::ThreadPoolDevice thread_pool_device(&thread_pool, num_threads);
+
+  // Many short lines along each axis, scanned by groups of lines.
+  Tensor<float, 3, DataLayout> t1(internal::random<int>(1, 37),
+                                  internal::random<int>(1, 37),
+                                  internal::random<int>(1, 37));
+  t1.setRandom();
+  t1 = t1.abs() + t1.constant(0.5f);
+  for (int axis = 0; axis < 3; ++axis) {
+    Tensor<float, 3, DataLayout> sum = t1.cumsum(axis, Exclusive);
+    Tensor<float, 3, DataLayout> sum_tp(t1.dimensions());
+    sum_tp.device(thread_pool_device) = t1.cumsum(axis, Exclusive);
+    Tensor<float, 3, DataLayout> prod = t1.cumprod(axis, Exclusive);
+    Tensor<float, 3, DataLayout> prod_tp(t1.dimensions());
+    prod_tp.device(thread_pool_device) = t1.cumprod(axis, Exclusive);
+    for (int i = 0; i < t1.size(); ++i) {
+      VERIFY_IS_EQUAL(sum(i), sum_tp(i));
+      VERIFY_IS_EQUAL(prod(i), prod_tp(i));
+    }
+  }
+
+  // A few long lines, split into blocks scanned in two passes.
+  const int num_lines = internal::random<int>(1, 2);
+  const int size = internal::random<int>(20000, 50000);
+  Tensor<float, 2, DataLayout> t2(num_lines, size);
+  t2.setRandom();
+  t2 = t2.abs() + t2.constant(0.5f);
+  Tensor<float, 2, DataLayout> sum = t2.cumsum(1, Exclusive);
+  Tensor<float, 2, DataLayout> sum_tp(num_lines, size);
+  sum_tp.device(thread_pool_device) = t2.cumsum(1, Exclusive);
+  for (int i = 0; i < num_lines; ++i) {
+    VERIFY_IS_EQUAL(sum_tp(i, 0), Exclusive ? 0.0f : t2(i, 0));
+    for (int j = 1; j < size; ++j) {
+      VERIFY_IS_APPROX(sum(i, j), sum_tp(i, j));
+    }
+  }
+  // A few groups of 8 long lines contiguous in memory, scanned by packets.
+  const bool col_major = static_cast<int>(DataLayout) == static_cast<int>(ColMajor);
+  Tensor<float, 2, DataLayout> t4(col_major ? 8 : size, col_major ? size : 8);
+  t4.setRandom();
+  t4 = t4.abs() + t4.constant(0.5f);
+  const int axis = col_major ? 1 : 0;
+  Tensor<float, 2, DataLayout> sum4 = t4.cumsum(axis, Exclusive);
+  Tensor<float, 2, DataLayout> sum4_tp(t4.dimensions());
+  sum4_tp.device(thread_pool_device) = t4.cumsum(axis, Exclusive);
+  for (int i = 0; i < t4.size(); ++i) {
+    if (sum4(i) == 0.0f) {
+      VERIFY_IS_EQUAL(sum4_tp(i), 0.0f);
+    } else {
+      VERIFY_IS_APPROX(sum4(i), sum4_tp(i));
+    }
+  }
+
+  Tensor<int, 2, DataLayout> t3 = (t2 * t2.constant(8.0f)).template cast<int>();
+  Tensor<int, 2, DataLayout> int_sum = t3.cumsum(1, Exclusive);
+  Tensor<int, 2, DataLayout> int_sum_tp(num_lines, size);
+  int_sum_tp.device(thread_pool_device) = t3.cumsum(1, Exclusive);
+  for (int i = 0; i < t3.size(); ++i) {
+    VERIFY_IS_EQUAL(int_sum(i), int_sum_tp(i));
+  }
+}
+
+
+template<int DataLayout>
+void test_multithread_fft() {
+  const int num_threads = internal::random<int>(3, 11);
+  ThreadPool thread_pool(num_threads);
+  Eigen::ThreadPoolDevice thread_pool_device(&thread_pool, num_threads);
+
+  // The dimensions of size 32 and 24 are transformed by the radix 4 and the
+  // Bluestein algorithms respectively.
+  Tensor<float, 3, DataLayout> input(32, 24, internal::random<int>(1, 40));
+  input.setRandom();
+  array<int, 3> fft;
+  fft[0] = 0;
+  fft[1] = 1;
+  fft[2] = 2;
+
+  Tensor<std::complex<float>, 3, DataLayout> forward = input.template fft<BothParts, FFT_FORWARD>(fft);
+  Tensor<std::complex<float>, 3, DataLayout> forward_tp(input.dimensions());
+  forward_tp.device(thread_pool_device) = input.template fft<BothParts, FFT_FORWARD>(fft);
+  Tensor<float, 3, DataLayout> round_trip_tp(input.dimensions());
+  round_trip_tp.device(thread_pool_device) = forward_tp.template fft<RealPart, FFT_REVERSE>(fft);
+
+  for (int i = 0; i < input.size(); ++i) {
+    VERIFY_IS_EQUAL(forward(i), forward_tp(i));
+    VERIFY_IS_APPROX(input(i) + 2.0f, round_trip_tp(i) + 2.0f);
+  }
+}
+
 
 void test_memcpy() {
 
@@ -433,18 +756,126 @@ void test_threadpool_allocate(TestAllocator* allocator)
   VERIFY_IS_EQUAL(allocator->dealloc_count(), num_allocs);
 }
 
+void test_threadpool_arena_allocator()
+{
+  ArenaAllocator arena;
+  std::vector<void*> buffers;
+  std::vector<size_t> sizes;
+  size_t num_small = 0;
+  for (int i = 0; i < 100; ++i) {
+    sizes.push_back(internal::random<size_t>(1, 100000));
+    if (sizes.back() < 4096) ++num_small;
+  }
+  for (size_t round = 0; round < 3; ++round) {
+    for (size_t size : sizes) {
+      char* buffer = static_cast<char*>(arena.allocate(size));
+      VERIFY(internal::UIntPtr(buffer) % EIGEN_MAX_ALIGN_BYTES == 0);
+      ::memset(buffer, static_cast<int>(round), size);
+      buffers.push_back(buffer);
+    }
+    for (void* buffer : buffers) arena.deallocate(buffer);
+    buffers.clear();
+    // The buffers of the first round are reused by the following ones, but
+    // the ones smaller than a page are always allocated by malloc.
+    VERIFY_IS_EQUAL(arena.numSystemAllocations(),
+                    sizes.size() + round * num_small);
+  }
+  VERIFY(arena.cachedBytes() > 0);
+  arena.Reset();
+  VERIFY_IS_EQUAL(arena.cachedBytes(), size_t(0));
+
+  // Temporaries of the evaluators are served by the scratch allocator.
+  const int num_threads = internal::random<int>(2, 11);
+  ThreadPool threads(num_threads);
+  ArenaAllocator scratch;
+  Eigen::ThreadPoolDevice device(&threads, num_threads, NULL, &scratch);
+
+  Tensor<float, 2> a(200, 300);
+  Tensor<float, 2> b(300, 100);
+  Tensor<float, 2> c(200, 100);
+  Tensor<float, 2> expected(200, 100);
+  a.setRandom();
+  b.setRandom();
+  typedef Tensor<float, 1>::DimensionPair DimPair;
+  Eigen::array<DimPair, 1> dims({{DimPair(1, 0)}});
+  expected = (a.contract(b, dims) + a.contract(b, dims).eval()).tanh();
+
+  size_t num_system_allocations = 0;
+  for (int round = 0; round < 3; ++round) {
+    c.device(device) = (a.contract(b, dims) + a.contract(b, dims).eval()).tanh();
+    for (Index i = 0; i < c.size(); ++i) {
+      VERIFY_IS_APPROX(c(i), expected(i));
+    }
+    if (round == 0) num_system_allocations = scratch.numSystemAllocations();
+  }
+  VERIFY(num_system_allocations > 0);
+  // Contraction packing buffers may be allocated in different orders across
+  // evaluations, but the cached buffers cover most of them.
+  VERIFY(scratch.numSystemAllocations() <= 2 * num_system_allocations);
+}
+
+void test_cost_model_calibration()
+{
+  typedef TensorCostModel<ThreadPoolDevice> CostModel;
+  const int num_threads = internal::random<int>(2, 8);
+  ThreadPool threads(num_threads);
+  Eigen::ThreadPoolDevice device(&threads, num_threads);
+
+  const TensorCostModelParameters params = calibrateTensorCostModel(device);
+  VERIFY_IS_EQUAL(params.device_cycles_per_compute_cycle, 1.0);
+  VERIFY(params.load_cycles_per_byte >= 0 && (numext::isfinite)(params.load_cycles_per_byte));
+  VERIFY(params.store_cycles_per_byte >= 0 && (numext::isfinite)(params.store_cycles_per_byte));
+  VERIFY(params.startup_cycles >= 0 && (numext::isfinite)(params.startup_cycles));
+  VERIFY(params.per_thread_cycles >= 1 && (numext::isfinite)(params.per_thread_cycles));
+  VERIFY(params.task_size >= 1 && (numext::isfinite)(params.task_size));
+
+  // Expressions evaluate the same with the calibrated parameters.
+  CostModel::setParameters(params);
+  Tensor<float, 3> in1(200, 30, 70);
+  Tensor<float, 3> out(200, 30, 70);
+  in1.setRandom();
+  out.device(device) = in1 * 3.14f;
+  for (Index i = 0; i < in1.size(); ++i) {
+    VERIFY_IS_APPROX(out.data()[i], in1.data()[i] * 3.14f);
+  }
+
+  // The parameters drive the number of threads.
+  const TensorOpCost cost(8, 4, 1);
+  TensorCostModelParameters custom = CostModel::defaultParameters();
+  custom.startup_cycles = 1e12;
+  CostModel::setParameters(custom);
+  VERIFY_IS_EQUAL(CostModel::numThreads(1e6, cost, num_threads), 1);
+  custom.startup_cycles = 0;
+  custom.per_thread_cycles = 1;
+  CostModel::setParameters(custom);
+  VERIFY_IS_EQUAL(CostModel::numThreads(1e6, cost, num_threads), num_threads);
+
+  CostModel::resetParameters();
+  VERIFY_IS_EQUAL(CostModel::parameters().startup_cycles,
+                  double(CostModel::kStartupCycles));
+  VERIFY_IS_EQUAL(CostModel::parameters().task_size,
+                  double(CostModel::kTaskSize));
+}
+
 EIGEN_DECLARE_TEST(cxx11_tensor_thread_pool)
 {
   CALL_SUBTEST_1(test_multithread_elementwise());
   CALL_SUBTEST_1(test_multithread_compound_assignment());
+  CALL_SUBTEST_1(test_async_multithread_elementwise());
 
   CALL_SUBTEST_2(test_multithread_contraction<ColMajor>());
   CALL_SUBTEST_2(test_multithread_contraction<RowMajor>());
+  CALL_SUBTEST_2(test_async_multithread_contraction<ColMajor>());
+  CALL_SUBTEST_2(test_async_multithread_contraction<RowMajor>());
+  CALL_SUBTEST_2(test_async_multithread_many_exprs<ColMajor>());
+  CALL_SUBTEST_2(test_async_multithread_many_exprs<RowMajor>());
 
   CALL_SUBTEST_3(test_multithread_contraction_agrees_with_singlethread<ColMajor>());
   CALL_SUBTEST_3(test_multithread_contraction_agrees_with_singlethread<RowMajor>());
   CALL_SUBTEST_3(test_multithread_contraction_with_output_kernel<ColMajor>());
   CALL_SUBTEST_3(test_multithread_contraction_with_output_kernel<RowMajor>());
+  CALL_SUBTEST_3(test_multithread_contraction_with_bias_relu_output_kernel(500, 300, 400));
+  CALL_SUBTEST_3(test_multithread_contraction_with_bias_relu_output_kernel(50, 30000, 40));
 
   // Exercise various cases that have been problematic in the past.
   CALL_SUBTEST_4(test_contraction_corner_cases<ColMajor>());
@@ -453,8 +884,18 @@ EIGEN_DECLARE_TEST(cxx11_tensor_thread_pool)
   CALL_SUBTEST_4(test_full_contraction<ColMajor>());
   CALL_SUBTEST_4(test_full_contraction<RowMajor>());
 
+  CALL_SUBTEST_4(test_sharded_by_inner_dim_contraction<ColMajor>());
+  CALL_SUBTEST_4(test_sharded_by_inner_dim_contraction<RowMajor>());
+
   CALL_SUBTEST_5(test_multithreaded_reductions<ColMajor>());
   CALL_SUBTEST_5(test_multithreaded_reductions<RowMajor>());
+  CALL_SUBTEST_5((test_multithreaded_scan<ColMajor, false>()));
+  CALL_SUBTEST_5((test_multithreaded_scan<RowMajor, false>()));
+  CALL_SUBTEST_5((test_multithreaded_scan<ColMajor, true>()));
+  CALL_SUBTEST_5((test_multithreaded_scan<RowMajor, true>()));
+
+  CALL_SUBTEST_5(test_multithread_fft<ColMajor>());
+  CALL_SUBTEST_5(test_multithread_fft<RowMajor>());
 
   CALL_SUBTEST_6(test_memcpy());
   CALL_SUBTEST_6(test_multithread_random());
@@ -463,4 +904,6 @@ EIGEN_DECLARE_TEST(cxx11_tensor_thread_pool)
   CALL_SUBTEST_6(test_multithread_shuffle<ColMajor>(NULL));
   CALL_SUBTEST_6(test_multithread_shuffle<RowMajor>(&test_allocator));
   CALL_SUBTEST_6(test_threadpool_allocate(&test_allocator));
+  CALL_SUBTEST_6(test_threadpool_arena_allocator());
+  CALL_SUBTEST_6(test_cost_model_calibration());
 }
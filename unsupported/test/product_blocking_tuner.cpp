@@ -0,0 +1,125 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "main.h"
+#include <unsupported/Eigen/ProductBlockingTuner>
+
+template<typename Scalar>
+void check_product(Index k, Index m, Index n)
+{
+  typedef Matrix<Scalar,Dynamic,Dynamic> MatrixType;
+  MatrixType lhs = MatrixType::Random(m, k);
+  MatrixType rhs = MatrixType::Random(k, n);
+  MatrixType res(m, n);
+  res.noalias() = lhs * rhs;
+  VERIFY_IS_APPROX(res, lhs.lazyProduct(rhs));
+}
+
+// a file name in the temporary directory, which differs between the subtests and between the runs
+template<typename Scalar>
+std::string temporary_filename()
+{
+  const char* dir = std::getenv("TMPDIR");
+  if(!dir || !*dir) dir = std::getenv("TEMP");
+#ifndef _WIN32
+  if(!dir || !*dir) dir = "/tmp";
+#endif
+  std::ostringstream name;
+  if(dir && *dir) name << dir << "/";
+  name << "product_blocking_sizes_" << sizeof(Scalar) << "_" << internal::random<int>(0,1000000000) << ".txt";
+  return name.str();
+}
+
+template<typename Scalar>
+void tuned_blocking_sizes()
+{
+  clearProductBlockingSizes();
+  Index k0 = 300, m0 = 270, n0 = 260;
+  internal::computeProductBlockingSizes<Scalar,Scalar>(k0, m0, n0);
+
+  // odd blocking sizes for the products whose dimensions lie in [256,512)
+  VERIFY((setProductBlockingSizes<Scalar,Scalar>(256, 256, 256, 7, 1, 3)));
+  Index k = 300, m = 270, n = 260;
+  internal::computeProductBlockingSizes<Scalar,Scalar>(k, m, n);
+  VERIFY_IS_EQUAL(k, 7);
+  VERIFY_IS_EQUAL(m, 1);
+  VERIFY_IS_EQUAL(n, 3);
+  check_product<Scalar>(300, 270, 260);
+
+  // larger sizes are rounded down to multiples of the register blocking sizes, like the default ones
+  typedef internal::gebp_traits<Scalar,Scalar> Traits;
+  VERIFY((setProductBlockingSizes<Scalar,Scalar>(256, 256, 256, 8*9+3, Traits::mr*5+1, Traits::nr*7+1)));
+  k = 300; m = 270; n = 260;
+  internal::computeProductBlockingSizes<Scalar,Scalar>(k, m, n);
+  VERIFY_IS_EQUAL(k, 8*9);
+  VERIFY_IS_EQUAL(m, Traits::mr*5);
+  VERIFY_IS_EQUAL(n, Traits::nr*7);
+  check_product<Scalar>(300, 270, 260);
+  VERIFY((setProductBlockingSizes<Scalar,Scalar>(256, 256, 256, 7, 1, 3)));
+
+  // other classes of products are not affected
+  Index k1 = 600, m1 = 270, n1 = 260;
+  internal::computeProductBlockingSizes<Scalar,Scalar>(k1, m1, n1);
+  VERIFY(k1!=7 && m1!=1 && n1!=3);
+  Index k2 = 300, m2 = 270, n2 = 260;
+  internal::computeProductBlockingSizes<Scalar,std::complex<Scalar> >(k2, m2, n2);
+  VERIFY(k2!=7);
+
+  // multi-threaded products keep the default blocking sizes
+  Index k3 = 300, m3 = 270, n3 = 260;
+  internal::computeProductBlockingSizes<Scalar,Scalar>(k3, m3, n3, Index(2));
+  VERIFY(k3!=7);
+
+  // save and reload
+  std::string filename = temporary_filename<Scalar>();
+  VERIFY(saveProductBlockingSizes(filename.c_str()));
+  clearProductBlockingSizes();
+  k = 300; m = 270; n = 260;
+  internal::computeProductBlockingSizes<Scalar,Scalar>(k, m, n);
+  VERIFY_IS_EQUAL(k, k0);
+  VERIFY_IS_EQUAL(m, m0);
+  VERIFY_IS_EQUAL(n, n0);
+  VERIFY(loadProductBlockingSizes(filename.c_str()));
+  k = 300; m = 270; n = 260;
+  internal::computeProductBlockingSizes<Scalar,Scalar>(k, m, n);
+  VERIFY_IS_EQUAL(k, 7);
+  VERIFY_IS_EQUAL(m, 1);
+  VERIFY_IS_EQUAL(n, 3);
+  std::remove(filename.c_str());
+  VERIFY(!loadProductBlockingSizes(filename.c_str()));
+
+  clearProductBlockingSizes();
+}
+
+template<typename Scalar>
+void autotune()
+{
+  clearProductBlockingSizes();
+  Index size = internal::random<Index>(64,128);
+  Index kc, mc, nc;
+  double speedup = autotuneProductBlockingSizes<Scalar>(size, size, size, kc, mc, nc, 1e-3);
+  VERIFY(speedup>=1);
+  VERIFY(kc>0 && mc>0 && nc>0);
+  if(speedup>1)
+  {
+    Index k = size, m = size, n = size;
+    internal::computeProductBlockingSizes<Scalar,Scalar>(k, m, n);
+    VERIFY_IS_EQUAL(k, (std::min)(kc, size));
+    VERIFY_IS_EQUAL(m, (std::min)(mc, size));
+    VERIFY_IS_EQUAL(n, (std::min)(nc, size));
+  }
+  check_product<Scalar>(size, size, size);
+  clearProductBlockingSizes();
+}
+
+EIGEN_DECLARE_TEST(product_blocking_tuner)
+{
+  CALL_SUBTEST_1( tuned_blocking_sizes<float>() );
+  CALL_SUBTEST_2( tuned_blocking_sizes<double>() );
+  CALL_SUBTEST_3( autotune<float>() );
+  CALL_SUBTEST_4( autotune<double>() );
+}
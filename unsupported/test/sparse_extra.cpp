@@ -142,6 +142,103 @@ void check_marketio()
   VERIFY_IS_EQUAL(DenseMatrix(m1),DenseMatrix(m2));
 }
 
+template<typename Scalar, typename StorageIndex>
+void check_sell_c_sigma()
+{
+  typedef SparseMatrix<Scalar,ColMajor,StorageIndex> SparseMatrixType;
+  typedef SellCSigmaMatrix<Scalar,StorageIndex> SellMatrixType;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  typedef Matrix<Scalar,Dynamic,1> DenseVector;
+  Index rows = internal::random<Index>(1,300);
+  Index cols = internal::random<Index>(1,300);
+  Index sigma = internal::random<Index>(1,2*rows);
+
+  // rows of very different lengths, including empty ones
+  SparseMatrixType m(rows, cols);
+  for(Index i=0; i<rows; ++i)
+  {
+    Index length = internal::random<int>(0,4)==0 ? 0 : internal::random<Index>(0,(std::min)(cols,Index(30)));
+    for(Index k=0; k<length; ++k)
+      m.coeffRef(i, internal::random<Index>(0,cols-1)) = internal::random<Scalar>();
+  }
+  SellMatrixType s(m, sigma);
+  VERIFY_IS_EQUAL(s.rows(), rows);
+  VERIFY_IS_EQUAL(s.cols(), cols);
+  VERIFY_IS_EQUAL(s.nonZeros(), m.nonZeros());
+  VERIFY(s.storageSize() >= s.nonZeros());
+
+  // the rows are stored as they are in the row-major copy
+  SparseMatrix<Scalar,RowMajor,StorageIndex> rm(m);
+  for(Index i=0; i<rows; ++i)
+  {
+    typename SellMatrixType::InnerIterator it(s, i);
+    for(typename SparseMatrix<Scalar,RowMajor,StorageIndex>::InnerIterator refIt(rm, i); refIt; ++refIt, ++it)
+    {
+      VERIFY(it);
+      VERIFY_IS_EQUAL(it.index(), refIt.index());
+      VERIFY_IS_EQUAL(it.value(), refIt.value());
+    }
+    VERIFY(!it);
+  }
+
+  DenseVector x = DenseVector::Random(cols);
+  DenseVector y = DenseVector::Random(rows);
+  DenseVector ref = y - m * x;
+  VERIFY_IS_APPROX(DenseVector(s * x), DenseVector(m * x));
+  y.noalias() -= s * x;
+  VERIFY_IS_APPROX(y, ref);
+
+  // the padding of the empty rows does not propagate the non finite coefficients of x
+  DenseVector xInf = x;
+  xInf(0) = std::numeric_limits<Scalar>::infinity();
+  DenseVector yInf = s * xInf;
+  for(Index i=0; i<rows; ++i)
+    if(rm.outerIndexPtr()[i+1]==rm.outerIndexPtr()[i])
+      VERIFY_IS_EQUAL(yInf(i), Scalar(0));
+
+  // the product is evaluated into a temporary when the destination is the vector itself
+  SparseMatrixType sq = m.block(0, 0, (std::min)(rows,cols), (std::min)(rows,cols));
+  SellMatrixType ssq(sq, sigma);
+  DenseVector z = DenseVector::Random(sq.cols());
+  ref = sq * z;
+  z = ssq * z;
+  VERIFY_IS_APPROX(z, ref);
+
+  Index n = internal::random<Index>(1,5);
+  DenseMatrix X = DenseMatrix::Random(cols, n);
+  Matrix<Scalar,Dynamic,Dynamic,RowMajor> rowMajorX = X;
+  DenseMatrix Y = s * X;
+  VERIFY_IS_APPROX(Y, DenseMatrix(m * X));
+  Y.noalias() = s * rowMajorX;
+  VERIFY_IS_APPROX(Y, DenseMatrix(m * X));
+  Y.noalias() = s * (X + X).middleCols(0,1);
+  VERIFY_IS_APPROX(Y, DenseMatrix(m * (X + X).middleCols(0,1)));
+
+  // without sorting
+  SellMatrixType unsorted(m, 1);
+  VERIFY_IS_APPROX(DenseVector(unsorted * x), DenseVector(m * x));
+
+  // as the matrix of an iterative solver
+  Index size = internal::random<Index>(10,300);
+  SparseMatrixType a(size, size);
+  for(Index i=0; i<size; ++i)
+  {
+    a.coeffRef(i,i) = Scalar(4);
+    if(i>0)      a.coeffRef(i,i-1) = Scalar(-1);
+    if(i+1<size) a.coeffRef(i,i+1) = Scalar(-1);
+  }
+  SellMatrixType sa(a);
+  DenseVector b = DenseVector::Random(size);
+  ConjugateGradient<SellMatrixType, Lower|Upper, IdentityPreconditioner> cg(sa);
+  DenseVector xcg = cg.solve(b);
+  VERIFY(cg.info() == Success);
+  VERIFY_IS_APPROX(a * xcg, b);
+  BiCGSTAB<SellMatrixType, DiagonalPreconditioner<Scalar> > bicg(sa);
+  DenseVector xbicg = bicg.solve(b);
+  VERIFY(bicg.info() == Success);
+  VERIFY_IS_APPROX(a * xbicg, b);
+}
+
 EIGEN_DECLARE_TEST(sparse_extra)
 {
   for(int i = 0; i < g_repeat; i++) {
@@ -165,6 +262,10 @@ EIGEN_DECLARE_TEST(sparse_extra)
     CALL_SUBTEST_4( (check_marketio<SparseMatrix<double,ColMajor,long int> >()) );
     CALL_SUBTEST_4( (check_marketio<SparseMatrix<std::complex<float>,ColMajor,long int> >()) );
     CALL_SUBTEST_4( (check_marketio<SparseMatrix<std::complex<double>,ColMajor,long int> >()) );
+
+    CALL_SUBTEST_5( (check_sell_c_sigma<float,int>()) );
+    CALL_SUBTEST_5( (check_sell_c_sigma<double,int>()) );
+    CALL_SUBTEST_5( (check_sell_c_sigma<std::complex<double>,long int>()) );
     TEST_SET_BUT_UNUSED_VARIABLE(s);
   }
 }